@@ -204,3 +204,120 @@ def handle_create_game_mode(command: Dict[str, Any]) -> Dict[str, Any]:
         return json.loads(result)
     except Exception as e:
         return {"success": False, "error": str(e)}
+
+
+def _spatial_result(query: str, result_json: str) -> Dict[str, Any]:
+    result = json.loads(result_json)
+    log.log_result(query, result.get("success", False), f"{len(result.get('actors', []))} actors")
+    return result
+
+
+def handle_find_actors_in_radius(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to find the actors within a radius of a point
+
+    Args:
+        command: The command dictionary containing:
+            - center: [X, Y, Z] center of the sphere
+            - radius: Radius of the sphere
+            - max_results: Maximum number of actors, closest first (optional, default 50)
+
+    Returns:
+        Response dictionary with the actors sorted by distance
+    """
+    try:
+        center = command.get("center")
+        radius = command.get("radius")
+        if center is None or radius is None:
+            return {"success": False, "error": "Missing center or radius"}
+
+        log.log_command("find_actors_in_radius", f"Center: {center}, Radius: {radius}")
+        result = unreal.GenActorUtils.find_actors_in_radius(uc.to_unreal_vector(center), float(radius),
+                                                            int(command.get("max_results", 50)))
+        return _spatial_result("find_actors_in_radius", result)
+    except Exception as e:
+        log.log_error(f"Error finding actors in radius: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
+def handle_find_actors_in_box(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to find the actors intersecting a box
+
+    Args:
+        command: The command dictionary containing:
+            - min: [X, Y, Z] minimum corner of the box
+            - max: [X, Y, Z] maximum corner of the box
+            - max_results: Maximum number of actors, closest to the box center first (optional, default 50)
+
+    Returns:
+        Response dictionary with the actors sorted by distance to the box center
+    """
+    try:
+        box_min = command.get("min")
+        box_max = command.get("max")
+        if box_min is None or box_max is None:
+            return {"success": False, "error": "Missing min or max"}
+
+        log.log_command("find_actors_in_box", f"Min: {box_min}, Max: {box_max}")
+        result = unreal.GenActorUtils.find_actors_in_box(uc.to_unreal_vector(box_min), uc.to_unreal_vector(box_max),
+                                                         int(command.get("max_results", 50)))
+        return _spatial_result("find_actors_in_box", result)
+    except Exception as e:
+        log.log_error(f"Error finding actors in box: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
+def handle_find_actors_along_ray(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to find the actors whose bounds a ray passes through
+
+    Args:
+        command: The command dictionary containing:
+            - start: [X, Y, Z] start of the ray
+            - direction: [X, Y, Z] direction of the ray
+            - max_distance: Length of the ray (optional, default 100000)
+            - max_results: Maximum number of actors, first hit first (optional, default 50)
+
+    Returns:
+        Response dictionary with the actors sorted by the distance where the ray enters them
+    """
+    try:
+        start = command.get("start")
+        direction = command.get("direction")
+        if start is None or direction is None:
+            return {"success": False, "error": "Missing start or direction"}
+
+        log.log_command("find_actors_along_ray", f"Start: {start}, Direction: {direction}")
+        result = unreal.GenActorUtils.find_actors_along_ray(uc.to_unreal_vector(start), uc.to_unreal_vector(direction),
+                                                            float(command.get("max_distance", 100000.0)),
+                                                            int(command.get("max_results", 50)))
+        return _spatial_result("find_actors_along_ray", result)
+    except Exception as e:
+        log.log_error(f"Error finding actors along ray: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
+def handle_find_nearest_actors(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to find the actors closest to a point
+
+    Args:
+        command: The command dictionary containing:
+            - location: [X, Y, Z] point to search from
+            - count: Number of actors (optional, default 10)
+
+    Returns:
+        Response dictionary with the actors sorted by distance
+    """
+    try:
+        location = command.get("location")
+        if location is None:
+            return {"success": False, "error": "Missing location"}
+
+        log.log_command("find_nearest_actors", f"Location: {location}")
+        result = unreal.GenActorUtils.find_nearest_actors(uc.to_unreal_vector(location), int(command.get("count", 10)))
+        return _spatial_result("find_nearest_actors", result)
+    except Exception as e:
+        log.log_error(f"Error finding nearest actors: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
@@ -2,6 +2,7 @@ import unreal
 from typing import Dict, Any, List, Tuple
 
 import base64
+import json
 import os
 import mss
 import time
@@ -185,6 +186,67 @@ def handle_get_all_scene_objects(command: Dict[str, Any]) -> Dict[str, Any]:
     except Exception as e:
         return {"success": False, "error": str(e)}
 
+def _build_scene_query(command: Dict[str, Any]) -> str:
+    query = {key: command[key] for key in ("classes", "folder", "bounds", "fields", "cursor", "limit")
+             if command.get(key) is not None}
+    return json.dumps(query)
+
+
+def handle_get_scene_snapshot(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to get one page of the scene actors together with a version token
+
+    Args:
+        command: The command dictionary containing optional query fields:
+            - classes: Class names, actors of these classes or their subclasses match
+            - folder: Outliner folder path prefix
+            - bounds: {"min": [X, Y, Z], "max": [X, Y, Z]} box the actor bounds must intersect
+            - fields: Fields per actor besides "id" (name, label, class, folder, location, rotation,
+              scale, bounds, components or all), default name, label, class and location
+            - cursor: next_cursor of the previous page
+            - limit: Actors per page
+
+    Returns:
+        Response dictionary with the actors, the version token and the cursor of the next page
+    """
+    try:
+        log.log_command("get_scene_snapshot", f"Cursor: {command.get('cursor', '')}")
+        result_json = unreal.GenObjectProperties.get_scene_snapshot(_build_scene_query(command))
+        result = json.loads(result_json)
+        log.log_result("get_scene_snapshot", result.get("success", False),
+                       f"{len(result.get('actors', []))} actors, {result.get('remaining', 0)} remaining")
+        return result
+    except Exception as e:
+        log.log_error(f"Error getting scene snapshot: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
+def handle_get_scene_changes(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to get the scene actors changed since a version token
+
+    Args:
+        command: The command dictionary containing:
+            - since_version: Version token of a snapshot or of the previous change query
+            - classes, folder, bounds, fields, limit: Same as for get_scene_snapshot
+
+    Returns:
+        Response dictionary with the changed actors, the removed actor ids and the new version token,
+        or reset set to True when a new snapshot has to be taken
+    """
+    try:
+        since_version = command.get("since_version", "")
+        log.log_command("get_scene_changes", f"Since: {since_version}")
+        result_json = unreal.GenObjectProperties.get_scene_changes(since_version, _build_scene_query(command))
+        result = json.loads(result_json)
+        log.log_result("get_scene_changes", result.get("success", False),
+                       f"{len(result.get('changed', []))} changed, {len(result.get('removed', []))} removed")
+        return result
+    except Exception as e:
+        log.log_error(f"Error getting scene changes: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
 def handle_create_project_folder(command: Dict[str, Any]) -> Dict[str, Any]:
     try:
         folder_path = command.get("folder_path")
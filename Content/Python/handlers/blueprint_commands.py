@@ -299,6 +299,38 @@ def handle_compile_blueprint(command: Dict[str, Any]) -> Dict[str, Any]:
         return {"success": False, "error": str(e)}
 
 
+def handle_flush_compiles(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to compile every Blueprint still waiting for the coalesced compile
+
+    Args:
+        command: The command dictionary (no parameters)
+
+    Returns:
+        Response dictionary with the status, errors and warnings of each compiled Blueprint
+    """
+    try:
+        log.log_command("flush_compiles", "Compiling pending Blueprints")
+
+        # Call the C++ implementation
+        gen_bp_utils = unreal.GenBlueprintUtils
+        result_json = gen_bp_utils.flush_pending_compiles()
+
+        try:
+            result_data = json.loads(result_json)
+        except json.JSONDecodeError:
+            log.log_error(f"Failed to parse JSON result from flush_compiles: {result_json}")
+            return {"success": False, "error": "Failed to parse compile results"}
+
+        log.log_result("flush_compiles", result_data.get("success", False),
+                       f"Compiled {result_data.get('compiled', 0)} pending Blueprints")
+        return result_data
+
+    except Exception as e:
+        log.log_error(f"Error flushing compiles: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
 def handle_spawn_blueprint(command: Dict[str, Any]) -> Dict[str, Any]:
     """
     Handle a command to spawn a Blueprint actor in the level
@@ -458,6 +490,55 @@ def handle_connect_nodes_bulk(command: Dict[str, Any]) -> Dict[str, Any]:
         log.log_error(f"Error connecting nodes: {str(e)}", include_traceback=True)
         return {"success": False, "error": str(e)}
 
+def handle_apply_graph(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to make a Blueprint graph match a complete graph spec
+
+    Args:
+        command: The command dictionary containing:
+            - blueprint_path: Path to the Blueprint asset
+            - function_id: ID of the function graph, or "EventGraph"
+            - graph: The graph spec, containing:
+                * nodes: Array of nodes, each with a stable "id" and either "node_type" (with optional
+                  "node_position" and "node_properties") or the "guid" of an existing node
+                * links: Array of links with source_node_id, source_pin, target_node_id and target_pin,
+                  the node ids are spec ids or existing node GUIDs
+                * prune: Delete nodes and links the spec does not mention (default False), skipped on any error
+                * compile: Compile the Blueprint once the changes are applied (default True)
+
+    Returns:
+        Response dictionary with the node id to GUID mapping and the applied changes
+    """
+    try:
+        blueprint_path = command.get("blueprint_path")
+        function_id = command.get("function_id")
+        graph = command.get("graph")
+
+        if not blueprint_path or not function_id or not isinstance(graph, dict):
+            log.log_error("Missing required parameters for apply_graph")
+            return {"success": False, "error": "Missing required parameters"}
+
+        log.log_command("apply_graph",
+                        f"Blueprint: {blueprint_path}, {len(graph.get('nodes', []))} nodes, {len(graph.get('links', []))} links")
+
+        node_creator = unreal.GenBlueprintNodeCreator
+        result_json = node_creator.apply_graph(blueprint_path, function_id, json.dumps(graph))
+
+        try:
+            result_data = json.loads(result_json)
+        except json.JSONDecodeError:
+            log.log_error(f"Failed to parse JSON result from apply_graph: {result_json}")
+            return {"success": False, "error": "Failed to parse apply results"}
+
+        log.log_result("apply_graph", result_data.get("success", False),
+                       f"Applied graph to {blueprint_path}: {result_data.get('nodes_created', 0)} created, "
+                       f"{result_data.get('nodes_deleted', 0)} deleted, {result_data.get('links_added', 0)} links added")
+        return result_data
+
+    except Exception as e:
+        log.log_error(f"Error applying graph: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
 def handle_delete_node(command: Dict[str, Any]) -> Dict[str, Any]:
     """
     Handle a command to delete a node from a Blueprint graph
@@ -691,6 +691,37 @@ def compile_blueprint(blueprint_path: str) -> str:
         return f"Failed to compile Blueprint: {response.get('error', 'Unknown error')}"
 
 
+@mcp.tool()
+def flush_compiles() -> str:
+    """
+    Compile every Blueprint whose edits are still waiting for the next coalesced compile.
+    Call this before reading compile errors after a series of edits.
+
+    Returns:
+        The status of each compiled Blueprint with its compiler errors and warnings
+    """
+    command = {
+        "type": "flush_compiles"
+    }
+
+    response = send_to_unreal(command)
+    if not response.get("success"):
+        return f"Failed to flush compiles: {response.get('error', 'Unknown error')}"
+
+    blueprints = response.get("blueprints", [])
+    if not blueprints:
+        return "No Blueprints were waiting to compile"
+
+    lines = [f"Compiled {response.get('compiled', len(blueprints))} Blueprints:"]
+    for blueprint in blueprints:
+        lines.append(f"- {blueprint.get('path')}: {blueprint.get('status')}")
+        for error in blueprint.get("errors", []):
+            lines.append(f"    error in {error.get('graph')} / {error.get('node_title')} ({error.get('node_guid')}): {error.get('message')}")
+        for warning in blueprint.get("warnings", []):
+            lines.append(f"    warning in {warning.get('graph')} / {warning.get('node_title')} ({warning.get('node_guid')}): {warning.get('message')}")
+    return "\n".join(lines)
+
+
 @mcp.tool()
 def spawn_blueprint_actor(blueprint_path: str, location: list = [0, 0, 0],
                           rotation: list = [0, 0, 0], scale: list = [1, 1, 1],
@@ -875,6 +906,58 @@ def connect_blueprint_nodes_bulk(blueprint_path: str, function_id: str, connecti
             return f"Failed to connect nodes: {error_message}"
 
 
+@mcp.tool()
+def apply_blueprint_graph(blueprint_path: str, function_id: str, nodes: list, links: list = None,
+                          prune: bool = False, compile_blueprint: bool = True) -> str:
+    """
+    Make a Blueprint graph match a complete spec in one call. Only the differences to the current graph are
+    applied: missing nodes are created, changed pin defaults and positions are updated and, with prune, nodes
+    and links the spec does not contain are removed, all in one undo step followed by a single compile. Send
+    the whole spec again with the same ids to revise the graph.
+
+    Args:
+        blueprint_path: Path to the Blueprint asset
+        function_id: ID of the function graph, or "EventGraph"
+        nodes: Array of nodes, each containing:
+            - id: Stable reference ID, keep it the same across revisions
+            - node_type: Type of node, as for add_node (changing it replaces the node)
+            - node_position: Optional [X, Y] position
+            - node_properties: Optional pin default values
+            or, to use a node that already exists (e.g. the function entry):
+            - id: Reference ID
+            - guid: GUID of the existing node
+        links: Array of links, each containing source_node_id, source_pin, target_node_id and target_pin,
+               the node ids are the spec ids or existing node GUIDs
+        prune: Delete nodes and links the spec does not contain (default False), entry nodes are always kept.
+               Only use it with a spec of the whole graph, nothing is deleted when any node fails
+        compile_blueprint: Compile the Blueprint after applying (default True)
+
+    Returns:
+        Message with the node id to GUID mapping and the applied changes, or the errors
+    """
+    command = {
+        "type": "apply_graph",
+        "blueprint_path": blueprint_path,
+        "function_id": function_id,
+        "graph": {
+            "nodes": nodes,
+            "links": links or [],
+            "prune": prune,
+            "compile": compile_blueprint
+        }
+    }
+
+    response = send_to_unreal(command)
+    summary = (f"{response.get('nodes_created', 0)} created, {response.get('nodes_updated', 0)} updated, "
+               f"{response.get('nodes_deleted', 0)} deleted, {response.get('links_added', 0)} links added, "
+               f"{response.get('links_removed', 0)} links removed")
+    if response.get("success"):
+        return f"Applied graph to {blueprint_path}: {summary}\nNodes: {json.dumps(response.get('nodes', {}))}"
+
+    errors = response.get("errors") or [response.get("error", "Unknown error")]
+    return f"Failed to apply graph: {summary}\n- " + "\n- ".join(errors) + f"\nNodes: {json.dumps(response.get('nodes', {}))}"
+
+
 @mcp.tool()
 def get_blueprint_node_guid(blueprint_path: str, graph_type: str = "EventGraph", node_name: str = None,
                             function_id: str = None) -> str:
@@ -941,6 +1024,126 @@ def get_all_scene_objects() -> str:
     return json.dumps(response) if response.get("success") else f"Failed: {response.get('error', 'Unknown error')}"
 
 
+@mcp.tool()
+def get_scene_snapshot(classes: list = None, folder: str = None, bounds: dict = None, fields: list = None,
+                       cursor: str = None, limit: int = None) -> str:
+    """
+    Get the actors of the current level one page at a time, with a version token to follow later changes
+    through get_scene_changes instead of fetching the whole scene again.
+
+    Args:
+        classes: Optional class names, actors of these classes or their subclasses match (e.g. ["StaticMeshActor"])
+        folder: Optional outliner folder path prefix
+        bounds: Optional {"min": [X, Y, Z], "max": [X, Y, Z]} box the actor bounds must intersect
+        fields: Fields per actor besides "id": name, label, class, folder, location, rotation, scale, bounds,
+                components, or "all" (default name, label, class and location)
+        cursor: next_cursor of the previous page
+        limit: Actors per page (default 1000)
+
+    Returns:
+        JSON with the actors, "version" and "next_cursor" while pages remain. Keep the version of the first
+        page to ask for changes.
+    """
+    command = {"type": "get_scene_snapshot", "classes": classes, "folder": folder, "bounds": bounds,
+               "fields": fields, "cursor": cursor, "limit": limit}
+    response = send_to_unreal(command)
+    return json.dumps(response) if response.get("success") else f"Failed: {response.get('error', 'Unknown error')}"
+
+
+@mcp.tool()
+def get_scene_changes(since_version: str, classes: list = None, folder: str = None, bounds: dict = None,
+                      fields: list = None, limit: int = None) -> str:
+    """
+    Get the actors added, changed or removed since a version token from get_scene_snapshot or a previous call.
+
+    Args:
+        since_version: Version token to continue from
+        classes, folder, bounds, fields: Same filters and fields as the snapshot
+        limit: Maximum number of actors per call (default 1000), has_more tells whether to call again
+
+    Returns:
+        JSON with "changed" actors, "removed" actor ids (deleted or no longer matching) and the next "version".
+        When "reset" is true the changes are no longer available and a new snapshot is needed.
+    """
+    command = {"type": "get_scene_changes", "since_version": since_version, "classes": classes, "folder": folder,
+               "bounds": bounds, "fields": fields, "limit": limit}
+    response = send_to_unreal(command)
+    return json.dumps(response) if response.get("success") else f"Failed: {response.get('error', 'Unknown error')}"
+
+
+@mcp.tool()
+def find_actors_in_radius(center: list, radius: float, max_results: int = 50) -> str:
+    """
+    Find the actors of the current level whose bounds are within a radius of a point.
+
+    Args:
+        center: [X, Y, Z] center of the search
+        radius: Search radius
+        max_results: Maximum number of actors to return, closest first
+
+    Returns:
+        JSON with the actors (id, label, class, location, distance) sorted by distance
+    """
+    command = {"type": "find_actors_in_radius", "center": center, "radius": radius, "max_results": max_results}
+    response = send_to_unreal(command)
+    return json.dumps(response) if response.get("success") else f"Failed: {response.get('error', 'Unknown error')}"
+
+
+@mcp.tool()
+def find_actors_in_box(box_min: list, box_max: list, max_results: int = 50) -> str:
+    """
+    Find the actors of the current level whose bounds intersect a box, e.g. to see what is inside a volume.
+
+    Args:
+        box_min: [X, Y, Z] minimum corner of the box
+        box_max: [X, Y, Z] maximum corner of the box
+        max_results: Maximum number of actors to return, closest to the box center first
+
+    Returns:
+        JSON with the actors (id, label, class, location, distance) sorted by distance to the box center
+    """
+    command = {"type": "find_actors_in_box", "min": box_min, "max": box_max, "max_results": max_results}
+    response = send_to_unreal(command)
+    return json.dumps(response) if response.get("success") else f"Failed: {response.get('error', 'Unknown error')}"
+
+
+@mcp.tool()
+def find_actors_along_ray(start: list, direction: list, max_distance: float = 100000.0, max_results: int = 50) -> str:
+    """
+    Find the actors of the current level whose bounds a ray passes through, e.g. what is in front of an actor.
+
+    Args:
+        start: [X, Y, Z] start of the ray
+        direction: [X, Y, Z] direction of the ray
+        max_distance: Length of the ray
+        max_results: Maximum number of actors to return, first hit first
+
+    Returns:
+        JSON with the actors (id, label, class, location, distance) sorted by where the ray enters their bounds
+    """
+    command = {"type": "find_actors_along_ray", "start": start, "direction": direction,
+               "max_distance": max_distance, "max_results": max_results}
+    response = send_to_unreal(command)
+    return json.dumps(response) if response.get("success") else f"Failed: {response.get('error', 'Unknown error')}"
+
+
+@mcp.tool()
+def find_nearest_actors(location: list, count: int = 10) -> str:
+    """
+    Find the actors of the current level closest to a point.
+
+    Args:
+        location: [X, Y, Z] point to search from
+        count: Number of actors to return
+
+    Returns:
+        JSON with the actors (id, label, class, location, distance) sorted by distance
+    """
+    command = {"type": "find_nearest_actors", "location": location, "count": count}
+    response = send_to_unreal(command)
+    return json.dumps(response) if response.get("success") else f"Failed: {response.get('error', 'Unknown error')}"
+
+
 # Project Control
 @mcp.tool()
 def create_project_folder(folder_path: str) -> str:
@@ -38,6 +38,7 @@ class CommandDispatcher:
             "add_node": blueprint_commands.handle_add_node,
             "connect_nodes": blueprint_commands.handle_connect_nodes,
             "compile_blueprint": blueprint_commands.handle_compile_blueprint,
+            "flush_compiles": blueprint_commands.handle_flush_compiles,
             "spawn_blueprint": blueprint_commands.handle_spawn_blueprint,
             "delete_node": blueprint_commands.handle_delete_node,
             
@@ -50,6 +51,7 @@ class CommandDispatcher:
             # Bulk commands
             "add_nodes_bulk": blueprint_commands.handle_add_nodes_bulk,
             "connect_nodes_bulk": blueprint_commands.handle_connect_nodes_bulk,
+            "apply_graph": blueprint_commands.handle_apply_graph,
             
             # Python and console
             "execute_python": python_commands.handle_execute_python,
@@ -61,6 +63,12 @@ class CommandDispatcher:
             
             # Scene
             "get_all_scene_objects": basic_commands.handle_get_all_scene_objects,
+            "get_scene_snapshot": basic_commands.handle_get_scene_snapshot,
+            "get_scene_changes": basic_commands.handle_get_scene_changes,
+            "find_actors_in_radius": actor_commands.handle_find_actors_in_radius,
+            "find_actors_in_box": actor_commands.handle_find_actors_in_box,
+            "find_actors_along_ray": actor_commands.handle_find_actors_along_ray,
+            "find_nearest_actors": actor_commands.handle_find_nearest_actors,
             "create_project_folder": basic_commands.handle_create_project_folder,
             "get_files_in_folder": basic_commands.handle_get_files_in_folder,
             
@@ -262,7 +270,7 @@ def initialize_server():
     log.log_info("Unreal Engine AI command server initialized successfully")
     log.log_info("Available commands:")
     log.log_info("  - Basic: handshake, spawn, create_material, modify_object")
-    log.log_info("  - Blueprint: create_blueprint, add_component, add_variable, add_function, add_node, connect_nodes, compile_blueprint, spawn_blueprint, add_nodes_bulk, connect_nodes_bulk")
+    log.log_info("  - Blueprint: create_blueprint, add_component, add_variable, add_function, add_node, connect_nodes, compile_blueprint, flush_compiles, spawn_blueprint, add_nodes_bulk, connect_nodes_bulk, apply_graph")
 
 # Auto-start the server when this module is imported
 initialize_server()
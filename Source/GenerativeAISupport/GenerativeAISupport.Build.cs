@@ -29,7 +29,13 @@ public class GenerativeAISupport : ModuleRules
 			new string[]
 			{
 				"Slate",
-				"SlateCore"
+				"SlateCore",
+				"Projects",
+				"JsonUtilities",
+				"ImageWrapper",
+				"ImageCore",
+				"RenderCore",
+				"RHI"
 			}
 		);
 	}
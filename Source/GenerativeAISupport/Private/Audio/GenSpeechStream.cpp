@@ -0,0 +1,162 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Audio/GenSpeechStream.h"
+
+#include "Network/GenRequestSubsystem.h"
+
+namespace GenSpeechStream
+{
+	static bool IsTerminator(TCHAR Char)
+	{
+		return Char == TEXT('.') || Char == TEXT('!') || Char == TEXT('?') || Char == TEXT(';');
+	}
+}
+
+void FGenSentenceChunker::Append(const FString& Text, const TFunctionRef<void(const FString&)>& OnSentence)
+{
+	Pending += Text;
+
+	int32 Start = 0;
+	for (int32 Index = ScanFrom; Index < Pending.Len(); ++Index)
+	{
+		const TCHAR Char = Pending[Index];
+		// A terminator only ends the sentence once the whitespace after it arrived
+		const bool bBoundary = Char == TEXT('\n')
+			|| (GenSpeechStream::IsTerminator(Char) && Index + 1 < Pending.Len() && FChar::IsWhitespace(Pending[Index + 1]));
+		if (bBoundary && Index + 1 - Start >= MinChars)
+		{
+			const FString Sentence = Pending.Mid(Start, Index + 1 - Start).TrimStartAndEnd();
+			if (!Sentence.IsEmpty())
+			{
+				OnSentence(Sentence);
+			}
+			Start = Index + 1;
+		}
+	}
+
+	Pending.RightChopInline(Start, EAllowShrinking::No);
+	ScanFrom = FMath::Max(0, Pending.Len() - 1);
+}
+
+void FGenSentenceChunker::Flush(const TFunctionRef<void(const FString&)>& OnSentence)
+{
+	const FString Sentence = Pending.TrimStartAndEnd();
+	if (!Sentence.IsEmpty())
+	{
+		OnSentence(Sentence);
+	}
+	Pending.Reset();
+	ScanFrom = 0;
+}
+
+FGenSpeechStream::FGenSpeechStream(const FGenOAISpeechSettings& InSpeechSettings, const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& InBuffer)
+	: SpeechSettings(InSpeechSettings)
+	, Buffer(InBuffer)
+	, CancellationToken(FGenCancellationToken::Create())
+{
+}
+
+TSharedRef<FGenSpeechStream> FGenSpeechStream::Create(const FGenOAISpeechSettings& SpeechSettings, const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& Buffer,
+                                                      TFunction<void(const FString& Error, bool bSuccess)>&& OnComplete)
+{
+	const TSharedRef<FGenSpeechStream> Stream = MakeShareable(new FGenSpeechStream(SpeechSettings, Buffer));
+	Stream->OnComplete = MoveTemp(OnComplete);
+	return Stream;
+}
+
+void FGenSpeechStream::AppendText(const FString& Text)
+{
+	if (bFinished || CancellationToken->IsCancelled())
+	{
+		return;
+	}
+	Chunker.Append(Text, [this](const FString& Sentence) { Sentences.Add(Sentence); });
+	SendNext();
+}
+
+void FGenSpeechStream::Finish()
+{
+	if (bFinished || CancellationToken->IsCancelled())
+	{
+		return;
+	}
+	Chunker.Flush([this](const FString& Sentence) { Sentences.Add(Sentence); });
+	bFinished = true;
+	SendNext();
+}
+
+void FGenSpeechStream::Cancel()
+{
+	CancellationToken->Cancel();
+	Sentences.Reset();
+	OnComplete = nullptr;
+	Buffer->Reset();
+	Buffer->Finish();
+}
+
+void FGenSpeechStream::SendNext()
+{
+	if (bInFlight || CancellationToken->IsCancelled())
+	{
+		return;
+	}
+	if (Sentences.Num() == 0)
+	{
+		if (bFinished)
+		{
+			Complete(TEXT(""), true);
+		}
+		return;
+	}
+
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem)
+	{
+		Complete(TEXT("Request subsystem not available"), false);
+		return;
+	}
+
+	FGenOAISpeechSettings SentenceSettings = SpeechSettings;
+	SentenceSettings.Input = Sentences[0];
+	Sentences.RemoveAt(0);
+
+	// Spoken lines are player facing, they should not wait behind background chatter
+	FGenRequestOptions Options;
+	Options.Priority = EGenRequestPriority::Interactive;
+	Options.CancellationToken = CancellationToken->CreateChild();
+
+	bInFlight = true;
+	TWeakPtr<FGenSpeechStream> WeakThis = AsShared();
+	Subsystem->SubmitOpenAISpeech(MoveTemp(SentenceSettings), Buffer, [WeakThis](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		const TSharedPtr<FGenSpeechStream> StrongThis = WeakThis.Pin();
+		if (!StrongThis.IsValid() || StrongThis->CancellationToken->IsCancelled())
+		{
+			return;
+		}
+		StrongThis->bInFlight = false;
+		if (!bSuccess)
+		{
+			StrongThis->Complete(Error, false);
+			return;
+		}
+		StrongThis->SendNext();
+	}, Options);
+}
+
+void FGenSpeechStream::Complete(const FString& Error, bool bSuccess)
+{
+	// Nothing else is spoken after an error, what was received still plays
+	CancellationToken->Cancel();
+	Sentences.Reset();
+	Buffer->Finish();
+
+	const TFunction<void(const FString&, bool)> Callback = MoveTemp(OnComplete);
+	if (Callback)
+	{
+		Callback(Error, bSuccess);
+	}
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Audio/GenStreamingSoundWave.h"
+
+void FGenPcmBuffer::Write(const uint8* Data, int32 NumBytes)
+{
+	if (NumBytes <= 0)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	// A cancelled speaker finishes the buffer, chunks of its request still arriving on the HTTP thread are dropped
+	if (bFinished)
+	{
+		return;
+	}
+
+	// Played bytes are only dropped once they are most of the array, so reads stay cheap
+	if (ReadOffset > 0 && ReadOffset >= Bytes.Num() / 2)
+	{
+		Bytes.RemoveAt(0, ReadOffset, EAllowShrinking::No);
+		ReadOffset = 0;
+	}
+	Bytes.Append(Data, NumBytes);
+}
+
+int32 FGenPcmBuffer::Read(uint8* Out, int32 MaxBytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	const int32 NumBytes = FMath::Min(MaxBytes, Bytes.Num() - ReadOffset) & ~1;
+	if (NumBytes > 0)
+	{
+		FMemory::Memcpy(Out, Bytes.GetData() + ReadOffset, NumBytes);
+		ReadOffset += NumBytes;
+	}
+	return NumBytes;
+}
+
+void FGenPcmBuffer::Finish()
+{
+	FScopeLock ScopeLock(&Lock);
+	bFinished = true;
+}
+
+void FGenPcmBuffer::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Bytes.Reset();
+	ReadOffset = 0;
+	bFinished = false;
+}
+
+bool FGenPcmBuffer::IsFinished() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return bFinished;
+}
+
+bool FGenPcmBuffer::IsDrained() const
+{
+	FScopeLock ScopeLock(&Lock);
+	// A dangling odd byte is never played
+	return bFinished && Bytes.Num() - ReadOffset < 2;
+}
+
+int32 FGenPcmBuffer::GetNumQueuedBytes() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Bytes.Num() - ReadOffset;
+}
+
+UGenStreamingSoundWave::UGenStreamingSoundWave(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, Buffer(MakeShared<FGenPcmBuffer, ESPMode::ThreadSafe>())
+{
+	NumChannels = 1;
+	Duration = INDEFINITELY_LOOPING_DURATION;
+	bLooping = false;
+	SoundGroup = SOUNDGROUP_Voice;
+	SetSampleRate(24000);
+}
+
+UGenStreamingSoundWave* UGenStreamingSoundWave::Create(int32 InSampleRate)
+{
+	UGenStreamingSoundWave* SoundWave = NewObject<UGenStreamingSoundWave>();
+	SoundWave->SetSampleRate(InSampleRate);
+	return SoundWave;
+}
+
+int32 UGenStreamingSoundWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples)
+{
+	// Audio render thread
+	const int32 NumBytes = NumSamples * sizeof(int16);
+	OutAudio.SetNumUninitialized(NumBytes, EAllowShrinking::No);
+	const int32 BytesRead = Buffer->Read(OutAudio.GetData(), NumBytes);
+
+	// Underruns play silence, the source would stop if fewer samples were returned
+	if (BytesRead < NumBytes)
+	{
+		FMemory::Memzero(OutAudio.GetData() + BytesRead, NumBytes - BytesRead);
+	}
+	return NumSamples;
+}
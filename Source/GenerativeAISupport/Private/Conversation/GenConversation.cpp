@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Conversation/GenConversation.h"
+
+#include "Network/GenRequestSubsystem.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace GenConversation
+{
+	static const TCHAR* SummaryPrefix = TEXT("Summary of the earlier conversation:\n");
+
+	static const TCHAR* SummaryInstructions = TEXT(
+		"Summarize the conversation below for the assistant that continues it. Keep names, facts, decisions, "
+		"promises and open questions, drop small talk. Write in the third person, no more than a few short paragraphs.");
+
+	// A failed summary is retried after this, doubled with every further failure up to the maximum
+	constexpr double RetryDelaySeconds = 5.0;
+	constexpr double MaxRetryDelaySeconds = 300.0;
+}
+
+UGenConversation* UGenConversation::CreateConversation(const FGenCompactionSettings& Settings)
+{
+	UGenConversation* Conversation = NewObject<UGenConversation>();
+	Conversation->Settings = Settings;
+	return Conversation;
+}
+
+void UGenConversation::AddMessage(const FGenChatMessage& Message)
+{
+	Messages.Add(Message);
+	CompactIfNeeded();
+}
+
+void UGenConversation::SetMessages(const TArray<FGenChatMessage>& InMessages)
+{
+	CancelCompaction();
+	++Generation;
+	Messages = InMessages;
+	SummaryIndex = INDEX_NONE;
+	CompactionFailures = 0;
+	RetryCompactionAt = 0.0;
+	CompactIfNeeded();
+}
+
+int32 UGenConversation::GetPromptTokens() const
+{
+	return FGenBPETokenizer::Get(Settings.Encoding)->CountChatTokens(Messages);
+}
+
+void UGenConversation::BeginDestroy()
+{
+	CancelCompaction();
+	Super::BeginDestroy();
+}
+
+void UGenConversation::CompactIfNeeded()
+{
+	if (IsCompacting() || Settings.CompactAboveTokens <= 0 || FPlatformTime::Seconds() < RetryCompactionAt
+		|| GetPromptTokens() <= Settings.CompactAboveTokens)
+	{
+		return;
+	}
+
+	// Everything older than the recent window except the system prompts, the previous summary included
+	TArray<int32> Fold;
+	int32 NumTurns = 0;
+	const int32 End = Messages.Num() - FMath::Max(Settings.KeepRecentMessages, 1);
+	for (int32 Index = 0; Index < End; ++Index)
+	{
+		if (Index == SummaryIndex || Messages[Index].Role != TEXT("system"))
+		{
+			Fold.Add(Index);
+			NumTurns += Index != SummaryIndex ? 1 : 0;
+		}
+	}
+	if (NumTurns < 2)
+	{
+		return;
+	}
+
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	FString Transcript;
+	for (const int32 Index : Fold)
+	{
+		const FGenChatMessage& Message = Messages[Index];
+		Transcript += Index == SummaryIndex ? Message.Content : FString::Printf(TEXT("%s: %s"), *Message.Role, *Message.Content);
+		Transcript += TEXT("\n\n");
+	}
+
+	FGenChatSettings ChatSettings;
+	ChatSettings.ModelEnum = EGenOAIChatModel::Custom;
+	ChatSettings.CustomModel = Settings.SummaryModel;
+	ChatSettings.MaxTokens = Settings.MaxSummaryTokens;
+	ChatSettings.Temperature = 0.2f;
+	FGenChatMessage& Instructions = ChatSettings.Messages.AddDefaulted_GetRef();
+	Instructions.Role = TEXT("system");
+	Instructions.Content = GenConversation::SummaryInstructions;
+	FGenChatMessage& Conversation = ChatSettings.Messages.AddDefaulted_GetRef();
+	Conversation.Role = TEXT("user");
+	Conversation.Content = MoveTemp(Transcript);
+
+	// The player's turns must never wait for this
+	FGenRequestOptions Options;
+	Options.Priority = EGenRequestPriority::Background;
+
+	PendingFold = MoveTemp(Fold);
+	TWeakObjectPtr<UGenConversation> WeakThis(this);
+	const uint32 ForGeneration = Generation;
+	PendingRequest = Subsystem->SubmitOpenAIChat(MoveTemp(ChatSettings), [WeakThis, ForGeneration](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		UGenConversation* StrongThis = WeakThis.Get();
+		if (!StrongThis)
+		{
+			return;
+		}
+		if (ForGeneration != StrongThis->Generation)
+		{
+			// Dropped by SetMessages, which already started over and may have a request of its own
+			return;
+		}
+		StrongThis->PendingRequest.Reset();
+		if (!bSuccess || Response.TrimStartAndEnd().IsEmpty())
+		{
+			// Background requests may be preempted, a message added after the backoff tries again
+			const double RetryDelay = FMath::Min(GenConversation::RetryDelaySeconds * FMath::Pow(2.0, FMath::Min(StrongThis->CompactionFailures, 16)),
+			                                     GenConversation::MaxRetryDelaySeconds);
+			++StrongThis->CompactionFailures;
+			StrongThis->RetryCompactionAt = FPlatformTime::Seconds() + RetryDelay;
+			UE_LOG(LogGenAI, Warning, TEXT("Conversation compaction failed, retrying in %.0f seconds: %s"), RetryDelay, *Error);
+			StrongThis->PendingFold.Reset();
+			return;
+		}
+		StrongThis->ApplySummary(ForGeneration, Response.TrimStartAndEnd());
+	}, Options);
+}
+
+void UGenConversation::ApplySummary(uint32 ForGeneration, const FString& Summary)
+{
+	const TArray<int32> Fold = MoveTemp(PendingFold);
+	PendingFold.Reset();
+	if (ForGeneration != Generation || Fold.Num() == 0)
+	{
+		return;
+	}
+	CompactionFailures = 0;
+	RetryCompactionAt = 0.0;
+
+	const int32 MessagesFolded = Fold.Num() - (Fold.Contains(SummaryIndex) ? 1 : 0);
+
+	// Only appends happen meanwhile, so the folded indices are still valid
+	for (int32 Index = Fold.Num() - 1; Index >= 0; --Index)
+	{
+		Messages.RemoveAt(Fold[Index], 1, EAllowShrinking::No);
+	}
+	FGenChatMessage SummaryMessage;
+	SummaryMessage.Role = TEXT("system");
+	SummaryMessage.Content = GenConversation::SummaryPrefix + Summary;
+	Messages.Insert(MoveTemp(SummaryMessage), Fold[0]);
+	SummaryIndex = Fold[0];
+	OnCompacted.Broadcast(MessagesFolded);
+
+	// Turns added while the summary was written may already need another pass
+	CompactIfNeeded();
+}
+
+void UGenConversation::CancelCompaction()
+{
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		Subsystem->Cancel(PendingRequest);
+	}
+	PendingRequest.Reset();
+	PendingFold.Reset();
+}
@@ -0,0 +1,19 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Data/Local/GenLocalChatStructs.h"
+
+#include "GenAISupportRuntimeSettings.h"
+
+FString FGenLocalChatSettings::GetModelName() const
+{
+	if (!Model.IsEmpty())
+	{
+		return Model;
+	}
+
+	const TArray<FString>& LocalModels = GetDefault<UGenAISupportRuntimeSettings>()->LocalModels;
+	return LocalModels.Num() > 0 ? LocalModels[0] : FString();
+}
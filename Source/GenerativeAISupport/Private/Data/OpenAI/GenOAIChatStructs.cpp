@@ -3,4 +3,11 @@
 #include "Data/OpenAI/GenOAIChatStructs.h"
 #include "Data/OpenAI/GenOAIModels.h"
 
-// Implementation of any struct methods if needed
+FGenChatImage FGenChatImage::FromPixels(TArray<FColor>&& InPixels, FIntPoint InSize)
+{
+	check(InPixels.Num() == InSize.X * InSize.Y);
+	FGenChatImage Image;
+	Image.Pixels = MakeShared<const TArray<FColor>, ESPMode::ThreadSafe>(MoveTemp(InPixels));
+	Image.PixelSize = InSize;
+	return Image;
+}
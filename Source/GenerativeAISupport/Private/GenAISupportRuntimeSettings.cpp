@@ -0,0 +1,49 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "GenAISupportRuntimeSettings.h"
+
+UGenAISupportRuntimeSettings::UGenAISupportRuntimeSettings()
+{
+	auto AddEndpoint = [this](EGenAIOrgs Org, const TCHAR* WarmUrl)
+	{
+		FGenConnectionEndpoint& Endpoint = WarmEndpoints.AddDefaulted_GetRef();
+		Endpoint.Org = Org;
+		Endpoint.WarmUrl = WarmUrl;
+	};
+
+	AddEndpoint(EGenAIOrgs::OpenAI, TEXT("https://api.openai.com/v1/models"));
+	AddEndpoint(EGenAIOrgs::Anthropic, TEXT("https://api.anthropic.com/v1/models"));
+	AddEndpoint(EGenAIOrgs::DeepSeek, TEXT("https://api.deepseek.com/models"));
+	AddEndpoint(EGenAIOrgs::XAI, TEXT("https://api.x.ai/v1/models"));
+}
+
+FString UGenAISupportRuntimeSettings::GetBaseUrl(EGenAIOrgs Org) const
+{
+	FString BaseUrl;
+	switch (Org)
+	{
+	case EGenAIOrgs::OpenAI:
+		BaseUrl = OpenAIBaseUrl;
+		break;
+	case EGenAIOrgs::Anthropic:
+		BaseUrl = AnthropicBaseUrl;
+		break;
+	case EGenAIOrgs::DeepSeek:
+		BaseUrl = DeepSeekBaseUrl;
+		break;
+	case EGenAIOrgs::XAI:
+		BaseUrl = XAIBaseUrl;
+		break;
+	case EGenAIOrgs::Local:
+		BaseUrl = LocalBaseUrl;
+		break;
+	default:
+		break;
+	}
+
+	BaseUrl.RemoveFromEnd(TEXT("/"));
+	return BaseUrl;
+}
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GenerativeAISupport.h"
+#include "Network/GenConnectionManager.h"
 
 #define LOCTEXT_NAMESPACE "FGenerativeAISupportModule"
 
@@ -13,11 +14,14 @@ void FGenerativeAISupportModule::StartupModule()
 {
 	// Log to debug module loading
 	UE_LOG(LogTemp, Log, TEXT("FGenerativeAISupportModule::StartupModule called"));
+
+	// Pre-warm provider connections and keep them alive between sporadic requests
+	FGenConnectionManager::Get().Initialize();
 }
 
 void FGenerativeAISupportModule::ShutdownModule()
 {
-	// Runtime module cleanup if needed
+	FGenConnectionManager::Get().Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -3,52 +3,100 @@
 
 #include "Models/Anthropic/GenClaudeChat.h"
 
+#include "GenAISupportRuntimeSettings.h"
 #include "HttpModule.h"
 #include "Data/GenAIOrgs.h"
 #include "Data/OpenAI/GenOAIChatStructs.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
+#include "Network/GenConnectionManager.h"
+#include "Network/GenRequestSubsystem.h"
 #include "Secure/GenSecureKey.h"
+#include "Tokenizer/GenTokenizer.h"
+#include "Utilities/GenImageEncoder.h"
 #include "Utilities/GenUtils.h"
 
 
-void UGenClaudeChat::SendChatRequest(const FGenClaudeChatSettings& ChatSettings, const FOnClaudeChatCompletionResponse& OnComplete)
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenClaudeChat::SendChatRequest(const FGenClaudeChatSettings& ChatSettings, const FOnClaudeChatCompletionResponse& OnComplete,
+                                                                               const FGenCancellationTokenPtr& CancellationToken)
 {
-    MakeRequest(ChatSettings, [OnComplete](const FString& Response, const FString& Error, bool Success)
+    return MakeRequest(ChatSettings, [OnComplete](const FString& Response, const FString& Error, bool Success)
     {
         if (OnComplete.IsBound())
         {
             OnComplete.Execute(Response, Error, Success);
         }
-    });
+    }, CancellationToken);
 }
 
 UGenClaudeChat* UGenClaudeChat::RequestClaudeChat(UObject* WorldContextObject, const FGenClaudeChatSettings& ChatSettings)
 {
     UGenClaudeChat* AsyncAction = NewObject<UGenClaudeChat>();
-    AsyncAction->ChatSettings = ChatSettings;
+    if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+    {
+        // The settings are copied once into the pooled slot, the request is queued on Activate
+        TWeakObjectPtr<UGenClaudeChat> WeakThis(AsyncAction);
+        FGenRequestOptions Options;
+        Options.bStartImmediately = false;
+        AsyncAction->RequestHandle = Subsystem->SubmitClaudeChat(ChatSettings, [WeakThis](const FString& Response, const FString& Error, bool Success)
+        {
+            if (UGenClaudeChat* StrongThis = WeakThis.Get())
+            {
+                StrongThis->RequestHandle.Reset();
+                StrongThis->OnComplete.Broadcast(Response, Error, Success);
+                StrongThis->Cancel();
+            }
+        }, Options);
+    }
+    AsyncAction->RegisterWithGameInstance(WorldContextObject);
     return AsyncAction;
 }
 
 void UGenClaudeChat::Activate()
 {
-    MakeRequest(ChatSettings, [this](const FString& Response, const FString& Error, bool Success)
+    UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+    if (!Subsystem || !RequestHandle.IsValid())
     {
-        if (OnComplete.IsBound())
+        OnComplete.Broadcast(TEXT(""), TEXT("Request subsystem not available"), false);
+        Cancel();
+        return;
+    }
+    Subsystem->Start(RequestHandle);
+}
+
+void UGenClaudeChat::Cancel()
+{
+    // Aborts the in-flight transfer and frees the request slot, no-op once the request completed
+    if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+    {
+        Subsystem->Cancel(RequestHandle);
+    }
+    RequestHandle.Reset();
+    Super::Cancel();
+}
+
+void UGenClaudeChat::BeginDestroy()
+{
+    // An action that was never activated still holds its pending request slot
+    if (RequestHandle.IsValid())
+    {
+        if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
         {
-            OnComplete.Broadcast(Response, Error, Success);
+            Subsystem->Cancel(RequestHandle);
         }
-        Cancel();
-    });
+        RequestHandle.Reset();
+    }
+    Super::BeginDestroy();
 }
 
-void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                                                           const FGenCancellationTokenPtr& CancellationToken)
 {
     FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::Anthropic);
     if (ApiKey.IsEmpty())
     {
         ResponseCallback(TEXT(""), TEXT("Anthropic API key not set"), false);
-        return;
+        return nullptr;
     }
 
     // Construct JSON payload
@@ -60,12 +108,49 @@ void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, con
     JsonPayload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
     JsonPayload->SetBoolField(TEXT("stream"), ChatSettings.bStreamResponse);
 
+    // Only copy the history when it has to be trimmed
+    TArray<FGenChatMessage> TrimmedMessages;
+    const TArray<FGenChatMessage>* Messages = &ChatSettings.Messages;
+    if (ChatSettings.MaxPromptTokens > 0)
+    {
+        TrimmedMessages = ChatSettings.Messages;
+        FGenContextTrimmer::TrimToBudget(TrimmedMessages, ChatSettings.MaxPromptTokens, EGenTokenizerEncoding::Claude);
+        Messages = &TrimmedMessages;
+    }
+
     TArray<TSharedPtr<FJsonValue>> MessagesArray;
-    for (const FGenChatMessage& Message : ChatSettings.Messages)
+    TArray<FGenChatImage> Images;
+    for (const FGenChatMessage& Message : *Messages)
     {
         TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
         JsonMessage->SetStringField(TEXT("role"), Message.Role);
-        JsonMessage->SetStringField(TEXT("content"), Message.Content);
+        if (Message.Images.Num() == 0)
+        {
+            JsonMessage->SetStringField(TEXT("content"), Message.Content);
+            MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
+            continue;
+        }
+
+        // Images go before the text, their data is filled in by the encoder
+        TArray<TSharedPtr<FJsonValue>> ContentBlocks;
+        for (const FGenChatImage& Image : Message.Images)
+        {
+            TSharedPtr<FJsonObject> Source = MakeShareable(new FJsonObject());
+            Source->SetStringField(TEXT("type"), TEXT("base64"));
+            Source->SetStringField(TEXT("media_type"), FGenImageEncoder::GetMimeType(Image.Encoding));
+            Source->SetStringField(TEXT("data"), FGenImageEncoder::GetPlaceholder(Images.Num()));
+
+            TSharedPtr<FJsonObject> ImageBlock = MakeShareable(new FJsonObject());
+            ImageBlock->SetStringField(TEXT("type"), TEXT("image"));
+            ImageBlock->SetObjectField(TEXT("source"), Source);
+            ContentBlocks.Add(MakeShareable(new FJsonValueObject(ImageBlock)));
+            Images.Add(Image);
+        }
+        TSharedPtr<FJsonObject> TextBlock = MakeShareable(new FJsonObject());
+        TextBlock->SetStringField(TEXT("type"), TEXT("text"));
+        TextBlock->SetStringField(TEXT("text"), Message.Content);
+        ContentBlocks.Add(MakeShareable(new FJsonValueObject(TextBlock)));
+        JsonMessage->SetArrayField(TEXT("content"), ContentBlocks);
         MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
     }
     JsonPayload->SetArrayField(TEXT("messages"), MessagesArray);
@@ -78,7 +163,7 @@ void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, con
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
     HttpRequest->SetTimeout(180.0f);
     HttpRequest->SetVerb(TEXT("POST"));
-    HttpRequest->SetURL(TEXT("https://api.anthropic.com/v1/messages"));
+    HttpRequest->SetURL(GetDefault<UGenAISupportRuntimeSettings>()->GetBaseUrl(EGenAIOrgs::Anthropic) + TEXT("/messages"));
     HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
     HttpRequest->SetHeader(TEXT("x-api-key"), ApiKey);
     HttpRequest->SetHeader(TEXT("anthropic-version"), TEXT("2023-06-01"));
@@ -106,7 +191,25 @@ void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, con
             ProcessResponse(Response->GetContentAsString(), ResponseCallback);
         });
     
+    if (Images.Num() > 0)
+    {
+        // The request starts once the images are encoded into its body
+        FGenImageEncoder::ProcessRequest(HttpRequest, MoveTemp(Images), EGenAIOrgs::Anthropic, CancellationToken, [ResponseCallback](const FString& Error)
+        {
+            ResponseCallback(TEXT(""), Error, false);
+        });
+        return HttpRequest;
+    }
+
+    if (CancellationToken.IsValid() && !CancellationToken->BindRequest(HttpRequest))
+    {
+        ResponseCallback(TEXT(""), CancellationToken->GetStopReason(), false);
+        return nullptr;
+    }
+
+    FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
     HttpRequest->ProcessRequest();
+    return HttpRequest;
 }
 
 void UGenClaudeChat::ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
@@ -3,51 +3,100 @@
 
 #include "Models/DeepSeek/GenDSeekChat.h"
 
+#include "GenAISupportRuntimeSettings.h"
 #include "HttpModule.h"
 #include "Data/GenAIOrgs.h"
 #include "Data/OpenAI/GenOAIChatStructs.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
+#include "Network/GenConnectionManager.h"
+#include "Network/GenRequestSubsystem.h"
 #include "Secure/GenSecureKey.h"
 #include "Utilities/GenUtils.h"
 
 
-void UGenDSeekChat::SendChatRequest(const FGenDSeekChatSettings& ChatSettings,
-                                    const FOnDSeekChatCompletionResponse& OnComplete)
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenDSeekChat::SendChatRequest(const FGenDSeekChatSettings& ChatSettings,
+                                                                              const FOnDSeekChatCompletionResponse& OnComplete,
+                                                                              const FGenCancellationTokenPtr& CancellationToken)
 {
-	MakeRequest(ChatSettings, [OnComplete](const FString& Response, const FString& Error, bool Success)
+	return MakeRequest(ChatSettings, [OnComplete](const FString& Response, const FString& Error, bool Success)
 	{
 		if (OnComplete.IsBound())
 		{
 			OnComplete.Execute(Response, Error, Success);
 		}
-	});
+	}, CancellationToken);
 }
 
 UGenDSeekChat* UGenDSeekChat::RequestDeepseekChat(UObject* WorldContextObject, const FGenDSeekChatSettings& ChatSettings)
 {
 	UGenDSeekChat* AsyncAction = NewObject<UGenDSeekChat>();
-	AsyncAction->ChatSettings = ChatSettings;
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		// The settings are copied once into the pooled slot, the request is queued on Activate
+		TWeakObjectPtr<UGenDSeekChat> WeakThis(AsyncAction);
+		FGenRequestOptions Options;
+		Options.bStartImmediately = false;
+		AsyncAction->RequestHandle = Subsystem->SubmitDeepSeekChat(ChatSettings, [WeakThis](const FString& Response, const FString& Error, bool Success)
+		{
+			if (UGenDSeekChat* StrongThis = WeakThis.Get())
+			{
+				StrongThis->RequestHandle.Reset();
+				StrongThis->OnComplete.Broadcast(Response, Error, Success);
+				StrongThis->Cancel();
+			}
+		}, Options);
+	}
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
 	return AsyncAction;
 }
 
 void UGenDSeekChat::Activate()
 {
-	MakeRequest(ChatSettings, [this](const FString& Response, const FString& Error, bool Success)
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem || !RequestHandle.IsValid())
 	{
-		OnComplete.Broadcast(Response, Error, Success);
+		OnComplete.Broadcast(TEXT(""), TEXT("Request subsystem not available"), false);
 		Cancel();
-	});
+		return;
+	}
+	Subsystem->Start(RequestHandle);
+}
+
+void UGenDSeekChat::Cancel()
+{
+	// Aborts the in-flight transfer and frees the request slot, no-op once the request completed
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		Subsystem->Cancel(RequestHandle);
+	}
+	RequestHandle.Reset();
+	Super::Cancel();
 }
 
-void UGenDSeekChat::MakeRequest(const FGenDSeekChatSettings& ChatSettings,
-                                const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+void UGenDSeekChat::BeginDestroy()
+{
+	// An action that was never activated still holds its pending request slot
+	if (RequestHandle.IsValid())
+	{
+		if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+		{
+			Subsystem->Cancel(RequestHandle);
+		}
+		RequestHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenDSeekChat::MakeRequest(const FGenDSeekChatSettings& ChatSettings,
+                                                                          const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                                                          const FGenCancellationTokenPtr& CancellationToken)
 {
 	FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::DeepSeek);
 	if (ApiKey.IsEmpty())
 	{
 		ResponseCallback(TEXT(""), TEXT("DeepSeek API key not set"), false);
-		return;
+		return nullptr;
 	}
 
 
@@ -57,6 +106,7 @@ void UGenDSeekChat::MakeRequest(const FGenDSeekChatSettings& ChatSettings,
 		TEXT("model"),
 		UGenUtils::GetEnumDisplayName(StaticEnum<EDeepSeekModels>(), static_cast<int32>(ChatSettings.Model)));
 	JsonPayload->SetNumberField(TEXT("max_tokens"), ChatSettings.MaxTokens);
+	JsonPayload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
 	JsonPayload->SetBoolField(TEXT("stream"), ChatSettings.bStreamResponse);
 
 	TArray<TSharedPtr<FJsonValue>> MessagesArray;
@@ -77,7 +127,7 @@ void UGenDSeekChat::MakeRequest(const FGenDSeekChatSettings& ChatSettings,
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->SetTimeout(180.0f); // Set 180 seconds timeout
 	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetURL(TEXT("https://api.deepseek.com/chat/completions"));
+	HttpRequest->SetURL(GetDefault<UGenAISupportRuntimeSettings>()->GetBaseUrl(EGenAIOrgs::DeepSeek) + TEXT("/chat/completions"));
 	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
 	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
 	HttpRequest->SetContentAsString(PayloadString);
@@ -108,7 +158,15 @@ void UGenDSeekChat::MakeRequest(const FGenDSeekChatSettings& ChatSettings,
 
 			ProcessResponse(Response->GetContentAsString(), ResponseCallback);
 		});
+	if (CancellationToken.IsValid() && !CancellationToken->BindRequest(HttpRequest))
+	{
+		ResponseCallback(TEXT(""), CancellationToken->GetStopReason(), false);
+		return nullptr;
+	}
+
+	FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
 	HttpRequest->ProcessRequest();
+	return HttpRequest;
 }
 
 
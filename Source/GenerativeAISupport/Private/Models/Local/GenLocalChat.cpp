@@ -0,0 +1,257 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Models/Local/GenLocalChat.h"
+
+#include "GenAISupportRuntimeSettings.h"
+#include "Async/Async.h"
+#include "Data/GenAIOrgs.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Models/OpenAI/GenOAIWireFormat.h"
+#include "Network/GenConnectionManager.h"
+#include "Network/GenRequestSubsystem.h"
+#include "Secure/GenSecureKey.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include "Utilities/GenImageEncoder.h"
+
+namespace GenLocalChat
+{
+	/** Hands the streamed body from the HTTP thread to the decoder on the game thread */
+	struct FStreamState : TSharedFromThis<FStreamState, ESPMode::ThreadSafe>
+	{
+		FCriticalSection Lock;
+		TArray<uint8> Pending;
+		bool bDrainQueued = false;
+
+		// Game thread only, the decoder keeps its position in Received and only looks at new bytes
+		TArray<uint8> Received;
+		FGenOAIStreamDecoder Decoder;
+
+		/** Called on the HTTP thread with every chunk of the body */
+		void Append(const void* Data, int64 Length, const FOnLocalChatDelta& OnDelta)
+		{
+			FScopeLock ScopeLock(&Lock);
+			Pending.Append(static_cast<const uint8*>(Data), Length);
+			if (bDrainQueued)
+			{
+				return;
+			}
+
+			bDrainQueued = true;
+			AsyncTask(ENamedThreads::GameThread, [WeakThis = AsWeak(), OnDelta]()
+			{
+				if (const TSharedPtr<FStreamState, ESPMode::ThreadSafe> This = WeakThis.Pin())
+				{
+					This->Drain(OnDelta);
+				}
+			});
+		}
+
+		/** Decodes the bytes that arrived since the last call */
+		void Drain(const FOnLocalChatDelta& OnDelta)
+		{
+			{
+				FScopeLock ScopeLock(&Lock);
+				bDrainQueued = false;
+				Received.Append(Pending);
+				Pending.Reset();
+			}
+			Decoder.Update(Received, [&OnDelta](const FString& Delta) { OnDelta.ExecuteIfBound(Delta); });
+		}
+	};
+}
+
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenLocalChat::SendChatRequest(const FGenLocalChatSettings& ChatSettings, const FOnLocalChatCompletionResponse& OnComplete,
+                                                                             const FGenCancellationTokenPtr& CancellationToken, const FOnLocalChatDelta& OnDelta)
+{
+	return MakeRequest(ChatSettings, [OnComplete](const FString& Response, const FString& Error, bool Success)
+	{
+		OnComplete.ExecuteIfBound(Response, Error, Success);
+	}, CancellationToken, OnDelta);
+}
+
+UGenLocalChat* UGenLocalChat::RequestLocalChat(UObject* WorldContextObject, const FGenLocalChatSettings& ChatSettings)
+{
+	UGenLocalChat* AsyncAction = NewObject<UGenLocalChat>();
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		// The settings are copied once into the pooled slot, the request is queued on Activate
+		TWeakObjectPtr<UGenLocalChat> WeakThis(AsyncAction);
+		FGenRequestOptions Options;
+		Options.bStartImmediately = false;
+		AsyncAction->RequestHandle = Subsystem->SubmitLocalChat(ChatSettings, [WeakThis](const FString& Response, const FString& Error, bool Success)
+		{
+			if (UGenLocalChat* StrongThis = WeakThis.Get())
+			{
+				StrongThis->RequestHandle.Reset();
+				StrongThis->OnComplete.Broadcast(Response, Error, Success);
+				StrongThis->Cancel();
+			}
+		}, Options, [WeakThis](const FString& Delta)
+		{
+			if (UGenLocalChat* StrongThis = WeakThis.Get())
+			{
+				StrongThis->OnDelta.Broadcast(Delta);
+			}
+		});
+	}
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
+	return AsyncAction;
+}
+
+TArray<FString> UGenLocalChat::GetLocalModelNames()
+{
+	return GetDefault<UGenAISupportRuntimeSettings>()->LocalModels;
+}
+
+void UGenLocalChat::Activate()
+{
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem || !RequestHandle.IsValid())
+	{
+		OnComplete.Broadcast(TEXT(""), TEXT("Request subsystem not available"), false);
+		Cancel();
+		return;
+	}
+	Subsystem->Start(RequestHandle);
+}
+
+void UGenLocalChat::Cancel()
+{
+	// Aborts the in-flight transfer and frees the request slot, no-op once the request completed
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		Subsystem->Cancel(RequestHandle);
+	}
+	RequestHandle.Reset();
+	Super::Cancel();
+}
+
+void UGenLocalChat::BeginDestroy()
+{
+	// An action that was never activated still holds its pending request slot
+	if (RequestHandle.IsValid())
+	{
+		if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+		{
+			Subsystem->Cancel(RequestHandle);
+		}
+		RequestHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenLocalChat::MakeRequest(const FGenLocalChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                                                         const FGenCancellationTokenPtr& CancellationToken, const FOnLocalChatDelta& OnDelta)
+{
+	const UGenAISupportRuntimeSettings* Settings = GetDefault<UGenAISupportRuntimeSettings>();
+	const FString BaseUrl = Settings->GetBaseUrl(EGenAIOrgs::Local);
+	if (BaseUrl.IsEmpty())
+	{
+		ResponseCallback(TEXT(""), TEXT("Local provider base URL not set"), false);
+		return nullptr;
+	}
+
+	// Most local servers run without authentication, the key is only sent when one is set
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::Local);
+	const FString AuthValue = ApiKey.IsEmpty() ? FString() : Settings->LocalAuthPrefix + ApiKey;
+
+	TArray<FGenChatImage> Images;
+	const TSharedRef<FJsonObject> JsonPayload = FGenOAIWireFormat::MakeChatPayload(ChatSettings.GetModelName(), ChatSettings.Messages, &Images);
+	JsonPayload->SetNumberField(TEXT("max_tokens"), ChatSettings.MaxTokens);
+	JsonPayload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
+	JsonPayload->SetBoolField(TEXT("stream"), ChatSettings.bStreamResponse);
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FGenOAIWireFormat::MakeChatRequest(
+		BaseUrl + TEXT("/chat/completions"), JsonPayload, Settings->LocalAuthHeader, AuthValue);
+	HttpRequest->SetTimeout(Settings->LocalRequestTimeoutSeconds);
+	HttpRequest->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+
+	// The body is handed over chunk by chunk as it arrives, fragments are decoded on the game thread
+	TSharedPtr<GenLocalChat::FStreamState, ESPMode::ThreadSafe> Stream;
+	if (ChatSettings.bStreamResponse)
+	{
+		Stream = MakeShared<GenLocalChat::FStreamState, ESPMode::ThreadSafe>();
+		HttpRequest->SetHeader(TEXT("Accept"), TEXT("text/event-stream"));
+#if UE_VERSION_NEWER_THAN(5, 3, 0)
+		HttpRequest->SetResponseBodyReceiveStreamDelegateV2(FHttpRequestStreamDelegateV2::CreateLambda([Stream, OnDelta](void* Data, int64& Length)
+		{
+			Stream->Append(Data, Length, OnDelta);
+		}));
+#else
+		HttpRequest->SetResponseBodyReceiveStreamDelegate(FHttpRequestStreamDelegate::CreateLambda([Stream, OnDelta](void* Data, int64 Length)
+		{
+			Stream->Append(Data, Length, OnDelta);
+			return true;
+		}));
+#endif
+	}
+
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[ResponseCallback, Stream, OnDelta](FHttpRequestPtr Request, const FHttpResponsePtr& Response, const bool bSuccess)
+		{
+			if (!bSuccess || !Response.IsValid())
+			{
+				const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : -1;
+				const FString ErrorMessage = ResponseCode == 0
+					                             ? TEXT("Request most likely timed out. No response received.")
+					                             : TEXT("Request failed, is the local server running?");
+				UE_LOG(LogGenAI, Error, TEXT("Local chat request failed, Response code: %d"), ResponseCode);
+				ResponseCallback(TEXT(""), ErrorMessage, false);
+				return;
+			}
+
+			// A streamed body only reaches the stream delegate, the response itself stays empty
+			FString Body;
+			if (Stream.IsValid())
+			{
+				Stream->Drain(OnDelta);
+				const FGenOAIStreamDecoder& Decoder = Stream->Decoder;
+				if (Decoder.HasEvents())
+				{
+					const bool bStreamSucceeded = Decoder.GetError().IsEmpty();
+					ResponseCallback(bStreamSucceeded ? Decoder.GetContent() : FString(), Decoder.GetError(), bStreamSucceeded);
+					return;
+				}
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Stream->Received.GetData()), Stream->Received.Num());
+				Body = FString(Converted.Length(), Converted.Get());
+			}
+			else
+			{
+				Body = Response->GetContentAsString();
+			}
+
+			// Not streamed, either because it was not asked for, the server ignored the flag or it returned an error body
+			FString Content;
+			FString ErrorMessage;
+			if (FGenOAIWireFormat::ParseChatResponse(Body, Content, ErrorMessage))
+			{
+				ResponseCallback(Content, TEXT(""), true);
+				return;
+			}
+			ResponseCallback(TEXT(""), ErrorMessage, false);
+		});
+
+	if (Images.Num() > 0)
+	{
+		// The request starts once the images are encoded into its body
+		FGenImageEncoder::ProcessRequest(HttpRequest, MoveTemp(Images), EGenAIOrgs::Local, CancellationToken, [ResponseCallback](const FString& Error)
+		{
+			ResponseCallback(TEXT(""), Error, false);
+		});
+		return HttpRequest;
+	}
+
+	if (CancellationToken.IsValid() && !CancellationToken->BindRequest(HttpRequest))
+	{
+		ResponseCallback(TEXT(""), CancellationToken->GetStopReason(), false);
+		return nullptr;
+	}
+
+	FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
+	HttpRequest->ProcessRequest();
+	return HttpRequest;
+}
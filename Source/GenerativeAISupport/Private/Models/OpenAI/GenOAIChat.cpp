@@ -2,7 +2,13 @@
 
 
 #include "Models/OpenAI/GenOAIChat.h"
+#include "GenAISupportRuntimeSettings.h"
+#include "Models/OpenAI/GenOAIWireFormat.h"
+#include "Network/GenConnectionManager.h"
+#include "Network/GenRequestSubsystem.h"
 #include "Secure/GenSecureKey.h"
+#include "Tokenizer/GenTokenizer.h"
+#include "Utilities/GenImageEncoder.h"
 #include "Http.h"
 #include "LatentActions.h"
 #include "Data/GenAIOrgs.h"
@@ -14,48 +20,79 @@
 #include "Utilities/GenGlobalDefinitions.h"
 
 
-TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIChat::SendChatRequest(const FGenChatSettings& ChatSettings, const FOnChatCompletionResponse& OnComplete)
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIChat::SendChatRequest(const FGenChatSettings& ChatSettings, const FOnChatCompletionResponse& OnComplete,
+                                                                           const FGenCancellationTokenPtr& CancellationToken)
 {
 	check(OnComplete.IsBound());
 	return MakeRequest(ChatSettings, [OnComplete](const FString& Response, const FString& Error, bool Success)
 	{
 		OnComplete.Execute(Response, Error, Success);
-	});
+	}, CancellationToken);
 }
 
 UGenOAIChat* UGenOAIChat::RequestOpenAIChat(UObject* WorldContextObject, const FGenChatSettings& ChatSettings)
 {
 	UGenOAIChat* AsyncAction = NewObject<UGenOAIChat>();
-	AsyncAction->ChatSettings = ChatSettings;
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		// The settings are copied once into the pooled slot, the request is queued on Activate
+		TWeakObjectPtr<UGenOAIChat> WeakThis(AsyncAction);
+		FGenRequestOptions Options;
+		Options.bStartImmediately = false;
+		AsyncAction->RequestHandle = Subsystem->SubmitOpenAIChat(ChatSettings, [WeakThis](const FString& Response, const FString& Error, bool Success)
+		{
+			if (UGenOAIChat* StrongThis = WeakThis.Get())
+			{
+				StrongThis->RequestHandle.Reset();
+				StrongThis->OnComplete.Broadcast(Response, Error, Success);
+				StrongThis->Cancel();
+			}
+		}, Options);
+	}
 	AsyncAction->RegisterWithGameInstance(WorldContextObject);
 	return AsyncAction;
 }
 
 void UGenOAIChat::Activate()
 {
-	TWeakObjectPtr<UGenOAIChat> WeakThis(this);
-	HttpRequest = MakeRequest(ChatSettings, [WeakThis](const FString& Response, const FString& Error, bool Success)
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem || !RequestHandle.IsValid())
 	{
-		if (WeakThis.IsValid())
-		{
-			UGenOAIChat* StrongThis = WeakThis.Get();
-			StrongThis->OnComplete.Broadcast(Response, Error, Success);
-			StrongThis->Cancel();
-		}
-	});
+		OnComplete.Broadcast(TEXT(""), TEXT("Request subsystem not available"), false);
+		Cancel();
+		return;
+	}
+	Subsystem->Start(RequestHandle);
 }
 
 void UGenOAIChat::Cancel()
 {
-	if (HttpRequest.IsValid() && HttpRequest->GetStatus() == EHttpRequestStatus::Processing)
+	// Aborts the in-flight transfer and frees the request slot, no-op once the request completed
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
 	{
-		HttpRequest->CancelRequest();
+		Subsystem->Cancel(RequestHandle);
 	}
+	RequestHandle.Reset();
 	Super::Cancel();
 }
 
+void UGenOAIChat::BeginDestroy()
+{
+	// An action that was never activated still holds its pending request slot
+	if (RequestHandle.IsValid())
+	{
+		if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+		{
+			Subsystem->Cancel(RequestHandle);
+		}
+		RequestHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
 TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIChat::MakeRequest(const FGenChatSettings& ChatSettings,
-                              const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+                              const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                              const FGenCancellationTokenPtr& CancellationToken)
 {
 	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
 	if (ApiKey.IsEmpty())
@@ -67,9 +104,11 @@ TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIChat::MakeRequest(const FGe
 	// Make a mutable copy so we can update the model
 	FGenChatSettings MutableSettings = ChatSettings;
 	MutableSettings.UpdateModel();
+	FGenContextTrimmer::TrimToBudget(MutableSettings.Messages, MutableSettings.MaxPromptTokens,
+	                                 FGenBPETokenizer::GetEncodingForModel(MutableSettings.Model));
 
-	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
-	JsonPayload->SetStringField(TEXT("model"), MutableSettings.Model);
+	TArray<FGenChatImage> Images;
+	const TSharedRef<FJsonObject> JsonPayload = FGenOAIWireFormat::MakeChatPayload(MutableSettings.Model, MutableSettings.Messages, &Images);
 	JsonPayload->SetNumberField(TEXT("max_completion_tokens"), MutableSettings.MaxTokens);
 	JsonPayload->SetNumberField(TEXT("temperature"), MutableSettings.Temperature);
 	JsonPayload->SetNumberField(TEXT("top_p"), MutableSettings.TopP);
@@ -90,28 +129,9 @@ TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIChat::MakeRequest(const FGe
 		JsonPayload->SetStringField(TEXT("verbosity"), VerbosityString.ToLower());
 	}
 
-	TArray<TSharedPtr<FJsonValue>> MessagesArray;
-	for (const auto& [Role, Content] : MutableSettings.Messages)
-	{
-		const TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
-		JsonMessage->SetStringField(TEXT("role"), Role);
-		JsonMessage->SetStringField(TEXT("content"), Content);
-		MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
-	}
-	JsonPayload->SetArrayField(TEXT("messages"), MessagesArray);
-
-	FString PayloadString;
-	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
-	FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
-
-	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetURL(TEXT("https://api.openai.com/v1/chat/completions"));
-	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
-	HttpRequest->SetContentAsString(PayloadString);
-
-	//UE_LOG(LogGenAIVerbose, Log, TEXT("Sending chat request... Payload: %s"), *PayloadString);
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FGenOAIWireFormat::MakeChatRequest(
+		GetDefault<UGenAISupportRuntimeSettings>()->GetBaseUrl(EGenAIOrgs::OpenAI) + TEXT("/chat/completions"), JsonPayload,
+		TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
 
 	HttpRequest->OnProcessRequestComplete().BindLambda(
 		[ResponseCallback](FHttpRequestPtr Request, const FHttpResponsePtr& Response, const bool bSuccess)
@@ -126,6 +146,23 @@ TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIChat::MakeRequest(const FGe
 			ProcessResponse(Response->GetContentAsString(), ResponseCallback);
 		});
 
+	if (Images.Num() > 0)
+	{
+		// The request starts once the images are encoded into its body
+		FGenImageEncoder::ProcessRequest(HttpRequest, MoveTemp(Images), EGenAIOrgs::OpenAI, CancellationToken, [ResponseCallback](const FString& Error)
+		{
+			ResponseCallback(TEXT(""), Error, false);
+		});
+		return HttpRequest;
+	}
+
+	if (CancellationToken.IsValid() && !CancellationToken->BindRequest(HttpRequest))
+	{
+		ResponseCallback(TEXT(""), CancellationToken->GetStopReason(), false);
+		return nullptr;
+	}
+
+	FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
@@ -133,40 +170,12 @@ TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIChat::MakeRequest(const FGe
 void UGenOAIChat::ProcessResponse(const FString& ResponseStr,
                                   const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
 {
-	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
-	TSharedPtr<FJsonObject> JsonObject;
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	FString Content;
+	FString ErrorMessage;
+	if (FGenOAIWireFormat::ParseChatResponse(ResponseStr, Content, ErrorMessage))
 	{
-		const TArray<TSharedPtr<FJsonValue>>* ChoicesArray;
-		if (JsonObject->TryGetArrayField(TEXT("choices"), ChoicesArray) && ChoicesArray->Num() > 0)
-		{
-			const TSharedPtr<FJsonObject>* FirstChoiceObject;
-			if ((*ChoicesArray)[0]->TryGetObject(FirstChoiceObject))
-			{
-				const TSharedPtr<FJsonObject>* MessageObject;
-				if ((*FirstChoiceObject)->TryGetObjectField(TEXT("message"), MessageObject))
-				{
-					FString Content;
-					if ((*MessageObject)->TryGetStringField(TEXT("content"), Content))
-					{
-						ResponseCallback(Content, TEXT(""), true);
-						return;
-					}
-				}
-			}
-		}
-
-		FString ErrorMessage;
-		const TSharedPtr<FJsonObject>* ErrorObject;
-		if (JsonObject->TryGetObjectField(TEXT("error"), ErrorObject))
-		{
-			if ((*ErrorObject)->TryGetStringField(TEXT("message"), ErrorMessage))
-			{
-				ResponseCallback(TEXT(""), ErrorMessage, false);
-				return;
-			}
-		}
+		ResponseCallback(Content, TEXT(""), true);
+		return;
 	}
-
-	ResponseCallback(TEXT(""), FString::Printf(TEXT("Failed to parse response: %s"), *ResponseStr), false);
+	ResponseCallback(TEXT(""), ErrorMessage, false);
 }
@@ -0,0 +1,718 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Models/OpenAI/GenOAIEmbeddings.h"
+
+#include "Async/Async.h"
+#include "GenAISupportRuntimeSettings.h"
+#include "Data/GenAIOrgs.h"
+#include "Dom/JsonObject.h"
+#include "Http.h"
+#include "Network/GenConnectionManager.h"
+#include "Network/GenRequestSubsystem.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Tasks/Task.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include <atomic>
+
+namespace GenEmbeddings
+{
+	/** Floats the result buffer needs for Rows vectors, INDEX_NONE when a TArray cannot hold them */
+	int32 GetNumValues(int32 Rows, int32 Dimensions)
+	{
+		const int64 NumValues = static_cast<int64>(Rows) * Dimensions;
+		return NumValues <= MAX_int32 ? static_cast<int32>(NumValues) : INDEX_NONE;
+	}
+
+	/**
+	 * Forward-only reader over a UTF-8 JSON body, just enough for the embeddings response.
+	 * Numbers are decoded in place instead of building a value object per float.
+	 */
+	struct FJsonCursor
+	{
+		const uint8* Pos;
+		const uint8* End;
+
+		void SkipWhitespace()
+		{
+			while (Pos < End && (*Pos == ' ' || *Pos == '\n' || *Pos == '\r' || *Pos == '\t'))
+			{
+				++Pos;
+			}
+		}
+
+		bool Consume(uint8 Char)
+		{
+			SkipWhitespace();
+			if (Pos < End && *Pos == Char)
+			{
+				++Pos;
+				return true;
+			}
+			return false;
+		}
+
+		bool ReadString(FAnsiStringView& OutString)
+		{
+			if (!Consume('"'))
+			{
+				return false;
+			}
+			const uint8* Start = Pos;
+			while (Pos < End && *Pos != '"')
+			{
+				Pos += *Pos == '\\' ? 2 : 1;
+			}
+			if (Pos >= End)
+			{
+				return false;
+			}
+			OutString = FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Start), static_cast<int32>(Pos - Start));
+			++Pos;
+			return true;
+		}
+
+		bool ReadKey(FAnsiStringView& OutKey)
+		{
+			return ReadString(OutKey) && Consume(':');
+		}
+
+		bool SkipValue()
+		{
+			SkipWhitespace();
+			if (Pos >= End)
+			{
+				return false;
+			}
+			if (*Pos == '"')
+			{
+				FAnsiStringView Ignored;
+				return ReadString(Ignored);
+			}
+			if (*Pos == '{' || *Pos == '[')
+			{
+				int32 Depth = 0;
+				while (Pos < End)
+				{
+					const uint8 Char = *Pos;
+					if (Char == '"')
+					{
+						FAnsiStringView Ignored;
+						if (!ReadString(Ignored))
+						{
+							return false;
+						}
+						continue;
+					}
+					++Pos;
+					if (Char == '{' || Char == '[')
+					{
+						++Depth;
+					}
+					else if ((Char == '}' || Char == ']') && --Depth == 0)
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+			while (Pos < End && *Pos != ',' && *Pos != '}' && *Pos != ']' && *Pos > ' ')
+			{
+				++Pos;
+			}
+			return true;
+		}
+
+		bool ReadNumber(double& OutValue)
+		{
+			static constexpr double ExactPowers[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+
+			SkipWhitespace();
+			const bool bNegative = Pos < End && *Pos == '-';
+			if (bNegative)
+			{
+				++Pos;
+			}
+
+			// Up to 19 significant digits fit in the mantissa, the rest only move the exponent
+			uint64 Mantissa = 0;
+			int32 Exponent = 0;
+			int32 Digits = 0;
+			const uint8* Start = Pos;
+			for (; Pos < End && FChar::IsDigit(*Pos); ++Pos)
+			{
+				if (Digits < 19)
+				{
+					Mantissa = Mantissa * 10 + (*Pos - '0');
+					Digits += Mantissa != 0;
+				}
+				else
+				{
+					++Exponent;
+				}
+			}
+			if (Pos == Start)
+			{
+				return false;
+			}
+			if (Pos < End && *Pos == '.')
+			{
+				for (++Pos; Pos < End && FChar::IsDigit(*Pos); ++Pos)
+				{
+					if (Digits < 19)
+					{
+						Mantissa = Mantissa * 10 + (*Pos - '0');
+						Digits += Mantissa != 0;
+						--Exponent;
+					}
+				}
+			}
+			if (Pos < End && (*Pos == 'e' || *Pos == 'E'))
+			{
+				++Pos;
+				const bool bNegativeExponent = Pos < End && *Pos == '-';
+				if (Pos < End && (*Pos == '-' || *Pos == '+'))
+				{
+					++Pos;
+				}
+				int32 ExplicitExponent = 0;
+				for (; Pos < End && FChar::IsDigit(*Pos); ++Pos)
+				{
+					ExplicitExponent = FMath::Min(ExplicitExponent * 10 + (*Pos - '0'), 1000);
+				}
+				Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+			}
+
+			double Value = static_cast<double>(Mantissa);
+			if (Exponent != 0 && Mantissa != 0)
+			{
+				const int32 AbsExponent = FMath::Abs(Exponent);
+				const double Scale = AbsExponent < UE_ARRAY_COUNT(ExactPowers) ? ExactPowers[AbsExponent] : FMath::Pow(10.0, static_cast<double>(AbsExponent));
+				Value = Exponent > 0 ? Value * Scale : Value / Scale;
+			}
+			OutValue = bNegative ? -Value : Value;
+			return true;
+		}
+
+		/** Number of elements in the numeric array starting at the cursor, without consuming it */
+		int32 CountArrayElements() const
+		{
+			FJsonCursor Probe = *this;
+			if (!Probe.Consume('['))
+			{
+				return INDEX_NONE;
+			}
+			int32 Commas = 0;
+			bool bHasValue = false;
+			for (; Probe.Pos < Probe.End && *Probe.Pos != ']'; ++Probe.Pos)
+			{
+				Commas += *Probe.Pos == ',';
+				bHasValue |= *Probe.Pos > ' ';
+			}
+			return Probe.Pos < Probe.End && bHasValue ? Commas + 1 : 0;
+		}
+	};
+}
+
+/**
+ * State shared by every batch of one SendEmbeddingRequest call.
+ * Scheduling fields are only touched on the game thread, decode tasks only write their own rows.
+ */
+struct FGenEmbeddingJob : public TSharedFromThis<FGenEmbeddingJob, ESPMode::ThreadSafe>
+{
+	FGenEmbeddingJob(const FGenEmbeddingSettings& Settings, const FString& InApiKey, const FGenCancellationTokenRef& InCancellationToken,
+	                 FGenEmbeddingCallback&& InOnComplete)
+		: Model(Settings.GetModelName())
+		, ApiKey(InApiKey)
+		, Inputs(Settings.Inputs)
+		, RequestedDimensions(Settings.Dimensions)
+		, BatchSize(FMath::Clamp(Settings.MaxInputsPerBatch, 1, 2048))
+		, MaxConcurrentBatches(FMath::Max(Settings.MaxConcurrentBatches, 1))
+		, NumBatches(FMath::DivideAndRoundUp(Settings.Inputs.Num(), BatchSize))
+		, CancellationToken(InCancellationToken)
+		, OnComplete(MoveTemp(InOnComplete))
+	{
+		// SendEmbeddingRequest rejects requests whose buffer would not fit, see GenEmbeddings::GetNumValues
+		if (RequestedDimensions > 0)
+		{
+			Result.Dimensions = RequestedDimensions;
+			Result.Values.SetNumUninitialized(GenEmbeddings::GetNumValues(Inputs.Num(), RequestedDimensions));
+		}
+	}
+
+	void LaunchBatches();
+
+private:
+	void LaunchBatch(int32 Batch);
+	void DecodeBatch(int32 Batch, const FHttpResponsePtr& Response);
+	void OnBatchDone(const FString& BatchError);
+	bool ParseBatch(int32 FirstRow, int32 NumRows, const TArray<uint8>& Body, FString& OutError);
+	float* AcquireRow(int32 Row, int32 Dimensions, FString& OutError);
+
+	const FString Model;
+	const FString ApiKey;
+	const TArray<FString> Inputs;
+	const int32 RequestedDimensions;
+	const int32 BatchSize;
+	const int32 MaxConcurrentBatches;
+	const int32 NumBatches;
+	const FGenCancellationTokenRef CancellationToken;
+	FGenEmbeddingCallback OnComplete;
+
+	int32 NextBatch = 0;
+	int32 InFlight = 0;
+	FString Error;
+	bool bFinished = false;
+
+	// Allocated once, on the first decoded row when the dimension was not requested explicitly
+	FCriticalSection ResultLock;
+	FGenEmbeddingResult Result;
+	std::atomic<int32> PromptTokens { 0 };
+};
+
+void FGenEmbeddingJob::LaunchBatches()
+{
+	while (!bFinished && Error.IsEmpty() && InFlight < MaxConcurrentBatches && NextBatch < NumBatches)
+	{
+		LaunchBatch(NextBatch++);
+	}
+}
+
+void FGenEmbeddingJob::LaunchBatch(int32 Batch)
+{
+	++InFlight;
+
+	const int32 FirstRow = Batch * BatchSize;
+	const int32 NumRows = FMath::Min(BatchSize, Inputs.Num() - FirstRow);
+
+	TArray<TSharedPtr<FJsonValue>> InputArray;
+	InputArray.Reserve(NumRows);
+	for (int32 Row = FirstRow; Row < FirstRow + NumRows; ++Row)
+	{
+		InputArray.Add(MakeShareable(new FJsonValueString(Inputs[Row])));
+	}
+
+	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
+	JsonPayload->SetStringField(TEXT("model"), Model);
+	JsonPayload->SetArrayField(TEXT("input"), InputArray);
+	JsonPayload->SetStringField(TEXT("encoding_format"), TEXT("float"));
+	if (RequestedDimensions > 0)
+	{
+		JsonPayload->SetNumberField(TEXT("dimensions"), RequestedDimensions);
+	}
+
+	FString PayloadString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
+	FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(GetDefault<UGenAISupportRuntimeSettings>()->GetBaseUrl(EGenAIOrgs::OpenAI) + TEXT("/embeddings"));
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
+	HttpRequest->SetContentAsString(PayloadString);
+
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[Job = AsShared(), Batch](FHttpRequestPtr Request, const FHttpResponsePtr& Response, const bool bSuccess)
+		{
+			if (!bSuccess || !Response.IsValid())
+			{
+				UE_LOG(LogGenAI, Error, TEXT("Embedding batch %d failed, Response code: %d"), Batch,
+				       Response.IsValid() ? Response->GetResponseCode() : -1);
+				Job->OnBatchDone(Job->CancellationToken->IsCancelled() || Job->CancellationToken->IsExpired()
+					                 ? Job->CancellationToken->GetStopReason() : TEXT("Request failed"));
+				return;
+			}
+
+			if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+			{
+				FString ErrorMessage = FString::Printf(TEXT("Embedding request failed with code %d"), Response->GetResponseCode());
+				TSharedPtr<FJsonObject> JsonObject;
+				const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+				const TSharedPtr<FJsonObject>* ErrorObject;
+				if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid() && JsonObject->TryGetObjectField(TEXT("error"), ErrorObject))
+				{
+					(*ErrorObject)->TryGetStringField(TEXT("message"), ErrorMessage);
+				}
+				Job->OnBatchDone(ErrorMessage);
+				return;
+			}
+
+			Job->DecodeBatch(Batch, Response);
+		});
+
+	if (!CancellationToken->BindRequest(HttpRequest))
+	{
+		OnBatchDone(CancellationToken->GetStopReason());
+		return;
+	}
+
+	FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
+	HttpRequest->ProcessRequest();
+}
+
+void FGenEmbeddingJob::DecodeBatch(int32 Batch, const FHttpResponsePtr& Response)
+{
+	// A full batch of large vectors is several megabytes of text, keep it off the game thread
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job = AsShared(), Batch, Response]()
+	{
+		const int32 FirstRow = Batch * Job->BatchSize;
+		const int32 NumRows = FMath::Min(Job->BatchSize, Job->Inputs.Num() - FirstRow);
+
+		FString BatchError;
+		Job->ParseBatch(FirstRow, NumRows, Response->GetContent(), BatchError);
+
+		AsyncTask(ENamedThreads::GameThread, [Job, BatchError = MoveTemp(BatchError)]()
+		{
+			Job->OnBatchDone(BatchError);
+		});
+	});
+}
+
+void FGenEmbeddingJob::OnBatchDone(const FString& BatchError)
+{
+	--InFlight;
+	if (!BatchError.IsEmpty() && Error.IsEmpty())
+	{
+		// The other batches are wasted work now, abort them
+		Error = BatchError;
+		CancellationToken->Cancel();
+	}
+
+	LaunchBatches();
+
+	if (bFinished || InFlight > 0 || (Error.IsEmpty() && NextBatch < NumBatches))
+	{
+		return;
+	}
+
+	bFinished = true;
+	if (Error.IsEmpty())
+	{
+		Result.PromptTokens = PromptTokens;
+		OnComplete(MoveTemp(Result), TEXT(""), true);
+	}
+	else
+	{
+		OnComplete(FGenEmbeddingResult(), Error, false);
+	}
+}
+
+float* FGenEmbeddingJob::AcquireRow(int32 Row, int32 Dimensions, FString& OutError)
+{
+	FScopeLock Lock(&ResultLock);
+	if (Result.Dimensions == 0)
+	{
+		const int32 NumValues = GenEmbeddings::GetNumValues(Inputs.Num(), Dimensions);
+		if (NumValues == INDEX_NONE)
+		{
+			OutError = FString::Printf(TEXT("%d embeddings of %d dimensions do not fit in one result"), Inputs.Num(), Dimensions);
+			return nullptr;
+		}
+		Result.Dimensions = Dimensions;
+		Result.Values.SetNumUninitialized(NumValues);
+	}
+	if (Result.Dimensions != Dimensions)
+	{
+		OutError = FString::Printf(TEXT("Embedding %d has %d dimensions, expected %d"), Row, Dimensions, Result.Dimensions);
+		return nullptr;
+	}
+	// The buffer never reallocates after this point, rows are disjoint so writers need no lock
+	return Result.Values.GetData() + static_cast<int64>(Row) * Dimensions;
+}
+
+bool FGenEmbeddingJob::ParseBatch(int32 FirstRow, int32 NumRows, const TArray<uint8>& Body, FString& OutError)
+{
+	GenEmbeddings::FJsonCursor Cursor { Body.GetData(), Body.GetData() + Body.Num() };
+	int32 RowsParsed = 0;
+
+	// Every row of the batch has to be written exactly once, an unwritten one would be returned uninitialized
+	TBitArray<> SeenRows(false, NumRows);
+
+	auto ParseEmbedding = [this, FirstRow, NumRows, &SeenRows, &OutError](GenEmbeddings::FJsonCursor& EmbeddingCursor, int64 Index)
+	{
+		if (Index < 0 || Index >= NumRows)
+		{
+			OutError = FString::Printf(TEXT("Embedding index %lld out of range"), Index);
+			return false;
+		}
+		if (SeenRows[static_cast<int32>(Index)])
+		{
+			OutError = FString::Printf(TEXT("Embedding index %lld received twice"), Index);
+			return false;
+		}
+		SeenRows[static_cast<int32>(Index)] = true;
+
+		const int32 Dimensions = EmbeddingCursor.CountArrayElements();
+		if (Dimensions <= 0)
+		{
+			OutError = TEXT("Embedding is not a float array");
+			return false;
+		}
+
+		float* Row = AcquireRow(FirstRow + static_cast<int32>(Index), Dimensions, OutError);
+		if (!Row)
+		{
+			return false;
+		}
+
+		EmbeddingCursor.Consume('[');
+		for (int32 Component = 0; Component < Dimensions; ++Component)
+		{
+			double Value;
+			if ((Component > 0 && !EmbeddingCursor.Consume(',')) || !EmbeddingCursor.ReadNumber(Value))
+			{
+				OutError = TEXT("Malformed embedding values");
+				return false;
+			}
+			Row[Component] = static_cast<float>(Value);
+		}
+		return EmbeddingCursor.Consume(']');
+	};
+
+	auto ParseDataEntry = [&Cursor, &ParseEmbedding, &RowsParsed]()
+	{
+		if (!Cursor.Consume('{'))
+		{
+			return false;
+		}
+
+		int64 Index = INDEX_NONE;
+		const uint8* EmbeddingStart = nullptr;
+		if (!Cursor.Consume('}'))
+		{
+			do
+			{
+				FAnsiStringView Key;
+				if (!Cursor.ReadKey(Key))
+				{
+					return false;
+				}
+				if (Key == ANSITEXTVIEW("index"))
+				{
+					double IndexValue;
+					if (!Cursor.ReadNumber(IndexValue))
+					{
+						return false;
+					}
+					Index = static_cast<int64>(IndexValue);
+				}
+				else
+				{
+					// The embedding is decoded once its index is known, the API does not guarantee key order
+					Cursor.SkipWhitespace();
+					if (Key == ANSITEXTVIEW("embedding"))
+					{
+						EmbeddingStart = Cursor.Pos;
+					}
+					if (!Cursor.SkipValue())
+					{
+						return false;
+					}
+				}
+			}
+			while (Cursor.Consume(','));
+
+			if (!Cursor.Consume('}'))
+			{
+				return false;
+			}
+		}
+
+		if (!EmbeddingStart)
+		{
+			return false;
+		}
+		GenEmbeddings::FJsonCursor EmbeddingCursor { EmbeddingStart, Cursor.End };
+		if (!ParseEmbedding(EmbeddingCursor, Index))
+		{
+			return false;
+		}
+		++RowsParsed;
+		return true;
+	};
+
+	auto ParseUsage = [&Cursor, this]()
+	{
+		if (!Cursor.Consume('{'))
+		{
+			return Cursor.SkipValue();
+		}
+		if (Cursor.Consume('}'))
+		{
+			return true;
+		}
+		do
+		{
+			FAnsiStringView Key;
+			if (!Cursor.ReadKey(Key))
+			{
+				return false;
+			}
+			double Tokens;
+			if (Key == ANSITEXTVIEW("prompt_tokens") && Cursor.ReadNumber(Tokens))
+			{
+				PromptTokens += static_cast<int32>(Tokens);
+			}
+			else if (!Cursor.SkipValue())
+			{
+				return false;
+			}
+		}
+		while (Cursor.Consume(','));
+		return Cursor.Consume('}');
+	};
+
+	bool bValid = Cursor.Consume('{');
+	while (bValid && OutError.IsEmpty())
+	{
+		FAnsiStringView Key;
+		if (!Cursor.ReadKey(Key))
+		{
+			bValid = false;
+			break;
+		}
+
+		if (Key == ANSITEXTVIEW("data"))
+		{
+			bValid = Cursor.Consume('[');
+			if (bValid && !Cursor.Consume(']'))
+			{
+				do
+				{
+					bValid = ParseDataEntry();
+				}
+				while (bValid && Cursor.Consume(','));
+				bValid = bValid && Cursor.Consume(']');
+			}
+		}
+		else if (Key == ANSITEXTVIEW("usage"))
+		{
+			bValid = ParseUsage();
+		}
+		else
+		{
+			bValid = Cursor.SkipValue();
+		}
+
+		if (!Cursor.Consume(','))
+		{
+			bValid = bValid && Cursor.Consume('}');
+			break;
+		}
+	}
+
+	const int32 MissingRow = SeenRows.Find(false);
+	if (OutError.IsEmpty() && (!bValid || MissingRow != INDEX_NONE))
+	{
+		OutError = bValid ? FString::Printf(TEXT("Expected %d embeddings, received %d without index %d"), NumRows, RowsParsed, MissingRow)
+			           : TEXT("Failed to parse embedding response");
+	}
+	return OutError.IsEmpty();
+}
+
+void UGenOAIEmbeddings::SendEmbeddingRequest(const FGenEmbeddingSettings& EmbeddingSettings, FGenEmbeddingCallback&& OnComplete,
+                                             const FGenCancellationTokenPtr& CancellationToken)
+{
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
+	if (ApiKey.IsEmpty())
+	{
+		OnComplete(FGenEmbeddingResult(), TEXT("API key not set"), false);
+		return;
+	}
+
+	if (EmbeddingSettings.Inputs.Num() == 0)
+	{
+		OnComplete(FGenEmbeddingResult(), TEXT(""), true);
+		return;
+	}
+
+	if (EmbeddingSettings.Dimensions > 0 && GenEmbeddings::GetNumValues(EmbeddingSettings.Inputs.Num(), EmbeddingSettings.Dimensions) == INDEX_NONE)
+	{
+		OnComplete(FGenEmbeddingResult(), FString::Printf(TEXT("%d inputs of %d dimensions do not fit in one result, split the request"),
+		                                                  EmbeddingSettings.Inputs.Num(), EmbeddingSettings.Dimensions), false);
+		return;
+	}
+
+	// Batches share a child token so a failed batch can abort its siblings without cancelling the caller's token
+	const FGenCancellationTokenRef Token = CancellationToken.IsValid() ? CancellationToken->CreateChild() : FGenCancellationToken::Create();
+	const TSharedRef<FGenEmbeddingJob, ESPMode::ThreadSafe> Job = MakeShared<FGenEmbeddingJob, ESPMode::ThreadSafe>(
+		EmbeddingSettings, ApiKey, Token, MoveTemp(OnComplete));
+	Job->LaunchBatches();
+}
+
+UGenOAIEmbeddings* UGenOAIEmbeddings::RequestOpenAIEmbeddings(UObject* WorldContextObject, const FGenEmbeddingSettings& EmbeddingSettings)
+{
+	UGenOAIEmbeddings* AsyncAction = NewObject<UGenOAIEmbeddings>();
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		// The settings are copied once into the pooled slot, the request is queued on Activate
+		TWeakObjectPtr<UGenOAIEmbeddings> WeakThis(AsyncAction);
+		FGenRequestOptions Options;
+		Options.bStartImmediately = false;
+		AsyncAction->RequestHandle = Subsystem->SubmitOpenAIEmbeddings(EmbeddingSettings, [WeakThis](FGenEmbeddingResult&& Result, const FString& Error, bool Success)
+		{
+			if (UGenOAIEmbeddings* StrongThis = WeakThis.Get())
+			{
+				StrongThis->RequestHandle.Reset();
+				StrongThis->OnComplete.Broadcast(Result, Error, Success);
+				StrongThis->Cancel();
+			}
+		}, Options);
+	}
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
+	return AsyncAction;
+}
+
+TArray<float> UGenOAIEmbeddings::GetEmbedding(const FGenEmbeddingResult& Result, int32 Index)
+{
+	if (Index < 0 || Index >= Result.Num())
+	{
+		return TArray<float>();
+	}
+	return TArray<float>(Result.GetEmbedding(Index));
+}
+
+void UGenOAIEmbeddings::Activate()
+{
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem || !RequestHandle.IsValid())
+	{
+		OnComplete.Broadcast(FGenEmbeddingResult(), TEXT("Request subsystem not available"), false);
+		Cancel();
+		return;
+	}
+	Subsystem->Start(RequestHandle);
+}
+
+void UGenOAIEmbeddings::Cancel()
+{
+	// Aborts every in-flight batch and frees the request slot, no-op once the request completed
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		Subsystem->Cancel(RequestHandle);
+	}
+	RequestHandle.Reset();
+	Super::Cancel();
+}
+
+void UGenOAIEmbeddings::BeginDestroy()
+{
+	// An action that was never activated still holds its pending request slot
+	if (RequestHandle.IsValid())
+	{
+		if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+		{
+			Subsystem->Cancel(RequestHandle);
+		}
+		RequestHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
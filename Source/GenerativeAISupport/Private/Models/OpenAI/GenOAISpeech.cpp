@@ -0,0 +1,244 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Models/OpenAI/GenOAISpeech.h"
+
+#include "Async/Async.h"
+#include "GenAISupportRuntimeSettings.h"
+#include "HttpModule.h"
+#include "Data/GenAIOrgs.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Network/GenConnectionManager.h"
+#include "Network/GenRequestSubsystem.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace GenOAISpeech
+{
+	/** Shared by the request's delegates, which run on the HTTP thread */
+	struct FStreamState
+	{
+		// Body bytes not written yet, kept until the status is known and whole for error responses
+		TArray<uint8> Held;
+		bool bStarted = false;
+		FOnSpeechCompletionResponse OnComplete;
+		FSimpleDelegate OnAudioStarted;
+	};
+
+	/** The body is streamed into the state rather than kept by the response, so errors are read from it */
+	static FString GetErrorMessage(const FHttpResponsePtr& Response, const TArray<uint8>& Body)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+		TSharedPtr<FJsonObject> JsonObject;
+		const TSharedPtr<FJsonObject>* ErrorObject;
+		FString Message;
+		if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid()
+			&& JsonObject->TryGetObjectField(TEXT("error"), ErrorObject) && (*ErrorObject)->TryGetStringField(TEXT("message"), Message))
+		{
+			return Message;
+		}
+		return FString::Printf(TEXT("Speech request failed with HTTP %d"), Response->GetResponseCode());
+	}
+}
+
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAISpeech::SendSpeechRequest(const FGenOAISpeechSettings& SpeechSettings, const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& Buffer,
+                                                                               const FOnSpeechCompletionResponse& OnComplete, const FGenCancellationTokenPtr& CancellationToken,
+                                                                               const FSimpleDelegate& OnAudioStarted)
+{
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
+	if (ApiKey.IsEmpty())
+	{
+		OnComplete.ExecuteIfBound(TEXT("API key not set"), false);
+		return nullptr;
+	}
+
+	const TSharedRef<FJsonObject> JsonPayload = MakeShared<FJsonObject>();
+	JsonPayload->SetStringField(TEXT("model"), SpeechSettings.Model);
+	JsonPayload->SetStringField(TEXT("voice"), SpeechSettings.Voice);
+	JsonPayload->SetStringField(TEXT("input"), SpeechSettings.Input);
+	// Raw 24 kHz 16 bit mono, playable as it arrives without a decoder
+	JsonPayload->SetStringField(TEXT("response_format"), TEXT("pcm"));
+	JsonPayload->SetNumberField(TEXT("speed"), SpeechSettings.Speed);
+	if (!SpeechSettings.Instructions.IsEmpty())
+	{
+		JsonPayload->SetStringField(TEXT("instructions"), SpeechSettings.Instructions);
+	}
+
+	FString PayloadString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
+	FJsonSerializer::Serialize(JsonPayload, Writer);
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(GetDefault<UGenAISupportRuntimeSettings>()->GetBaseUrl(EGenAIOrgs::OpenAI) + TEXT("/audio/speech"));
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
+	HttpRequest->SetContentAsString(PayloadString);
+
+	// Chunks go into the buffer on the HTTP thread, only the callbacks are sent to the game thread
+	HttpRequest->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+
+	const TSharedRef<GenOAISpeech::FStreamState, ESPMode::ThreadSafe> State = MakeShared<GenOAISpeech::FStreamState, ESPMode::ThreadSafe>();
+	State->OnComplete = OnComplete;
+	State->OnAudioStarted = OnAudioStarted;
+
+	// Writes the held bytes once the response is known to be audio, error bodies are JSON and must not be played
+	auto WriteHeld = [State, Buffer, CancellationToken](const FHttpResponsePtr& Response)
+	{
+		if (State->Held.Num() == 0 || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode())
+			|| (CancellationToken.IsValid() && CancellationToken->IsCancelled()))
+		{
+			return;
+		}
+
+		Buffer->Write(State->Held.GetData(), State->Held.Num());
+		State->Held.Reset();
+		if (!State->bStarted)
+		{
+			State->bStarted = true;
+			AsyncTask(ENamedThreads::GameThread, [State]()
+			{
+				State->OnAudioStarted.ExecuteIfBound();
+			});
+		}
+	};
+
+	// Each chunk is handed over as it arrives instead of the whole body being copied again on every progress tick.
+	// The request is only weakly held, it owns this delegate
+	const TWeakPtr<IHttpRequest, ESPMode::ThreadSafe> WeakRequest = HttpRequest;
+	auto OnBodyReceived = [State, WriteHeld, WeakRequest](const void* Data, int64 Length)
+	{
+		State->Held.Append(static_cast<const uint8*>(Data), static_cast<int32>(Length));
+		if (const TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request = WeakRequest.Pin())
+		{
+			WriteHeld(Request->GetResponse());
+		}
+	};
+#if UE_VERSION_NEWER_THAN(5, 3, 0)
+	HttpRequest->SetResponseBodyReceiveStreamDelegateV2(FHttpRequestStreamDelegateV2::CreateLambda([OnBodyReceived](void* Data, int64& Length)
+	{
+		OnBodyReceived(Data, Length);
+	}));
+#else
+	HttpRequest->SetResponseBodyReceiveStreamDelegate(FHttpRequestStreamDelegate::CreateLambda([OnBodyReceived](void* Data, int64 Length)
+	{
+		OnBodyReceived(Data, Length);
+		return true;
+	}));
+#endif
+
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[State, WriteHeld](FHttpRequestPtr Request, const FHttpResponsePtr& Response, const bool bSuccess)
+		{
+			WriteHeld(Response);
+
+			FString ErrorMessage;
+			if (!bSuccess || !Response.IsValid())
+			{
+				const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : -1;
+				ErrorMessage = ResponseCode == 0 ? TEXT("Request most likely timed out. No response received.") : TEXT("Request failed");
+				UE_LOG(LogGenAI, Error, TEXT("Speech request failed, Response code: %d"), ResponseCode);
+			}
+			else if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+			{
+				ErrorMessage = GenOAISpeech::GetErrorMessage(Response, State->Held);
+			}
+
+			// The delegates are released on the game thread, they may hold game thread only state
+			AsyncTask(ENamedThreads::GameThread, [State, ErrorMessage]()
+			{
+				const FOnSpeechCompletionResponse Callback = MoveTemp(State->OnComplete);
+				State->OnAudioStarted.Unbind();
+				Callback.ExecuteIfBound(ErrorMessage, ErrorMessage.IsEmpty());
+			});
+		});
+
+	if (CancellationToken.IsValid() && !CancellationToken->BindRequest(HttpRequest))
+	{
+		OnComplete.ExecuteIfBound(CancellationToken->GetStopReason(), false);
+		return nullptr;
+	}
+
+	FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
+	HttpRequest->ProcessRequest();
+	return HttpRequest;
+}
+
+UGenOAISpeech* UGenOAISpeech::RequestOpenAISpeech(UObject* WorldContextObject, const FGenOAISpeechSettings& SpeechSettings)
+{
+	UGenOAISpeech* AsyncAction = NewObject<UGenOAISpeech>();
+	AsyncAction->Sound = UGenStreamingSoundWave::Create();
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		// The settings are copied once into the pooled slot, the request is queued on Activate
+		TWeakObjectPtr<UGenOAISpeech> WeakThis(AsyncAction);
+		FGenRequestOptions Options;
+		Options.bStartImmediately = false;
+		AsyncAction->RequestHandle = Subsystem->SubmitOpenAISpeech(SpeechSettings, AsyncAction->Sound->GetBuffer(), [WeakThis](const FString& Response, const FString& Error, bool Success)
+		{
+			if (UGenOAISpeech* StrongThis = WeakThis.Get())
+			{
+				StrongThis->RequestHandle.Reset();
+				StrongThis->Sound->GetBuffer()->Finish();
+				StrongThis->OnComplete.Broadcast(StrongThis->Sound, Error, Success);
+				StrongThis->Cancel();
+			}
+		}, Options, [WeakThis]()
+		{
+			if (UGenOAISpeech* StrongThis = WeakThis.Get())
+			{
+				StrongThis->OnStarted.Broadcast(StrongThis->Sound, TEXT(""), true);
+			}
+		});
+	}
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
+	return AsyncAction;
+}
+
+void UGenOAISpeech::Activate()
+{
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem || !RequestHandle.IsValid())
+	{
+		OnComplete.Broadcast(Sound, TEXT("Request subsystem not available"), false);
+		Cancel();
+		return;
+	}
+	Subsystem->Start(RequestHandle);
+}
+
+void UGenOAISpeech::Cancel()
+{
+	// Aborts the in-flight transfer and frees the request slot, no-op once the request completed
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		Subsystem->Cancel(RequestHandle);
+	}
+	RequestHandle.Reset();
+	// Lets the wave report the end of playback once what was received has played
+	if (Sound)
+	{
+		Sound->GetBuffer()->Finish();
+	}
+	Super::Cancel();
+}
+
+void UGenOAISpeech::BeginDestroy()
+{
+	// An action that was never activated still holds its pending request slot
+	if (RequestHandle.IsValid())
+	{
+		if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+		{
+			Subsystem->Cancel(RequestHandle);
+		}
+		RequestHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
@@ -3,52 +3,100 @@
 
 #include "Models/OpenAI/GenOAIStructuredOpService.h"
 
+#include "GenAISupportRuntimeSettings.h"
 #include "Http.h"
 #include "Data/GenAIOrgs.h"
 #include "Data/OpenAI/GenOAIChatStructs.h"
 #include "Engine/Engine.h" // For GEngine logging
+#include "Network/GenConnectionManager.h"
+#include "Network/GenRequestSubsystem.h"
 #include "Secure/GenSecureKey.h"
 #include "Utilities/GenGlobalDefinitions.h"
 
-void UGenOAIStructuredOpService::RequestStructuredOutput(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FOnSchemaResponse& OnComplete)
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIStructuredOpService::RequestStructuredOutput(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FOnSchemaResponse& OnComplete,
+                                                                                               const FGenCancellationTokenPtr& CancellationToken)
 {
-    MakeRequest(
+    return MakeRequest(
         StructuredChatSettings,
         [OnComplete](const FString& Response, const FString& Error, bool Success) {
             if (OnComplete.IsBound())
             {
                 OnComplete.Execute(Response, Error, Success);
             }
-        }
+        },
+        CancellationToken
     );
 }
 
 UGenOAIStructuredOpService* UGenOAIStructuredOpService::RequestOpenAIStructuredOutput(UObject* WorldContextObject, const FGenOAIStructuredChatSettings& StructuredChatSettings)
 {
     UGenOAIStructuredOpService* AsyncAction = NewObject<UGenOAIStructuredOpService>();
-    AsyncAction->StructuredChatSettings = StructuredChatSettings;
+    if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+    {
+        // The settings are copied once into the pooled slot, the request is queued on Activate
+        TWeakObjectPtr<UGenOAIStructuredOpService> WeakThis(AsyncAction);
+        FGenRequestOptions Options;
+        Options.bStartImmediately = false;
+        AsyncAction->RequestHandle = Subsystem->SubmitOpenAIStructuredOutput(StructuredChatSettings, [WeakThis](const FString& Response, const FString& Error, bool Success)
+        {
+            if (UGenOAIStructuredOpService* StrongThis = WeakThis.Get())
+            {
+                StrongThis->RequestHandle.Reset();
+                StrongThis->OnComplete.Broadcast(Response, Error, Success);
+                StrongThis->Cancel();
+            }
+        }, Options);
+    }
+    AsyncAction->RegisterWithGameInstance(WorldContextObject);
     return AsyncAction;
 }
 
 void UGenOAIStructuredOpService::Activate()
 {
-    MakeRequest(
-        StructuredChatSettings,
-        [this](const FString& Response, const FString& Error, bool Success) {
-            OnComplete.Broadcast(Response, Error, Success);
-            Cancel();
+    UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+    if (!Subsystem || !RequestHandle.IsValid())
+    {
+        OnComplete.Broadcast(TEXT(""), TEXT("Request subsystem not available"), false);
+        Cancel();
+        return;
+    }
+    Subsystem->Start(RequestHandle);
+}
+
+void UGenOAIStructuredOpService::Cancel()
+{
+    // Aborts the in-flight transfer and frees the request slot, no-op once the request completed
+    if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+    {
+        Subsystem->Cancel(RequestHandle);
+    }
+    RequestHandle.Reset();
+    Super::Cancel();
+}
+
+void UGenOAIStructuredOpService::BeginDestroy()
+{
+    // An action that was never activated still holds its pending request slot
+    if (RequestHandle.IsValid())
+    {
+        if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+        {
+            Subsystem->Cancel(RequestHandle);
         }
-    );
+        RequestHandle.Reset();
+    }
+    Super::BeginDestroy();
 }
 
-void UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                                                                   const FGenCancellationTokenPtr& CancellationToken)
 {
     FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
     if (ApiKey.IsEmpty())
     {
         ResponseCallback(TEXT(""), TEXT("API key not set"), false);
         UE_LOG(LogGenAI, Error, TEXT("API key not set"));
-        return;
+        return nullptr;
     }
 
     // Create JSON payload
@@ -69,7 +117,8 @@ void UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings
     if (!FJsonSerializer::Deserialize(SchemaReader, SchemaObject) || !SchemaObject.IsValid())
     {
         UE_LOG(LogGenAI, Error, TEXT("Failed to parse schema JSON: %s"), *StructuredChatSettings.SchemaJson);
-        return;
+        ResponseCallback(TEXT(""), TEXT("Failed to parse schema JSON"), false);
+        return nullptr;
     }
     RootSchemaObject->SetObjectField(TEXT("schema"), SchemaObject);
 
@@ -102,7 +151,7 @@ void UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings
     // Create HTTP request
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
     HttpRequest->SetVerb(TEXT("POST"));
-    HttpRequest->SetURL(TEXT("https://api.openai.com/v1/chat/completions"));
+    HttpRequest->SetURL(GetDefault<UGenAISupportRuntimeSettings>()->GetBaseUrl(EGenAIOrgs::OpenAI) + TEXT("/chat/completions"));
     HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
     HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
     HttpRequest->SetContentAsString(PayloadString);
@@ -119,7 +168,15 @@ void UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings
         ProcessResponse(Response->GetContentAsString(), ResponseCallback);
     });
 
+    if (CancellationToken.IsValid() && !CancellationToken->BindRequest(HttpRequest))
+    {
+        ResponseCallback(TEXT(""), CancellationToken->GetStopReason(), false);
+        return nullptr;
+    }
+
+    FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
     HttpRequest->ProcessRequest();
+    return HttpRequest;
 }
 
 
@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Models/OpenAI/GenOAIWireFormat.h"
+
+#include "HttpModule.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utilities/GenImageEncoder.h"
+
+TSharedRef<FJsonObject> FGenOAIWireFormat::MakeChatPayload(const FString& Model, const TArray<FGenChatMessage>& Messages, TArray<FGenChatImage>* OutImages)
+{
+	const TSharedRef<FJsonObject> JsonPayload = MakeShared<FJsonObject>();
+	JsonPayload->SetStringField(TEXT("model"), Model);
+
+	TArray<TSharedPtr<FJsonValue>> MessagesArray;
+	MessagesArray.Reserve(Messages.Num());
+	for (const FGenChatMessage& Message : Messages)
+	{
+		const TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
+		JsonMessage->SetStringField(TEXT("role"), Message.Role);
+		if (!OutImages || Message.Images.Num() == 0)
+		{
+			JsonMessage->SetStringField(TEXT("content"), Message.Content);
+			MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
+			continue;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> ContentParts;
+		const TSharedRef<FJsonObject> TextPart = MakeShared<FJsonObject>();
+		TextPart->SetStringField(TEXT("type"), TEXT("text"));
+		TextPart->SetStringField(TEXT("text"), Message.Content);
+		ContentParts.Add(MakeShared<FJsonValueObject>(TextPart));
+		for (const FGenChatImage& Image : Message.Images)
+		{
+			const TSharedRef<FJsonObject> ImageUrl = MakeShared<FJsonObject>();
+			ImageUrl->SetStringField(TEXT("url"), FString::Printf(TEXT("data:%s;base64,%s"),
+				*FGenImageEncoder::GetMimeType(Image.Encoding), *FGenImageEncoder::GetPlaceholder(OutImages->Num())));
+			ImageUrl->SetStringField(TEXT("detail"), StaticEnum<EGenImageDetail>()->GetNameStringByValue(static_cast<int64>(Image.Detail)).ToLower());
+
+			const TSharedRef<FJsonObject> ImagePart = MakeShared<FJsonObject>();
+			ImagePart->SetStringField(TEXT("type"), TEXT("image_url"));
+			ImagePart->SetObjectField(TEXT("image_url"), ImageUrl);
+			ContentParts.Add(MakeShared<FJsonValueObject>(ImagePart));
+			OutImages->Add(Image);
+		}
+		JsonMessage->SetArrayField(TEXT("content"), ContentParts);
+		MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
+	}
+	JsonPayload->SetArrayField(TEXT("messages"), MessagesArray);
+	return JsonPayload;
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FGenOAIWireFormat::MakeChatRequest(const FString& Url, const TSharedRef<FJsonObject>& Payload,
+                                                                                 const FString& AuthHeader, const FString& AuthValue)
+{
+	FString PayloadString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
+	FJsonSerializer::Serialize(Payload, Writer);
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(Url);
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	if (!AuthHeader.IsEmpty() && !AuthValue.IsEmpty())
+	{
+		HttpRequest->SetHeader(AuthHeader, AuthValue);
+	}
+	HttpRequest->SetContentAsString(PayloadString);
+	return HttpRequest;
+}
+
+bool FGenOAIWireFormat::ParseChatResponse(const FString& ResponseStr, FString& OutContent, FString& OutError)
+{
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
+	TSharedPtr<FJsonObject> JsonObject;
+	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	{
+		const TArray<TSharedPtr<FJsonValue>>* ChoicesArray;
+		if (JsonObject->TryGetArrayField(TEXT("choices"), ChoicesArray) && ChoicesArray->Num() > 0)
+		{
+			const TSharedPtr<FJsonObject>* FirstChoiceObject;
+			if ((*ChoicesArray)[0]->TryGetObject(FirstChoiceObject))
+			{
+				const TSharedPtr<FJsonObject>* MessageObject;
+				if ((*FirstChoiceObject)->TryGetObjectField(TEXT("message"), MessageObject)
+					&& (*MessageObject)->TryGetStringField(TEXT("content"), OutContent))
+				{
+					return true;
+				}
+			}
+		}
+
+		const TSharedPtr<FJsonObject>* ErrorObject;
+		if (JsonObject->TryGetObjectField(TEXT("error"), ErrorObject) && (*ErrorObject)->TryGetStringField(TEXT("message"), OutError))
+		{
+			return false;
+		}
+	}
+
+	OutError = FString::Printf(TEXT("Failed to parse response: %s"), *ResponseStr);
+	return false;
+}
+
+void FGenOAIStreamDecoder::Update(const TArray<uint8>& Received, const TFunctionRef<void(const FString&)>& OnDelta)
+{
+	const ANSICHAR* Data = reinterpret_cast<const ANSICHAR*>(Received.GetData());
+	int32 LineStart = Consumed;
+	for (int32 Index = Consumed; Index < Received.Num() && !bDone; ++Index)
+	{
+		if (Data[Index] != '\n')
+		{
+			continue;
+		}
+
+		int32 LineEnd = Index;
+		if (LineEnd > LineStart && Data[LineEnd - 1] == '\r')
+		{
+			--LineEnd;
+		}
+		DecodeLine(Data + LineStart, LineEnd - LineStart, OnDelta);
+		LineStart = Index + 1;
+	}
+	Consumed = LineStart;
+}
+
+void FGenOAIStreamDecoder::DecodeLine(const ANSICHAR* Line, int32 Length, const TFunctionRef<void(const FString&)>& OnDelta)
+{
+	// Blank lines separate events and lines starting with ':' are comments, only data fields carry payload
+	static constexpr ANSICHAR DataField[] = "data:";
+	static constexpr int32 DataFieldLength = UE_ARRAY_COUNT(DataField) - 1;
+	if (Length < DataFieldLength || FCStringAnsi::Strncmp(Line, DataField, DataFieldLength) != 0)
+	{
+		return;
+	}
+
+	Line += DataFieldLength;
+	Length -= DataFieldLength;
+	while (Length > 0 && *Line == ' ')
+	{
+		++Line;
+		--Length;
+	}
+
+	bHasEvents = true;
+	if (Length == 6 && FCStringAnsi::Strncmp(Line, "[DONE]", 6) == 0)
+	{
+		bDone = true;
+		return;
+	}
+
+	const FUTF8ToTCHAR Converted(Line, Length);
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+	TSharedPtr<FJsonObject> Event;
+	if (!FJsonSerializer::Deserialize(Reader, Event) || !Event.IsValid())
+	{
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* ErrorObject;
+	if (Event->TryGetObjectField(TEXT("error"), ErrorObject))
+	{
+		if (!(*ErrorObject)->TryGetStringField(TEXT("message"), Error))
+		{
+			Error = TEXT("Unknown error in response stream");
+		}
+		bDone = true;
+		return;
+	}
+
+	// Role-only and finish events have no content, null content is skipped by TryGetStringField
+	const TArray<TSharedPtr<FJsonValue>>* ChoicesArray;
+	const TSharedPtr<FJsonObject>* FirstChoiceObject;
+	const TSharedPtr<FJsonObject>* DeltaObject;
+	FString Delta;
+	if (Event->TryGetArrayField(TEXT("choices"), ChoicesArray) && ChoicesArray->Num() > 0
+		&& (*ChoicesArray)[0]->TryGetObject(FirstChoiceObject)
+		&& (*FirstChoiceObject)->TryGetObjectField(TEXT("delta"), DeltaObject)
+		&& (*DeltaObject)->TryGetStringField(TEXT("content"), Delta) && !Delta.IsEmpty())
+	{
+		Content += Delta;
+		OnDelta(Delta);
+	}
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Models/Router/GenRoutedChat.h"
+
+UGenRoutedChat* UGenRoutedChat::RequestRoutedChat(UObject* WorldContextObject, const FGenRoutedChatRequest& Request, const FGenRoutingPolicy& Policy)
+{
+	UGenRoutedChat* AsyncAction = NewObject<UGenRoutedChat>();
+	AsyncAction->Request = Request;
+	AsyncAction->Policy = Policy;
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
+	return AsyncAction;
+}
+
+void UGenRoutedChat::Activate()
+{
+	CancellationToken = FGenCancellationToken::Create();
+
+	FGenRequestOptions Options;
+	Options.CancellationToken = CancellationToken;
+
+	TWeakObjectPtr<UGenRoutedChat> WeakThis(this);
+	FGenProviderRouter::Get().SendChat(Request, Policy, [WeakThis](const FString& Response, const FString& Error, bool Success, EGenAIOrgs Provider)
+	{
+		// A cleared token means the action was cancelled and must stay silent
+		UGenRoutedChat* StrongThis = WeakThis.Get();
+		if (StrongThis && StrongThis->CancellationToken.IsValid())
+		{
+			StrongThis->CancellationToken.Reset();
+			StrongThis->OnComplete.Broadcast(Response, Error, Success, Provider);
+			StrongThis->Cancel();
+		}
+	}, Options);
+}
+
+void UGenRoutedChat::Cancel()
+{
+	if (const FGenCancellationTokenPtr Token = MoveTemp(CancellationToken))
+	{
+		Token->Cancel();
+	}
+	Super::Cancel();
+}
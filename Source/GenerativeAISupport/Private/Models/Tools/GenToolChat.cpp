@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Models/Tools/GenToolChat.h"
+
+UGenToolChat* UGenToolChat::RequestToolChat(UObject* WorldContextObject, const FGenToolChatSettings& ChatSettings, const TArray<FGenFunctionTool>& Tools)
+{
+	UGenToolChat* AsyncAction = NewObject<UGenToolChat>();
+	AsyncAction->ChatSettings = ChatSettings;
+	AsyncAction->Tools = Tools;
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
+	return AsyncAction;
+}
+
+void UGenToolChat::Activate()
+{
+	const TSharedRef<FGenToolbox, ESPMode::ThreadSafe> Toolbox = MakeShared<FGenToolbox, ESPMode::ThreadSafe>();
+	for (const FGenFunctionTool& Tool : Tools)
+	{
+		Toolbox->AddFunction(Tool);
+	}
+
+	CancellationToken = FGenCancellationToken::Create();
+
+	FGenRequestOptions Options;
+	Options.CancellationToken = CancellationToken;
+
+	TWeakObjectPtr<UGenToolChat> WeakThis(this);
+	FGenToolLoop::Run(ChatSettings, Toolbox, [WeakThis](const FString& Response, const FString& Error, bool Success)
+	{
+		// A cleared token means the action was cancelled and must stay silent
+		UGenToolChat* StrongThis = WeakThis.Get();
+		if (StrongThis && StrongThis->CancellationToken.IsValid())
+		{
+			StrongThis->CancellationToken.Reset();
+			StrongThis->OnComplete.Broadcast(Response, Error, Success);
+			StrongThis->Cancel();
+		}
+	}, Options, [WeakThis](const FGenToolCall& Call, const FString& Result)
+	{
+		UGenToolChat* StrongThis = WeakThis.Get();
+		if (StrongThis && StrongThis->CancellationToken.IsValid())
+		{
+			StrongThis->OnToolCalled.Broadcast(Call.Name, Call.Arguments, Result);
+		}
+	});
+}
+
+void UGenToolChat::Cancel()
+{
+	if (const FGenCancellationTokenPtr Token = MoveTemp(CancellationToken))
+	{
+		Token->Cancel();
+	}
+	Super::Cancel();
+}
@@ -1,6 +1,9 @@
 // Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
 
 #include "Models/XAI/GenXAIChat.h"
+#include "GenAISupportRuntimeSettings.h"
+#include "Network/GenConnectionManager.h"
+#include "Network/GenRequestSubsystem.h"
 #include "Secure/GenSecureKey.h"
 #include "Http.h"
 #include "LatentActions.h"
@@ -12,41 +15,87 @@
 #include "Engine/Engine.h"  // For GEngine and screen logging
 #include "Utilities/GenGlobalDefinitions.h"
 
-void UGenXAIChat::SendChatRequest(const FGenXAIChatSettings& ChatSettings, const FOnXAIChatCompletionResponse& OnComplete)
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenXAIChat::SendChatRequest(const FGenXAIChatSettings& ChatSettings, const FOnXAIChatCompletionResponse& OnComplete,
+                                                                           const FGenCancellationTokenPtr& CancellationToken)
 {
-	MakeRequest(ChatSettings, [OnComplete](const FString& Response, const FString& Error, bool Success)
+	return MakeRequest(ChatSettings, [OnComplete](const FString& Response, const FString& Error, bool Success)
 	{
 		if (OnComplete.IsBound())
 		{
 			OnComplete.Execute(Response, Error, Success);
 		}
-	});
+	}, CancellationToken);
 }
 
 UGenXAIChat* UGenXAIChat::RequestXAIChat(UObject* WorldContextObject, const FGenXAIChatSettings& ChatSettings)
 {
 	UGenXAIChat* AsyncAction = NewObject<UGenXAIChat>();
-	AsyncAction->ChatSettings = ChatSettings;
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		// The settings are copied once into the pooled slot, the request is queued on Activate
+		TWeakObjectPtr<UGenXAIChat> WeakThis(AsyncAction);
+		FGenRequestOptions Options;
+		Options.bStartImmediately = false;
+		AsyncAction->RequestHandle = Subsystem->SubmitXAIChat(ChatSettings, [WeakThis](const FString& Response, const FString& Error, bool Success)
+		{
+			if (UGenXAIChat* StrongThis = WeakThis.Get())
+			{
+				StrongThis->RequestHandle.Reset();
+				StrongThis->OnComplete.Broadcast(Response, Error, Success);
+				StrongThis->Cancel();
+			}
+		}, Options);
+	}
+	AsyncAction->RegisterWithGameInstance(WorldContextObject);
 	return AsyncAction;
 }
 
 void UGenXAIChat::Activate()
 {
-	MakeRequest(ChatSettings, [this](const FString& Response, const FString& Error, bool Success)
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem || !RequestHandle.IsValid())
 	{
-		OnComplete.Broadcast(Response, Error, Success);
+		OnComplete.Broadcast(TEXT(""), TEXT("Request subsystem not available"), false);
 		Cancel();
-	});
+		return;
+	}
+	Subsystem->Start(RequestHandle);
+}
+
+void UGenXAIChat::Cancel()
+{
+	// Aborts the in-flight transfer and frees the request slot, no-op once the request completed
+	if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+	{
+		Subsystem->Cancel(RequestHandle);
+	}
+	RequestHandle.Reset();
+	Super::Cancel();
 }
 
-void UGenXAIChat::MakeRequest(const FGenXAIChatSettings& ChatSettings,
-                              const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+void UGenXAIChat::BeginDestroy()
+{
+	// An action that was never activated still holds its pending request slot
+	if (RequestHandle.IsValid())
+	{
+		if (UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get())
+		{
+			Subsystem->Cancel(RequestHandle);
+		}
+		RequestHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenXAIChat::MakeRequest(const FGenXAIChatSettings& ChatSettings,
+                              const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                              const FGenCancellationTokenPtr& CancellationToken)
 {
 	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::XAI);
 	if (ApiKey.IsEmpty())
 	{
 		ResponseCallback(TEXT(""), TEXT("XAI API key not set"), false);
-		return;
+		return nullptr;
 	}
 
 	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
@@ -69,7 +118,7 @@ void UGenXAIChat::MakeRequest(const FGenXAIChatSettings& ChatSettings,
 
 	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetURL(TEXT("https://api.x.ai/v1/chat/completions"));
+	HttpRequest->SetURL(GetDefault<UGenAISupportRuntimeSettings>()->GetBaseUrl(EGenAIOrgs::XAI) + TEXT("/chat/completions"));
 	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
 	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
 	HttpRequest->SetContentAsString(PayloadString);
@@ -87,7 +136,15 @@ void UGenXAIChat::MakeRequest(const FGenXAIChatSettings& ChatSettings,
 			ProcessResponse(Response->GetContentAsString(), ResponseCallback);
 		});
 
+	if (CancellationToken.IsValid() && !CancellationToken->BindRequest(HttpRequest))
+	{
+		ResponseCallback(TEXT(""), CancellationToken->GetStopReason(), false);
+		return nullptr;
+	}
+
+	FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
 	HttpRequest->ProcessRequest();
+	return HttpRequest;
 }
 
 void UGenXAIChat::ProcessResponse(const FString& ResponseStr,
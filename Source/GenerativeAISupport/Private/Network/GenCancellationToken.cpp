@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Network/GenCancellationToken.h"
+
+FGenCancellationTokenRef FGenCancellationToken::Create(double TimeoutSeconds)
+{
+	FGenCancellationTokenRef Token = MakeShared<FGenCancellationToken, ESPMode::ThreadSafe>();
+	Token->SetTimeout(TimeoutSeconds);
+	return Token;
+}
+
+FGenCancellationTokenRef FGenCancellationToken::CreateChild()
+{
+	FGenCancellationTokenRef Child = MakeShared<FGenCancellationToken, ESPMode::ThreadSafe>();
+	Child->SetDeadline(GetDeadline());
+	OnCancelled([WeakChild = TWeakPtr<FGenCancellationToken, ESPMode::ThreadSafe>(Child)]()
+	{
+		if (const FGenCancellationTokenPtr PinnedChild = WeakChild.Pin())
+		{
+			PinnedChild->Cancel();
+		}
+	});
+	return Child;
+}
+
+void FGenCancellationToken::Cancel()
+{
+	if (bCancelled.exchange(true))
+	{
+		return;
+	}
+
+	TArray<TFunction<void()>> Callbacks;
+	{
+		FScopeLock ScopeLock(&CallbacksLock);
+		Callbacks = MoveTemp(CancelCallbacks);
+	}
+
+	for (TFunction<void()>& Callback : Callbacks)
+	{
+		Callback();
+	}
+}
+
+double FGenCancellationToken::GetRemainingSeconds() const
+{
+	const double CurrentDeadline = Deadline;
+	return CurrentDeadline > 0.0 ? CurrentDeadline - FPlatformTime::Seconds() : -1.0;
+}
+
+void FGenCancellationToken::OnCancelled(TFunction<void()>&& Callback)
+{
+	{
+		FScopeLock ScopeLock(&CallbacksLock);
+		if (!bCancelled)
+		{
+			CancelCallbacks.Add(MoveTemp(Callback));
+			return;
+		}
+	}
+	Callback();
+}
+
+bool FGenCancellationToken::BindRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest)
+{
+	if (bCancelled || IsExpired())
+	{
+		return false;
+	}
+
+	if (HasDeadline())
+	{
+		HttpRequest->SetTimeout(static_cast<float>(GetRemainingSeconds()));
+	}
+
+	TWeakPtr<IHttpRequest, ESPMode::ThreadSafe> WeakRequest = HttpRequest;
+	OnCancelled([WeakRequest]()
+	{
+		if (const TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request = WeakRequest.Pin())
+		{
+			if (!EHttpRequestStatus::IsFinished(Request->GetStatus()))
+			{
+				Request->CancelRequest();
+			}
+		}
+	});
+	return true;
+}
+
+FString FGenCancellationToken::GetStopReason() const
+{
+	return bCancelled ? TEXT("Request cancelled") : TEXT("Request deadline exceeded");
+}
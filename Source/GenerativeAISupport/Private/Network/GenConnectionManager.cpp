@@ -0,0 +1,275 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Network/GenConnectionManager.h"
+
+#include "GenAISupportRuntimeSettings.h"
+#include "HttpModule.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/CoreDelegates.h"
+#include "Secure/GenSecureKey.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+FGenConnectionManager* FGenConnectionManager::Singleton = nullptr;
+
+static FAutoConsoleCommand GenConnectionStatsCommand(
+	TEXT("GenAI.Connections.Stats"),
+	TEXT("Logs request, estimated connection reuse and ping counters for every provider host"),
+	FConsoleCommandDelegate::CreateLambda([]() { FGenConnectionManager::Get().LogStats(); }));
+
+static FAutoConsoleCommand GenConnectionPrewarmCommand(
+	TEXT("GenAI.Connections.Prewarm"),
+	TEXT("Opens connections to every configured endpoint of the providers with an API key"),
+	FConsoleCommandDelegate::CreateLambda([]() { FGenConnectionManager::Get().PrewarmAll(); }));
+
+FGenConnectionManager& FGenConnectionManager::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenConnectionManager();
+	}
+	return *Singleton;
+}
+
+void FGenConnectionManager::Initialize()
+{
+	if (IsRunningCommandlet() || TickHandle.IsValid())
+	{
+		return;
+	}
+
+	// The HTTP module is not guaranteed to be usable this early in module startup,
+	// so warm-up waits for the engine loop unless it is already running
+	auto Start = [this]()
+	{
+		// Ticks often enough for the short keep-alive interval of LAN servers
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FGenConnectionManager::Tick), 0.5f);
+
+		if (GetDefault<UGenAISupportRuntimeSettings>()->bPrewarmConnectionsOnStartup)
+		{
+			PrewarmAll();
+		}
+	};
+
+	if (GIsRunning)
+	{
+		Start();
+	}
+	else
+	{
+		EngineInitHandle = FCoreDelegates::OnFEngineLoopInitComplete.AddLambda(Start);
+	}
+}
+
+void FGenConnectionManager::Shutdown()
+{
+	if (EngineInitHandle.IsValid())
+	{
+		FCoreDelegates::OnFEngineLoopInitComplete.Remove(EngineInitHandle);
+		EngineInitHandle.Reset();
+	}
+
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+}
+
+void FGenConnectionManager::PrewarmAll()
+{
+	for (const FGenConnectionEndpoint& Endpoint : GetDefault<UGenAISupportRuntimeSettings>()->WarmEndpoints)
+	{
+		if (HasApiKey(Endpoint.Org))
+		{
+			PrewarmUrl(Endpoint.WarmUrl, Endpoint.PoolSize, Endpoint.PingIntervalSeconds);
+		}
+	}
+	PrewarmLocal();
+}
+
+void FGenConnectionManager::Prewarm(EGenAIOrgs Org)
+{
+	for (const FGenConnectionEndpoint& Endpoint : GetDefault<UGenAISupportRuntimeSettings>()->WarmEndpoints)
+	{
+		if (Endpoint.Org == Org && HasApiKey(Org))
+		{
+			PrewarmUrl(Endpoint.WarmUrl, Endpoint.PoolSize, Endpoint.PingIntervalSeconds);
+		}
+	}
+
+	if (Org == EGenAIOrgs::Local)
+	{
+		PrewarmLocal();
+	}
+}
+
+void FGenConnectionManager::PrewarmLocal()
+{
+	// The local server is configured in its own settings rather than through WarmEndpoints
+	const UGenAISupportRuntimeSettings* Settings = GetDefault<UGenAISupportRuntimeSettings>();
+	const FString BaseUrl = Settings->GetBaseUrl(EGenAIOrgs::Local);
+	if (Settings->bEnableLocalProvider && !BaseUrl.IsEmpty())
+	{
+		PrewarmUrl(BaseUrl + TEXT("/models"), Settings->LocalConnectionPoolSize, Settings->LocalKeepAlivePingIntervalSeconds);
+	}
+}
+
+bool FGenConnectionManager::HasApiKey(EGenAIOrgs Org)
+{
+	// A provider the game never authenticates against has no requests to speed up, so its host is left alone
+	return !UGenSecureKey::GetGenerativeAIApiKey(Org).IsEmpty();
+}
+
+void FGenConnectionManager::PrewarmUrl(const FString& Url, int32 PoolSize, float PingIntervalSeconds)
+{
+	const FString Origin = GetOrigin(Url);
+	if (Origin.IsEmpty())
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Cannot pre-warm invalid URL: %s"), *Url);
+		return;
+	}
+
+	PoolSize = FMath::Clamp(PoolSize, 1, 16);
+	{
+		FScopeLock ScopeLock(&HostsLock);
+		FHostState& State = Hosts.FindOrAdd(Origin);
+		State.WarmUrl = Url;
+		State.PoolSize = PoolSize;
+		State.PingInterval = PingIntervalSeconds;
+		State.bKeepAlive = true;
+		State.Stats.Origin = Origin;
+	}
+
+	SendPings(Origin, Url, PoolSize);
+}
+
+void FGenConnectionManager::NotifyRequestIssued(const FString& Url)
+{
+	const FString Origin = GetOrigin(Url);
+	const double Now = FPlatformTime::Seconds();
+	const double Lifetime = GetDefault<UGenAISupportRuntimeSettings>()->IdleConnectionLifetimeSeconds;
+
+	FScopeLock ScopeLock(&HostsLock);
+	FHostState& State = Hosts.FindOrAdd(Origin);
+	State.Stats.Origin = Origin;
+	State.Stats.Requests++;
+	if (State.bHasConnection && Now - State.LastActivityTime < Lifetime)
+	{
+		State.Stats.EstimatedReusedRequests++;
+	}
+
+	// Whatever happens to this request, the backend is about to hold a fresh connection to the host
+	State.bHasConnection = true;
+	State.LastActivityTime = Now;
+}
+
+TArray<FGenConnectionStats> FGenConnectionManager::GetStats() const
+{
+	FScopeLock ScopeLock(&HostsLock);
+	TArray<FGenConnectionStats> Result;
+	Result.Reserve(Hosts.Num());
+	for (const TPair<FString, FHostState>& Pair : Hosts)
+	{
+		Result.Add(Pair.Value.Stats);
+	}
+	return Result;
+}
+
+void FGenConnectionManager::LogStats() const
+{
+	for (const FGenConnectionStats& Stats : GetStats())
+	{
+		UE_LOG(LogGenAI, Display, TEXT("%s: %lld requests, ~%.1f%% estimated reused, %lld pings, last ping %.1f ms"),
+		       *Stats.Origin, Stats.Requests, Stats.GetEstimatedReuseRatio() * 100.0, Stats.Pings, Stats.LastPingMs);
+	}
+}
+
+bool FGenConnectionManager::Tick(float DeltaTime)
+{
+	const UGenAISupportRuntimeSettings* Settings = GetDefault<UGenAISupportRuntimeSettings>();
+	const double Now = FPlatformTime::Seconds();
+	TArray<TPair<FString, FHostState>> DueHosts;
+	{
+		FScopeLock ScopeLock(&HostsLock);
+		for (const TPair<FString, FHostState>& Pair : Hosts)
+		{
+			const FHostState& State = Pair.Value;
+			const float Interval = State.PingInterval > 0.0f ? State.PingInterval : Settings->KeepAlivePingIntervalSeconds;
+			if (Interval > 0.0f && State.bKeepAlive && State.PingsInFlight == 0 && !State.WarmUrl.IsEmpty()
+				&& Now - State.LastActivityTime >= Interval)
+			{
+				DueHosts.Add(Pair);
+			}
+		}
+	}
+
+	for (const TPair<FString, FHostState>& Pair : DueHosts)
+	{
+		SendPings(Pair.Key, Pair.Value.WarmUrl, Pair.Value.PoolSize);
+	}
+	return true;
+}
+
+void FGenConnectionManager::SendPings(const FString& Origin, const FString& Url, int32 Count)
+{
+	{
+		FScopeLock ScopeLock(&HostsLock);
+		FHostState& State = Hosts.FindOrAdd(Origin);
+		State.PingsInFlight += Count;
+		State.Stats.Pings += Count;
+		State.LastActivityTime = FPlatformTime::Seconds();
+	}
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		// HEAD without credentials, the status code does not matter, only that the connection got established
+		const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+		HttpRequest->SetVerb(TEXT("HEAD"));
+		HttpRequest->SetURL(Url);
+		HttpRequest->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+		HttpRequest->SetTimeout(10.0f);
+		HttpRequest->OnProcessRequestComplete().BindLambda(
+			[this, Origin](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+			{
+				FScopeLock ScopeLock(&HostsLock);
+				FHostState& State = Hosts.FindOrAdd(Origin);
+				State.PingsInFlight = FMath::Max(0, State.PingsInFlight - 1);
+				if (bSuccess && Response.IsValid())
+				{
+					State.bHasConnection = true;
+					State.LastActivityTime = FPlatformTime::Seconds();
+					State.Stats.LastPingMs = Request.IsValid() ? Request->GetElapsedTime() * 1000.0 : 0.0;
+				}
+				else
+				{
+					State.bHasConnection = false;
+					UE_LOG(LogGenAI, Warning, TEXT("Connection warm-up to %s failed"), *Origin);
+				}
+			});
+		HttpRequest->ProcessRequest();
+	}
+}
+
+FString FGenConnectionManager::GetOrigin(const FString& Url)
+{
+	// scheme://authority, keeping the port so local stand-in servers get their own entry
+	const int32 SchemeEnd = Url.Find(TEXT("://"));
+	if (SchemeEnd == INDEX_NONE)
+	{
+		return FString();
+	}
+
+	const int32 AuthorityStart = SchemeEnd + 3;
+	int32 PathStart = Url.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, AuthorityStart);
+	if (PathStart == INDEX_NONE)
+	{
+		PathStart = Url.Len();
+	}
+	return Url.Left(PathStart).ToLower();
+}
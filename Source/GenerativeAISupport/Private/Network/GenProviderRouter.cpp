@@ -0,0 +1,374 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Network/GenProviderRouter.h"
+
+#include "GenAISupportRuntimeSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Secure/GenSecureKey.h"
+#include "Tokenizer/GenTokenizer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+FGenProviderRouter* FGenProviderRouter::Singleton = nullptr;
+
+static FAutoConsoleCommand GenRouterStatsCommand(
+	TEXT("GenAI.Router.Stats"),
+	TEXT("Logs the latency and error averages the provider router ranks backends by"),
+	FConsoleCommandDelegate::CreateLambda([]() { FGenProviderRouter::Get().LogStats(); }));
+
+namespace GenProviderRouter
+{
+	static const EGenAIOrgs RoutableProviders[] = { EGenAIOrgs::OpenAI, EGenAIOrgs::Anthropic, EGenAIOrgs::DeepSeek, EGenAIOrgs::XAI, EGenAIOrgs::Local };
+
+	static bool IsRoutable(EGenAIOrgs Org)
+	{
+		for (const EGenAIOrgs Routable : RoutableProviders)
+		{
+			if (Routable == Org)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Cloud providers need a key, the local server only needs to be enabled since it may run without authentication */
+	static bool IsConfigured(EGenAIOrgs Org)
+	{
+		if (Org == EGenAIOrgs::Local)
+		{
+			const UGenAISupportRuntimeSettings* Settings = GetDefault<UGenAISupportRuntimeSettings>();
+			return Settings->bEnableLocalProvider && !Settings->GetBaseUrl(EGenAIOrgs::Local).IsEmpty();
+		}
+		return !UGenSecureKey::GetGenerativeAIApiKey(Org).IsEmpty();
+	}
+
+	static FString GetOrgName(EGenAIOrgs Org)
+	{
+		return StaticEnum<EGenAIOrgs>()->GetNameStringByValue(static_cast<int64>(Org));
+	}
+}
+
+struct FGenProviderRouter::FRoutedRequest
+{
+	FGenRoutedChatRequest Request;
+	FGenRoutingPolicy Policy;
+	FGenRoutedChatCallback OnComplete;
+	EGenRequestPriority Priority = EGenRequestPriority::Normal;
+	FGenCancellationTokenPtr CancellationToken;
+	TArray<EGenAIOrgs> Candidates;
+	int32 NextCandidate = 0;
+	FString LastError;
+	EGenAIOrgs LastOrg = EGenAIOrgs::Unknown;
+};
+
+FGenProviderRouter& FGenProviderRouter::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenProviderRouter();
+	}
+	return *Singleton;
+}
+
+void FGenProviderRouter::SendChat(const FGenRoutedChatRequest& Request, const FGenRoutingPolicy& Policy, FGenRoutedChatCallback&& OnComplete,
+                                  const FGenRequestOptions& Options)
+{
+	check(IsInGameThread());
+
+	const TSharedRef<FRoutedRequest> Routed = MakeShared<FRoutedRequest>();
+	Routed->Request = Request;
+	Routed->Policy = Policy;
+	Routed->OnComplete = MoveTemp(OnComplete);
+	Routed->Priority = Options.Priority;
+
+	// The caller's token stays untouched, the request deadline lives on a child
+	Routed->CancellationToken = Options.CancellationToken.IsValid()
+		                            ? Options.CancellationToken->CreateChild()
+		                            : FGenCancellationToken::Create();
+	if (Options.TimeoutSeconds > 0.0)
+	{
+		const double Deadline = FPlatformTime::Seconds() + Options.TimeoutSeconds;
+		const bool bTighter = !Routed->CancellationToken->HasDeadline() || Deadline < Routed->CancellationToken->GetDeadline();
+		if (bTighter)
+		{
+			Routed->CancellationToken->SetDeadline(Deadline);
+		}
+	}
+
+	Routed->Candidates = RankProviders(Request, Policy);
+	if (Policy.MaxAttempts > 0 && Routed->Candidates.Num() > Policy.MaxAttempts)
+	{
+		Routed->Candidates.SetNum(Policy.MaxAttempts);
+	}
+
+	if (Routed->Candidates.Num() == 0)
+	{
+		Routed->OnComplete(TEXT(""), TEXT("No provider satisfies the routing policy"), false, EGenAIOrgs::Unknown);
+		return;
+	}
+
+	Dispatch(Routed);
+}
+
+void FGenProviderRouter::Dispatch(const TSharedRef<FRoutedRequest>& Routed)
+{
+	const FGenCancellationTokenRef RequestToken = Routed->CancellationToken.ToSharedRef();
+	if (RequestToken->IsCancelled() || RequestToken->IsExpired())
+	{
+		Routed->OnComplete(TEXT(""), RequestToken->GetStopReason(), false, Routed->LastOrg);
+		return;
+	}
+
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem || Routed->NextCandidate >= Routed->Candidates.Num())
+	{
+		const FString Error = !Subsystem ? TEXT("Request subsystem not available")
+			                      : Routed->LastError.IsEmpty() ? TEXT("Every provider failed") : Routed->LastError;
+		Routed->OnComplete(TEXT(""), Error, false, Routed->LastOrg);
+		return;
+	}
+
+	const EGenAIOrgs Org = Routed->Candidates[Routed->NextCandidate++];
+	Routed->LastOrg = Org;
+	const double SLO = Routed->Policy.LatencySLOSeconds;
+
+	// A request queued behind a saturated provider would only start after the others finished, with an SLO the next
+	// candidate is tried instead. Saturation says nothing about the provider's health, so nothing is recorded
+	const bool bHasFallback = Routed->NextCandidate < Routed->Candidates.Num();
+	if (SLO > 0.0 && bHasFallback && Subsystem->GetNumQueued(Org) > 0)
+	{
+		Routed->LastError = FString::Printf(TEXT("%s is saturated"), *GenProviderRouter::GetOrgName(Org));
+		UE_LOG(LogGenAI, Log, TEXT("Routed request skipped a provider: %s"), *Routed->LastError);
+		Dispatch(Routed);
+		return;
+	}
+
+	// Each attempt is bounded by the SLO and by what is left of the request's own deadline. The deadline is set on the
+	// attempt token so that it also covers the time spent queued, the subsystem fails a waiting request once it passes
+	const FGenCancellationTokenRef AttemptToken = RequestToken->CreateChild();
+	if (SLO > 0.0)
+	{
+		const double Deadline = FPlatformTime::Seconds() + SLO;
+		if (!AttemptToken->HasDeadline() || Deadline < AttemptToken->GetDeadline())
+		{
+			AttemptToken->SetDeadline(Deadline);
+		}
+	}
+	FGenRequestOptions AttemptOptions;
+	AttemptOptions.Priority = Routed->Priority;
+	AttemptOptions.CancellationToken = AttemptToken;
+
+	const double StartTime = FPlatformTime::Seconds();
+	Submit(*Subsystem, Org, Routed->Request, [this, Routed, Org, StartTime, AttemptToken, SLO](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		if (Routed->CancellationToken->IsCancelled())
+		{
+			// Cancelled by the caller, says nothing about the provider
+			Routed->OnComplete(TEXT(""), Routed->CancellationToken->GetStopReason(), false, Org);
+			return;
+		}
+
+		const double Latency = FPlatformTime::Seconds() - StartTime;
+		const bool bTimedOut = !bSuccess && AttemptToken->IsExpired();
+		RecordResult(Org, bTimedOut ? FMath::Max(Latency, SLO) : Latency, bSuccess);
+
+		if (bSuccess)
+		{
+			Routed->OnComplete(Response, TEXT(""), true, Org);
+			return;
+		}
+
+		Routed->LastError = bTimedOut
+			                    ? FString::Printf(TEXT("%s did not answer within %.1f seconds"), *GenProviderRouter::GetOrgName(Org), Latency)
+			                    : FString::Printf(TEXT("%s: %s"), *GenProviderRouter::GetOrgName(Org), *Error);
+		UE_LOG(LogGenAI, Warning, TEXT("Routed request failed over: %s"), *Routed->LastError);
+		Dispatch(Routed);
+	}, AttemptOptions);
+}
+
+FGenRequestHandle FGenProviderRouter::Submit(UGenRequestSubsystem& Subsystem, EGenAIOrgs Org, const FGenRoutedChatRequest& Request,
+                                             FGenRequestCallback&& OnDone, const FGenRequestOptions& Options)
+{
+	switch (Org)
+	{
+	case EGenAIOrgs::OpenAI:
+		{
+			FGenChatSettings ChatSettings;
+			ChatSettings.ModelEnum = Request.OpenAIModel;
+			ChatSettings.UpdateModel();
+			ChatSettings.MaxTokens = Request.MaxTokens;
+			ChatSettings.Temperature = Request.Temperature;
+			ChatSettings.Messages = Request.Messages;
+			return Subsystem.SubmitOpenAIChat(MoveTemp(ChatSettings), MoveTemp(OnDone), Options);
+		}
+
+	case EGenAIOrgs::Anthropic:
+		{
+			FGenClaudeChatSettings ChatSettings;
+			ChatSettings.Model = Request.ClaudeModel;
+			ChatSettings.MaxTokens = Request.MaxTokens;
+			ChatSettings.Temperature = Request.Temperature;
+			ChatSettings.Messages = Request.Messages;
+			return Subsystem.SubmitClaudeChat(MoveTemp(ChatSettings), MoveTemp(OnDone), Options);
+		}
+
+	case EGenAIOrgs::DeepSeek:
+		{
+			FGenDSeekChatSettings ChatSettings;
+			ChatSettings.Model = Request.DeepSeekModel;
+			ChatSettings.MaxTokens = Request.MaxTokens;
+			ChatSettings.Temperature = Request.Temperature;
+			ChatSettings.Messages = Request.Messages;
+			return Subsystem.SubmitDeepSeekChat(MoveTemp(ChatSettings), MoveTemp(OnDone), Options);
+		}
+
+	case EGenAIOrgs::XAI:
+		{
+			FGenXAIChatSettings ChatSettings;
+			ChatSettings.Model = Request.XAIModel;
+			ChatSettings.MaxTokens = Request.MaxTokens;
+			for (const FGenChatMessage& Message : Request.Messages)
+			{
+				FGenXAIMessage& XAIMessage = ChatSettings.Messages.AddDefaulted_GetRef();
+				XAIMessage.Role = Message.Role;
+				XAIMessage.Content = Message.Content;
+			}
+			return Subsystem.SubmitXAIChat(MoveTemp(ChatSettings), MoveTemp(OnDone), Options);
+		}
+
+	case EGenAIOrgs::Local:
+		{
+			// Streaming only pays off with a delta consumer, routed requests report the full text
+			FGenLocalChatSettings ChatSettings;
+			ChatSettings.Model = Request.LocalModel;
+			ChatSettings.MaxTokens = Request.MaxTokens;
+			ChatSettings.Temperature = Request.Temperature;
+			ChatSettings.Messages = Request.Messages;
+			ChatSettings.bStreamResponse = false;
+			return Subsystem.SubmitLocalChat(MoveTemp(ChatSettings), MoveTemp(OnDone), Options);
+		}
+
+	default:
+		OnDone(TEXT(""), FString::Printf(TEXT("%s cannot be routed to"), *GenProviderRouter::GetOrgName(Org)), false);
+		return FGenRequestHandle();
+	}
+}
+
+TArray<EGenAIOrgs> FGenProviderRouter::RankProviders(const FGenRoutedChatRequest& Request, const FGenRoutingPolicy& Policy) const
+{
+	const double Now = FPlatformTime::Seconds();
+	const double SLO = Policy.LatencySLOSeconds;
+
+	TArray<EGenAIOrgs> Pool = Policy.Providers;
+	if (Pool.Num() == 0)
+	{
+		Pool.Append(GenProviderRouter::RoutableProviders, UE_ARRAY_COUNT(GenProviderRouter::RoutableProviders));
+	}
+
+	// Within SLO and not erroring keep the policy's order, the rest follow from least to most troubled
+	TArray<EGenAIOrgs> Healthy;
+	TArray<EGenAIOrgs> Degraded;
+	TArray<EGenAIOrgs> CoolingDown;
+	for (const EGenAIOrgs Org : Pool)
+	{
+		if (!GenProviderRouter::IsRoutable(Org) || Healthy.Contains(Org) || Degraded.Contains(Org) || CoolingDown.Contains(Org)
+			|| !GenProviderRouter::IsConfigured(Org)
+			|| (Policy.MaxCostPerRequest > 0.0f && EstimateCost(Org, Request) > Policy.MaxCostPerRequest))
+		{
+			continue;
+		}
+
+		const FGenProviderHealth* ProviderHealth = Health.Find(Org);
+		if (!ProviderHealth || ProviderHealth->Requests == 0)
+		{
+			Healthy.Add(Org);
+		}
+		else if (ProviderHealth->CooldownUntil > Now)
+		{
+			CoolingDown.Add(Org);
+		}
+		else if (ProviderHealth->ErrorEwma >= 0.5 || (SLO > 0.0 && ProviderHealth->LatencyEwmaSeconds > SLO))
+		{
+			Degraded.Add(Org);
+		}
+		else
+		{
+			Healthy.Add(Org);
+		}
+	}
+
+	auto ByTrouble = [this](EGenAIOrgs A, EGenAIOrgs B)
+	{
+		const FGenProviderHealth& HealthA = Health.FindChecked(A);
+		const FGenProviderHealth& HealthB = Health.FindChecked(B);
+		return HealthA.LatencyEwmaSeconds * (1.0 + 4.0 * HealthA.ErrorEwma) < HealthB.LatencyEwmaSeconds * (1.0 + 4.0 * HealthB.ErrorEwma);
+	};
+	Degraded.StableSort(ByTrouble);
+	CoolingDown.StableSort([this](EGenAIOrgs A, EGenAIOrgs B) { return Health.FindChecked(A).CooldownUntil < Health.FindChecked(B).CooldownUntil; });
+
+	Healthy.Append(Degraded);
+	Healthy.Append(CoolingDown);
+	return Healthy;
+}
+
+FGenProviderHealth FGenProviderRouter::GetHealth(EGenAIOrgs Org) const
+{
+	const FGenProviderHealth* ProviderHealth = Health.Find(Org);
+	return ProviderHealth ? *ProviderHealth : FGenProviderHealth();
+}
+
+void FGenProviderRouter::RecordResult(EGenAIOrgs Org, double LatencySeconds, bool bSuccess)
+{
+	const UGenAISupportRuntimeSettings* Settings = GetDefault<UGenAISupportRuntimeSettings>();
+	const double Alpha = FMath::Clamp(Settings->RouterHealthSmoothing, 0.01f, 1.0f);
+
+	FGenProviderHealth& ProviderHealth = Health.FindOrAdd(Org);
+	ProviderHealth.LatencyEwmaSeconds = ProviderHealth.Requests == 0 ? LatencySeconds : FMath::Lerp(ProviderHealth.LatencyEwmaSeconds, LatencySeconds, Alpha);
+	ProviderHealth.ErrorEwma = FMath::Lerp(ProviderHealth.ErrorEwma, bSuccess ? 0.0 : 1.0, Alpha);
+	ProviderHealth.Requests++;
+
+	if (bSuccess)
+	{
+		ProviderHealth.ConsecutiveFailures = 0;
+		ProviderHealth.CooldownUntil = 0.0;
+	}
+	else if (++ProviderHealth.ConsecutiveFailures >= Settings->RouterFailuresBeforeCooldown)
+	{
+		ProviderHealth.CooldownUntil = FPlatformTime::Seconds() + Settings->RouterCooldownSeconds;
+		UE_LOG(LogGenAI, Warning, TEXT("%s failed %d times in a row, routing around it for %.0f seconds"),
+		       *GenProviderRouter::GetOrgName(Org), ProviderHealth.ConsecutiveFailures, Settings->RouterCooldownSeconds);
+	}
+}
+
+double FGenProviderRouter::EstimateCost(EGenAIOrgs Org, const FGenRoutedChatRequest& Request)
+{
+	const FGenProviderPricing* Pricing = GetDefault<UGenAISupportRuntimeSettings>()->ProviderPricing.FindByPredicate(
+		[Org](const FGenProviderPricing& Entry) { return Entry.Org == Org; });
+	if (!Pricing)
+	{
+		return 0.0;
+	}
+
+	const EGenTokenizerEncoding Encoding = Org == EGenAIOrgs::OpenAI ? FGenBPETokenizer::GetEncodingForModel(UGenOAIModelUtils::ChatModelToString(Request.OpenAIModel))
+		                                       : Org == EGenAIOrgs::Anthropic ? EGenTokenizerEncoding::Claude
+		                                       : EGenTokenizerEncoding::CL100K;
+	const int32 PromptTokens = FGenBPETokenizer::Get(Encoding)->CountChatTokens(Request.Messages);
+	return (PromptTokens * static_cast<double>(Pricing->InputCostPerMillionTokens)
+		+ FMath::Max(Request.MaxTokens, 0) * static_cast<double>(Pricing->OutputCostPerMillionTokens)) / 1000000.0;
+}
+
+void FGenProviderRouter::LogStats() const
+{
+	const double Now = FPlatformTime::Seconds();
+	for (const EGenAIOrgs Org : GenProviderRouter::RoutableProviders)
+	{
+		const FGenProviderHealth ProviderHealth = GetHealth(Org);
+		UE_LOG(LogGenAI, Log, TEXT("%s: %lld requests, latency %.0f ms, error rate %.1f%%%s"),
+		       *GenProviderRouter::GetOrgName(Org), ProviderHealth.Requests, ProviderHealth.LatencyEwmaSeconds * 1000.0,
+		       ProviderHealth.ErrorEwma * 100.0,
+		       ProviderHealth.CooldownUntil > Now ? *FString::Printf(TEXT(", cooling down for %.0f s"), ProviderHealth.CooldownUntil - Now) : TEXT(""));
+	}
+}
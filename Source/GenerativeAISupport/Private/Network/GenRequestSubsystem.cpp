@@ -0,0 +1,618 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Network/GenRequestSubsystem.h"
+
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "GenAISupportRuntimeSettings.h"
+#include "Models/Anthropic/GenClaudeChat.h"
+#include "Models/DeepSeek/GenDSeekChat.h"
+#include "Models/OpenAI/GenOAIChat.h"
+#include "Models/OpenAI/GenOAISpeech.h"
+#include "Models/OpenAI/GenOAIStructuredOpService.h"
+#include "Models/XAI/GenXAIChat.h"
+#include "Retrieval/GenSemanticCache.h"
+
+namespace GenRequestSubsystem
+{
+	static bool HasImages(const TArray<FGenChatMessage>& Messages)
+	{
+		return Messages.ContainsByPredicate([](const FGenChatMessage& Message) { return Message.Images.Num() > 0; });
+	}
+
+	/** Options that also keep the image textures alive, the launcher only holds them in a copy of the messages */
+	static FGenRequestOptions WithImageObjects(const FGenRequestOptions& Options, const TArray<FGenChatMessage>& Messages)
+	{
+		FGenRequestOptions Result = Options;
+		for (const FGenChatMessage& Message : Messages)
+		{
+			for (const FGenChatImage& Image : Message.Images)
+			{
+				if (Image.Texture)
+				{
+					Result.ReferencedObjects.Add(Image.Texture);
+				}
+				if (Image.RenderTarget)
+				{
+					Result.ReferencedObjects.Add(Image.RenderTarget);
+				}
+			}
+		}
+		return Result;
+	}
+}
+
+UGenRequestSubsystem* UGenRequestSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UGenRequestSubsystem>() : nullptr;
+}
+
+void UGenRequestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Deadlines are coarse, a few checks a second is plenty
+	SweepHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UGenRequestSubsystem::SweepExpired), 0.25f);
+}
+
+void UGenRequestSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(SweepHandle);
+	SweepHandle.Reset();
+
+	// Nothing queued may start while the in-flight requests are being cancelled
+	bShuttingDown = true;
+	for (TPair<EGenAIOrgs, FProviderQueue>& Pair : Queues)
+	{
+		for (const int32 Index : Pair.Value.Queued)
+		{
+			Slots[Index].State = ESlotState::Pending;
+		}
+		Pair.Value.Queued.Reset();
+	}
+
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		if (Slots[Index].State != ESlotState::Free && Slots[Index].CancellationToken.IsValid())
+		{
+			Slots[Index].CancellationToken->Cancel();
+		}
+	}
+	Slots.Empty();
+	FreeSlots.Empty();
+	Queues.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGenRequestSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	UGenRequestSubsystem* This = CastChecked<UGenRequestSubsystem>(InThis);
+	for (FRequestSlot& Slot : This->Slots)
+	{
+		if (Slot.State != ESlotState::Free)
+		{
+			Collector.AddReferencedObjects(Slot.ReferencedObjects);
+		}
+	}
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
+FGenRequestHandle UGenRequestSubsystem::Submit(EGenAIOrgs Org, FGenRequestLauncher&& Launcher, FGenRequestCallback&& OnComplete,
+                                               const FGenRequestOptions& Options)
+{
+	check(IsInGameThread());
+
+	const int32 Index = FreeSlots.Num() > 0 ? FreeSlots.Pop() : Slots.AddDefaulted();
+	FRequestSlot& Slot = Slots[Index];
+	Slot.Serial++;
+	Slot.State = ESlotState::Pending;
+	Slot.Org = Org;
+	Slot.Priority = Options.Priority;
+	Slot.SubmitTime = FPlatformTime::Seconds();
+	Slot.Launcher = MoveTemp(Launcher);
+	Slot.OnComplete = MoveTemp(OnComplete);
+	Slot.ReferencedObjects = Options.ReferencedObjects;
+	// The caller's token may be shared by several requests, the timeout and Cancel() only apply to this one
+	Slot.CancellationToken = Options.CancellationToken.IsValid() ? Options.CancellationToken->CreateChild() : FGenCancellationToken::Create();
+	if (Options.TimeoutSeconds > 0.0)
+	{
+		const double Deadline = FPlatformTime::Seconds() + Options.TimeoutSeconds;
+		if (!Slot.CancellationToken->HasDeadline() || Deadline < Slot.CancellationToken->GetDeadline())
+		{
+			Slot.CancellationToken->SetDeadline(Deadline);
+		}
+	}
+
+	FGenRequestHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Slot.Serial;
+
+	// Tokens may be cancelled from any thread, slot bookkeeping stays on the game thread
+	TWeakObjectPtr<UGenRequestSubsystem> WeakThis(this);
+	Slot.CancellationToken->OnCancelled([WeakThis, Handle]()
+	{
+		auto Release = [WeakThis, Handle]()
+		{
+			if (UGenRequestSubsystem* StrongThis = WeakThis.Get())
+			{
+				StrongThis->HandleTokenCancelled(Handle);
+			}
+		};
+
+		if (IsInGameThread())
+		{
+			Release();
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(Release));
+		}
+	});
+
+	if (Options.bStartImmediately)
+	{
+		Start(Handle);
+	}
+	return Handle;
+}
+
+FGenRequestHandle UGenRequestSubsystem::SubmitOpenAIChat(FGenChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+                                                         const FGenRequestOptions& Options)
+{
+	const FGenRequestOptions ReferencedOptions = GenRequestSubsystem::WithImageObjects(Options, ChatSettings.Messages);
+	return Submit(EGenAIOrgs::OpenAI, [ChatSettings = MoveTemp(ChatSettings)](const FGenCancellationTokenRef& Token, FGenRequestCallback&& OnDone)
+	{
+		auto Send = [ChatSettings, Token](FGenRequestCallback&& Done)
+		{
+			UGenOAIChat::SendChatRequest(ChatSettings, FOnChatCompletionResponse::CreateLambda(MoveTemp(Done)), Token);
+		};
+
+		// The cache keys on text only, a question about an image must reach the model
+		if (!ChatSettings.bUseSemanticCache || GenRequestSubsystem::HasImages(ChatSettings.Messages))
+		{
+			Send(MoveTemp(OnDone));
+			return;
+		}
+
+		FGenChatSettings ResolvedSettings = ChatSettings;
+		ResolvedSettings.UpdateModel();
+		const FString Sampling = FString::Printf(TEXT("%d|%g|%g|%s|%d|%d"), ChatSettings.MaxTokens, ChatSettings.Temperature, ChatSettings.TopP, *ChatSettings.Stop,
+		                                         static_cast<int32>(ChatSettings.ReasoningEffort), static_cast<int32>(ChatSettings.Verbosity));
+		FGenSemanticCache::Get().Fetch(EGenAIOrgs::OpenAI, ResolvedSettings.Model, Sampling, ChatSettings.Messages, Token, MoveTemp(Send), MoveTemp(OnDone));
+	}, MoveTemp(OnComplete), ReferencedOptions);
+}
+
+FGenRequestHandle UGenRequestSubsystem::SubmitOpenAIStructuredOutput(FGenOAIStructuredChatSettings StructuredChatSettings, FGenRequestCallback&& OnComplete,
+                                                                     const FGenRequestOptions& Options)
+{
+	return Submit(EGenAIOrgs::OpenAI, [StructuredChatSettings = MoveTemp(StructuredChatSettings)](const FGenCancellationTokenRef& Token, FGenRequestCallback&& OnDone)
+	{
+		UGenOAIStructuredOpService::RequestStructuredOutput(StructuredChatSettings, FOnSchemaResponse::CreateLambda(MoveTemp(OnDone)), Token);
+	}, MoveTemp(OnComplete), Options);
+}
+
+FGenRequestHandle UGenRequestSubsystem::SubmitClaudeChat(FGenClaudeChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+                                                         const FGenRequestOptions& Options)
+{
+	const FGenRequestOptions ReferencedOptions = GenRequestSubsystem::WithImageObjects(Options, ChatSettings.Messages);
+	return Submit(EGenAIOrgs::Anthropic, [ChatSettings = MoveTemp(ChatSettings)](const FGenCancellationTokenRef& Token, FGenRequestCallback&& OnDone)
+	{
+		auto Send = [ChatSettings, Token](FGenRequestCallback&& Done)
+		{
+			UGenClaudeChat::SendChatRequest(ChatSettings, FOnClaudeChatCompletionResponse::CreateLambda(MoveTemp(Done)), Token);
+		};
+
+		// The cache keys on text only, a question about an image must reach the model
+		if (!ChatSettings.bUseSemanticCache || GenRequestSubsystem::HasImages(ChatSettings.Messages))
+		{
+			Send(MoveTemp(OnDone));
+			return;
+		}
+
+		const FString Model = StaticEnum<EClaudeModels>()->GetNameStringByValue(static_cast<int64>(ChatSettings.Model));
+		const FString Sampling = FString::Printf(TEXT("%d|%g"), ChatSettings.MaxTokens, ChatSettings.Temperature);
+		FGenSemanticCache::Get().Fetch(EGenAIOrgs::Anthropic, Model, Sampling, ChatSettings.Messages, Token, MoveTemp(Send), MoveTemp(OnDone));
+	}, MoveTemp(OnComplete), ReferencedOptions);
+}
+
+FGenRequestHandle UGenRequestSubsystem::SubmitDeepSeekChat(FGenDSeekChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+                                                           const FGenRequestOptions& Options)
+{
+	return Submit(EGenAIOrgs::DeepSeek, [ChatSettings = MoveTemp(ChatSettings)](const FGenCancellationTokenRef& Token, FGenRequestCallback&& OnDone)
+	{
+		UGenDSeekChat::SendChatRequest(ChatSettings, FOnDSeekChatCompletionResponse::CreateLambda(MoveTemp(OnDone)), Token);
+	}, MoveTemp(OnComplete), Options);
+}
+
+FGenRequestHandle UGenRequestSubsystem::SubmitXAIChat(FGenXAIChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+                                                      const FGenRequestOptions& Options)
+{
+	return Submit(EGenAIOrgs::XAI, [ChatSettings = MoveTemp(ChatSettings)](const FGenCancellationTokenRef& Token, FGenRequestCallback&& OnDone)
+	{
+		UGenXAIChat::SendChatRequest(ChatSettings, FOnXAIChatCompletionResponse::CreateLambda(MoveTemp(OnDone)), Token);
+	}, MoveTemp(OnComplete), Options);
+}
+
+FGenRequestHandle UGenRequestSubsystem::SubmitLocalChat(FGenLocalChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+                                                        const FGenRequestOptions& Options, TFunction<void(const FString&)>&& OnDelta)
+{
+	const FGenRequestOptions ReferencedOptions = GenRequestSubsystem::WithImageObjects(Options, ChatSettings.Messages);
+	return Submit(EGenAIOrgs::Local, [ChatSettings = MoveTemp(ChatSettings), OnDelta = MoveTemp(OnDelta)](const FGenCancellationTokenRef& Token, FGenRequestCallback&& OnDone)
+	{
+		FOnLocalChatDelta DeltaDelegate;
+		if (OnDelta)
+		{
+			DeltaDelegate.BindLambda(OnDelta);
+		}
+		UGenLocalChat::SendChatRequest(ChatSettings, FOnLocalChatCompletionResponse::CreateLambda(MoveTemp(OnDone)), Token, DeltaDelegate);
+	}, MoveTemp(OnComplete), ReferencedOptions);
+}
+
+FGenRequestHandle UGenRequestSubsystem::SubmitOpenAISpeech(FGenOAISpeechSettings SpeechSettings, const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& Buffer, FGenRequestCallback&& OnComplete,
+                                                           const FGenRequestOptions& Options, TFunction<void()>&& OnAudioStarted)
+{
+	return Submit(EGenAIOrgs::OpenAI, [SpeechSettings = MoveTemp(SpeechSettings), Buffer, OnAudioStarted = MoveTemp(OnAudioStarted)](const FGenCancellationTokenRef& Token, FGenRequestCallback&& OnDone)
+	{
+		FSimpleDelegate StartedDelegate;
+		if (OnAudioStarted)
+		{
+			StartedDelegate.BindLambda(OnAudioStarted);
+		}
+		UGenOAISpeech::SendSpeechRequest(SpeechSettings, Buffer, FOnSpeechCompletionResponse::CreateLambda([OnDone = MoveTemp(OnDone)](const FString& Error, bool bSuccess)
+		{
+			OnDone(TEXT(""), Error, bSuccess);
+		}), Token, StartedDelegate);
+	}, MoveTemp(OnComplete), Options);
+}
+
+FGenRequestHandle UGenRequestSubsystem::SubmitOpenAIEmbeddings(FGenEmbeddingSettings EmbeddingSettings, FGenEmbeddingCallback&& OnComplete,
+                                                               const FGenRequestOptions& Options)
+{
+	// The slot callback only carries strings, the vectors are handed over through shared storage
+	const TSharedRef<FGenEmbeddingResult, ESPMode::ThreadSafe> Storage = MakeShared<FGenEmbeddingResult, ESPMode::ThreadSafe>();
+	return Submit(EGenAIOrgs::OpenAI, [EmbeddingSettings = MoveTemp(EmbeddingSettings), Storage](const FGenCancellationTokenRef& Token, FGenRequestCallback&& OnDone)
+	{
+		UGenOAIEmbeddings::SendEmbeddingRequest(EmbeddingSettings, [Storage, OnDone = MoveTemp(OnDone)](FGenEmbeddingResult&& Result, const FString& Error, bool bSuccess)
+		{
+			*Storage = MoveTemp(Result);
+			OnDone(TEXT(""), Error, bSuccess);
+		}, Token);
+	}, [Storage, OnComplete = MoveTemp(OnComplete)](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		OnComplete(MoveTemp(*Storage), Error, bSuccess);
+	}, Options);
+}
+
+void UGenRequestSubsystem::Start(const FGenRequestHandle& Handle)
+{
+	check(IsInGameThread());
+
+	FRequestSlot* Slot = FindSlot(Handle);
+	if (!Slot || Slot->State != ESlotState::Pending)
+	{
+		return;
+	}
+
+	Slot->State = ESlotState::Queued;
+	const EGenAIOrgs Org = Slot->Org;
+	const EGenRequestPriority Priority = Slot->Priority;
+	Queues.FindOrAdd(Org).Queued.Add(Handle.Index);
+	TryPreempt(Org, Priority);
+	PumpQueue(Org);
+}
+
+bool UGenRequestSubsystem::Cancel(const FGenRequestHandle& Handle)
+{
+	check(IsInGameThread());
+
+	const FRequestSlot* Slot = FindSlot(Handle);
+	if (!Slot)
+	{
+		return false;
+	}
+
+	const EGenAIOrgs Org = Slot->Org;
+	const FGenCancellationTokenPtr CancellationToken = Slot->CancellationToken;
+	const FGenCancellationTokenPtr AttemptToken = Slot->AttemptToken;
+
+	// Free the slot before aborting so the abort's own completion is ignored. Releasing the slot drops the
+	// only strong reference to the attempt token, the parent's cancel would no longer reach it
+	DetachSlot(Handle);
+	CancellationToken->Cancel();
+	if (AttemptToken.IsValid())
+	{
+		AttemptToken->Cancel();
+	}
+	PumpQueue(Org);
+	return true;
+}
+
+bool UGenRequestSubsystem::IsActive(const FGenRequestHandle& Handle) const
+{
+	return FindSlot(Handle) != nullptr;
+}
+
+FGenCancellationTokenPtr UGenRequestSubsystem::GetCancellationToken(const FGenRequestHandle& Handle) const
+{
+	const FRequestSlot* Slot = FindSlot(Handle);
+	return Slot ? Slot->CancellationToken : nullptr;
+}
+
+int32 UGenRequestSubsystem::GetNumQueued(EGenAIOrgs Org) const
+{
+	const FProviderQueue* Queue = Queues.Find(Org);
+	return Queue ? Queue->Queued.Num() : 0;
+}
+
+int32 UGenRequestSubsystem::GetNumInFlight(EGenAIOrgs Org) const
+{
+	const FProviderQueue* Queue = Queues.Find(Org);
+	return Queue ? Queue->InFlight : 0;
+}
+
+UGenRequestSubsystem::FRequestSlot* UGenRequestSubsystem::FindSlot(const FGenRequestHandle& Handle)
+{
+	if (!Slots.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	FRequestSlot& Slot = Slots[Handle.Index];
+	return Slot.Serial == Handle.Serial && Slot.State != ESlotState::Free ? &Slot : nullptr;
+}
+
+const UGenRequestSubsystem::FRequestSlot* UGenRequestSubsystem::FindSlot(const FGenRequestHandle& Handle) const
+{
+	return const_cast<UGenRequestSubsystem*>(this)->FindSlot(Handle);
+}
+
+void UGenRequestSubsystem::ReleaseSlot(int32 Index)
+{
+	FRequestSlot& Slot = Slots[Index];
+	Slot.State = ESlotState::Free;
+	Slot.Launcher = nullptr;
+	Slot.OnComplete = nullptr;
+	Slot.CancellationToken.Reset();
+	Slot.AttemptToken.Reset();
+	Slot.ReferencedObjects.Reset();
+	FreeSlots.Add(Index);
+}
+
+void UGenRequestSubsystem::PumpQueue(EGenAIOrgs Org)
+{
+	if (bShuttingDown)
+	{
+		return;
+	}
+
+	const int32 MaxInFlight = FMath::Max(1, GetDefault<UGenAISupportRuntimeSettings>()->MaxConcurrentRequestsPerProvider);
+
+	// Launch can complete synchronously and re-enter, so the queue is looked up again every iteration
+	while (true)
+	{
+		FProviderQueue& Queue = Queues.FindOrAdd(Org);
+		if (Queue.InFlight >= MaxInFlight || Queue.Queued.Num() == 0)
+		{
+			break;
+		}
+
+		const int32 Index = PopNextQueued(Queue);
+		Queue.InFlight++;
+		Launch(Index);
+	}
+}
+
+int32 UGenRequestSubsystem::PopNextQueued(FProviderQueue& Queue) const
+{
+	const float AgingSeconds = GetDefault<UGenAISupportRuntimeSettings>()->PriorityAgingSeconds;
+	const double Now = FPlatformTime::Seconds();
+
+	// Queues are short, a linear scan keeps FIFO order within a class without a heap
+	int32 BestPosition = 0;
+	double BestScore = -1.0;
+	for (int32 Position = 0; Position < Queue.Queued.Num(); ++Position)
+	{
+		const FRequestSlot& Slot = Slots[Queue.Queued[Position]];
+		const double Promotion = AgingSeconds > 0.0f ? FMath::FloorToDouble((Now - Slot.SubmitTime) / AgingSeconds) : 0.0;
+		const double Score = static_cast<double>(Slot.Priority) + Promotion;
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestPosition = Position;
+		}
+	}
+
+	const int32 Index = Queue.Queued[BestPosition];
+	Queue.Queued.RemoveAt(BestPosition);
+	return Index;
+}
+
+void UGenRequestSubsystem::TryPreempt(EGenAIOrgs Org, EGenRequestPriority Priority)
+{
+	const UGenAISupportRuntimeSettings* Settings = GetDefault<UGenAISupportRuntimeSettings>();
+	if (Settings->BackgroundPreemption == EGenPreemptionPolicy::Disabled || Priority < EGenRequestPriority::Interactive)
+	{
+		return;
+	}
+
+	const FProviderQueue* Queue = Queues.Find(Org);
+	if (!Queue || Queue->InFlight < FMath::Max(1, Settings->MaxConcurrentRequestsPerProvider))
+	{
+		return;
+	}
+
+	// Newest background request loses the least progress
+	int32 Victim = INDEX_NONE;
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		const FRequestSlot& Slot = Slots[Index];
+		if (Slot.State == ESlotState::InFlight && Slot.Org == Org && Slot.Priority == EGenRequestPriority::Background
+			&& (Victim == INDEX_NONE || Slot.SubmitTime > Slots[Victim].SubmitTime))
+		{
+			Victim = Index;
+		}
+	}
+
+	if (Victim == INDEX_NONE)
+	{
+		return;
+	}
+
+	FGenRequestHandle VictimHandle;
+	VictimHandle.Index = Victim;
+	VictimHandle.Serial = Slots[Victim].Serial;
+
+	if (Settings->BackgroundPreemption == EGenPreemptionPolicy::Cancel)
+	{
+		const FGenCancellationTokenPtr AttemptToken = Slots[Victim].AttemptToken;
+		const FGenRequestCallback OnComplete = DetachSlot(VictimHandle);
+		AttemptToken->Cancel();
+		if (OnComplete)
+		{
+			OnComplete(TEXT(""), TEXT("Request preempted"), false);
+		}
+		return;
+	}
+
+	// Requeue keeps the original submit time so the request keeps aging
+	FRequestSlot& Slot = Slots[Victim];
+	const FGenCancellationTokenPtr AttemptToken = Slot.AttemptToken;
+	Slot.State = ESlotState::Queued;
+	Slot.AttemptToken.Reset();
+	FProviderQueue& MutableQueue = Queues.FindOrAdd(Org);
+	MutableQueue.InFlight--;
+	MutableQueue.Queued.Add(Victim);
+	AttemptToken->Cancel();
+}
+
+void UGenRequestSubsystem::Launch(int32 Index)
+{
+	FRequestSlot& Slot = Slots[Index];
+	Slot.State = ESlotState::InFlight;
+	Slot.Attempt++;
+
+	FGenRequestHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Slot.Serial;
+	const uint32 Attempt = Slot.Attempt;
+
+	// Each launch gets its own token so preemption can abort the transfer without cancelling the request
+	const FGenCancellationTokenRef AttemptToken = Slot.CancellationToken->CreateChild();
+	Slot.AttemptToken = AttemptToken;
+
+	// Copied rather than moved, a preempted request needs its launcher again
+	const FGenRequestLauncher Launcher = Slot.Launcher;
+
+	TWeakObjectPtr<UGenRequestSubsystem> WeakThis(this);
+	Launcher(AttemptToken, [WeakThis, Handle, Attempt](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		if (UGenRequestSubsystem* StrongThis = WeakThis.Get())
+		{
+			StrongThis->HandleCompleted(Handle, Attempt, Response, Error, bSuccess);
+		}
+	});
+}
+
+void UGenRequestSubsystem::HandleCompleted(FGenRequestHandle Handle, uint32 Attempt, const FString& Response, const FString& Error, bool bSuccess)
+{
+	FRequestSlot* Slot = FindSlot(Handle);
+	if (!Slot || Slot->State != ESlotState::InFlight || Slot->Attempt != Attempt)
+	{
+		// Cancelled or preempted, the slot may already belong to another request or attempt
+		return;
+	}
+
+	const EGenAIOrgs Org = Slot->Org;
+	const FGenRequestCallback OnComplete = DetachSlot(Handle);
+	PumpQueue(Org);
+
+	if (OnComplete)
+	{
+		OnComplete(Response, Error, bSuccess);
+	}
+}
+
+void UGenRequestSubsystem::HandleTokenCancelled(FGenRequestHandle Handle)
+{
+	const FRequestSlot* Slot = FindSlot(Handle);
+	if (!Slot)
+	{
+		// Already completed or cancelled through Cancel()
+		return;
+	}
+
+	// This callback can run before the token reaches the attempt token, which only lives in the slot
+	const EGenAIOrgs Org = Slot->Org;
+	const FGenCancellationTokenPtr AttemptToken = Slot->AttemptToken;
+	const FGenRequestCallback OnComplete = DetachSlot(Handle);
+	if (AttemptToken.IsValid())
+	{
+		AttemptToken->Cancel();
+	}
+	PumpQueue(Org);
+
+	if (OnComplete)
+	{
+		OnComplete(TEXT(""), TEXT("Request cancelled"), false);
+	}
+}
+
+bool UGenRequestSubsystem::SweepExpired(float DeltaTime)
+{
+	TArray<FGenRequestHandle, TInlineAllocator<8>> Expired;
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
+	{
+		const FRequestSlot& Slot = Slots[Index];
+		if ((Slot.State == ESlotState::Pending || Slot.State == ESlotState::Queued) && Slot.CancellationToken->IsExpired())
+		{
+			FGenRequestHandle Handle;
+			Handle.Index = Index;
+			Handle.Serial = Slot.Serial;
+			Expired.Add(Handle);
+		}
+	}
+
+	// Callbacks may submit or cancel other requests, every handle is looked up again
+	for (const FGenRequestHandle& Handle : Expired)
+	{
+		const FRequestSlot* Slot = FindSlot(Handle);
+		if (!Slot || (Slot->State != ESlotState::Pending && Slot->State != ESlotState::Queued))
+		{
+			continue;
+		}
+
+		const EGenAIOrgs Org = Slot->Org;
+		const FGenCancellationTokenPtr CancellationToken = Slot->CancellationToken;
+		const FGenRequestCallback OnComplete = DetachSlot(Handle);
+		CancellationToken->Cancel();
+		PumpQueue(Org);
+
+		if (OnComplete)
+		{
+			OnComplete(TEXT(""), TEXT("Request deadline exceeded"), false);
+		}
+	}
+	return true;
+}
+
+FGenRequestCallback UGenRequestSubsystem::DetachSlot(const FGenRequestHandle& Handle)
+{
+	FRequestSlot& Slot = Slots[Handle.Index];
+	FProviderQueue& Queue = Queues.FindOrAdd(Slot.Org);
+	if (Slot.State == ESlotState::Queued)
+	{
+		Queue.Queued.Remove(Handle.Index);
+	}
+	else if (Slot.State == ESlotState::InFlight)
+	{
+		Queue.InFlight--;
+	}
+
+	FGenRequestCallback OnComplete = MoveTemp(Slot.OnComplete);
+	ReleaseSlot(Handle.Index);
+	return OnComplete;
+}
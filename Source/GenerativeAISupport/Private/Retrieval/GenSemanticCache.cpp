@@ -0,0 +1,279 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Retrieval/GenSemanticCache.h"
+
+#include "Data/GenAIOrgs.h"
+#include "GenAISupportRuntimeSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
+#include "Models/OpenAI/GenOAIEmbeddings.h"
+#include "Retrieval/GenVectorIndex.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+FGenSemanticCache* FGenSemanticCache::Singleton = nullptr;
+
+static FAutoConsoleCommand GenSemanticCacheStatsCommand(
+	TEXT("GenAI.SemanticCache.Stats"),
+	TEXT("Logs semantic response cache hit and miss counters"),
+	FConsoleCommandDelegate::CreateLambda([]() { FGenSemanticCache::Get().LogStats(); }));
+
+static FAutoConsoleCommand GenSemanticCacheClearCommand(
+	TEXT("GenAI.SemanticCache.Clear"),
+	TEXT("Drops every cached chat response"),
+	FConsoleCommandDelegate::CreateLambda([]() { FGenSemanticCache::Get().Clear(); }));
+
+FGenSemanticCache& FGenSemanticCache::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenSemanticCache();
+	}
+	return *Singleton;
+}
+
+void FGenSemanticCache::Fetch(EGenAIOrgs Org, const FString& Model, const FString& Sampling, const TArray<FGenChatMessage>& Messages, const FGenCancellationTokenRef& CancellationToken,
+                              TFunction<void(FGenRequestCallback&&)>&& Send, FGenRequestCallback&& OnDone)
+{
+	check(IsInGameThread());
+
+	// Only a conversation waiting on a user message has something to look up
+	if (Messages.Num() == 0 || Messages.Last().Role != TEXT("user") || Messages.Last().Content.IsEmpty())
+	{
+		Send(MoveTemp(OnDone));
+		return;
+	}
+
+	const uint64 ScopeId = MakeScopeId(Org, Model, Sampling, Messages);
+	FString Key = MakeKey(Messages.Last().Content);
+	if (const FEntry* Entry = FindExact(ScopeId, Key))
+	{
+		++ExactHits;
+		OnDone(Entry->Response, TEXT(""), true);
+		return;
+	}
+
+	const UGenAISupportRuntimeSettings* Settings = GetDefault<UGenAISupportRuntimeSettings>();
+	FGenEmbeddingSettings EmbeddingSettings;
+	EmbeddingSettings.ModelEnum = Settings->SemanticCacheEmbeddingModel;
+	EmbeddingSettings.Dimensions = Settings->SemanticCacheEmbeddingDimensions;
+	EmbeddingSettings.Inputs.Add(Messages.Last().Content);
+
+	UGenOAIEmbeddings::SendEmbeddingRequest(EmbeddingSettings,
+		[this, ScopeId, Key = MoveTemp(Key), CancellationToken, Send = MoveTemp(Send), OnDone = MoveTemp(OnDone)]
+		(FGenEmbeddingResult&& Result, const FString& Error, bool bSuccess) mutable
+		{
+			if (CancellationToken->IsCancelled() || CancellationToken->IsExpired())
+			{
+				OnDone(TEXT(""), CancellationToken->GetStopReason(), false);
+				return;
+			}
+
+			++Misses;
+			if (!bSuccess || Result.Num() != 1)
+			{
+				// The cache is an optimization, never a reason for the request to fail
+				UE_LOG(LogGenAI, Verbose, TEXT("Semantic cache lookup skipped: %s"), *Error);
+				Send(MoveTemp(OnDone));
+				return;
+			}
+
+			TArray<float> Vector(Result.GetEmbedding(0));
+			const float LengthSquared = FGenVectorIndex::DotProduct(Vector.GetData(), Vector.GetData(), Vector.Num());
+			if (LengthSquared > UE_SMALL_NUMBER)
+			{
+				const float InvLength = FMath::InvSqrt(LengthSquared);
+				for (float& Component : Vector)
+				{
+					Component *= InvLength;
+				}
+			}
+
+			if (const FEntry* Entry = FindSimilar(ScopeId, Vector))
+			{
+				--Misses;
+				++SemanticHits;
+				OnDone(Entry->Response, TEXT(""), true);
+				return;
+			}
+
+			Send([this, ScopeId, Key = MoveTemp(Key), Vector = MoveTemp(Vector), OnDone = MoveTemp(OnDone)](const FString& Response, const FString& SendError, bool bSendSuccess)
+			{
+				if (bSendSuccess && !Response.IsEmpty())
+				{
+					Store(ScopeId, Key, Vector, Response);
+				}
+				OnDone(Response, SendError, bSendSuccess);
+			});
+		}, CancellationToken);
+}
+
+void FGenSemanticCache::Clear()
+{
+	Scopes.Empty();
+}
+
+void FGenSemanticCache::LogStats() const
+{
+	int32 Entries = 0;
+	for (const TPair<uint64, FScope>& Scope : Scopes)
+	{
+		Entries += Scope.Value.Entries.Num();
+	}
+
+	const int64 Lookups = ExactHits + SemanticHits + Misses;
+	UE_LOG(LogGenAI, Log, TEXT("Semantic cache: %d scopes, %d entries, %lld lookups, %lld exact hits, %lld semantic hits, %lld misses (%.1f%% hit rate)"),
+	       Scopes.Num(), Entries, Lookups, ExactHits, SemanticHits, Misses,
+	       Lookups > 0 ? 100.0 * static_cast<double>(ExactHits + SemanticHits) / static_cast<double>(Lookups) : 0.0);
+}
+
+uint64 FGenSemanticCache::MakeScopeId(EGenAIOrgs Org, const FString& Model, const FString& Sampling, const TArray<FGenChatMessage>& Messages)
+{
+	// Everything before the final user message, an answer only fits the conversation it was given in
+	FString Scope = FString::Printf(TEXT("%d|%s|%s"), static_cast<int32>(Org), *Model, *Sampling);
+	for (int32 Index = 0; Index < Messages.Num() - 1; ++Index)
+	{
+		Scope += FString::Printf(TEXT("|%d:%s|%d:"), Messages[Index].Role.Len(), *Messages[Index].Role, Messages[Index].Content.Len());
+		Scope += Messages[Index].Content;
+	}
+	return CityHash64(reinterpret_cast<const char*>(*Scope), Scope.Len() * sizeof(TCHAR));
+}
+
+FString FGenSemanticCache::MakeKey(const FString& Message)
+{
+	// Case and spacing differences should not cost an embedding call
+	FString Key;
+	Key.Reserve(Message.Len());
+	bool bPendingSpace = false;
+	for (const TCHAR Char : Message)
+	{
+		if (FChar::IsWhitespace(Char))
+		{
+			bPendingSpace = !Key.IsEmpty();
+			continue;
+		}
+		if (bPendingSpace)
+		{
+			Key.AppendChar(TEXT(' '));
+			bPendingSpace = false;
+		}
+		Key.AppendChar(FChar::ToLower(Char));
+	}
+	return Key;
+}
+
+bool FGenSemanticCache::IsExpired(const FEntry& Entry) const
+{
+	const float Lifetime = GetDefault<UGenAISupportRuntimeSettings>()->SemanticCacheEntryLifetimeSeconds;
+	return Lifetime > 0.0f && FPlatformTime::Seconds() - Entry.StoreTime > Lifetime;
+}
+
+const FGenSemanticCache::FEntry* FGenSemanticCache::FindExact(uint64 ScopeId, const FString& Key)
+{
+	FScope* Scope = Scopes.Find(ScopeId);
+	const int32* Index = Scope ? Scope->EntryByKey.Find(Key) : nullptr;
+	if (!Index)
+	{
+		return nullptr;
+	}
+
+	FEntry& Entry = Scope->Entries[*Index];
+	if (IsExpired(Entry))
+	{
+		RemoveEntry(*Scope, *Index);
+		return nullptr;
+	}
+	Entry.LastUseTime = FPlatformTime::Seconds();
+	return &Entry;
+}
+
+const FGenSemanticCache::FEntry* FGenSemanticCache::FindSimilar(uint64 ScopeId, const TArray<float>& Vector)
+{
+	FScope* Scope = Scopes.Find(ScopeId);
+	if (!Scope || Scope->Dimensions != Vector.Num())
+	{
+		return nullptr;
+	}
+
+	const float Threshold = GetDefault<UGenAISupportRuntimeSettings>()->SemanticCacheSimilarityThreshold;
+	int32 Best = INDEX_NONE;
+	float BestScore = Threshold;
+	for (int32 Index = 0; Index < Scope->Entries.Num(); ++Index)
+	{
+		const float Score = FGenVectorIndex::DotProduct(Scope->Vectors.GetData() + static_cast<int64>(Index) * Scope->Dimensions, Vector.GetData(), Scope->Dimensions);
+		if (Score >= BestScore && !IsExpired(Scope->Entries[Index]))
+		{
+			BestScore = Score;
+			Best = Index;
+		}
+	}
+
+	if (Best == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	Scope->Entries[Best].LastUseTime = FPlatformTime::Seconds();
+	return &Scope->Entries[Best];
+}
+
+void FGenSemanticCache::Store(uint64 ScopeId, const FString& Key, const TArray<float>& Vector, const FString& Response)
+{
+	FScope& Scope = Scopes.FindOrAdd(ScopeId);
+	if (Scope.Dimensions != Vector.Num())
+	{
+		// The embedding settings changed, older vectors are not comparable anymore
+		Scope = FScope();
+		Scope.Dimensions = Vector.Num();
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (const int32* Existing = Scope.EntryByKey.Find(Key))
+	{
+		FEntry& Entry = Scope.Entries[*Existing];
+		Entry.Response = Response;
+		Entry.StoreTime = Now;
+		Entry.LastUseTime = Now;
+		FMemory::Memcpy(Scope.Vectors.GetData() + static_cast<int64>(*Existing) * Scope.Dimensions, Vector.GetData(), Scope.Dimensions * sizeof(float));
+		return;
+	}
+
+	const int32 MaxEntries = FMath::Max(GetDefault<UGenAISupportRuntimeSettings>()->SemanticCacheMaxEntriesPerScope, 1);
+	while (Scope.Entries.Num() >= MaxEntries)
+	{
+		int32 LeastRecent = 0;
+		for (int32 Index = 1; Index < Scope.Entries.Num(); ++Index)
+		{
+			if (Scope.Entries[Index].LastUseTime < Scope.Entries[LeastRecent].LastUseTime)
+			{
+				LeastRecent = Index;
+			}
+		}
+		RemoveEntry(Scope, LeastRecent);
+	}
+
+	FEntry& Entry = Scope.Entries.AddDefaulted_GetRef();
+	Entry.Key = Key;
+	Entry.Response = Response;
+	Entry.StoreTime = Now;
+	Entry.LastUseTime = Now;
+	Scope.Vectors.Append(Vector);
+	Scope.EntryByKey.Add(Key, Scope.Entries.Num() - 1);
+}
+
+void FGenSemanticCache::RemoveEntry(FScope& Scope, int32 Index)
+{
+	// Move the last entry into the hole so rows stay contiguous
+	const int32 Last = Scope.Entries.Num() - 1;
+	Scope.EntryByKey.Remove(Scope.Entries[Index].Key);
+	if (Index != Last)
+	{
+		Scope.Entries[Index] = MoveTemp(Scope.Entries[Last]);
+		Scope.EntryByKey.Add(Scope.Entries[Index].Key, Index);
+		FMemory::Memcpy(Scope.Vectors.GetData() + static_cast<int64>(Index) * Scope.Dimensions,
+		                Scope.Vectors.GetData() + static_cast<int64>(Last) * Scope.Dimensions, Scope.Dimensions * sizeof(float));
+	}
+	Scope.Entries.RemoveAt(Last);
+	Scope.Vectors.SetNum(Last * Scope.Dimensions);
+}
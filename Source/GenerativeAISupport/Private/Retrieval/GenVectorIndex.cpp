@@ -0,0 +1,773 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Retrieval/GenVectorIndex.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Math/Float16.h"
+#include "Math/RandomStream.h"
+#include "Math/VectorRegister.h"
+#include "Misc/FileHelper.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define GEN_VECTOR_INDEX_SSE2 1
+#else
+#define GEN_VECTOR_INDEX_SSE2 0
+#endif
+
+/**
+ * On-disk and in-memory layout, little endian. Every section starts on a 64 byte boundary:
+ * header | centroids (float, NumLists x Dimensions) | list offsets (uint32, NumLists + 1)
+ * | ids (int64, Count) | scales (float, Count, int8 only) | rows (RowStride bytes each, in list order)
+ */
+struct FGenVectorIndexHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	int32 Dimensions;
+	int32 Count;
+	uint8 Metric;
+	uint8 Quantization;
+	uint8 Padding[2];
+	int32 NumLists;
+	int32 RowStride;
+	int32 Reserved;
+	uint64 CentroidsOffset;
+	uint64 ListOffsetsOffset;
+	uint64 IdsOffset;
+	uint64 ScalesOffset;
+	uint64 RowsOffset;
+	uint64 TotalSize;
+};
+
+struct FGenPreparedQuery
+{
+	TArray<float> Float;
+	TArray<int8> Int8;
+	float Int8Scale = 0.0f;
+};
+
+namespace GenVectorIndex
+{
+	constexpr uint32 Magic = 0x58495647; // "GVIX"
+	constexpr uint32 Version = 1;
+	constexpr uint64 SectionAlignment = 64;
+
+	// Rows per parallel scan chunk, large enough to amortize the task overhead
+	constexpr int32 ScanChunkRows = 8192;
+
+	// Training sample per inverted list, more barely moves the centroids
+	constexpr int32 TrainingSamplesPerList = 64;
+
+	static int32 GetElementSize(EGenVectorQuantization Quantization)
+	{
+		switch (Quantization)
+		{
+		case EGenVectorQuantization::Float16: return sizeof(FFloat16);
+		case EGenVectorQuantization::Int8: return sizeof(int8);
+		default: return sizeof(float);
+		}
+	}
+
+	static float DotFloat(const float* A, const float* B, int32 Dimensions)
+	{
+		VectorRegister4Float Acc0 = VectorZeroFloat();
+		VectorRegister4Float Acc1 = VectorZeroFloat();
+		int32 Index = 0;
+		for (; Index + 8 <= Dimensions; Index += 8)
+		{
+			Acc0 = VectorMultiplyAdd(VectorLoad(A + Index), VectorLoad(B + Index), Acc0);
+			Acc1 = VectorMultiplyAdd(VectorLoad(A + Index + 4), VectorLoad(B + Index + 4), Acc1);
+		}
+		for (; Index + 4 <= Dimensions; Index += 4)
+		{
+			Acc0 = VectorMultiplyAdd(VectorLoad(A + Index), VectorLoad(B + Index), Acc0);
+		}
+
+		alignas(16) float Lanes[4];
+		VectorStoreAligned(VectorAdd(Acc0, Acc1), Lanes);
+		float Sum = (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+		for (; Index < Dimensions; ++Index)
+		{
+			Sum += A[Index] * B[Index];
+		}
+		return Sum;
+	}
+
+	static float DotHalf(const FFloat16* Row, const float* Query, int32 Dimensions)
+	{
+		// Widen a block at a time so the multiply stays on the vector path
+		constexpr int32 BlockSize = 64;
+		alignas(16) float Block[BlockSize];
+		float Sum = 0.0f;
+		for (int32 Start = 0; Start < Dimensions; Start += BlockSize)
+		{
+			const int32 Count = FMath::Min(BlockSize, Dimensions - Start);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Block[Index] = Row[Start + Index].GetFloat();
+			}
+			Sum += DotFloat(Block, Query + Start, Count);
+		}
+		return Sum;
+	}
+
+	static int32 DotInt8(const int8* A, const int8* B, int32 Dimensions)
+	{
+		int32 Index = 0;
+		int32 Sum = 0;
+#if GEN_VECTOR_INDEX_SSE2
+		// Sign extend to 16 bits (interleave with itself, arithmetic shift) and multiply-add pairs into 32 bit lanes.
+		// 127 * 127 * 2 per pair leaves room for vectors far longer than any embedding model produces
+		__m128i Acc = _mm_setzero_si128();
+		for (; Index + 16 <= Dimensions; Index += 16)
+		{
+			const __m128i VA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(A + Index));
+			const __m128i VB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(B + Index));
+			const __m128i ALow = _mm_srai_epi16(_mm_unpacklo_epi8(VA, VA), 8);
+			const __m128i AHigh = _mm_srai_epi16(_mm_unpackhi_epi8(VA, VA), 8);
+			const __m128i BLow = _mm_srai_epi16(_mm_unpacklo_epi8(VB, VB), 8);
+			const __m128i BHigh = _mm_srai_epi16(_mm_unpackhi_epi8(VB, VB), 8);
+			Acc = _mm_add_epi32(Acc, _mm_madd_epi16(ALow, BLow));
+			Acc = _mm_add_epi32(Acc, _mm_madd_epi16(AHigh, BHigh));
+		}
+		alignas(16) int32 Lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(Lanes), Acc);
+		Sum = Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+#endif
+		for (; Index < Dimensions; ++Index)
+		{
+			Sum += static_cast<int32>(A[Index]) * static_cast<int32>(B[Index]);
+		}
+		return Sum;
+	}
+
+	static void Normalize(float* Vector, int32 Dimensions)
+	{
+		const float LengthSquared = DotFloat(Vector, Vector, Dimensions);
+		if (LengthSquared > UE_SMALL_NUMBER)
+		{
+			const float InvLength = FMath::InvSqrt(LengthSquared);
+			for (int32 Index = 0; Index < Dimensions; ++Index)
+			{
+				Vector[Index] *= InvLength;
+			}
+		}
+	}
+
+	/** Symmetric per-vector quantization, returns the scale that maps int8 values back to floats */
+	static float QuantizeInt8(const float* Vector, int32 Dimensions, int8* OutValues)
+	{
+		float MaxAbs = 0.0f;
+		for (int32 Index = 0; Index < Dimensions; ++Index)
+		{
+			MaxAbs = FMath::Max(MaxAbs, FMath::Abs(Vector[Index]));
+		}
+
+		const float Scale = MaxAbs / 127.0f;
+		const float InvScale = Scale > 0.0f ? 1.0f / Scale : 0.0f;
+		for (int32 Index = 0; Index < Dimensions; ++Index)
+		{
+			OutValues[Index] = static_cast<int8>(FMath::Clamp(FMath::RoundToInt(Vector[Index] * InvScale), -127, 127));
+		}
+		return Scale;
+	}
+
+	/** Nearest centroid in L2 terms, argmax of dot(v, c) - |c|^2 / 2 */
+	static int32 FindNearestCentroid(const float* Vector, const TArray<float>& Centroids, const TArray<float>& HalfNormsSquared, int32 Dimensions)
+	{
+		int32 Best = 0;
+		float BestScore = -MAX_flt;
+		for (int32 List = 0; List < HalfNormsSquared.Num(); ++List)
+		{
+			const float Score = DotFloat(Vector, Centroids.GetData() + static_cast<int64>(List) * Dimensions, Dimensions) - HalfNormsSquared[List];
+			if (Score > BestScore)
+			{
+				BestScore = Score;
+				Best = List;
+			}
+		}
+		return Best;
+	}
+
+	static void ComputeHalfNormsSquared(const TArray<float>& Centroids, int32 NumLists, int32 Dimensions, TArray<float>& OutHalfNormsSquared)
+	{
+		OutHalfNormsSquared.SetNumUninitialized(NumLists);
+		for (int32 List = 0; List < NumLists; ++List)
+		{
+			const float* Centroid = Centroids.GetData() + static_cast<int64>(List) * Dimensions;
+			OutHalfNormsSquared[List] = 0.5f * DotFloat(Centroid, Centroid, Dimensions);
+		}
+	}
+
+	/** Lloyd's k-means over a random sample of the vectors */
+	static void TrainCentroids(const TArray<float>& Vectors, int32 Count, int32 Dimensions, int32 NumLists,
+	                           const FGenVectorIndexBuildOptions& Options, TArray<float>& OutCentroids)
+	{
+		FRandomStream Random(Options.Seed);
+
+		const int32 SampleSize = FMath::Min(Count, NumLists * TrainingSamplesPerList);
+		TArray<int32> Sample;
+		Sample.SetNumUninitialized(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Sample[Index] = Index;
+		}
+		for (int32 Index = 0; Index < SampleSize; ++Index)
+		{
+			Sample.Swap(Index, Index + Random.RandHelper(Count - Index));
+		}
+		Sample.SetNum(SampleSize);
+
+		OutCentroids.SetNumUninitialized(NumLists * Dimensions);
+		for (int32 List = 0; List < NumLists; ++List)
+		{
+			FMemory::Memcpy(OutCentroids.GetData() + static_cast<int64>(List) * Dimensions,
+			                Vectors.GetData() + static_cast<int64>(Sample[List]) * Dimensions, Dimensions * sizeof(float));
+		}
+
+		TArray<int32> Assignment;
+		Assignment.SetNumUninitialized(SampleSize);
+		TArray<float> HalfNormsSquared;
+		TArray<double> Sums;
+		TArray<int32> Counts;
+		for (int32 Iteration = 0; Iteration < FMath::Max(Options.TrainingIterations, 1); ++Iteration)
+		{
+			ComputeHalfNormsSquared(OutCentroids, NumLists, Dimensions, HalfNormsSquared);
+			ParallelFor(SampleSize, [&](int32 Index)
+			{
+				Assignment[Index] = FindNearestCentroid(Vectors.GetData() + static_cast<int64>(Sample[Index]) * Dimensions, OutCentroids, HalfNormsSquared, Dimensions);
+			});
+
+			Sums.SetNumZeroed(NumLists * Dimensions);
+			Counts.SetNumZeroed(NumLists);
+			for (int32 Index = 0; Index < SampleSize; ++Index)
+			{
+				const float* Vector = Vectors.GetData() + static_cast<int64>(Sample[Index]) * Dimensions;
+				double* Sum = Sums.GetData() + static_cast<int64>(Assignment[Index]) * Dimensions;
+				for (int32 Component = 0; Component < Dimensions; ++Component)
+				{
+					Sum[Component] += Vector[Component];
+				}
+				Counts[Assignment[Index]]++;
+			}
+
+			for (int32 List = 0; List < NumLists; ++List)
+			{
+				float* Centroid = OutCentroids.GetData() + static_cast<int64>(List) * Dimensions;
+				if (Counts[List] == 0)
+				{
+					// Reseed empty lists so every list ends up holding something
+					FMemory::Memcpy(Centroid, Vectors.GetData() + static_cast<int64>(Sample[Random.RandHelper(SampleSize)]) * Dimensions, Dimensions * sizeof(float));
+					continue;
+				}
+				const double* Sum = Sums.GetData() + static_cast<int64>(List) * Dimensions;
+				for (int32 Component = 0; Component < Dimensions; ++Component)
+				{
+					Centroid[Component] = static_cast<float>(Sum[Component] / Counts[List]);
+				}
+				if (Options.Metric == EGenVectorMetric::Cosine)
+				{
+					Normalize(Centroid, Dimensions);
+				}
+			}
+		}
+	}
+
+	static void PushMatch(TArray<FGenVectorMatch>& Heap, int32 K, int64 Id, float Score)
+	{
+		// Min-heap on score, the weakest kept match sits on top
+		auto Less = [](const FGenVectorMatch& A, const FGenVectorMatch& B) { return A.Score < B.Score; };
+		if (Heap.Num() < K)
+		{
+			Heap.HeapPush(FGenVectorMatch { Id, Score }, Less);
+		}
+		else if (Score > Heap.HeapTop().Score)
+		{
+			Heap.HeapPopDiscard(Less);
+			Heap.HeapPush(FGenVectorMatch { Id, Score }, Less);
+		}
+	}
+
+	static uint64 AlignSection(uint64 Offset)
+	{
+		return Align(Offset, SectionAlignment);
+	}
+}
+
+FGenVectorIndex::~FGenVectorIndex()
+{
+	// The region has to go before the file it maps
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+TSharedPtr<FGenVectorIndex, ESPMode::ThreadSafe> FGenVectorIndex::Load(const FString& Path)
+{
+	TSharedPtr<FGenVectorIndex, ESPMode::ThreadSafe> Index = MakeShareable(new FGenVectorIndex());
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	Index->MappedFile.Reset(PlatformFile.OpenMapped(*Path));
+	if (Index->MappedFile.IsValid())
+	{
+		Index->MappedRegion.Reset(Index->MappedFile->MapRegion(0, Index->MappedFile->GetFileSize()));
+	}
+
+	if (Index->MappedRegion.IsValid())
+	{
+		Index->Data = Index->MappedRegion->GetMappedPtr();
+		Index->DataSize = Index->MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		Index->MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(Index->OwnedData, *Path))
+		{
+			UE_LOG(LogGenAI, Error, TEXT("Failed to open vector index %s"), *Path);
+			return nullptr;
+		}
+		Index->Data = Index->OwnedData.GetData();
+		Index->DataSize = Index->OwnedData.Num();
+	}
+
+	if (!Index->BindSections())
+	{
+		UE_LOG(LogGenAI, Error, TEXT("%s is not a valid vector index"), *Path);
+		return nullptr;
+	}
+	return Index;
+}
+
+bool FGenVectorIndex::Save(const FString& Path) const
+{
+	return FFileHelper::SaveArrayToFile(TArrayView64<const uint8>(Data, DataSize), *Path);
+}
+
+bool FGenVectorIndex::BindSections()
+{
+	using namespace GenVectorIndex;
+
+	if (!Data || DataSize < static_cast<int64>(sizeof(FGenVectorIndexHeader)))
+	{
+		return false;
+	}
+
+	Header = reinterpret_cast<const FGenVectorIndexHeader*>(Data);
+	if (Header->Magic != Magic || Header->Version != GenVectorIndex::Version || Header->TotalSize > static_cast<uint64>(DataSize)
+		|| Header->Dimensions <= 0 || Header->Count < 0 || Header->NumLists < 0
+		|| Header->Quantization > static_cast<uint8>(EGenVectorQuantization::Int8) || Header->Metric > static_cast<uint8>(EGenVectorMetric::DotProduct))
+	{
+		return false;
+	}
+
+	const uint64 Dimensions = Header->Dimensions;
+	const uint64 Count = Header->Count;
+	const uint64 Lists = Header->NumLists;
+
+	// Offsets are checked on their own first, so a corrupt offset cannot wrap the section end checks below
+	auto IsValidOffset = [this](uint64 Offset, uint64 Alignment)
+	{
+		return Offset <= Header->TotalSize && Offset % Alignment == 0;
+	};
+
+	// Element counts are products of two int32 fields at most, so they fit in 62 bits. Dividing the space left
+	// instead of multiplying by the element size keeps a crafted header from wrapping past the check
+	auto FitsAt = [this](uint64 Offset, uint64 NumElements, uint64 ElementSize)
+	{
+		return NumElements <= (Header->TotalSize - Offset) / ElementSize;
+	};
+
+	const uint64 MinRowStride = Dimensions * GetElementSize(static_cast<EGenVectorQuantization>(Header->Quantization));
+	const bool bValidLayout =
+		IsValidOffset(Header->CentroidsOffset, alignof(float)) && IsValidOffset(Header->ListOffsetsOffset, alignof(uint32))
+		&& IsValidOffset(Header->IdsOffset, alignof(int64)) && IsValidOffset(Header->ScalesOffset, alignof(float))
+		&& IsValidOffset(Header->RowsOffset, alignof(float))
+		&& Header->RowStride > 0 && static_cast<uint64>(Header->RowStride) >= MinRowStride
+		&& FitsAt(Header->CentroidsOffset, Lists * Dimensions, sizeof(float))
+		&& FitsAt(Header->ListOffsetsOffset, Lists + 1, sizeof(uint32))
+		&& FitsAt(Header->IdsOffset, Count, sizeof(int64))
+		&& FitsAt(Header->ScalesOffset, Count, sizeof(float))
+		&& FitsAt(Header->RowsOffset, Count, Header->RowStride);
+	if (!bValidLayout)
+	{
+		return false;
+	}
+
+	NumLists = Header->NumLists;
+	RowStride = Header->RowStride;
+	Centroids = reinterpret_cast<const float*>(Data + Header->CentroidsOffset);
+	ListOffsets = reinterpret_cast<const uint32*>(Data + Header->ListOffsetsOffset);
+	Ids = reinterpret_cast<const int64*>(Data + Header->IdsOffset);
+	Scales = reinterpret_cast<const float*>(Data + Header->ScalesOffset);
+	Rows = Data + Header->RowsOffset;
+
+	// Searches scan the rows between neighbouring list offsets, they have to stay within the entries
+	if (NumLists > 0 && (ListOffsets[0] != 0 || ListOffsets[NumLists] != Count))
+	{
+		return false;
+	}
+	for (int32 List = 0; List < NumLists; ++List)
+	{
+		if (ListOffsets[List] > ListOffsets[List + 1])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int32 FGenVectorIndex::Num() const
+{
+	return Header ? Header->Count : 0;
+}
+
+int32 FGenVectorIndex::GetDimensions() const
+{
+	return Header ? Header->Dimensions : 0;
+}
+
+EGenVectorMetric FGenVectorIndex::GetMetric() const
+{
+	return Header ? static_cast<EGenVectorMetric>(Header->Metric) : EGenVectorMetric::Cosine;
+}
+
+EGenVectorQuantization FGenVectorIndex::GetQuantization() const
+{
+	return Header ? static_cast<EGenVectorQuantization>(Header->Quantization) : EGenVectorQuantization::Float32;
+}
+
+void FGenVectorIndex::ScanRows(int32 FirstRow, int32 LastRow, const FGenPreparedQuery& Query, float MinScore,
+                               TArray<FGenVectorMatch>& Heap, int32 K) const
+{
+	using namespace GenVectorIndex;
+
+	const int32 Dimensions = Header->Dimensions;
+	auto Consider = [&Heap, K, MinScore, this](int32 Row, float Score)
+	{
+		if (Score >= MinScore)
+		{
+			PushMatch(Heap, K, Ids[Row], Score);
+		}
+	};
+
+	// One loop per storage format so the inner loop never branches on it
+	switch (GetQuantization())
+	{
+	case EGenVectorQuantization::Float32:
+		for (int32 Row = FirstRow; Row < LastRow; ++Row)
+		{
+			Consider(Row, DotFloat(reinterpret_cast<const float*>(Rows + static_cast<int64>(Row) * RowStride), Query.Float.GetData(), Dimensions));
+		}
+		break;
+
+	case EGenVectorQuantization::Float16:
+		for (int32 Row = FirstRow; Row < LastRow; ++Row)
+		{
+			Consider(Row, DotHalf(reinterpret_cast<const FFloat16*>(Rows + static_cast<int64>(Row) * RowStride), Query.Float.GetData(), Dimensions));
+		}
+		break;
+
+	case EGenVectorQuantization::Int8:
+		for (int32 Row = FirstRow; Row < LastRow; ++Row)
+		{
+			const int32 Dot = DotInt8(reinterpret_cast<const int8*>(Rows + static_cast<int64>(Row) * RowStride), Query.Int8.GetData(), Dimensions);
+			Consider(Row, static_cast<float>(Dot) * Scales[Row] * Query.Int8Scale);
+		}
+		break;
+	}
+}
+
+TArray<FGenVectorMatch> FGenVectorIndex::Search(TArrayView<const float> Query, const FGenVectorSearchOptions& Options) const
+{
+	using namespace GenVectorIndex;
+
+	TArray<FGenVectorMatch> Matches;
+	const int32 Count = Num();
+	const int32 Dimensions = GetDimensions();
+	if (Count == 0 || Options.K <= 0)
+	{
+		return Matches;
+	}
+	if (Query.Num() != Dimensions)
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Vector index query has %d dimensions, the index has %d"), Query.Num(), Dimensions);
+		return Matches;
+	}
+
+	FGenPreparedQuery Prepared;
+	Prepared.Float.Append(Query.GetData(), Query.Num());
+	if (GetMetric() == EGenVectorMetric::Cosine)
+	{
+		Normalize(Prepared.Float.GetData(), Dimensions);
+	}
+	if (GetQuantization() == EGenVectorQuantization::Int8)
+	{
+		Prepared.Int8.SetNumUninitialized(Dimensions);
+		Prepared.Int8Scale = QuantizeInt8(Prepared.Float.GetData(), Dimensions, Prepared.Int8.GetData());
+	}
+
+	// Row ranges to scan: everything, or the lists whose centroids score best against the query
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Ranges;
+	if (NumLists == 0)
+	{
+		Ranges.Emplace(0, Count);
+	}
+	else
+	{
+		const int32 NumProbes = FMath::Clamp(Options.NumProbes > 0 ? Options.NumProbes : FMath::Max(NumLists / 16, 4), 1, NumLists);
+		TArray<FGenVectorMatch> ClosestLists;
+		ClosestLists.Reserve(NumProbes);
+		for (int32 List = 0; List < NumLists; ++List)
+		{
+			PushMatch(ClosestLists, NumProbes, List, DotFloat(Centroids + static_cast<int64>(List) * Dimensions, Prepared.Float.GetData(), Dimensions));
+		}
+		for (const FGenVectorMatch& List : ClosestLists)
+		{
+			if (ListOffsets[List.Id + 1] > ListOffsets[List.Id])
+			{
+				Ranges.Emplace(ListOffsets[List.Id], ListOffsets[List.Id + 1]);
+			}
+		}
+	}
+
+	// Split into chunks for the task graph, small scans stay on the calling thread
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Chunks;
+	for (const TPair<int32, int32>& Range : Ranges)
+	{
+		for (int32 First = Range.Key; First < Range.Value; First += ScanChunkRows)
+		{
+			Chunks.Emplace(First, FMath::Min(First + ScanChunkRows, Range.Value));
+		}
+	}
+
+	const int32 K = FMath::Min(Options.K, Count);
+	if (Chunks.Num() == 1)
+	{
+		Matches.Reserve(K);
+		ScanRows(Chunks[0].Key, Chunks[0].Value, Prepared, Options.MinScore, Matches, K);
+	}
+	else
+	{
+		TArray<TArray<FGenVectorMatch>> ChunkMatches;
+		ChunkMatches.SetNum(Chunks.Num());
+		ParallelFor(Chunks.Num(), [&](int32 Chunk)
+		{
+			ChunkMatches[Chunk].Reserve(K);
+			ScanRows(Chunks[Chunk].Key, Chunks[Chunk].Value, Prepared, Options.MinScore, ChunkMatches[Chunk], K);
+		});
+
+		Matches.Reserve(K * Chunks.Num());
+		for (TArray<FGenVectorMatch>& Chunk : ChunkMatches)
+		{
+			Matches.Append(MoveTemp(Chunk));
+		}
+	}
+
+	Matches.Sort([](const FGenVectorMatch& A, const FGenVectorMatch& B) { return A.Score > B.Score; });
+	if (Matches.Num() > K)
+	{
+		Matches.SetNum(K);
+	}
+	return Matches;
+}
+
+UE::Tasks::TTask<TArray<FGenVectorMatch>> FGenVectorIndex::SearchAsync(TArray<float> Query, const FGenVectorSearchOptions& Options) const
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [This = AsShared(), Query = MoveTemp(Query), Options]()
+	{
+		return This->Search(Query, Options);
+	});
+}
+
+float FGenVectorIndex::DotProduct(const float* A, const float* B, int32 Dimensions)
+{
+	return GenVectorIndex::DotFloat(A, B, Dimensions);
+}
+
+FGenVectorIndexBuilder::FGenVectorIndexBuilder(int32 InDimensions)
+	: Dimensions(FMath::Max(InDimensions, 1))
+{
+}
+
+void FGenVectorIndexBuilder::Reserve(int32 NumVectors)
+{
+	Vectors.Reserve(static_cast<int64>(NumVectors) * Dimensions);
+	Ids.Reserve(NumVectors);
+}
+
+bool FGenVectorIndexBuilder::Add(int64 Id, TArrayView<const float> Vector)
+{
+	if (Vector.Num() != Dimensions || static_cast<int64>(Vectors.Num()) + Dimensions > MAX_int32)
+	{
+		return false;
+	}
+	Vectors.Append(Vector.GetData(), Vector.Num());
+	Ids.Add(Id);
+	return true;
+}
+
+int32 FGenVectorIndexBuilder::AddEmbeddings(const FGenEmbeddingResult& Result, int64 FirstId)
+{
+	if (Result.Dimensions != Dimensions)
+	{
+		return 0;
+	}
+
+	// The builder keeps every value in one int32 indexed array, a result that does not fit is rejected whole
+	const int32 Count = Result.Num();
+	const int64 NumValues = static_cast<int64>(Count) * Dimensions;
+	if (static_cast<int64>(Vectors.Num()) + NumValues > MAX_int32)
+	{
+		UE_LOG(LogGenAI, Error, TEXT("Vector index builder cannot hold %d more vectors of %d dimensions"), Count, Dimensions);
+		return 0;
+	}
+	Reserve(Ids.Num() + Count);
+	Vectors.Append(Result.Values.GetData(), static_cast<int32>(NumValues));
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Ids.Add(FirstId + Index);
+	}
+	return Count;
+}
+
+TSharedPtr<FGenVectorIndex, ESPMode::ThreadSafe> FGenVectorIndexBuilder::Build(const FGenVectorIndexBuildOptions& Options) const
+{
+	using namespace GenVectorIndex;
+
+	LOG_TIME_START(BuildStart);
+
+	const int32 Count = Ids.Num();
+	const bool bCosine = Options.Metric == EGenVectorMetric::Cosine;
+
+	// Cosine stores unit vectors so every score is a plain dot product
+	TArray<float> Source;
+	const TArray<float>* SourceVectors = &Vectors;
+	if (bCosine)
+	{
+		Source = Vectors;
+		ParallelFor(Count, [&Source, this](int32 Row)
+		{
+			Normalize(Source.GetData() + static_cast<int64>(Row) * Dimensions, Dimensions);
+		});
+		SourceVectors = &Source;
+	}
+
+	int32 NumLists = 0;
+	if (Count >= FMath::Max(Options.IvfThreshold, 1))
+	{
+		NumLists = Options.NumLists > 0 ? Options.NumLists : FMath::RoundToInt(FMath::Sqrt(static_cast<float>(Count)));
+		NumLists = FMath::Clamp(NumLists, 1, Count);
+	}
+
+	// Partition rows into lists and lay each list out contiguously
+	TArray<float> CentroidData;
+	TArray<uint32> ListOffsetData;
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Count);
+	if (NumLists > 0)
+	{
+		TrainCentroids(*SourceVectors, Count, Dimensions, NumLists, Options, CentroidData);
+
+		TArray<float> HalfNormsSquared;
+		ComputeHalfNormsSquared(CentroidData, NumLists, Dimensions, HalfNormsSquared);
+		TArray<int32> Assignment;
+		Assignment.SetNumUninitialized(Count);
+		ParallelFor(Count, [&](int32 Row)
+		{
+			Assignment[Row] = FindNearestCentroid(SourceVectors->GetData() + static_cast<int64>(Row) * Dimensions, CentroidData, HalfNormsSquared, Dimensions);
+		});
+
+		ListOffsetData.SetNumZeroed(NumLists + 1);
+		for (const int32 List : Assignment)
+		{
+			ListOffsetData[List + 1]++;
+		}
+		for (int32 List = 0; List < NumLists; ++List)
+		{
+			ListOffsetData[List + 1] += ListOffsetData[List];
+		}
+		TArray<uint32> Cursor(ListOffsetData.GetData(), NumLists);
+		for (int32 Row = 0; Row < Count; ++Row)
+		{
+			Order[Cursor[Assignment[Row]]++] = Row;
+		}
+	}
+	else
+	{
+		for (int32 Row = 0; Row < Count; ++Row)
+		{
+			Order[Row] = Row;
+		}
+	}
+
+	const int32 RowStride = Align(Dimensions * GetElementSize(Options.Quantization), 16);
+
+	FGenVectorIndexHeader Header = {};
+	Header.Magic = Magic;
+	Header.Version = GenVectorIndex::Version;
+	Header.Dimensions = Dimensions;
+	Header.Count = Count;
+	Header.Metric = static_cast<uint8>(Options.Metric);
+	Header.Quantization = static_cast<uint8>(Options.Quantization);
+	Header.NumLists = NumLists;
+	Header.RowStride = RowStride;
+	Header.CentroidsOffset = AlignSection(sizeof(FGenVectorIndexHeader));
+	Header.ListOffsetsOffset = AlignSection(Header.CentroidsOffset + static_cast<uint64>(NumLists) * Dimensions * sizeof(float));
+	Header.IdsOffset = AlignSection(Header.ListOffsetsOffset + (static_cast<uint64>(NumLists) + 1) * sizeof(uint32));
+	Header.ScalesOffset = AlignSection(Header.IdsOffset + static_cast<uint64>(Count) * sizeof(int64));
+	Header.RowsOffset = AlignSection(Header.ScalesOffset + static_cast<uint64>(Count) * sizeof(float));
+	Header.TotalSize = Header.RowsOffset + static_cast<uint64>(Count) * RowStride;
+
+	TSharedPtr<FGenVectorIndex, ESPMode::ThreadSafe> Index = MakeShareable(new FGenVectorIndex());
+	Index->OwnedData.SetNumZeroed(static_cast<int64>(Header.TotalSize));
+	uint8* Data = Index->OwnedData.GetData();
+
+	FMemory::Memcpy(Data, &Header, sizeof(Header));
+	if (NumLists > 0)
+	{
+		FMemory::Memcpy(Data + Header.CentroidsOffset, CentroidData.GetData(), CentroidData.Num() * sizeof(float));
+		FMemory::Memcpy(Data + Header.ListOffsetsOffset, ListOffsetData.GetData(), ListOffsetData.Num() * sizeof(uint32));
+	}
+
+	int64* OutIds = reinterpret_cast<int64*>(Data + Header.IdsOffset);
+	float* OutScales = reinterpret_cast<float*>(Data + Header.ScalesOffset);
+	uint8* OutRows = Data + Header.RowsOffset;
+	ParallelFor(Count, [&](int32 Slot)
+	{
+		const int32 Row = Order[Slot];
+		const float* Vector = SourceVectors->GetData() + static_cast<int64>(Row) * Dimensions;
+		uint8* OutRow = OutRows + static_cast<int64>(Slot) * RowStride;
+		OutIds[Slot] = Ids[Row];
+
+		switch (Options.Quantization)
+		{
+		case EGenVectorQuantization::Float32:
+			FMemory::Memcpy(OutRow, Vector, Dimensions * sizeof(float));
+			break;
+
+		case EGenVectorQuantization::Float16:
+			for (int32 Component = 0; Component < Dimensions; ++Component)
+			{
+				reinterpret_cast<FFloat16*>(OutRow)[Component] = FFloat16(Vector[Component]);
+			}
+			break;
+
+		case EGenVectorQuantization::Int8:
+			OutScales[Slot] = QuantizeInt8(Vector, Dimensions, reinterpret_cast<int8*>(OutRow));
+			break;
+		}
+	});
+
+	Index->Data = Data;
+	Index->DataSize = Index->OwnedData.Num();
+	verify(Index->BindSections());
+
+	LOG_TIME_ELAPSED(BuildStart, TEXT("Vector index build"));
+	return Index;
+}
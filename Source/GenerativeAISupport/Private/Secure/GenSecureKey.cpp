@@ -42,6 +42,9 @@ FString UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs Org)
 		case EGenAIOrgs::XAI:
 			EnvKey = TEXT("PS_XAIAPIKEY");
 			break;
+		case EGenAIOrgs::Local:
+			EnvKey = TEXT("PS_LOCALAPIKEY");
+			break;
 		default:
 			return TEXT("");
 		}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Tasks/GenAITasks.h"
+
+FGenAITasks::FChatTask FGenAITasks::OpenAIChat(const FGenChatSettings& ChatSettings, const FGenRequestOptions& Options)
+{
+	return FromSubmission([ChatSettings, Options](UGenRequestSubsystem& Subsystem, FGenRequestCallback&& OnComplete)
+	{
+		Subsystem.SubmitOpenAIChat(ChatSettings, MoveTemp(OnComplete), Options);
+	});
+}
+
+FGenAITasks::FChatTask FGenAITasks::OpenAIStructuredOutput(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FGenRequestOptions& Options)
+{
+	return FromSubmission([StructuredChatSettings, Options](UGenRequestSubsystem& Subsystem, FGenRequestCallback&& OnComplete)
+	{
+		Subsystem.SubmitOpenAIStructuredOutput(StructuredChatSettings, MoveTemp(OnComplete), Options);
+	});
+}
+
+FGenAITasks::FChatTask FGenAITasks::ClaudeChat(const FGenClaudeChatSettings& ChatSettings, const FGenRequestOptions& Options)
+{
+	return FromSubmission([ChatSettings, Options](UGenRequestSubsystem& Subsystem, FGenRequestCallback&& OnComplete)
+	{
+		Subsystem.SubmitClaudeChat(ChatSettings, MoveTemp(OnComplete), Options);
+	});
+}
+
+FGenAITasks::FChatTask FGenAITasks::DeepSeekChat(const FGenDSeekChatSettings& ChatSettings, const FGenRequestOptions& Options)
+{
+	return FromSubmission([ChatSettings, Options](UGenRequestSubsystem& Subsystem, FGenRequestCallback&& OnComplete)
+	{
+		Subsystem.SubmitDeepSeekChat(ChatSettings, MoveTemp(OnComplete), Options);
+	});
+}
+
+FGenAITasks::FChatTask FGenAITasks::XAIChat(const FGenXAIChatSettings& ChatSettings, const FGenRequestOptions& Options)
+{
+	return FromSubmission([ChatSettings, Options](UGenRequestSubsystem& Subsystem, FGenRequestCallback&& OnComplete)
+	{
+		Subsystem.SubmitXAIChat(ChatSettings, MoveTemp(OnComplete), Options);
+	});
+}
+
+FGenAITasks::FChatTask FGenAITasks::FromSubmission(TFunction<void(UGenRequestSubsystem& Subsystem, FGenRequestCallback&& OnComplete)>&& Submit)
+{
+	TSharedRef<FGenChatResult, ESPMode::ThreadSafe> Result = MakeShared<FGenChatResult, ESPMode::ThreadSafe>();
+	UE::Tasks::FTaskEvent Completed(UE_SOURCE_LOCATION);
+
+	// The subsystem is game thread only, the task itself can be created and waited on anywhere
+	auto SubmitOnGameThread = [Submit = MoveTemp(Submit), Result, Completed]() mutable
+	{
+		UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+		if (!Subsystem)
+		{
+			Result->Error = TEXT("Request subsystem not available");
+			Completed.Trigger();
+			return;
+		}
+
+		Submit(*Subsystem, [Result, Completed](const FString& Response, const FString& Error, bool bSuccess) mutable
+		{
+			Result->Response = Response;
+			Result->Error = Error;
+			Result->bSuccess = bSuccess;
+			Completed.Trigger();
+		});
+	};
+
+	if (IsInGameThread())
+	{
+		SubmitOnGameThread();
+	}
+	else
+	{
+		AsyncTask(ENamedThreads::GameThread, MoveTemp(SubmitOnGameThread));
+	}
+
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Result]() { return *Result; }, UE::Tasks::Prerequisites(Completed));
+}
+
+UE::Tasks::TTask<TArray<FGenChatResult>> FGenAITasks::WhenAll(const TArray<FChatTask>& Tasks)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Tasks]() mutable
+	{
+		TArray<FGenChatResult> Results;
+		Results.Reserve(Tasks.Num());
+		for (FChatTask& Task : Tasks)
+		{
+			Results.Add(Task.GetResult());
+		}
+		return Results;
+	}, Tasks);
+}
+
+UE::Tasks::TTask<FGenChatAnyResult> FGenAITasks::WhenAny(const TArray<FChatTask>& Tasks)
+{
+	UE::Tasks::FTaskEvent FirstDone(UE_SOURCE_LOCATION);
+	TSharedRef<std::atomic<int32>, ESPMode::ThreadSafe> Winner = MakeShared<std::atomic<int32>, ESPMode::ThreadSafe>(INDEX_NONE);
+
+	if (Tasks.Num() == 0)
+	{
+		FirstDone.Trigger();
+	}
+
+	for (int32 Index = 0; Index < Tasks.Num(); ++Index)
+	{
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Index, Winner, FirstDone]() mutable
+		{
+			int32 Expected = INDEX_NONE;
+			if (Winner->compare_exchange_strong(Expected, Index))
+			{
+				FirstDone.Trigger();
+			}
+		}, UE::Tasks::Prerequisites(Tasks[Index]));
+	}
+
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Tasks, Winner]() mutable
+	{
+		FGenChatAnyResult AnyResult;
+		AnyResult.Index = Winner->load();
+		if (Tasks.IsValidIndex(AnyResult.Index))
+		{
+			AnyResult.Result = Tasks[AnyResult.Index].GetResult();
+		}
+		return AnyResult;
+	}, UE::Tasks::Prerequisites(FirstDone));
+}
@@ -0,0 +1,614 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Tokenizer/GenTokenizer.h"
+
+#include "Hash/CityHash.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define GEN_TOKENIZER_SSE2 1
+#else
+#define GEN_TOKENIZER_SSE2 0
+#endif
+
+namespace GenTokenizer
+{
+	// Per-message framing tokens added by chat endpoints, and the tokens priming the reply
+	constexpr int32 TokensPerMessage = 3;
+	constexpr int32 TokensPerReply = 3;
+
+	// Enough for a few thousand distinct words of dialogue, cleared rather than evicted when full
+	constexpr int32 MaxCachedPieces = 65536;
+
+	enum ECharClass : uint8
+	{
+		Other = 0,
+		Letter = 1,
+		Number = 2,
+		Space = 4,
+		Newline = 8
+	};
+
+	struct FAsciiClassTable
+	{
+		uint8 Classes[128];
+
+		FAsciiClassTable()
+		{
+			for (int32 Char = 0; Char < 128; ++Char)
+			{
+				uint8 Class = Other;
+				if ((Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z'))
+				{
+					Class = Letter;
+				}
+				else if (Char >= '0' && Char <= '9')
+				{
+					Class = Number;
+				}
+				else if (Char == '\r' || Char == '\n')
+				{
+					Class = Space | Newline;
+				}
+				else if (Char == ' ' || Char == '\t' || Char == '\v' || Char == '\f')
+				{
+					Class = Space;
+				}
+				Classes[Char] = Class;
+			}
+		}
+	};
+
+	static const FAsciiClassTable AsciiClassTable;
+
+	/** Decodes one UTF-8 code point at Pos, invalid bytes are returned as themselves */
+	static uint32 DecodeCodePoint(const uint8* Data, int32 Length, int32 Pos, int32& OutSize)
+	{
+		const uint8 Lead = Data[Pos];
+		int32 Size = Lead < 0x80 ? 1 : (Lead >> 5) == 0x6 ? 2 : (Lead >> 4) == 0xE ? 3 : (Lead >> 3) == 0x1E ? 4 : 1;
+		if (Pos + Size > Length)
+		{
+			Size = 1;
+		}
+
+		OutSize = Size;
+		switch (Size)
+		{
+		case 2: return ((Lead & 0x1F) << 6) | (Data[Pos + 1] & 0x3F);
+		case 3: return ((Lead & 0x0F) << 12) | ((Data[Pos + 1] & 0x3F) << 6) | (Data[Pos + 2] & 0x3F);
+		case 4: return ((Lead & 0x07) << 18) | ((Data[Pos + 1] & 0x3F) << 12) | ((Data[Pos + 2] & 0x3F) << 6) | (Data[Pos + 3] & 0x3F);
+		default: return Lead;
+		}
+	}
+
+	static uint8 ClassifyCodePoint(uint32 CodePoint)
+	{
+		if (CodePoint < 128)
+		{
+			return AsciiClassTable.Classes[CodePoint];
+		}
+		if (CodePoint <= 0xFFFF)
+		{
+			const TCHAR Char = static_cast<TCHAR>(CodePoint);
+			if (FChar::IsWhitespace(Char))
+			{
+				return CodePoint == 0x85 || CodePoint == 0x2028 || CodePoint == 0x2029 ? (Space | Newline) : Space;
+			}
+			if (FChar::IsAlpha(Char))
+			{
+				return Letter;
+			}
+		}
+		return Other;
+	}
+
+	static uint8 ClassAt(const uint8* Data, int32 Length, int32 Pos, int32& OutSize)
+	{
+		if (Pos >= Length)
+		{
+			OutSize = 0;
+			return Other;
+		}
+		if (Data[Pos] < 0x80)
+		{
+			OutSize = 1;
+			return AsciiClassTable.Classes[Data[Pos]];
+		}
+		return ClassifyCodePoint(DecodeCodePoint(Data, Length, Pos, OutSize));
+	}
+
+	/** End of the run of ASCII letters starting at Pos, 16 bytes at a time where SSE2 is available */
+	static int32 ScanAsciiLetters(const uint8* Data, int32 Pos, int32 Length)
+	{
+#if GEN_TOKENIZER_SSE2
+		const __m128i CaseBit = _mm_set1_epi8(0x20);
+		const __m128i BeforeA = _mm_set1_epi8('a' - 1);
+		const __m128i AfterZ = _mm_set1_epi8('z' + 1);
+		while (Pos + 16 <= Length)
+		{
+			// Folding case maps letters onto a..z, bytes >= 0x80 are negative as signed and fail the first compare
+			const __m128i Folded = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Pos)), CaseBit);
+			const __m128i IsLetter = _mm_and_si128(_mm_cmpgt_epi8(Folded, BeforeA), _mm_cmplt_epi8(Folded, AfterZ));
+			const uint32 Mask = static_cast<uint32>(_mm_movemask_epi8(IsLetter));
+			if (Mask != 0xFFFF)
+			{
+				return Pos + static_cast<int32>(FMath::CountTrailingZeros(~Mask & 0xFFFF));
+			}
+			Pos += 16;
+		}
+#endif
+		while (Pos < Length && Data[Pos] < 0x80 && AsciiClassTable.Classes[Data[Pos]] == Letter)
+		{
+			++Pos;
+		}
+		return Pos;
+	}
+
+	/** End of the run of letters starting at Pos, ASCII runs take the vectorized path */
+	static int32 ScanLetters(const uint8* Data, int32 Pos, int32 Length)
+	{
+		while (Pos < Length)
+		{
+			Pos = ScanAsciiLetters(Data, Pos, Length);
+			int32 Size = 0;
+			if (Pos >= Length || Data[Pos] < 0x80 || ClassAt(Data, Length, Pos, Size) != Letter)
+			{
+				break;
+			}
+			Pos += Size;
+		}
+		return Pos;
+	}
+
+	static uint64 HashBytes(const uint8* Bytes, int32 Length)
+	{
+		return CityHash64(reinterpret_cast<const char*>(Bytes), static_cast<uint32>(Length));
+	}
+
+	static FString GetVocabularyPath(EGenTokenizerEncoding Encoding)
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("GenerativeAISupport"));
+		if (!Plugin.IsValid())
+		{
+			return FString();
+		}
+
+		const TCHAR* FileName = Encoding == EGenTokenizerEncoding::O200K ? TEXT("o200k_base.tiktoken")
+			: Encoding == EGenTokenizerEncoding::Claude ? TEXT("claude.tiktoken")
+			: TEXT("cl100k_base.tiktoken");
+		return FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources"), TEXT("Tokenizers"), FileName);
+	}
+}
+
+TSharedRef<FGenBPETokenizer, ESPMode::ThreadSafe> FGenBPETokenizer::Get(EGenTokenizerEncoding Encoding)
+{
+	static FCriticalSection InstancesLock;
+	static TMap<EGenTokenizerEncoding, TSharedRef<FGenBPETokenizer, ESPMode::ThreadSafe>> Instances;
+
+	FScopeLock ScopeLock(&InstancesLock);
+	if (const TSharedRef<FGenBPETokenizer, ESPMode::ThreadSafe>* Existing = Instances.Find(Encoding))
+	{
+		return *Existing;
+	}
+
+	FString Path = GenTokenizer::GetVocabularyPath(Encoding);
+	if (Encoding == EGenTokenizerEncoding::Claude && !FPaths::FileExists(Path))
+	{
+		// Closest public vocabulary for Claude estimates
+		Path = GenTokenizer::GetVocabularyPath(EGenTokenizerEncoding::CL100K);
+	}
+
+	// Parsing a vocabulary takes a while, counts are estimated until it is ready instead of stalling the caller
+	TSharedRef<FGenBPETokenizer, ESPMode::ThreadSafe> Tokenizer = MakeShareable(new FGenBPETokenizer());
+	Tokenizer->LoadTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Tokenizer, Path = MoveTemp(Path)]()
+	{
+		Tokenizer->LoadVocabulary(Path);
+	});
+	Instances.Add(Encoding, Tokenizer);
+	return Tokenizer;
+}
+
+EGenTokenizerEncoding FGenBPETokenizer::GetEncodingForModel(const FString& Model)
+{
+	if (Model.StartsWith(TEXT("gpt-3.5")) || (Model.StartsWith(TEXT("gpt-4")) && !Model.StartsWith(TEXT("gpt-4o")) && !Model.StartsWith(TEXT("gpt-4.1"))))
+	{
+		return EGenTokenizerEncoding::CL100K;
+	}
+	if (Model.StartsWith(TEXT("claude")))
+	{
+		return EGenTokenizerEncoding::Claude;
+	}
+	return EGenTokenizerEncoding::O200K;
+}
+
+void FGenBPETokenizer::WaitForVocabulary() const
+{
+	LoadTask.Wait();
+}
+
+void FGenBPETokenizer::LoadVocabulary(const FString& VocabularyPath)
+{
+	TArray<FString> Lines;
+	if (VocabularyPath.IsEmpty() || !FFileHelper::LoadFileToStringArray(Lines, *VocabularyPath))
+	{
+		UE_LOG(LogGenAI, Log, TEXT("Tokenizer vocabulary %s not found, token counts will be estimated"), *VocabularyPath);
+		return;
+	}
+
+	LOG_TIME_START(LoadStart);
+	Ranks.Reserve(Lines.Num());
+	TArray<uint8> Bytes;
+	for (const FString& Line : Lines)
+	{
+		FString Encoded, Rank;
+		if (!Line.Split(TEXT(" "), &Encoded, &Rank) || !FBase64::Decode(Encoded, Bytes) || Bytes.Num() == 0)
+		{
+			continue;
+		}
+		Ranks.Add(GenTokenizer::HashBytes(Bytes.GetData(), Bytes.Num()), FCString::Atoi(*Rank));
+	}
+	LOG_TIME_ELAPSED(LoadStart, TEXT("Tokenizer vocabulary load"));
+	bVocabularyLoaded.store(Ranks.Num() > 0, std::memory_order_release);
+}
+
+void FGenBPETokenizer::PreTokenize(const uint8* Data, int32 Length, TArray<TPair<int32, int32>>& OutPieces)
+{
+	using namespace GenTokenizer;
+
+	// Hand-written equivalent of the cl100k pre-tokenizer pattern:
+	// 's|'t|'re|'ve|'m|'ll|'d | [^\r\n\p{L}\p{N}]?\p{L}+ | \p{N}{1,3} | ?[^\s\p{L}\p{N}]+[\r\n]* | \s*[\r\n]+ | \s+(?!\S) | \s+
+	int32 Pos = 0;
+	while (Pos < Length)
+	{
+		const int32 Start = Pos;
+		int32 Size = 0;
+		const uint8 Class = ClassAt(Data, Length, Pos, Size);
+
+		// Contractions
+		if (Data[Pos] == '\'' && Pos + 1 < Length)
+		{
+			const uint8 Next = FChar::ToLower(static_cast<TCHAR>(Data[Pos + 1]));
+			const uint8 After = Pos + 2 < Length ? FChar::ToLower(static_cast<TCHAR>(Data[Pos + 2])) : 0;
+			int32 ContractionLength = 0;
+			if ((Next == 'r' && After == 'e') || (Next == 'v' && After == 'e') || (Next == 'l' && After == 'l'))
+			{
+				ContractionLength = 3;
+			}
+			else if (Next == 's' || Next == 't' || Next == 'm' || Next == 'd')
+			{
+				ContractionLength = 2;
+			}
+
+			if (ContractionLength > 0)
+			{
+				OutPieces.Emplace(Start, ContractionLength);
+				Pos += ContractionLength;
+				continue;
+			}
+		}
+
+		// Letters with an optional leading non-letter, non-number, non-newline character
+		if (Class == Letter)
+		{
+			Pos = ScanLetters(Data, Pos, Length);
+			OutPieces.Emplace(Start, Pos - Start);
+			continue;
+		}
+		if (!(Class & (Number | Newline)))
+		{
+			int32 NextSize = 0;
+			if (ClassAt(Data, Length, Pos + Size, NextSize) == Letter)
+			{
+				Pos = ScanLetters(Data, Pos + Size, Length);
+				OutPieces.Emplace(Start, Pos - Start);
+				continue;
+			}
+		}
+
+		// Up to three digits
+		if (Class == Number)
+		{
+			int32 Digits = 0;
+			while (Pos < Length && Digits < 3 && ClassAt(Data, Length, Pos, Size) == Number)
+			{
+				Pos += Size;
+				++Digits;
+			}
+			OutPieces.Emplace(Start, Pos - Start);
+			continue;
+		}
+
+		// Punctuation with an optional leading space and trailing newlines
+		{
+			int32 Cursor = Pos;
+			if (Data[Cursor] == ' ')
+			{
+				++Cursor;
+			}
+
+			const int32 SymbolStart = Cursor;
+			int32 SymbolSize = 0;
+			while (Cursor < Length && ClassAt(Data, Length, Cursor, SymbolSize) == Other)
+			{
+				Cursor += SymbolSize;
+			}
+
+			if (Cursor > SymbolStart)
+			{
+				while (Cursor < Length && (Data[Cursor] == '\r' || Data[Cursor] == '\n'))
+				{
+					++Cursor;
+				}
+				OutPieces.Emplace(Start, Cursor - Start);
+				Pos = Cursor;
+				continue;
+			}
+		}
+
+		// Whitespace runs
+		int32 RunEnd = Pos;
+		int32 LastNewlineEnd = INDEX_NONE;
+		int32 LastCharStart = Pos;
+		while (RunEnd < Length)
+		{
+			const uint8 RunClass = ClassAt(Data, Length, RunEnd, Size);
+			if (!(RunClass & Space))
+			{
+				break;
+			}
+			LastCharStart = RunEnd;
+			RunEnd += Size;
+			if (RunClass & Newline)
+			{
+				LastNewlineEnd = RunEnd;
+			}
+		}
+
+		if (LastNewlineEnd != INDEX_NONE)
+		{
+			Pos = LastNewlineEnd;
+		}
+		else if (RunEnd < Length && LastCharStart > Start)
+		{
+			// Leave the last space to prefix the following word
+			Pos = LastCharStart;
+		}
+		else
+		{
+			Pos = FMath::Max(RunEnd, Start + FMath::Max(Size, 1));
+		}
+		OutPieces.Emplace(Start, Pos - Start);
+	}
+}
+
+TArray<int32> FGenBPETokenizer::Encode(const FString& Text) const
+{
+	TArray<int32> Tokens;
+	WaitForVocabulary();
+	if (!HasVocabulary())
+	{
+		return Tokens;
+	}
+
+	const FTCHARToUTF8 Utf8(*Text);
+	const uint8* Data = reinterpret_cast<const uint8*>(Utf8.Get());
+
+	TArray<TPair<int32, int32>> Pieces;
+	PreTokenize(Data, Utf8.Length(), Pieces);
+
+	Tokens.Reserve(Pieces.Num() + Pieces.Num() / 2);
+	for (const TPair<int32, int32>& Piece : Pieces)
+	{
+		EncodePiece(Data + Piece.Key, Piece.Value, Tokens);
+	}
+	return Tokens;
+}
+
+int32 FGenBPETokenizer::CountTokens(const FString& Text) const
+{
+	const FTCHARToUTF8 Utf8(*Text);
+	const uint8* Data = reinterpret_cast<const uint8*>(Utf8.Get());
+
+	TArray<TPair<int32, int32>> Pieces;
+	PreTokenize(Data, Utf8.Length(), Pieces);
+
+	int32 Count = 0;
+	for (const TPair<int32, int32>& Piece : Pieces)
+	{
+		Count += CountPiece(Data + Piece.Key, Piece.Value);
+	}
+	return Count;
+}
+
+int32 FGenBPETokenizer::CountChatTokens(const TArray<FGenChatMessage>& Messages) const
+{
+	int32 Count = GenTokenizer::TokensPerReply;
+	for (const FGenChatMessage& Message : Messages)
+	{
+		Count += GenTokenizer::TokensPerMessage + CountTokens(Message.Role) + CountTokens(Message.Content);
+	}
+	return Count;
+}
+
+int32 FGenBPETokenizer::CountPiece(const uint8* Piece, int32 Length) const
+{
+	if (!HasVocabulary())
+	{
+		// Without a vocabulary, one token per four bytes of each pre-token is a close estimate for English
+		return FMath::Max(1, FMath::DivideAndRoundUp(Length, 4));
+	}
+
+	const uint64 Hash = GenTokenizer::HashBytes(Piece, Length);
+	{
+		FReadScopeLock ReadLock(PieceCountCacheLock);
+		if (const int32* Cached = PieceCountCache.Find(Hash))
+		{
+			return *Cached;
+		}
+	}
+
+	TArray<int32> Encoded;
+	EncodePiece(Piece, Length, Encoded);
+
+	FWriteScopeLock WriteLock(PieceCountCacheLock);
+	if (PieceCountCache.Num() >= GenTokenizer::MaxCachedPieces)
+	{
+		PieceCountCache.Reset();
+	}
+	PieceCountCache.Add(Hash, Encoded.Num());
+	return Encoded.Num();
+}
+
+int32 FGenBPETokenizer::GetRank(const uint8* Bytes, int32 Length) const
+{
+	const int32* Rank = Ranks.Find(GenTokenizer::HashBytes(Bytes, Length));
+	return Rank ? *Rank : MAX_int32;
+}
+
+void FGenBPETokenizer::EncodePiece(const uint8* Piece, int32 Length, TArray<int32>& OutTokens) const
+{
+	const int32 WholeRank = GetRank(Piece, Length);
+	if (WholeRank != MAX_int32)
+	{
+		OutTokens.Add(WholeRank);
+		return;
+	}
+
+	// tiktoken's byte pair merge: Parts holds (start offset, rank of merging with the next part)
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Parts;
+	Parts.Reserve(Length + 1);
+	for (int32 Index = 0; Index + 1 < Length; ++Index)
+	{
+		Parts.Emplace(Index, GetRank(Piece + Index, 2));
+	}
+	Parts.Emplace(Length - 1, MAX_int32);
+	Parts.Emplace(Length, MAX_int32);
+
+	auto GetMergedRank = [this, Piece, &Parts](int32 Index)
+	{
+		if (Index + 3 < Parts.Num())
+		{
+			const int32 Start = Parts[Index].Key;
+			return GetRank(Piece + Start, Parts[Index + 3].Key - Start);
+		}
+		return MAX_int32;
+	};
+
+	while (true)
+	{
+		int32 MinRank = MAX_int32;
+		int32 MinIndex = INDEX_NONE;
+		for (int32 Index = 0; Index + 1 < Parts.Num(); ++Index)
+		{
+			if (Parts[Index].Value < MinRank)
+			{
+				MinRank = Parts[Index].Value;
+				MinIndex = Index;
+			}
+		}
+
+		if (MinIndex == INDEX_NONE)
+		{
+			break;
+		}
+
+		if (MinIndex > 0)
+		{
+			Parts[MinIndex - 1].Value = GetMergedRank(MinIndex - 1);
+		}
+		Parts[MinIndex].Value = GetMergedRank(MinIndex);
+		Parts.RemoveAt(MinIndex + 1);
+	}
+
+	for (int32 Index = 0; Index + 1 < Parts.Num(); ++Index)
+	{
+		const int32 Start = Parts[Index].Key;
+		const int32 Rank = GetRank(Piece + Start, Parts[Index + 1].Key - Start);
+		// Every single byte is in a complete vocabulary, an unknown byte means a truncated file
+		OutTokens.Add(Rank != MAX_int32 ? Rank : 0);
+	}
+}
+
+int32 FGenContextTrimmer::TrimToBudget(TArray<FGenChatMessage>& Messages, int32 MaxPromptTokens, EGenTokenizerEncoding Encoding,
+                                       int32 KeepRecentMessages)
+{
+	if (MaxPromptTokens <= 0 || Messages.Num() == 0)
+	{
+		return 0;
+	}
+
+	const TSharedRef<FGenBPETokenizer, ESPMode::ThreadSafe> Tokenizer = FGenBPETokenizer::Get(Encoding);
+
+	// Count every message once, then drop from the front using the cached counts
+	TArray<int32> MessageTokens;
+	MessageTokens.Reserve(Messages.Num());
+	int32 Total = GenTokenizer::TokensPerReply;
+	for (const FGenChatMessage& Message : Messages)
+	{
+		const int32 Tokens = GenTokenizer::TokensPerMessage + Tokenizer->CountTokens(Message.Role) + Tokenizer->CountTokens(Message.Content);
+		MessageTokens.Add(Tokens);
+		Total += Tokens;
+	}
+
+	const int32 FirstProtected = FMath::Max(0, Messages.Num() - FMath::Max(KeepRecentMessages, 0));
+	TBitArray<> Remove(false, Messages.Num());
+	int32 Removed = 0;
+	for (int32 Index = 0; Index < FirstProtected && Total > MaxPromptTokens; ++Index)
+	{
+		if (Messages[Index].Role == TEXT("system"))
+		{
+			continue;
+		}
+		Remove[Index] = true;
+		Total -= MessageTokens[Index];
+		++Removed;
+	}
+
+	if (Removed > 0)
+	{
+		int32 WriteIndex = 0;
+		for (int32 ReadIndex = 0; ReadIndex < Messages.Num(); ++ReadIndex)
+		{
+			if (!Remove[ReadIndex])
+			{
+				if (WriteIndex != ReadIndex)
+				{
+					Messages[WriteIndex] = MoveTemp(Messages[ReadIndex]);
+				}
+				++WriteIndex;
+			}
+		}
+		Messages.SetNum(WriteIndex);
+	}
+
+	if (Total > MaxPromptTokens)
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Prompt still needs %d tokens after trimming, budget is %d"), Total, MaxPromptTokens);
+	}
+	return Removed;
+}
+
+int32 UGenTokenizerLibrary::CountTokens(const FString& Text, EGenTokenizerEncoding Encoding)
+{
+	return FGenBPETokenizer::Get(Encoding)->CountTokens(Text);
+}
+
+int32 UGenTokenizerLibrary::CountChatTokens(const TArray<FGenChatMessage>& Messages, EGenTokenizerEncoding Encoding)
+{
+	return FGenBPETokenizer::Get(Encoding)->CountChatTokens(Messages);
+}
+
+int32 UGenTokenizerLibrary::TrimMessagesToBudget(TArray<FGenChatMessage>& Messages, int32 MaxPromptTokens,
+                                                 EGenTokenizerEncoding Encoding, int32 KeepRecentMessages)
+{
+	return FGenContextTrimmer::TrimToBudget(Messages, MaxPromptTokens, Encoding, KeepRecentMessages);
+}
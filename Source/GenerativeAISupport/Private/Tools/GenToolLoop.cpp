@@ -0,0 +1,557 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Tools/GenToolLoop.h"
+
+#include "GenAISupportRuntimeSettings.h"
+#include "Data/Anthropic/GenClaudeChatStructs.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Models/OpenAI/GenOAIWireFormat.h"
+#include "Network/GenConnectionManager.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Utilities/GenImageEncoder.h"
+#include "Utilities/GenUtils.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace GenToolLoop
+{
+	static FString GetDefaultModel(EGenAIOrgs Org)
+	{
+		switch (Org)
+		{
+		case EGenAIOrgs::OpenAI:
+			return UGenOAIModelUtils::ChatModelToString(EGenOAIChatModel::GPT_4O_Mini);
+		case EGenAIOrgs::Anthropic:
+			return UGenUtils::GetEnumDisplayName(StaticEnum<EClaudeModels>(), static_cast<int32>(EClaudeModels::Claude_4_Sonnet));
+		case EGenAIOrgs::DeepSeek:
+			return UGenUtils::GetEnumDisplayName(StaticEnum<EDeepSeekModels>(), static_cast<int32>(EDeepSeekModels::Chat));
+		case EGenAIOrgs::XAI:
+			return TEXT("grok-3-latest");
+		case EGenAIOrgs::Local:
+			{
+				const TArray<FString>& LocalModels = GetDefault<UGenAISupportRuntimeSettings>()->LocalModels;
+				return LocalModels.Num() > 0 ? LocalModels[0] : FString();
+			}
+		default:
+			return FString();
+		}
+	}
+
+	static FString ToJsonString(const TSharedRef<FJsonObject>& JsonObject)
+	{
+		FString Result;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+		return Result;
+	}
+
+	/**
+	 * Provider specific encoding of the conversation, its tools and the model's tool calls
+	 */
+	class FProtocol
+	{
+	public:
+		virtual ~FProtocol() = default;
+
+		/** Request carrying the conversation so far */
+		virtual TSharedRef<IHttpRequest, ESPMode::ThreadSafe> MakeRequest() = 0;
+
+		/** Reads the model's turn, a turn with tool calls is appended to the conversation */
+		virtual bool ReadTurn(const FJsonObject& Response, FString& OutContent, TArray<FGenToolCall>& OutCalls) = 0;
+
+		virtual void AddResults(const TArray<FGenToolCall>& Calls, const TArray<FString>& Results) = 0;
+
+		/** Images of the conversation, in the order of their placeholders in the messages */
+		const TArray<FGenChatImage>& GetImages() const { return Images; }
+
+	protected:
+		TSharedPtr<FJsonObject> Payload;
+		TArray<TSharedPtr<FJsonValue>> Messages;
+		TArray<FGenChatImage> Images;
+	};
+
+	/**
+	 * Chat completions tools, spoken by OpenAI and the OpenAI-compatible providers
+	 */
+	class FOpenAIProtocol : public FProtocol
+	{
+	public:
+		FOpenAIProtocol(EGenAIOrgs Org, const FString& Model, const FGenToolChatSettings& ChatSettings, const FGenToolbox& Toolbox)
+		{
+			const UGenAISupportRuntimeSettings* Settings = GetDefault<UGenAISupportRuntimeSettings>();
+			Url = Settings->GetBaseUrl(Org) + TEXT("/chat/completions");
+
+			const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(Org);
+			if (Org == EGenAIOrgs::Local)
+			{
+				AuthHeader = Settings->LocalAuthHeader;
+				AuthValue = ApiKey.IsEmpty() ? FString() : Settings->LocalAuthPrefix + ApiKey;
+				Timeout = Settings->LocalRequestTimeoutSeconds;
+			}
+			else
+			{
+				AuthHeader = TEXT("Authorization");
+				AuthValue = FString::Printf(TEXT("Bearer %s"), *ApiKey);
+			}
+
+			const TSharedRef<FJsonObject> ChatPayload = FGenOAIWireFormat::MakeChatPayload(Model, ChatSettings.Messages, &Images);
+			Messages = ChatPayload->GetArrayField(TEXT("messages"));
+			ChatPayload->SetNumberField(Org == EGenAIOrgs::OpenAI ? TEXT("max_completion_tokens") : TEXT("max_tokens"), ChatSettings.MaxTokens);
+			ChatPayload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
+
+			TArray<TSharedPtr<FJsonValue>> ToolsArray;
+			for (const FGenTool& Tool : Toolbox.GetTools())
+			{
+				const TSharedRef<FJsonObject> Function = MakeShared<FJsonObject>();
+				Function->SetStringField(TEXT("name"), Tool.Name);
+				Function->SetStringField(TEXT("description"), Tool.Description);
+				Function->SetObjectField(TEXT("parameters"), Tool.Parameters);
+
+				const TSharedRef<FJsonObject> JsonTool = MakeShared<FJsonObject>();
+				JsonTool->SetStringField(TEXT("type"), TEXT("function"));
+				JsonTool->SetObjectField(TEXT("function"), Function);
+				ToolsArray.Add(MakeShared<FJsonValueObject>(JsonTool));
+			}
+			if (ToolsArray.Num() > 0)
+			{
+				ChatPayload->SetArrayField(TEXT("tools"), ToolsArray);
+				// Only OpenAI documents the switch, compatible servers may reject unknown fields
+				if (Org == EGenAIOrgs::OpenAI)
+				{
+					ChatPayload->SetBoolField(TEXT("parallel_tool_calls"), ChatSettings.bParallelToolCalls);
+				}
+			}
+			Payload = ChatPayload;
+		}
+
+		virtual TSharedRef<IHttpRequest, ESPMode::ThreadSafe> MakeRequest() override
+		{
+			Payload->SetArrayField(TEXT("messages"), Messages);
+			const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FGenOAIWireFormat::MakeChatRequest(Url, Payload.ToSharedRef(), AuthHeader, AuthValue);
+			if (Timeout > 0.0f)
+			{
+				HttpRequest->SetTimeout(Timeout);
+			}
+			return HttpRequest;
+		}
+
+		virtual bool ReadTurn(const FJsonObject& Response, FString& OutContent, TArray<FGenToolCall>& OutCalls) override
+		{
+			const TArray<TSharedPtr<FJsonValue>>* ChoicesArray;
+			const TSharedPtr<FJsonObject>* FirstChoiceObject;
+			const TSharedPtr<FJsonObject>* MessageObject;
+			if (!Response.TryGetArrayField(TEXT("choices"), ChoicesArray) || ChoicesArray->Num() == 0
+				|| !(*ChoicesArray)[0]->TryGetObject(FirstChoiceObject)
+				|| !(*FirstChoiceObject)->TryGetObjectField(TEXT("message"), MessageObject))
+			{
+				return false;
+			}
+
+			// Content is null when the turn only calls tools
+			(*MessageObject)->TryGetStringField(TEXT("content"), OutContent);
+
+			const TArray<TSharedPtr<FJsonValue>>* ToolCallsArray;
+			if ((*MessageObject)->TryGetArrayField(TEXT("tool_calls"), ToolCallsArray) && ToolCallsArray->Num() > 0)
+			{
+				for (const TSharedPtr<FJsonValue>& ToolCallValue : *ToolCallsArray)
+				{
+					const TSharedPtr<FJsonObject>* ToolCallObject;
+					const TSharedPtr<FJsonObject>* FunctionObject;
+					if (ToolCallValue->TryGetObject(ToolCallObject) && (*ToolCallObject)->TryGetObjectField(TEXT("function"), FunctionObject))
+					{
+						FGenToolCall& Call = OutCalls.AddDefaulted_GetRef();
+						(*ToolCallObject)->TryGetStringField(TEXT("id"), Call.Id);
+						(*FunctionObject)->TryGetStringField(TEXT("name"), Call.Name);
+						(*FunctionObject)->TryGetStringField(TEXT("arguments"), Call.Arguments);
+					}
+				}
+
+				// The assistant turn goes back verbatim so the results can refer to its call ids
+				Messages.Add(MakeShared<FJsonValueObject>(*MessageObject));
+			}
+			return true;
+		}
+
+		virtual void AddResults(const TArray<FGenToolCall>& Calls, const TArray<FString>& Results) override
+		{
+			for (int32 Index = 0; Index < Calls.Num(); ++Index)
+			{
+				const TSharedRef<FJsonObject> JsonMessage = MakeShared<FJsonObject>();
+				JsonMessage->SetStringField(TEXT("role"), TEXT("tool"));
+				JsonMessage->SetStringField(TEXT("tool_call_id"), Calls[Index].Id);
+				JsonMessage->SetStringField(TEXT("content"), Results[Index]);
+				Messages.Add(MakeShared<FJsonValueObject>(JsonMessage));
+			}
+		}
+
+	private:
+		FString Url;
+		FString AuthHeader;
+		FString AuthValue;
+		float Timeout = 0.0f;
+	};
+
+	/**
+	 * Anthropic messages API, tool calls and results are content blocks
+	 */
+	class FClaudeProtocol : public FProtocol
+	{
+	public:
+		FClaudeProtocol(const FString& Model, const FGenToolChatSettings& ChatSettings, const FGenToolbox& Toolbox)
+		{
+			Url = GetDefault<UGenAISupportRuntimeSettings>()->GetBaseUrl(EGenAIOrgs::Anthropic) + TEXT("/messages");
+			ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::Anthropic);
+
+			Payload = MakeShared<FJsonObject>();
+			Payload->SetStringField(TEXT("model"), Model);
+			Payload->SetNumberField(TEXT("max_tokens"), ChatSettings.MaxTokens);
+			Payload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
+
+			// The system prompt is a top level field rather than a message
+			FString System;
+			for (const FGenChatMessage& Message : ChatSettings.Messages)
+			{
+				if (Message.Role == TEXT("system"))
+				{
+					System += System.IsEmpty() ? Message.Content : TEXT("\n\n") + Message.Content;
+					continue;
+				}
+
+				const TSharedRef<FJsonObject> JsonMessage = MakeShared<FJsonObject>();
+				JsonMessage->SetStringField(TEXT("role"), Message.Role);
+				if (Message.Images.Num() == 0)
+				{
+					JsonMessage->SetStringField(TEXT("content"), Message.Content);
+					Messages.Add(MakeShared<FJsonValueObject>(JsonMessage));
+					continue;
+				}
+
+				// Images go before the text, as in the plain chat, their data is filled in by the encoder
+				TArray<TSharedPtr<FJsonValue>> ContentBlocks;
+				for (const FGenChatImage& Image : Message.Images)
+				{
+					const TSharedRef<FJsonObject> Source = MakeShared<FJsonObject>();
+					Source->SetStringField(TEXT("type"), TEXT("base64"));
+					Source->SetStringField(TEXT("media_type"), FGenImageEncoder::GetMimeType(Image.Encoding));
+					Source->SetStringField(TEXT("data"), FGenImageEncoder::GetPlaceholder(Images.Num()));
+
+					const TSharedRef<FJsonObject> ImageBlock = MakeShared<FJsonObject>();
+					ImageBlock->SetStringField(TEXT("type"), TEXT("image"));
+					ImageBlock->SetObjectField(TEXT("source"), Source);
+					ContentBlocks.Add(MakeShared<FJsonValueObject>(ImageBlock));
+					Images.Add(Image);
+				}
+				const TSharedRef<FJsonObject> TextBlock = MakeShared<FJsonObject>();
+				TextBlock->SetStringField(TEXT("type"), TEXT("text"));
+				TextBlock->SetStringField(TEXT("text"), Message.Content);
+				ContentBlocks.Add(MakeShared<FJsonValueObject>(TextBlock));
+				JsonMessage->SetArrayField(TEXT("content"), ContentBlocks);
+				Messages.Add(MakeShared<FJsonValueObject>(JsonMessage));
+			}
+			if (!System.IsEmpty())
+			{
+				Payload->SetStringField(TEXT("system"), System);
+			}
+
+			TArray<TSharedPtr<FJsonValue>> ToolsArray;
+			for (const FGenTool& Tool : Toolbox.GetTools())
+			{
+				const TSharedRef<FJsonObject> JsonTool = MakeShared<FJsonObject>();
+				JsonTool->SetStringField(TEXT("name"), Tool.Name);
+				JsonTool->SetStringField(TEXT("description"), Tool.Description);
+				JsonTool->SetObjectField(TEXT("input_schema"), Tool.Parameters);
+				ToolsArray.Add(MakeShared<FJsonValueObject>(JsonTool));
+			}
+			if (ToolsArray.Num() > 0)
+			{
+				Payload->SetArrayField(TEXT("tools"), ToolsArray);
+				if (!ChatSettings.bParallelToolCalls)
+				{
+					const TSharedRef<FJsonObject> ToolChoice = MakeShared<FJsonObject>();
+					ToolChoice->SetStringField(TEXT("type"), TEXT("auto"));
+					ToolChoice->SetBoolField(TEXT("disable_parallel_tool_use"), true);
+					Payload->SetObjectField(TEXT("tool_choice"), ToolChoice);
+				}
+			}
+		}
+
+		virtual TSharedRef<IHttpRequest, ESPMode::ThreadSafe> MakeRequest() override
+		{
+			Payload->SetArrayField(TEXT("messages"), Messages);
+			const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FGenOAIWireFormat::MakeChatRequest(Url, Payload.ToSharedRef(), TEXT("x-api-key"), ApiKey);
+			HttpRequest->SetHeader(TEXT("anthropic-version"), TEXT("2023-06-01"));
+			HttpRequest->SetTimeout(180.0f);
+			return HttpRequest;
+		}
+
+		virtual bool ReadTurn(const FJsonObject& Response, FString& OutContent, TArray<FGenToolCall>& OutCalls) override
+		{
+			const TArray<TSharedPtr<FJsonValue>>* ContentArray;
+			if (!Response.TryGetArrayField(TEXT("content"), ContentArray))
+			{
+				return false;
+			}
+
+			for (const TSharedPtr<FJsonValue>& BlockValue : *ContentArray)
+			{
+				const TSharedPtr<FJsonObject>* BlockObject;
+				FString Type;
+				if (!BlockValue->TryGetObject(BlockObject) || !(*BlockObject)->TryGetStringField(TEXT("type"), Type))
+				{
+					continue;
+				}
+
+				if (Type == TEXT("text"))
+				{
+					OutContent += (*BlockObject)->GetStringField(TEXT("text"));
+				}
+				else if (Type == TEXT("tool_use"))
+				{
+					FGenToolCall& Call = OutCalls.AddDefaulted_GetRef();
+					(*BlockObject)->TryGetStringField(TEXT("id"), Call.Id);
+					(*BlockObject)->TryGetStringField(TEXT("name"), Call.Name);
+					const TSharedPtr<FJsonObject>* InputObject;
+					if ((*BlockObject)->TryGetObjectField(TEXT("input"), InputObject))
+					{
+						Call.Arguments = ToJsonString(InputObject->ToSharedRef());
+					}
+				}
+			}
+
+			if (OutCalls.Num() > 0)
+			{
+				const TSharedRef<FJsonObject> JsonMessage = MakeShared<FJsonObject>();
+				JsonMessage->SetStringField(TEXT("role"), TEXT("assistant"));
+				JsonMessage->SetArrayField(TEXT("content"), *ContentArray);
+				Messages.Add(MakeShared<FJsonValueObject>(JsonMessage));
+			}
+			return true;
+		}
+
+		virtual void AddResults(const TArray<FGenToolCall>& Calls, const TArray<FString>& Results) override
+		{
+			// Every result of the turn goes into a single user message
+			TArray<TSharedPtr<FJsonValue>> ResultBlocks;
+			for (int32 Index = 0; Index < Calls.Num(); ++Index)
+			{
+				const TSharedRef<FJsonObject> Block = MakeShared<FJsonObject>();
+				Block->SetStringField(TEXT("type"), TEXT("tool_result"));
+				Block->SetStringField(TEXT("tool_use_id"), Calls[Index].Id);
+				Block->SetStringField(TEXT("content"), Results[Index]);
+				ResultBlocks.Add(MakeShared<FJsonValueObject>(Block));
+			}
+
+			const TSharedRef<FJsonObject> JsonMessage = MakeShared<FJsonObject>();
+			JsonMessage->SetStringField(TEXT("role"), TEXT("user"));
+			JsonMessage->SetArrayField(TEXT("content"), ResultBlocks);
+			Messages.Add(MakeShared<FJsonValueObject>(JsonMessage));
+		}
+
+	private:
+		FString Url;
+		FString ApiKey;
+	};
+}
+
+struct FGenToolLoop::FConversation
+{
+	EGenAIOrgs Org = EGenAIOrgs::Unknown;
+	TUniquePtr<GenToolLoop::FProtocol> Protocol;
+	TSharedPtr<FGenToolbox, ESPMode::ThreadSafe> Toolbox;
+	FGenRequestCallback OnComplete;
+	FGenToolCalledCallback OnToolCalled;
+	FGenCancellationTokenPtr CancellationToken;
+	/** Image textures stay alive across the rounds and the tool calls between them */
+	TArray<TStrongObjectPtr<UObject>> ImageObjects;
+	EGenRequestPriority Priority = EGenRequestPriority::Normal;
+	int32 Rounds = 0;
+	int32 MaxToolRounds = 0;
+
+	void Finish(const FString& Response, const FString& Error, bool bSuccess)
+	{
+		if (FGenRequestCallback Callback = MoveTemp(OnComplete))
+		{
+			Callback(Response, Error, bSuccess);
+		}
+	}
+};
+
+void FGenToolLoop::Run(const FGenToolChatSettings& ChatSettings, const TSharedRef<FGenToolbox, ESPMode::ThreadSafe>& Toolbox,
+                       FGenRequestCallback&& OnComplete, const FGenRequestOptions& Options, FGenToolCalledCallback&& OnToolCalled)
+{
+	check(IsInGameThread());
+
+	const EGenAIOrgs Org = ChatSettings.Org;
+	const FString OrgName = StaticEnum<EGenAIOrgs>()->GetNameStringByValue(static_cast<int64>(Org));
+	if (Org != EGenAIOrgs::OpenAI && Org != EGenAIOrgs::Anthropic && Org != EGenAIOrgs::DeepSeek && Org != EGenAIOrgs::XAI && Org != EGenAIOrgs::Local)
+	{
+		OnComplete(TEXT(""), FString::Printf(TEXT("%s does not support tools"), *OrgName), false);
+		return;
+	}
+	if (Org != EGenAIOrgs::Local && UGenSecureKey::GetGenerativeAIApiKey(Org).IsEmpty())
+	{
+		OnComplete(TEXT(""), FString::Printf(TEXT("%s API key not set"), *OrgName), false);
+		return;
+	}
+
+	const FString Model = ChatSettings.Model.IsEmpty() ? GenToolLoop::GetDefaultModel(Org) : ChatSettings.Model;
+
+	const TSharedRef<FConversation> Conversation = MakeShared<FConversation>();
+	Conversation->Org = Org;
+	if (Org == EGenAIOrgs::Anthropic)
+	{
+		Conversation->Protocol = MakeUnique<GenToolLoop::FClaudeProtocol>(Model, ChatSettings, *Toolbox);
+	}
+	else
+	{
+		Conversation->Protocol = MakeUnique<GenToolLoop::FOpenAIProtocol>(Org, Model, ChatSettings, *Toolbox);
+	}
+	for (const FGenChatImage& Image : Conversation->Protocol->GetImages())
+	{
+		if (Image.Texture)
+		{
+			Conversation->ImageObjects.Emplace(Image.Texture);
+		}
+		if (Image.RenderTarget)
+		{
+			Conversation->ImageObjects.Emplace(Image.RenderTarget);
+		}
+	}
+	Conversation->Toolbox = Toolbox;
+	Conversation->OnComplete = MoveTemp(OnComplete);
+	Conversation->OnToolCalled = MoveTemp(OnToolCalled);
+	Conversation->Priority = Options.Priority;
+	Conversation->MaxToolRounds = FMath::Max(1, ChatSettings.MaxToolRounds);
+
+	// The caller's token stays untouched, the chat's deadline lives on a child
+	Conversation->CancellationToken = Options.CancellationToken.IsValid()
+		                                  ? Options.CancellationToken->CreateChild()
+		                                  : FGenCancellationToken::Create();
+	if (Options.TimeoutSeconds > 0.0)
+	{
+		const double Deadline = FPlatformTime::Seconds() + Options.TimeoutSeconds;
+		if (!Conversation->CancellationToken->HasDeadline() || Deadline < Conversation->CancellationToken->GetDeadline())
+		{
+			Conversation->CancellationToken->SetDeadline(Deadline);
+		}
+	}
+
+	SendRound(Conversation);
+}
+
+void FGenToolLoop::SendRound(const TSharedRef<FConversation>& Conversation)
+{
+	const FGenCancellationTokenRef Token = Conversation->CancellationToken.ToSharedRef();
+	if (Token->IsCancelled() || Token->IsExpired())
+	{
+		Conversation->Finish(TEXT(""), Token->GetStopReason(), false);
+		return;
+	}
+
+	UGenRequestSubsystem* Subsystem = UGenRequestSubsystem::Get();
+	if (!Subsystem)
+	{
+		Conversation->Finish(TEXT(""), TEXT("Request subsystem not available"), false);
+		return;
+	}
+
+	FGenRequestOptions RoundOptions;
+	RoundOptions.Priority = Conversation->Priority;
+	RoundOptions.CancellationToken = Token->CreateChild();
+	Subsystem->Submit(Conversation->Org, [Conversation](const FGenCancellationTokenRef& RoundToken, FGenRequestCallback&& OnDone)
+	{
+		const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = Conversation->Protocol->MakeRequest();
+		HttpRequest->OnProcessRequestComplete().BindLambda([OnDone](FHttpRequestPtr Request, const FHttpResponsePtr& Response, const bool bSuccess)
+		{
+			if (!bSuccess || !Response.IsValid())
+			{
+				UE_LOG(LogGenAI, Error, TEXT("Tool chat request failed, Response code: %d"), Response.IsValid() ? Response->GetResponseCode() : -1);
+				OnDone(TEXT(""), TEXT("Request failed"), false);
+				return;
+			}
+			OnDone(Response->GetContentAsString(), TEXT(""), true);
+		});
+
+		// Every round sends the whole conversation, so its images are encoded into each round's body
+		if (Conversation->Protocol->GetImages().Num() > 0)
+		{
+			TArray<FGenChatImage> Images = Conversation->Protocol->GetImages();
+			FGenImageEncoder::ProcessRequest(HttpRequest, MoveTemp(Images), Conversation->Org, RoundToken, [OnDone](const FString& Error)
+			{
+				OnDone(TEXT(""), Error, false);
+			});
+			return;
+		}
+
+		if (!RoundToken->BindRequest(HttpRequest))
+		{
+			OnDone(TEXT(""), RoundToken->GetStopReason(), false);
+			return;
+		}
+
+		FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
+		HttpRequest->ProcessRequest();
+	}, [Conversation](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		HandleRound(Conversation, Response, Error, bSuccess);
+	}, RoundOptions);
+}
+
+void FGenToolLoop::HandleRound(const TSharedRef<FConversation>& Conversation, const FString& Response, const FString& Error, bool bSuccess)
+{
+	if (!bSuccess)
+	{
+		Conversation->Finish(TEXT(""), Error, false);
+		return;
+	}
+
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+	TSharedPtr<FJsonObject> JsonObject;
+	FString Content;
+	TArray<FGenToolCall> Calls;
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid() || !Conversation->Protocol->ReadTurn(*JsonObject, Content, Calls))
+	{
+		// Both protocols report failures as {"error": {"message": ...}}
+		FString ErrorMessage = FString::Printf(TEXT("Failed to parse response: %s"), *Response);
+		const TSharedPtr<FJsonObject>* ErrorObject;
+		if (JsonObject.IsValid() && JsonObject->TryGetObjectField(TEXT("error"), ErrorObject))
+		{
+			(*ErrorObject)->TryGetStringField(TEXT("message"), ErrorMessage);
+		}
+		Conversation->Finish(TEXT(""), ErrorMessage, false);
+		return;
+	}
+
+	if (Calls.Num() == 0)
+	{
+		Conversation->Finish(Content, TEXT(""), true);
+		return;
+	}
+
+	if (++Conversation->Rounds > Conversation->MaxToolRounds)
+	{
+		Conversation->Finish(TEXT(""), FString::Printf(TEXT("The model still requested tools after %d rounds"), Conversation->MaxToolRounds), false);
+		return;
+	}
+
+	Conversation->Toolbox->ExecuteCalls(Calls, [Conversation, Calls](TArray<FString>&& Results)
+	{
+		if (Conversation->OnToolCalled)
+		{
+			for (int32 Index = 0; Index < Calls.Num(); ++Index)
+			{
+				Conversation->OnToolCalled(Calls[Index], Results[Index]);
+			}
+		}
+
+		Conversation->Protocol->AddResults(Calls, Results);
+		SendRound(Conversation);
+	});
+}
@@ -0,0 +1,281 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Tools/GenToolbox.h"
+
+#include "Async/Async.h"
+#include "JsonObjectConverter.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Tasks/Task.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include <atomic>
+
+namespace GenToolbox
+{
+	static FString MakeError(const FString& Message)
+	{
+		const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		JsonObject->SetStringField(TEXT("error"), Message);
+
+		FString Result;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+		return Result;
+	}
+
+	static bool IsInputParameter(const FProperty* Property)
+	{
+		return Property->HasAnyPropertyFlags(CPF_Parm) && !Property->HasAnyPropertyFlags(CPF_ReturnParm)
+			&& (!Property->HasAnyPropertyFlags(CPF_OutParm) || Property->HasAnyPropertyFlags(CPF_ReferenceParm));
+	}
+
+	static bool IsOutputParameter(const FProperty* Property)
+	{
+		return Property->HasAnyPropertyFlags(CPF_ReturnParm)
+			|| (Property->HasAnyPropertyFlags(CPF_OutParm) && !Property->HasAnyPropertyFlags(CPF_ConstParm));
+	}
+
+	/** Calls the function with arguments converted from JSON, the outputs are returned as a JSON object */
+	static FString InvokeFunction(UObject* Target, UFunction* Function, const TSharedRef<FJsonObject>& Arguments)
+	{
+		uint8* Params = static_cast<uint8*>(FMemory::Malloc(FMath::Max<int32>(Function->ParmsSize, 1), Function->GetMinAlignment()));
+		FMemory::Memzero(Params, Function->ParmsSize);
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			It->InitializeValue_InContainer(Params);
+		}
+
+		FString Result;
+		FText FailReason;
+		if (!FJsonObjectConverter::JsonObjectToUStruct(Arguments, Function, Params, 0, 0, false, &FailReason))
+		{
+			Result = MakeError(FString::Printf(TEXT("Invalid arguments: %s"), *FailReason.ToString()));
+		}
+		else
+		{
+			Target->ProcessEvent(Function, Params);
+
+			const TSharedRef<FJsonObject> Output = MakeShared<FJsonObject>();
+			for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+			{
+				if (IsOutputParameter(*It))
+				{
+					Output->SetField(It->GetName(), FJsonObjectConverter::UPropertyToJsonValue(*It, It->ContainerPtrToValuePtr<void>(Params)));
+				}
+			}
+			if (Output->Values.Num() == 0)
+			{
+				Output->SetBoolField(TEXT("success"), true);
+			}
+
+			const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Result);
+			FJsonSerializer::Serialize(Output, Writer);
+		}
+
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			It->DestroyValue_InContainer(Params);
+		}
+		FMemory::Free(Params);
+		return Result;
+	}
+}
+
+void FGenToolbox::AddTool(const FString& Name, const FString& Description, const TSharedRef<FJsonObject>& ParametersSchema,
+                          FGenToolFunction&& Function, bool bRunOnGameThread)
+{
+	FGenTool& Tool = Tools.AddDefaulted_GetRef();
+	Tool.Name = Name;
+	Tool.Description = Description;
+	Tool.Parameters = ParametersSchema;
+	Tool.Function = MoveTemp(Function);
+	Tool.bRunOnGameThread = bRunOnGameThread;
+}
+
+bool FGenToolbox::AddFunction(UObject* Target, FName FunctionName, const FString& Description)
+{
+	UFunction* Function = Target ? Target->FindFunction(FunctionName) : nullptr;
+	if (!Function)
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Cannot add tool %s, the function does not exist"), *FunctionName.ToString());
+		return false;
+	}
+
+	const TSharedRef<FJsonObject> Properties = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Required;
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (GenToolbox::IsInputParameter(*It))
+		{
+			Properties->SetObjectField(It->GetName(), MakePropertySchema(*It));
+			Required.Add(MakeShared<FJsonValueString>(It->GetName()));
+		}
+	}
+
+	const TSharedRef<FJsonObject> Schema = MakeShared<FJsonObject>();
+	Schema->SetStringField(TEXT("type"), TEXT("object"));
+	Schema->SetObjectField(TEXT("properties"), Properties);
+	Schema->SetArrayField(TEXT("required"), Required);
+
+	FString ToolDescription = Description;
+#if WITH_EDITOR
+	if (ToolDescription.IsEmpty())
+	{
+		ToolDescription = Function->GetToolTipText().ToString();
+	}
+#endif
+
+	// UObjects are only safe to touch on the game thread
+	TWeakObjectPtr<UObject> WeakTarget(Target);
+	TWeakObjectPtr<UFunction> WeakFunction(Function);
+	AddTool(FunctionName.ToString(), ToolDescription, Schema, [WeakTarget, WeakFunction](const TSharedRef<FJsonObject>& Arguments)
+	{
+		UObject* StrongTarget = WeakTarget.Get();
+		UFunction* StrongFunction = WeakFunction.Get();
+		if (!StrongTarget || !StrongFunction)
+		{
+			return GenToolbox::MakeError(TEXT("The tool's object no longer exists"));
+		}
+		return GenToolbox::InvokeFunction(StrongTarget, StrongFunction, Arguments);
+	}, true);
+	return true;
+}
+
+const FGenTool* FGenToolbox::FindTool(const FString& Name) const
+{
+	return Tools.FindByPredicate([&Name](const FGenTool& Tool) { return Tool.Name == Name; });
+}
+
+FString FGenToolbox::RunCall(const FGenToolCall& Call) const
+{
+	const FGenTool* Tool = FindTool(Call.Name);
+	if (!Tool || !Tool->Function)
+	{
+		return GenToolbox::MakeError(FString::Printf(TEXT("Unknown tool %s"), *Call.Name));
+	}
+
+	// Models send an empty string rather than {} for tools without arguments
+	TSharedPtr<FJsonObject> Arguments = MakeShared<FJsonObject>();
+	if (!Call.Arguments.TrimStartAndEnd().IsEmpty())
+	{
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Call.Arguments);
+		if (!FJsonSerializer::Deserialize(Reader, Arguments) || !Arguments.IsValid())
+		{
+			return GenToolbox::MakeError(TEXT("Arguments are not a JSON object"));
+		}
+	}
+	return Tool->Function(Arguments.ToSharedRef());
+}
+
+void FGenToolbox::ExecuteCalls(const TArray<FGenToolCall>& Calls, TFunction<void(TArray<FString>&&)>&& OnDone) const
+{
+	check(IsInGameThread());
+
+	struct FExecution
+	{
+		TArray<FString> Results;
+		TFunction<void(TArray<FString>&&)> OnDone;
+		// One extra count held until every call has been started
+		std::atomic<int32> Remaining { 1 };
+
+		void Finish(const TSharedRef<FExecution, ESPMode::ThreadSafe>& Self)
+		{
+			if (--Remaining == 0)
+			{
+				// The callback is released on the game thread too, it may hold game thread only state
+				AsyncTask(ENamedThreads::GameThread, [Self]()
+				{
+					const TFunction<void(TArray<FString>&&)> Callback = MoveTemp(Self->OnDone);
+					Callback(MoveTemp(Self->Results));
+				});
+			}
+		}
+	};
+
+	const TSharedRef<FExecution, ESPMode::ThreadSafe> Execution = MakeShared<FExecution, ESPMode::ThreadSafe>();
+	Execution->Results.SetNum(Calls.Num());
+	Execution->OnDone = MoveTemp(OnDone);
+	Execution->Remaining += Calls.Num();
+
+	// Worker calls are started first so they overlap with the game thread calls below
+	TArray<int32> GameThreadCalls;
+	for (int32 Index = 0; Index < Calls.Num(); ++Index)
+	{
+		const FGenTool* Tool = FindTool(Calls[Index].Name);
+		if (!Tool || Tool->bRunOnGameThread)
+		{
+			GameThreadCalls.Add(Index);
+			continue;
+		}
+
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Toolbox = AsShared(), Call = Calls[Index], Index, Execution]()
+		{
+			Execution->Results[Index] = Toolbox->RunCall(Call);
+			Execution->Finish(Execution);
+		});
+	}
+
+	for (const int32 Index : GameThreadCalls)
+	{
+		Execution->Results[Index] = RunCall(Calls[Index]);
+		Execution->Finish(Execution);
+	}
+	Execution->Finish(Execution);
+}
+
+TSharedRef<FJsonObject> FGenToolbox::MakePropertySchema(const FProperty* Property)
+{
+	const TSharedRef<FJsonObject> Schema = MakeShared<FJsonObject>();
+
+	auto SetEnum = [&Schema](const UEnum* Enum)
+	{
+		TArray<TSharedPtr<FJsonValue>> Names;
+		for (int32 Index = 0; Index < Enum->NumEnums() - 1; ++Index)
+		{
+			Names.Add(MakeShared<FJsonValueString>(Enum->GetNameStringByIndex(Index)));
+		}
+		Schema->SetStringField(TEXT("type"), TEXT("string"));
+		Schema->SetArrayField(TEXT("enum"), Names);
+	};
+
+	if (Property->IsA<FBoolProperty>())
+	{
+		Schema->SetStringField(TEXT("type"), TEXT("boolean"));
+	}
+	else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		SetEnum(EnumProperty->GetEnum());
+	}
+	else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property); ByteProperty && ByteProperty->Enum)
+	{
+		SetEnum(ByteProperty->Enum);
+	}
+	else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		Schema->SetStringField(TEXT("type"), NumericProperty->IsInteger() ? TEXT("integer") : TEXT("number"));
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		Schema->SetStringField(TEXT("type"), TEXT("array"));
+		Schema->SetObjectField(TEXT("items"), MakePropertySchema(ArrayProperty->Inner));
+	}
+	else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		const TSharedRef<FJsonObject> Properties = MakeShared<FJsonObject>();
+		for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+		{
+			Properties->SetObjectField(It->GetName(), MakePropertySchema(*It));
+		}
+		Schema->SetStringField(TEXT("type"), TEXT("object"));
+		Schema->SetObjectField(TEXT("properties"), Properties);
+	}
+	else
+	{
+		// Strings, names, texts and object paths
+		Schema->SetStringField(TEXT("type"), TEXT("string"));
+	}
+	return Schema;
+}
@@ -0,0 +1,352 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "Utilities/GenImageEncoder.h"
+
+#include "Async/Async.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "Misc/Base64.h"
+#include "Modules/ModuleManager.h"
+#include "Network/GenConnectionManager.h"
+#include "RenderingThread.h"
+#include "Tasks/Task.h"
+#include "TextureResource.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include <atomic>
+
+namespace GenImageEncoder
+{
+	typedef TSharedPtr<const TArray<FColor>, ESPMode::ThreadSafe> FPixelsPtr;
+
+	struct FEntry
+	{
+		FPixelsPtr Pixels;
+		FIntPoint Size = FIntPoint::ZeroValue;
+		EGenImageDetail Detail = EGenImageDetail::Auto;
+		EGenImageEncoding Encoding = EGenImageEncoding::JPEG;
+		int32 Quality = 85;
+	};
+
+	struct FJob
+	{
+		TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+		FGenCancellationTokenPtr CancellationToken;
+		TFunction<void(const FString&)> OnFailed;
+		EGenAIOrgs Org = EGenAIOrgs::Unknown;
+
+		// UTF-8 payload with the placeholders, small since it holds no image data
+		TArray<uint8> Content;
+		TArray<FEntry> Entries;
+		FString Error;
+		IImageWrapperModule* ImageWrapperModule = nullptr;
+
+		// One extra count held until every read has been queued
+		std::atomic<int32> PendingReads { 1 };
+	};
+
+	typedef TSharedRef<FJob, ESPMode::ThreadSafe> FJobRef;
+
+	static int32 FindBytes(const TArray<uint8>& Haystack, int32 Start, const ANSICHAR* Needle, int32 NeedleLength)
+	{
+		for (int32 Index = Start; Index + NeedleLength <= Haystack.Num(); ++Index)
+		{
+			if (FMemory::Memcmp(Haystack.GetData() + Index, Needle, NeedleLength) == 0)
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	static void AppendBase64(TArray<uint8>& Body, const TArray64<uint8>& Data)
+	{
+		const int32 Start = Body.Num();
+		// One extra byte for the terminator the encoder writes
+		Body.AddUninitialized(FBase64::GetEncodedDataSize(Data.Num()) + 1);
+		const uint32 Written = FBase64::Encode(Data.GetData(), static_cast<uint32>(Data.Num()), reinterpret_cast<ANSICHAR*>(Body.GetData() + Start));
+		Body.SetNum(Start + Written, EAllowShrinking::No);
+	}
+
+	static void Complete(const FJobRef& Job, TArray<uint8>&& Body)
+	{
+		check(IsInGameThread());
+
+		// Released here rather than wherever the last reference happens to drop
+		const TFunction<void(const FString&)> OnFailed = MoveTemp(Job->OnFailed);
+		const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = Job->HttpRequest.ToSharedRef();
+		Job->HttpRequest.Reset();
+
+		if (!Job->Error.IsEmpty())
+		{
+			UE_LOG(LogGenAI, Error, TEXT("Could not attach chat images: %s"), *Job->Error);
+			OnFailed(Job->Error);
+			return;
+		}
+
+		HttpRequest->SetContent(MoveTemp(Body));
+		if (Job->CancellationToken.IsValid() && !Job->CancellationToken->BindRequest(HttpRequest))
+		{
+			OnFailed(Job->CancellationToken->GetStopReason());
+			return;
+		}
+
+		FGenConnectionManager::Get().NotifyRequestIssued(HttpRequest->GetURL());
+		HttpRequest->ProcessRequest();
+	}
+
+	/** Resizes, encodes and splices every image into the body, runs on a worker thread */
+	static void Encode(const FJobRef& Job)
+	{
+		TArray<TArray64<uint8>> Encoded;
+		Encoded.SetNum(Job->Entries.Num());
+		int64 BodySize = Job->Content.Num();
+
+		for (int32 Index = 0; Index < Job->Entries.Num() && Job->Error.IsEmpty(); ++Index)
+		{
+			if (Job->CancellationToken.IsValid() && Job->CancellationToken->IsCancelled())
+			{
+				break;
+			}
+
+			FEntry& Entry = Job->Entries[Index];
+			if (!Entry.Pixels.IsValid() || Entry.Size.X <= 0 || Entry.Size.Y <= 0 || Entry.Pixels->Num() != Entry.Size.X * Entry.Size.Y)
+			{
+				Job->Error = FString::Printf(TEXT("Could not read the pixels of image %d"), Index);
+				break;
+			}
+
+			const FIntPoint TargetSize = FGenImageEncoder::GetTargetSize(Entry.Size, Job->Org, Entry.Detail);
+			TArray<FColor> Resized;
+			if (TargetSize != Entry.Size)
+			{
+				FImageUtils::ImageResize(Entry.Size.X, Entry.Size.Y, *Entry.Pixels, TargetSize.X, TargetSize.Y, Resized, false);
+			}
+			const TArray<FColor>& Pixels = TargetSize != Entry.Size ? Resized : *Entry.Pixels;
+
+			const TSharedPtr<IImageWrapper> ImageWrapper = Job->ImageWrapperModule->CreateImageWrapper(
+				Entry.Encoding == EGenImageEncoding::PNG ? EImageFormat::PNG : EImageFormat::JPEG);
+			if (!ImageWrapper.IsValid()
+				|| !ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), TargetSize.X, TargetSize.Y, ERGBFormat::BGRA, 8))
+			{
+				Job->Error = FString::Printf(TEXT("Could not encode image %d"), Index);
+				break;
+			}
+			Encoded[Index] = ImageWrapper->GetCompressed(Entry.Encoding == EGenImageEncoding::JPEG ? Entry.Quality : 0);
+			BodySize += FBase64::GetEncodedDataSize(Encoded[Index].Num());
+
+			// The message may still hold the pixels, this only drops the job's reference
+			Entry.Pixels.Reset();
+		}
+
+		TArray<uint8> Body;
+		if (Job->Error.IsEmpty() && !(Job->CancellationToken.IsValid() && Job->CancellationToken->IsCancelled()))
+		{
+			Body.Reserve(BodySize);
+			int32 Cursor = 0;
+			for (int32 Index = 0; Index < Encoded.Num(); ++Index)
+			{
+				const FTCHARToUTF8 Placeholder(*FGenImageEncoder::GetPlaceholder(Index));
+				const int32 Found = FindBytes(Job->Content, Cursor, Placeholder.Get(), Placeholder.Length());
+				if (Found == INDEX_NONE)
+				{
+					Job->Error = FString::Printf(TEXT("The payload has no placeholder for image %d"), Index);
+					break;
+				}
+				Body.Append(Job->Content.GetData() + Cursor, Found - Cursor);
+				AppendBase64(Body, Encoded[Index]);
+				Encoded[Index].Empty();
+				Cursor = Found + Placeholder.Length();
+			}
+			Body.Append(Job->Content.GetData() + Cursor, Job->Content.Num() - Cursor);
+		}
+
+		// A cancelled job still completes on the game thread, binding the token then reports the stop
+		AsyncTask(ENamedThreads::GameThread, [Job, Body = MoveTemp(Body)]() mutable
+		{
+			Complete(Job, MoveTemp(Body));
+		});
+	}
+
+	static void FinishRead(const FJobRef& Job)
+	{
+		if (--Job->PendingReads == 0)
+		{
+			UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job]() { Encode(Job); });
+		}
+	}
+
+	/** Copies the texture to the CPU on the render thread, the pixels go straight to the job */
+	static void EnqueueRead(const FJobRef& Job, int32 Index, FTextureResource* Resource, bool bLinearToGamma)
+	{
+		++Job->PendingReads;
+		ENQUEUE_RENDER_COMMAND(GenReadChatImage)([Job, Index, Resource, bLinearToGamma](FRHICommandListImmediate& RHICmdList)
+		{
+			if (FRHITexture* TextureRHI = Resource->TextureRHI)
+			{
+				const FIntPoint Size(Resource->GetSizeX(), Resource->GetSizeY());
+				FReadSurfaceDataFlags Flags(RCM_UNorm, CubeFace_MAX);
+				Flags.SetLinearToGamma(bLinearToGamma);
+
+				TArray<FColor> Pixels;
+				RHICmdList.ReadSurfaceData(TextureRHI, FIntRect(FIntPoint::ZeroValue, Size), Pixels, Flags);
+				FEntry& Entry = Job->Entries[Index];
+				Entry.Pixels = MakeShared<const TArray<FColor>, ESPMode::ThreadSafe>(MoveTemp(Pixels));
+				Entry.Size = Size;
+			}
+			FinishRead(Job);
+		});
+	}
+
+#if WITH_EDITORONLY_DATA
+	/** Decompresses the source art of an editor texture on a worker, it is uncompressed whatever the platform format */
+	static void EnqueueSourceRead(const FJobRef& Job, int32 Index, UTexture2D* Texture)
+	{
+		++Job->PendingReads;
+		// The torn off copy shares the bulk data and does not follow later edits, so it is safe to read off the game thread
+		TSharedRef<FTextureSource, ESPMode::ThreadSafe> Source = MakeShared<FTextureSource, ESPMode::ThreadSafe>(Texture->Source.CopyTornOff());
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, Index, Source]()
+		{
+			FImage Image;
+			if (Source->GetMipImage(Image, 0, 0, 0))
+			{
+				Image.ChangeFormat(ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+				const TArrayView64<FColor> View = Image.AsBGRA8();
+				FEntry& Entry = Job->Entries[Index];
+				Entry.Pixels = MakeShared<const TArray<FColor>, ESPMode::ThreadSafe>(View.GetData(), static_cast<int32>(View.Num()));
+				Entry.Size = FIntPoint(Image.SizeX, Image.SizeY);
+			}
+			FinishRead(Job);
+		});
+	}
+#endif
+
+	/** Queues the read of one image, returns an error if it has no readable source */
+	static FString StartRead(const FJobRef& Job, int32 Index, const FGenChatImage& Image)
+	{
+		FEntry& Entry = Job->Entries[Index];
+		if (UTexture2D* Texture = Image.Texture)
+		{
+#if WITH_EDITORONLY_DATA
+			if (Texture->Source.IsValid())
+			{
+				EnqueueSourceRead(Job, Index, Texture);
+				return FString();
+			}
+#endif
+			FTextureResource* Resource = Texture->GetResource();
+			if (!Resource)
+			{
+				return FString::Printf(TEXT("Texture %s has no resource"), *Texture->GetName());
+			}
+			if (GPixelFormats[Texture->GetPixelFormat()].BlockSizeX > 1)
+			{
+				return FString::Printf(TEXT("Texture %s is block compressed, use an uncompressed texture or a render target"), *Texture->GetName());
+			}
+			EnqueueRead(Job, Index, Resource, false);
+			return FString();
+		}
+		if (UTextureRenderTarget2D* RenderTarget = Image.RenderTarget)
+		{
+			FTextureRenderTargetResource* Resource = RenderTarget->GameThread_GetRenderTargetResource();
+			if (!Resource)
+			{
+				return FString::Printf(TEXT("Render target %s has no resource"), *RenderTarget->GetName());
+			}
+			// Float targets hold linear color, 8 bit ones are read as they are
+			EnqueueRead(Job, Index, Resource, true);
+			return FString();
+		}
+		if (Image.Pixels.IsValid())
+		{
+			Entry.Pixels = Image.Pixels;
+			Entry.Size = Image.PixelSize;
+			return FString();
+		}
+		return FString::Printf(TEXT("Image %d has no source"), Index);
+	}
+}
+
+FString FGenImageEncoder::GetPlaceholder(int32 Index)
+{
+	// Random per process and never sent, so message text cannot contain it whatever the player types
+	static const FString Key = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	return FString::Printf(TEXT("__genai_image_%s_%d__"), *Key, Index);
+}
+
+FString FGenImageEncoder::GetMimeType(EGenImageEncoding Encoding)
+{
+	return Encoding == EGenImageEncoding::PNG ? TEXT("image/png") : TEXT("image/jpeg");
+}
+
+FIntPoint FGenImageEncoder::GetTargetSize(FIntPoint Size, EGenAIOrgs Org, EGenImageDetail Detail)
+{
+	const int32 LongEdge = FMath::Max(Size.X, Size.Y);
+	const int32 ShortEdge = FMath::Min(Size.X, Size.Y);
+	if (LongEdge <= 0)
+	{
+		return Size;
+	}
+
+	double Scale = 1.0;
+	if (Detail == EGenImageDetail::Low)
+	{
+		Scale = FMath::Min(Scale, 512.0 / LongEdge);
+	}
+	else if (Org == EGenAIOrgs::Anthropic)
+	{
+		// Larger images are downscaled by the API before the model sees them
+		Scale = FMath::Min(Scale, 1568.0 / LongEdge);
+	}
+	else
+	{
+		// OpenAI fits high detail images into 2048 and then scales the short side to 768
+		Scale = FMath::Min3(Scale, 2048.0 / LongEdge, 768.0 / ShortEdge);
+	}
+
+	if (Scale >= 1.0)
+	{
+		return Size;
+	}
+	return FIntPoint(FMath::Max(1, FMath::RoundToInt(Size.X * Scale)), FMath::Max(1, FMath::RoundToInt(Size.Y * Scale)));
+}
+
+void FGenImageEncoder::ProcessRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest, TArray<FGenChatImage>&& Images, EGenAIOrgs Org,
+                                      const FGenCancellationTokenPtr& CancellationToken, TFunction<void(const FString& Error)>&& OnFailed)
+{
+	check(IsInGameThread());
+
+	const GenImageEncoder::FJobRef Job = MakeShared<GenImageEncoder::FJob, ESPMode::ThreadSafe>();
+	Job->HttpRequest = HttpRequest;
+	Job->CancellationToken = CancellationToken;
+	Job->OnFailed = MoveTemp(OnFailed);
+	Job->Org = Org;
+	Job->Content = HttpRequest->GetContent();
+	Job->Entries.SetNum(Images.Num());
+	// Modules can only be loaded on the game thread
+	Job->ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	for (int32 Index = 0; Index < Images.Num(); ++Index)
+	{
+		const FGenChatImage& Image = Images[Index];
+		GenImageEncoder::FEntry& Entry = Job->Entries[Index];
+		Entry.Detail = Image.Detail;
+		Entry.Encoding = Image.Encoding;
+		Entry.Quality = FMath::Clamp(Image.Quality, 1, 100);
+
+		const FString Error = GenImageEncoder::StartRead(Job, Index, Image);
+		if (!Error.IsEmpty())
+		{
+			// Reads already queued still finish, the job completes with this error once they did
+			Job->Error = Error;
+			break;
+		}
+	}
+	GenImageEncoder::FinishRead(Job);
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Audio/GenStreamingSoundWave.h"
+#include "Data/OpenAI/GenOAISpeechStructs.h"
+#include "Network/GenCancellationToken.h"
+
+/**
+ * Cuts streamed text into sentences, so speech can start before the reply is complete.
+ * A sentence ends at a newline or at . ! ? ; followed by whitespace, which keeps numbers
+ * such as 3.5 whole. Sentences shorter than MinChars are merged with the next one.
+ */
+class GENERATIVEAISUPPORT_API FGenSentenceChunker
+{
+public:
+	explicit FGenSentenceChunker(int32 InMinChars = 24) : MinChars(InMinChars) {}
+
+	/** Adds streamed text, OnSentence gets every sentence it completes */
+	void Append(const FString& Text, const TFunctionRef<void(const FString&)>& OnSentence);
+
+	/** Hands out whatever is left, at the end of the stream */
+	void Flush(const TFunctionRef<void(const FString&)>& OnSentence);
+
+private:
+	FString Pending;
+	int32 ScanFrom = 0;
+	int32 MinChars;
+};
+
+/**
+ * Speaks text while it is still being streamed, e.g. the deltas of UGenLocalChat.
+ *
+ * Each sentence becomes one speech request. They are sent one after another into the same buffer,
+ * so the audio stays in order; each download is far shorter than the playback of the sentence
+ * before it, so the speaker does not pause between sentences. Game thread only.
+ */
+class GENERATIVEAISUPPORT_API FGenSpeechStream : public TSharedFromThis<FGenSpeechStream>
+{
+public:
+	/** OnComplete is called once the last sentence was received, or with the first error */
+	static TSharedRef<FGenSpeechStream> Create(const FGenOAISpeechSettings& SpeechSettings, const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& Buffer,
+	                                           TFunction<void(const FString& Error, bool bSuccess)>&& OnComplete = nullptr);
+
+	/** Adds streamed text, complete sentences are spoken right away */
+	void AppendText(const FString& Text);
+
+	/** Speaks the rest of the text, the buffer is finished after it */
+	void Finish();
+
+	/** Stops speaking: the pending text, the request in flight and the queued audio are dropped. OnComplete is not called */
+	void Cancel();
+
+private:
+	FGenSpeechStream(const FGenOAISpeechSettings& InSpeechSettings, const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& InBuffer);
+
+	void SendNext();
+	void Complete(const FString& Error, bool bSuccess);
+
+	FGenOAISpeechSettings SpeechSettings;
+	TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe> Buffer;
+	TFunction<void(const FString&, bool)> OnComplete;
+	FGenSentenceChunker Chunker;
+	TArray<FString> Sentences;
+	FGenCancellationTokenRef CancellationToken;
+	bool bInFlight = false;
+	bool bFinished = false;
+};
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sound/SoundWaveProcedural.h"
+#include "GenStreamingSoundWave.generated.h"
+
+/**
+ * FIFO of 16 bit PCM between a network thread writing audio as it arrives and the audio thread
+ * playing it. Thread safe.
+ */
+class GENERATIVEAISUPPORT_API FGenPcmBuffer
+{
+public:
+	/** Appends raw bytes, a sample split across two calls is reassembled on read. Ignored once finished */
+	void Write(const uint8* Data, int32 NumBytes);
+
+	/** Copies up to MaxBytes of whole samples into Out, returns the number of bytes copied */
+	int32 Read(uint8* Out, int32 MaxBytes);
+
+	/** Marks the end of the audio, later writes are dropped until Reset */
+	void Finish();
+
+	/** Drops the queued audio and starts over, e.g. when the speaker is interrupted */
+	void Reset();
+
+	bool IsFinished() const;
+
+	/** True once the audio is finished and everything was read */
+	bool IsDrained() const;
+
+	int32 GetNumQueuedBytes() const;
+
+private:
+	mutable FCriticalSection Lock;
+	TArray<uint8> Bytes;
+	int32 ReadOffset = 0;
+	bool bFinished = false;
+};
+
+/**
+ * Procedural sound wave playing PCM as it is streamed in, so speech starts with its first chunk.
+ *
+ * Play it on an audio component as soon as it is created: while the buffer runs dry it plays
+ * silence instead of stopping, so late chunks are still heard.
+ */
+UCLASS(BlueprintType)
+class GENERATIVEAISUPPORT_API UGenStreamingSoundWave : public USoundWaveProcedural
+{
+	GENERATED_BODY()
+
+public:
+	UGenStreamingSoundWave(const FObjectInitializer& ObjectInitializer);
+
+	/** Mono 16 bit wave at the given rate, 24 kHz matches the OpenAI PCM format */
+	static UGenStreamingSoundWave* Create(int32 InSampleRate = 24000);
+
+	/** Audio source, writable from any thread */
+	const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& GetBuffer() const { return Buffer; }
+
+	/** True once the stream ended and all of it was played */
+	UFUNCTION(BlueprintPure, Category = "GenAI|Speech")
+	bool IsPlaybackFinished() const { return Buffer->IsDrained(); }
+
+	//~ Begin USoundWaveProcedural Interface
+	virtual int32 OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples) override;
+	//~ End USoundWaveProcedural Interface
+
+private:
+	TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe> Buffer;
+};
@@ -0,0 +1,110 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Network/GenRequestHandle.h"
+#include "Tokenizer/GenTokenizer.h"
+#include "UObject/Object.h"
+#include "GenConversation.generated.h"
+
+/**
+ * When and how a conversation folds its older turns into a summary
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenCompactionSettings
+{
+	GENERATED_BODY()
+
+	// Compaction starts once the history needs more prompt tokens than this, 0 never compacts
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation", meta = (ClampMin = "0"))
+	int32 CompactAboveTokens = 4000;
+
+	// Latest messages that are always sent verbatim
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation", meta = (ClampMin = "1"))
+	int32 KeepRecentMessages = 8;
+
+	// OpenAI model writing the summary, a small one is plenty
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation")
+	FString SummaryModel = TEXT("gpt-4o-mini");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation", meta = (ClampMin = "32"))
+	int32 MaxSummaryTokens = 400;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation")
+	EGenTokenizerEncoding Encoding = EGenTokenizerEncoding::O200K;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGenConversationCompactedDelegate, int32, MessagesFolded);
+
+/**
+ * Chat history that keeps its prompt size bounded.
+ *
+ * Once the history grows past CompactAboveTokens, the older turns are summarized by a cheap model
+ * in a background priority request while the conversation carries on with the full history. When
+ * the summary arrives it replaces those turns as a single system message, the system prompts and
+ * the recent window stay verbatim. Messages are only ever appended, so turns added meanwhile are
+ * unaffected. A failed summary is retried with a growing delay. Game thread only.
+ */
+UCLASS(BlueprintType)
+class GENERATIVEAISUPPORT_API UGenConversation : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Conversation")
+	static UGenConversation* CreateConversation(const FGenCompactionSettings& Settings);
+
+	/** Appends a message, may start a compaction in the background */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Conversation")
+	void AddMessage(const FGenChatMessage& Message);
+
+	/** The history to send with the next turn */
+	UFUNCTION(BlueprintPure, Category = "GenAI|Conversation")
+	const TArray<FGenChatMessage>& GetMessages() const { return Messages; }
+
+	/** Replaces the history, a compaction in flight is dropped */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Conversation")
+	void SetMessages(const TArray<FGenChatMessage>& InMessages);
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Conversation")
+	bool IsCompacting() const { return PendingFold.Num() > 0; }
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Conversation")
+	int32 GetPromptTokens() const;
+
+	// Fires after older turns were replaced by their summary
+	UPROPERTY(BlueprintAssignable)
+	FGenConversationCompactedDelegate OnCompacted;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Conversation")
+	FGenCompactionSettings Settings;
+
+	virtual void BeginDestroy() override;
+
+private:
+	void CompactIfNeeded();
+	void ApplySummary(uint32 ForGeneration, const FString& Summary);
+	void CancelCompaction();
+
+	UPROPERTY()
+	TArray<FGenChatMessage> Messages;
+
+	// Index of the summary written by an earlier compaction, folded into the next one
+	int32 SummaryIndex = INDEX_NONE;
+
+	// Messages being summarized, ascending
+	TArray<int32> PendingFold;
+	FGenRequestHandle PendingRequest;
+
+	// Bumped whenever the history is replaced, so stale summaries are ignored
+	uint32 Generation = 0;
+
+	// Failed summaries in a row and the time before which no new one is requested
+	int32 CompactionFailures = 0;
+	double RetryCompactionAt = 0.0;
+};
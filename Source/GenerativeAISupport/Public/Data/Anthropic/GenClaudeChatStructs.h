@@ -39,6 +39,16 @@ struct FGenClaudeChatSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude API")
 	TArray<FGenChatMessage> Messages;
+
+	// Oldest non-system messages are dropped locally until the prompt fits, 0 sends the history as is.
+	// Claude's vocabulary is not public so the count is an estimate, leave some headroom
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude API", meta = (ClampMin = "0"))
+	int32 MaxPromptTokens = 0;
+
+	// Answer paraphrases of earlier messages in the same conversation and settings from the local semantic cache.
+	// Lookups embed the message with OpenAI, so an OpenAI key is needed as well
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude API")
+	bool bUseSemanticCache = false;
 };
 
 /**
@@ -16,6 +16,7 @@ enum class EGenAIOrgs : uint8
 	Meta        UMETA(DisplayName = "Meta"),
 	Google      UMETA(DisplayName = "Google"),
 	XAI         UMETA(DisplayName = "XAI"),
+	Local       UMETA(DisplayName = "Local/Custom"),
 	Unknown     UMETA(DisplayName = "Unknown")
 };
 
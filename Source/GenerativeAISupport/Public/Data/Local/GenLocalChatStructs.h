@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "GenLocalChatStructs.generated.h"
+
+/**
+ * Chat request for a local or self-hosted OpenAI-compatible server, configured under the
+ * Local Provider runtime settings
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenLocalChatSettings
+{
+	GENERATED_BODY()
+
+	// Model served by the local server, empty uses the first entry of LocalModels
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Local", meta = (GetOptions = "GenerativeAISupport.GenLocalChat.GetLocalModelNames"))
+	FString Model;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Local")
+	int32 MaxTokens = 1024;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Local")
+	float Temperature = 0.7f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Local")
+	TArray<FGenChatMessage> Messages;
+
+	// Deliver the answer as it is generated, the completion callback still gets the full text
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Local")
+	bool bStreamResponse = true;
+
+	/** Model name sent to the server */
+	FString GetModelName() const;
+};
@@ -6,6 +6,9 @@
 #include "Data/OpenAI/GenOAIModels.h"
 #include "GenOAIChatStructs.generated.h"
 
+class UTexture2D;
+class UTextureRenderTarget2D;
+
 UENUM(BlueprintType)
 enum class EGenAIOpenAIReasoningEffort : uint8
 {
@@ -60,6 +63,57 @@ struct FResponse
 };
 
 
+UENUM(BlueprintType)
+enum class EGenImageDetail : uint8
+{
+    Auto UMETA(DisplayName = "Auto"),
+    Low UMETA(DisplayName = "Low"),
+    High UMETA(DisplayName = "High")
+};
+
+UENUM(BlueprintType)
+enum class EGenImageEncoding : uint8
+{
+    JPEG UMETA(DisplayName = "JPEG"),
+    PNG UMETA(DisplayName = "PNG")
+};
+
+/**
+ * Image sent along with a chat message.
+ * The first source set is used: Texture, RenderTarget, then the native pixels. The image is read,
+ * downscaled to the provider's limit and encoded off the game thread when the request is sent.
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenChatImage
+{
+    GENERATED_BODY()
+
+    // Compressed textures are only readable in editor builds, from their source art
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Vision")
+    TObjectPtr<UTexture2D> Texture = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Vision")
+    TObjectPtr<UTextureRenderTarget2D> RenderTarget = nullptr;
+
+    // Low sends a 512 pixel image at a fraction of the tokens
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Vision")
+    EGenImageDetail Detail = EGenImageDetail::Auto;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Vision")
+    EGenImageEncoding Encoding = EGenImageEncoding::JPEG;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Vision", meta = (ClampMin = "1", ClampMax = "100", EditCondition = "Encoding == EGenImageEncoding::JPEG"))
+    int32 Quality = 85;
+
+    // Raw BGRA pixels for native callers, shared so that copying the message never copies the image
+    TSharedPtr<const TArray<FColor>, ESPMode::ThreadSafe> Pixels;
+    FIntPoint PixelSize = FIntPoint::ZeroValue;
+
+    static FGenChatImage FromPixels(TArray<FColor>&& InPixels, FIntPoint InSize);
+
+    bool HasSource() const { return Texture != nullptr || RenderTarget != nullptr || Pixels.IsValid(); }
+};
+
 USTRUCT(BlueprintType)
 struct FGenChatMessage
 {
@@ -70,6 +124,10 @@ struct FGenChatMessage
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI")
     FString Content;
+
+    // Sent with the text, ignored by providers without vision support
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI")
+    TArray<FGenChatImage> Images;
 };
 
 USTRUCT(BlueprintType)
@@ -103,6 +161,14 @@ struct FGenChatSettings
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI")
     TArray<FGenChatMessage> Messages;
+
+    // Oldest non-system messages are dropped locally until the prompt fits, 0 sends the history as is
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI", meta = (ClampMin = "0"))
+    int32 MaxPromptTokens = 0;
+
+    // Answer paraphrases of earlier messages in the same conversation and settings from the local semantic cache
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI")
+    bool bUseSemanticCache = false;
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI|GPT-5")
     EGenAIOpenAIReasoningEffort ReasoningEffort = EGenAIOpenAIReasoningEffort::Default;
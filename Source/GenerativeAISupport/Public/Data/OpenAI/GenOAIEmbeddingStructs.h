@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIModels.h"
+#include "GenOAIEmbeddingStructs.generated.h"
+
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenEmbeddingSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI")
+	EGenOAIEmbeddingModel ModelEnum = EGenOAIEmbeddingModel::Text_Embedding_3_Small;
+
+	// Custom model name if ModelEnum is set to Custom
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI", meta = (EditCondition = "ModelEnum == EGenOAIEmbeddingModel::Custom", EditConditionHides))
+	FString CustomModel;
+
+	// Texts to embed, any number: they are split into batches automatically
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI")
+	TArray<FString> Inputs;
+
+	// Shortens the vectors on text-embedding-3 models, 0 keeps the model default
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI", meta = (ClampMin = "0"))
+	int32 Dimensions = 0;
+
+	// Inputs per request, the API accepts up to 2048
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI|Batching", meta = (ClampMin = "1", ClampMax = "2048"))
+	int32 MaxInputsPerBatch = 256;
+
+	// Batches in flight at the same time
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI|Batching", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 MaxConcurrentBatches = 4;
+
+	FString GetModelName() const
+	{
+		return ModelEnum == EGenOAIEmbeddingModel::Custom ? CustomModel : UGenOAIModelUtils::EmbeddingModelToString(ModelEnum);
+	}
+};
+
+/**
+ * Embeddings for every input, stored contiguously: vector i starts at Values[i * Dimensions]
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenEmbeddingResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|OpenAI")
+	int32 Dimensions = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|OpenAI")
+	TArray<float> Values;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|OpenAI")
+	int32 PromptTokens = 0;
+
+	int32 Num() const { return Dimensions > 0 ? Values.Num() / Dimensions : 0; }
+
+	TArrayView<const float> GetEmbedding(int32 Index) const
+	{
+		check(Index >= 0 && Index < Num());
+		return TArrayView<const float>(Values.GetData() + static_cast<int64>(Index) * Dimensions, Dimensions);
+	}
+};
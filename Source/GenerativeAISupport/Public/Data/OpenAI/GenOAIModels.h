@@ -38,6 +38,18 @@ enum class EGenOAIWhisperModel : uint8
     Custom UMETA(DisplayName = "Custom Model")
 };
 
+/**
+ * Enum representing available OpenAI embedding models
+ */
+UENUM(BlueprintType)
+enum class EGenOAIEmbeddingModel : uint8
+{
+    Text_Embedding_3_Small UMETA(DisplayName = "Text Embedding 3 Small"),
+    Text_Embedding_3_Large UMETA(DisplayName = "Text Embedding 3 Large"),
+    Text_Embedding_Ada_002 UMETA(DisplayName = "Text Embedding Ada 002"),
+    Custom UMETA(DisplayName = "Custom Model")
+};
+
 /**
  * Utility class for OpenAI models
  */
@@ -104,5 +116,25 @@ public:
             return TEXT("");
         }
     }
+
+    /**
+     * Convert embedding model enum to string representation
+     */
+    UFUNCTION(BlueprintCallable, Category = "GenAI|OpenAI|Models")
+    static FString EmbeddingModelToString(EGenOAIEmbeddingModel Model)
+    {
+        switch (Model)
+        {
+        case EGenOAIEmbeddingModel::Text_Embedding_3_Small:
+            return TEXT("text-embedding-3-small");
+        case EGenOAIEmbeddingModel::Text_Embedding_3_Large:
+            return TEXT("text-embedding-3-large");
+        case EGenOAIEmbeddingModel::Text_Embedding_Ada_002:
+            return TEXT("text-embedding-ada-002");
+        case EGenOAIEmbeddingModel::Custom:
+        default:
+            return TEXT("");
+        }
+    }
 };
 
@@ -0,0 +1,35 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenOAISpeechStructs.generated.h"
+
+/**
+ * Text-to-speech request, the audio is streamed as 24 kHz 16 bit mono PCM
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenOAISpeechSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI|Speech")
+	FString Model = TEXT("gpt-4o-mini-tts");
+
+	// alloy, ash, ballad, coral, echo, fable, onyx, nova, sage, shimmer or verse
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI|Speech")
+	FString Voice = TEXT("alloy");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI|Speech", meta = (MultiLine = "true"))
+	FString Input;
+
+	// Tone and delivery, ignored by the tts-1 models
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI|Speech", meta = (MultiLine = "true"))
+	FString Instructions;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|OpenAI|Speech", meta = (ClampMin = "0.25", ClampMax = "4.0"))
+	float Speed = 1.0f;
+};
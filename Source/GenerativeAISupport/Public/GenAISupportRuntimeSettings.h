@@ -0,0 +1,200 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/GenAIOrgs.h"
+#include "Data/OpenAI/GenOAIModels.h"
+#include "Engine/DeveloperSettings.h"
+#include "GenAISupportRuntimeSettings.generated.h"
+
+/**
+ * A provider endpoint the connection manager keeps warm
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenConnectionEndpoint
+{
+	GENERATED_BODY()
+
+	/** Provider this endpoint belongs to */
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Connections")
+	EGenAIOrgs Org = EGenAIOrgs::OpenAI;
+
+	/** URL used for warm-up and keep-alive pings, any cheap unauthenticated path on the provider host works */
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Connections")
+	FString WarmUrl;
+
+	/** Number of parallel connections to open during pre-warm */
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Connections", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 PoolSize = 1;
+
+	/** Keep-alive ping interval for this host, 0 uses KeepAlivePingIntervalSeconds */
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Connections", meta = (ClampMin = "0"))
+	float PingIntervalSeconds = 0.0f;
+};
+
+/**
+ * Price of a provider's default model, used by the router's cost ceiling
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenProviderPricing
+{
+	GENERATED_BODY()
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Routing")
+	EGenAIOrgs Org = EGenAIOrgs::OpenAI;
+
+	/** USD per million prompt tokens */
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Routing", meta = (ClampMin = "0"))
+	float InputCostPerMillionTokens = 0.0f;
+
+	/** USD per million completion tokens */
+	UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Routing", meta = (ClampMin = "0"))
+	float OutputCostPerMillionTokens = 0.0f;
+};
+
+/**
+ * What happens to a background request in flight when higher priority work finds its provider saturated
+ */
+UENUM(BlueprintType)
+enum class EGenPreemptionPolicy : uint8
+{
+	Disabled    UMETA(DisplayName = "Disabled"),
+	Requeue     UMETA(DisplayName = "Abort and Requeue"),
+	Cancel      UMETA(DisplayName = "Cancel")
+};
+
+/**
+ * Runtime settings for the Generative AI Support Plugin, available in packaged games
+ */
+UCLASS(config=Game, defaultconfig, meta = (DisplayName = "Generative AI Support Runtime"))
+class GENERATIVEAISUPPORT_API UGenAISupportRuntimeSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UGenAISupportRuntimeSettings();
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	/**
+	 * Open connections to the endpoints below once the engine loop has started and keep them alive with pings.
+	 * Only providers with an API key are contacted. Off by default so games do not ping hosts they never use
+	 */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Connections")
+	bool bPrewarmConnectionsOnStartup = false;
+
+	/** Endpoints to pre-warm and keep alive, point these at a local stand-in server for testing */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Connections")
+	TArray<FGenConnectionEndpoint> WarmEndpoints;
+
+	/** Seconds of inactivity after which an endpoint is pinged to keep its connections open, 0 disables pings */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Connections", meta = (ClampMin = "0"))
+	float KeepAlivePingIntervalSeconds = 45.0f;
+
+	/** Seconds an idle connection is assumed to stay open, matches the HTTP backend's connection max age */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Connections", meta = (ClampMin = "1"))
+	float IdleConnectionLifetimeSeconds = 110.0f;
+
+	/** Requests sent to one provider at the same time, the rest wait in the provider's queue */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Requests", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 MaxConcurrentRequestsPerProvider = 4;
+
+	/** Seconds a queued request waits before it is promoted by one priority class, 0 disables aging */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Requests", meta = (ClampMin = "0"))
+	float PriorityAgingSeconds = 10.0f;
+
+	/** Whether interactive and critical requests may abort background requests when their provider is saturated */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Requests")
+	EGenPreemptionPolicy BackgroundPreemption = EGenPreemptionPolicy::Disabled;
+
+	/** Cosine similarity above which a new user message is answered with a cached response */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Semantic Cache", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float SemanticCacheSimilarityThreshold = 0.92f;
+
+	/** Model used to embed user messages for the semantic cache */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Semantic Cache")
+	EGenOAIEmbeddingModel SemanticCacheEmbeddingModel = EGenOAIEmbeddingModel::Text_Embedding_3_Small;
+
+	/** Embedding size kept per cached message, small vectors are plenty to match paraphrases */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Semantic Cache", meta = (ClampMin = "16"))
+	int32 SemanticCacheEmbeddingDimensions = 256;
+
+	/** Responses kept per persona or system prompt, the least recently used are evicted first */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Semantic Cache", meta = (ClampMin = "1"))
+	int32 SemanticCacheMaxEntriesPerScope = 1024;
+
+	/** Seconds a cached response stays valid, 0 keeps it until evicted */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Semantic Cache", meta = (ClampMin = "0"))
+	float SemanticCacheEntryLifetimeSeconds = 0.0f;
+
+	/** Provider prices for routing cost ceilings, providers without an entry always pass the ceiling */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Routing")
+	TArray<FGenProviderPricing> ProviderPricing;
+
+	/** Weight of the newest sample in the router's latency and error averages */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Routing", meta = (ClampMin = "0.01", ClampMax = "1.0"))
+	float RouterHealthSmoothing = 0.2f;
+
+	/** Consecutive failures after which the router skips a provider for RouterCooldownSeconds */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Routing", meta = (ClampMin = "1"))
+	int32 RouterFailuresBeforeCooldown = 3;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Routing", meta = (ClampMin = "0"))
+	float RouterCooldownSeconds = 30.0f;
+
+	/** Base URL of the OpenAI API, chat, structured output and embedding paths are appended to it */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Endpoints")
+	FString OpenAIBaseUrl = TEXT("https://api.openai.com/v1");
+
+	/** Base URL of the Anthropic API */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Endpoints")
+	FString AnthropicBaseUrl = TEXT("https://api.anthropic.com/v1");
+
+	/** Base URL of the DeepSeek API */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Endpoints")
+	FString DeepSeekBaseUrl = TEXT("https://api.deepseek.com");
+
+	/** Base URL of the xAI API */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Endpoints")
+	FString XAIBaseUrl = TEXT("https://api.x.ai/v1");
+
+	/** Makes the Local/Custom provider available to the router and keeps its connections alive */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Local Provider")
+	bool bEnableLocalProvider = false;
+
+	/** Base URL of an OpenAI-compatible server such as llama.cpp, vLLM, Ollama or LM Studio, or of a stand-in test server */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Local Provider")
+	FString LocalBaseUrl = TEXT("http://127.0.0.1:8080/v1");
+
+	/** Header the Local/Custom API key is sent in, leave empty for servers without authentication */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Local Provider")
+	FString LocalAuthHeader = TEXT("Authorization");
+
+	/** Text put in front of the key in LocalAuthHeader */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Local Provider")
+	FString LocalAuthPrefix = TEXT("Bearer ");
+
+	/** Models served by the local server, the first one is used when a request does not name one */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Local Provider")
+	TArray<FString> LocalModels;
+
+	/** Seconds a local request may take, local models on consumer hardware generate slowly */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Local Provider", meta = (ClampMin = "1"))
+	float LocalRequestTimeoutSeconds = 300.0f;
+
+	/** Connections kept open to the local server */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Local Provider", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 LocalConnectionPoolSize = 2;
+
+	/** Idle seconds before the local server is pinged. LAN round-trips are cheap and servers like uvicorn drop
+	 *  idle connections after 5 seconds, so this is much shorter than the cloud interval. 0 disables pings */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Local Provider", meta = (ClampMin = "0"))
+	float LocalKeepAlivePingIntervalSeconds = 4.0f;
+
+	/** Base URL of a provider's API without a trailing slash, empty for providers without one */
+	FString GetBaseUrl(EGenAIOrgs Org) const;
+};
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Data/Anthropic/GenClaudeChatStructs.h"
 #include "Engine/CancellableAsyncAction.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
 #include "UObject/Object.h"
 #include "GenClaudeChat.generated.h"
 
@@ -25,8 +28,9 @@ class GENERATIVEAISUPPORT_API UGenClaudeChat : public UCancellableAsyncAction
 	GENERATED_BODY()
     
 public:
-	// Static function for native C++
-	static void SendChatRequest(const FGenClaudeChatSettings& ChatSettings, const FOnClaudeChatCompletionResponse& OnComplete);
+	// Static function for native C++, the optional token cancels the request or bounds it with a deadline
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SendChatRequest(const FGenClaudeChatSettings& ChatSettings, const FOnClaudeChatCompletionResponse& OnComplete,
+	                                                                     const FGenCancellationTokenPtr& CancellationToken = nullptr);
 
 	// Blueprint async function
 	UPROPERTY(BlueprintAssignable)
@@ -36,12 +40,16 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|Claude")
 	static UGenClaudeChat* RequestClaudeChat(UObject* WorldContextObject, const FGenClaudeChatSettings& ChatSettings);
 
+	virtual void Cancel() override;
+	virtual void BeginDestroy() override;
+
 private:
-	// Stores settings for request
-	FGenClaudeChatSettings ChatSettings;
+	// Request owned by UGenRequestSubsystem, this action is only a view over its pooled slot
+	FGenRequestHandle RequestHandle;
 
 	// Internal request processing
-	static void MakeRequest(const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> MakeRequest(const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+	                                                                 const FGenCancellationTokenPtr& CancellationToken);
 	static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
 
 protected:
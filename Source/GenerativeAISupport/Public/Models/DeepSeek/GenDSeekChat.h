@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Data/GenAIOrgs.h"
 #include "Engine/CancellableAsyncAction.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
 #include "GenDSeekChat.generated.h"
 
 struct FGenChatMessage;
@@ -26,6 +29,10 @@ struct FGenDSeekChatSettings
 	UPROPERTY(BlueprintReadWrite, Category = "GenAI")
 	int32 MaxTokens = 4096;
 
+	// The reasoner model accepts but ignores it
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI")
+	float Temperature = 1.0f;
+
 	UPROPERTY(BlueprintReadWrite, Category = "GenAI")
 	TArray<FGenChatMessage> Messages;
 
@@ -43,8 +50,9 @@ class GENERATIVEAISUPPORT_API UGenDSeekChat : public UCancellableAsyncAction
 	GENERATED_BODY()
 	
 public:
-	// Static function for native C++
-	static void SendChatRequest(const FGenDSeekChatSettings& ChatSettings, const FOnDSeekChatCompletionResponse& OnComplete);
+	// Static function for native C++, the optional token cancels the request or bounds it with a deadline
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SendChatRequest(const FGenDSeekChatSettings& ChatSettings, const FOnDSeekChatCompletionResponse& OnComplete,
+	                                                                     const FGenCancellationTokenPtr& CancellationToken = nullptr);
 
 	// Blueprint async function
 	UPROPERTY(BlueprintAssignable)
@@ -54,12 +62,16 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|DeepSeek")
 	static UGenDSeekChat* RequestDeepseekChat(UObject* WorldContextObject, const FGenDSeekChatSettings& ChatSettings);
 
+	virtual void Cancel() override;
+	virtual void BeginDestroy() override;
+
 private:
-	// Stores settings for request
-	FGenDSeekChatSettings ChatSettings;
+	// Request owned by UGenRequestSubsystem, this action is only a view over its pooled slot
+	FGenRequestHandle RequestHandle;
 
 	// Internal request processing
-	static void MakeRequest(const FGenDSeekChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> MakeRequest(const FGenDSeekChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+	                                                                 const FGenCancellationTokenPtr& CancellationToken);
 	static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
 
 protected:
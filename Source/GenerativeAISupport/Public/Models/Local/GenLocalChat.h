@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Local/GenLocalChatStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
+#include "GenLocalChat.generated.h"
+
+// Delegates for native code, the delta delegate fires for every streamed fragment
+DECLARE_DELEGATE_ThreeParams(FOnLocalChatCompletionResponse, const FString&, const FString&, bool);
+DECLARE_DELEGATE_OneParam(FOnLocalChatDelta, const FString&);
+
+// Blueprint async delegates
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenLocalChatCompletionDelegate, const FString&, Response, const FString&, Error, bool, Success);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGenLocalChatDeltaDelegate, const FString&, Delta);
+
+/**
+ * Chat with a local or self-hosted server speaking the OpenAI chat completions protocol.
+ *
+ * The server, its authentication and its models are configured under the Local Provider runtime
+ * settings, so the same requests can be pointed at a stand-in server in tests.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenLocalChat : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Static function for native C++, the optional token cancels the request or bounds it with a deadline
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SendChatRequest(const FGenLocalChatSettings& ChatSettings, const FOnLocalChatCompletionResponse& OnComplete,
+	                                                                     const FGenCancellationTokenPtr& CancellationToken = nullptr,
+	                                                                     const FOnLocalChatDelta& OnDelta = FOnLocalChatDelta());
+
+	// Fires for every fragment of a streamed response
+	UPROPERTY(BlueprintAssignable)
+	FGenLocalChatDeltaDelegate OnDelta;
+
+	UPROPERTY(BlueprintAssignable)
+	FGenLocalChatCompletionDelegate OnComplete;
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|Local")
+	static UGenLocalChat* RequestLocalChat(UObject* WorldContextObject, const FGenLocalChatSettings& ChatSettings);
+
+	/** Models listed in the Local Provider settings */
+	UFUNCTION(BlueprintPure, Category = "GenAI|Local")
+	static TArray<FString> GetLocalModelNames();
+
+	virtual void Cancel() override;
+	virtual void BeginDestroy() override;
+
+private:
+	// Request owned by UGenRequestSubsystem, this action is only a view over its pooled slot
+	FGenRequestHandle RequestHandle;
+
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> MakeRequest(const FGenLocalChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+	                                                                 const FGenCancellationTokenPtr& CancellationToken, const FOnLocalChatDelta& OnDelta);
+
+protected:
+	virtual void Activate() override;
+};
@@ -8,6 +8,8 @@
 #include "Engine/CancellableAsyncAction.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
 #include "GenOAIChat.generated.h"
 
 
@@ -26,8 +28,9 @@ class GENERATIVEAISUPPORT_API UGenOAIChat : public UCancellableAsyncAction
     GENERATED_BODY()
 
 public:
-    // Static function for native C++
-    static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SendChatRequest(const FGenChatSettings& ChatSettings, const FOnChatCompletionResponse& OnComplete);
+    // Static function for native C++, the optional token cancels the request or bounds it with a deadline
+    static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SendChatRequest(const FGenChatSettings& ChatSettings, const FOnChatCompletionResponse& OnComplete,
+                                                                         const FGenCancellationTokenPtr& CancellationToken = nullptr);
 
     // Blueprint-callable function
     UPROPERTY(BlueprintAssignable)
@@ -38,13 +41,15 @@ public:
     static UGenOAIChat* RequestOpenAIChat(UObject* WorldContextObject, const FGenChatSettings& ChatSettings);
     
     virtual void Cancel() override;
+    virtual void BeginDestroy() override;
 
 private:
-    FGenChatSettings ChatSettings;
-    TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+    // Request owned by UGenRequestSubsystem, this action is only a view over its pooled slot
+    FGenRequestHandle RequestHandle;
 
     // Shared implementation
-    static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> MakeRequest(const FGenChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+    static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> MakeRequest(const FGenChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                                                     const FGenCancellationTokenPtr& CancellationToken);
     static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
 
 protected:
@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIEmbeddingStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
+#include "GenOAIEmbeddings.generated.h"
+
+// Native completion, the result is handed over by rvalue so large batches are never copied
+typedef TFunction<void(FGenEmbeddingResult&& Result, const FString& Error, bool bSuccess)> FGenEmbeddingCallback;
+
+// Blueprint async delegate
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenEmbeddingCompletionDelegate, const FGenEmbeddingResult&, Result, const FString&, Error, bool, Success);
+
+/**
+ * OpenAI embeddings client.
+ *
+ * Inputs are split into MaxInputsPerBatch sized requests, up to MaxConcurrentBatches of which are in
+ * flight at once. Responses are decoded on worker threads straight into one preallocated float
+ * buffer, so a few thousand vectors never round-trip through JSON value objects.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenOAIEmbeddings : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Static function for native C++, completes on the game thread. The token cancels every batch
+	static void SendEmbeddingRequest(const FGenEmbeddingSettings& EmbeddingSettings, FGenEmbeddingCallback&& OnComplete,
+	                                 const FGenCancellationTokenPtr& CancellationToken = nullptr);
+
+	UPROPERTY(BlueprintAssignable)
+	FGenEmbeddingCompletionDelegate OnComplete;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI")
+	static UGenOAIEmbeddings* RequestOpenAIEmbeddings(UObject* WorldContextObject, const FGenEmbeddingSettings& EmbeddingSettings);
+
+	// Copies one vector out of a result
+	UFUNCTION(BlueprintPure, Category = "GenAI|OpenAI")
+	static TArray<float> GetEmbedding(const FGenEmbeddingResult& Result, int32 Index);
+
+	virtual void Cancel() override;
+	virtual void BeginDestroy() override;
+
+private:
+	// Request owned by UGenRequestSubsystem, this action is only a view over its pooled slot
+	FGenRequestHandle RequestHandle;
+
+protected:
+	virtual void Activate() override;
+};
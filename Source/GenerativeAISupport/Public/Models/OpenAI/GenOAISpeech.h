@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Audio/GenStreamingSoundWave.h"
+#include "Data/OpenAI/GenOAISpeechStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
+#include "GenOAISpeech.generated.h"
+
+// Delegate for native code, called on the game thread once all of the audio was written
+DECLARE_DELEGATE_TwoParams(FOnSpeechCompletionResponse, const FString&, bool);
+
+// Blueprint async delegate
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenSpeechDelegate, UGenStreamingSoundWave*, Sound, const FString&, Error, bool, Success);
+
+/**
+ * OpenAI text-to-speech with streamed playback.
+ *
+ * The audio is requested as raw PCM and written into the sound wave's buffer on the HTTP thread
+ * as each chunk arrives, so playback can start with the first chunk instead of the whole file.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenOAISpeech : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Static function for native C++. The buffer is not finished when the request completes, so several
+	 * requests can be spoken into one wave. OnAudioStarted fires on the game thread with the first chunk
+	 */
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SendSpeechRequest(const FGenOAISpeechSettings& SpeechSettings, const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& Buffer,
+	                                                                       const FOnSpeechCompletionResponse& OnComplete, const FGenCancellationTokenPtr& CancellationToken = nullptr,
+	                                                                       const FSimpleDelegate& OnAudioStarted = FSimpleDelegate());
+
+	// Fires with the first chunk of audio, play the sound from here
+	UPROPERTY(BlueprintAssignable)
+	FGenSpeechDelegate OnStarted;
+
+	UPROPERTY(BlueprintAssignable)
+	FGenSpeechDelegate OnComplete;
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|OpenAI|Speech")
+	static UGenOAISpeech* RequestOpenAISpeech(UObject* WorldContextObject, const FGenOAISpeechSettings& SpeechSettings);
+
+	virtual void Cancel() override;
+	virtual void BeginDestroy() override;
+
+private:
+	// Request owned by UGenRequestSubsystem, this action is only a view over its pooled slot
+	FGenRequestHandle RequestHandle;
+
+	UPROPERTY()
+	TObjectPtr<UGenStreamingSoundWave> Sound;
+
+protected:
+	virtual void Activate() override;
+};
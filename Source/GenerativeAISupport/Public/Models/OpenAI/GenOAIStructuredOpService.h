@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Data/OpenAI/GenOAIChatStructs.h"
 #include "Engine/CancellableAsyncAction.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
 #include "GenOAIStructuredOpService.generated.h"
 
 // Static delegate for native C++ usage
@@ -23,8 +26,9 @@ class GENERATIVEAISUPPORT_API UGenOAIStructuredOpService : public UCancellableAs
 	GENERATED_BODY()
 
 public:
-	// Static function for native C++
-	static void RequestStructuredOutput(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FOnSchemaResponse& OnComplete);
+	// Static function for native C++, the optional token cancels the request or bounds it with a deadline
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> RequestStructuredOutput(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FOnSchemaResponse& OnComplete,
+	                                                                             const FGenCancellationTokenPtr& CancellationToken = nullptr);
 
 	// Blueprint async function
 	UPROPERTY(BlueprintAssignable)
@@ -34,13 +38,17 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI")
 	static UGenOAIStructuredOpService* RequestOpenAIStructuredOutput(UObject* WorldContextObject, const FGenOAIStructuredChatSettings& StructuredChatSettings);
 
+	virtual void Cancel() override;
+	virtual void BeginDestroy() override;
+
 private:
 	FString Prompt;
 	FString SchemaJson;
-	FGenOAIStructuredChatSettings StructuredChatSettings;
+	// Request owned by UGenRequestSubsystem, this action is only a view over its pooled slot
+	FGenRequestHandle RequestHandle;
 
-	static void MakeRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings, const TFunction<void(const FString&, const FString&, bool)
-	                        >& ResponseCallback);
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> MakeRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings, const TFunction<void(const FString&, const FString&, bool)
+	                                                                 >& ResponseCallback, const FGenCancellationTokenPtr& CancellationToken);
 	static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
 
 protected:
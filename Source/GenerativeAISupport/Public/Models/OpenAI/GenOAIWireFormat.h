@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Interfaces/IHttpRequest.h"
+
+struct FGenChatImage;
+struct FGenChatMessage;
+
+/**
+ * Chat completions wire format, shared by OpenAI and every OpenAI-compatible server
+ */
+class GENERATIVEAISUPPORT_API FGenOAIWireFormat
+{
+public:
+	/**
+	 * Payload with the model and messages set, callers add their provider specific fields.
+	 * Images are written as placeholders and collected into OutImages for FGenImageEncoder, they are left out when it is null
+	 */
+	static TSharedRef<FJsonObject> MakeChatPayload(const FString& Model, const TArray<FGenChatMessage>& Messages, TArray<FGenChatImage>* OutImages = nullptr);
+
+	/** JSON POST of the payload, no auth header is sent when AuthHeader or AuthValue is empty */
+	static TSharedRef<IHttpRequest, ESPMode::ThreadSafe> MakeChatRequest(const FString& Url, const TSharedRef<FJsonObject>& Payload,
+	                                                                     const FString& AuthHeader, const FString& AuthValue);
+
+	/** Reads the first choice's message, or the error of a failed request into OutError */
+	static bool ParseChatResponse(const FString& ResponseStr, FString& OutContent, FString& OutError);
+};
+
+/**
+ * Incremental decoder for streamed chat completions.
+ *
+ * The server sends one server-sent event per delta. Bytes are only decoded once their line is
+ * complete, so UTF-8 sequences split across reads are never cut.
+ */
+class GENERATIVEAISUPPORT_API FGenOAIStreamDecoder
+{
+public:
+	/** Decodes the bytes of Received not seen by an earlier call, OnDelta gets every new content fragment */
+	void Update(const TArray<uint8>& Received, const TFunctionRef<void(const FString&)>& OnDelta);
+
+	/** Every fragment received so far */
+	const FString& GetContent() const { return Content; }
+
+	/** Error event sent by the server, empty if there was none */
+	const FString& GetError() const { return Error; }
+
+	/** True once the server sent the [DONE] event */
+	bool IsDone() const { return bDone; }
+
+	/** True if any event was decoded, false when the server ignored the stream flag */
+	bool HasEvents() const { return bHasEvents; }
+
+private:
+	void DecodeLine(const ANSICHAR* Line, int32 Length, const TFunctionRef<void(const FString&)>& OnDelta);
+
+	int32 Consumed = 0;
+	FString Content;
+	FString Error;
+	bool bDone = false;
+	bool bHasEvents = false;
+};
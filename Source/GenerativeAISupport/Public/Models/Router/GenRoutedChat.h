@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Network/GenProviderRouter.h"
+#include "GenRoutedChat.generated.h"
+
+// Blueprint async delegate, Provider is the backend that produced the result
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FGenRoutedChatCompletionDelegate, const FString&, Response, const FString&, Error, bool, Success, EGenAIOrgs, Provider);
+
+/**
+ * Blueprint entry point for FGenProviderRouter
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenRoutedChat : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FGenRoutedChatCompletionDelegate OnComplete;
+
+	// Sends the request to the best healthy provider allowed by the policy, failing over on errors and timeouts
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|Routing")
+	static UGenRoutedChat* RequestRoutedChat(UObject* WorldContextObject, const FGenRoutedChatRequest& Request, const FGenRoutingPolicy& Policy);
+
+	virtual void Cancel() override;
+
+protected:
+	virtual void Activate() override;
+
+private:
+	FGenRoutedChatRequest Request;
+	FGenRoutingPolicy Policy;
+
+	// Valid while the request runs, cancelling it aborts the current attempt and every failover
+	FGenCancellationTokenPtr CancellationToken;
+};
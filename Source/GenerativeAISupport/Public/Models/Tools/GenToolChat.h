@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Tools/GenToolLoop.h"
+#include "GenToolChat.generated.h"
+
+// Blueprint async delegates
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenToolChatCompletionDelegate, const FString&, Response, const FString&, Error, bool, Success);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenToolCalledDelegate, const FString&, ToolName, const FString&, Arguments, const FString&, Result);
+
+/**
+ * Blueprint entry point for FGenToolLoop, the tools are UFUNCTIONs and run on the game thread
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenToolChat : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Fires after every tool call, before its result is sent back to the model
+	UPROPERTY(BlueprintAssignable)
+	FGenToolCalledDelegate OnToolCalled;
+
+	UPROPERTY(BlueprintAssignable)
+	FGenToolChatCompletionDelegate OnComplete;
+
+	// Chats with the model, running the tools it asks for until it gives a final answer
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|Tools")
+	static UGenToolChat* RequestToolChat(UObject* WorldContextObject, const FGenToolChatSettings& ChatSettings, const TArray<FGenFunctionTool>& Tools);
+
+	virtual void Cancel() override;
+
+protected:
+	virtual void Activate() override;
+
+private:
+	FGenToolChatSettings ChatSettings;
+
+	UPROPERTY()
+	TArray<FGenFunctionTool> Tools;
+
+	// Valid while the chat runs, cancelling it aborts the current round and skips the rest
+	FGenCancellationTokenPtr CancellationToken;
+};
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Data/XAI/GenXAIChatStructs.h"
 #include "Engine/CancellableAsyncAction.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
 #include "GenXAIChat.generated.h"
 
 // Regular C++ delegate for native code
@@ -19,8 +22,9 @@ class GENERATIVEAISUPPORT_API UGenXAIChat : public UCancellableAsyncAction
     GENERATED_BODY()
 
 public:
-    // Static function for native C++
-    static void SendChatRequest(const FGenXAIChatSettings& ChatSettings, const FOnXAIChatCompletionResponse& OnComplete);
+    // Static function for native C++, the optional token cancels the request or bounds it with a deadline
+    static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> SendChatRequest(const FGenXAIChatSettings& ChatSettings, const FOnXAIChatCompletionResponse& OnComplete,
+                                                                         const FGenCancellationTokenPtr& CancellationToken = nullptr);
 
     // Blueprint-callable function
     UPROPERTY(BlueprintAssignable)
@@ -30,11 +34,16 @@ public:
     UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI")
     static UGenXAIChat* RequestXAIChat(UObject* WorldContextObject, const FGenXAIChatSettings& ChatSettings);
 
+    virtual void Cancel() override;
+    virtual void BeginDestroy() override;
+
 private:
-    FGenXAIChatSettings ChatSettings;
+    // Request owned by UGenRequestSubsystem, this action is only a view over its pooled slot
+    FGenRequestHandle RequestHandle;
 
     // Shared implementation
-    static void MakeRequest(const FGenXAIChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+    static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> MakeRequest(const FGenXAIChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                                                     const FGenCancellationTokenPtr& CancellationToken);
     static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
 
 protected:
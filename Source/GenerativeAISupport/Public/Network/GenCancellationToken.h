@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include <atomic>
+
+/**
+ * Shared cancellation and deadline state for a provider request.
+ *
+ * Every provider binds its HTTP request to the token, so cancelling the token aborts the transfer
+ * and a deadline becomes the request timeout. Anything else holding resources for the request
+ * (queue slots, pending retries) can register an OnCancelled callback to release them immediately.
+ * The token is thread safe and may outlive the request and the object that created it.
+ */
+class GENERATIVEAISUPPORT_API FGenCancellationToken : public TSharedFromThis<FGenCancellationToken, ESPMode::ThreadSafe>
+{
+public:
+	/** Creates a token, optionally with a deadline TimeoutSeconds from now */
+	static TSharedRef<FGenCancellationToken, ESPMode::ThreadSafe> Create(double TimeoutSeconds = 0.0);
+
+	/** Creates a token that is cancelled with this one and starts with its deadline, so it can be
+	 *  cancelled or given a tighter deadline on its own without affecting this token */
+	TSharedRef<FGenCancellationToken, ESPMode::ThreadSafe> CreateChild();
+
+	/** Cancels the token, aborting any bound request and running the cancel callbacks once */
+	void Cancel();
+
+	bool IsCancelled() const { return bCancelled; }
+
+	/** Sets an absolute deadline in FPlatformTime::Seconds() terms, 0 clears it */
+	void SetDeadline(double AbsoluteSeconds) { Deadline = AbsoluteSeconds; }
+
+	/** Sets the deadline relative to now */
+	void SetTimeout(double Seconds) { Deadline = Seconds > 0.0 ? FPlatformTime::Seconds() + Seconds : 0.0; }
+
+	bool HasDeadline() const { return Deadline > 0.0; }
+	double GetDeadline() const { return Deadline; }
+
+	/** Seconds left until the deadline, or a negative value when there is none */
+	double GetRemainingSeconds() const;
+
+	/** True once the deadline has passed */
+	bool IsExpired() const { return HasDeadline() && GetRemainingSeconds() <= 0.0; }
+
+	/** Registers a callback to run when the token is cancelled, runs immediately if it already is */
+	void OnCancelled(TFunction<void()>&& Callback);
+
+	/**
+	 * Binds an HTTP request to this token: cancelling aborts it and the remaining time until the
+	 * deadline becomes its timeout. Returns false if the token is already cancelled or expired,
+	 * in which case the request should not be processed.
+	 */
+	bool BindRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest);
+
+	/** Error reported to callbacks when a request never started because of this token */
+	FString GetStopReason() const;
+
+private:
+	std::atomic<bool> bCancelled { false };
+	std::atomic<double> Deadline { 0.0 };
+
+	FCriticalSection CallbacksLock;
+	TArray<TFunction<void()>> CancelCallbacks;
+};
+
+typedef TSharedPtr<FGenCancellationToken, ESPMode::ThreadSafe> FGenCancellationTokenPtr;
+typedef TSharedRef<FGenCancellationToken, ESPMode::ThreadSafe> FGenCancellationTokenRef;
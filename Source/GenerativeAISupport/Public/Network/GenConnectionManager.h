@@ -0,0 +1,110 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+enum class EGenAIOrgs : uint8;
+
+/**
+ * Per-host counters reported by the connection manager
+ */
+struct GENERATIVEAISUPPORT_API FGenConnectionStats
+{
+	/** scheme://host[:port] the counters belong to */
+	FString Origin;
+
+	/** Provider requests sent to this host */
+	int64 Requests = 0;
+
+	/**
+	 * Provider requests issued within IdleConnectionLifetimeSeconds of the last activity on the host.
+	 * The HTTP backend does not report whether it reused a connection, so this is a timing guess
+	 */
+	int64 EstimatedReusedRequests = 0;
+
+	/** Warm-up and keep-alive pings sent to this host */
+	int64 Pings = 0;
+
+	/** Round trip of the last ping, in milliseconds */
+	double LastPingMs = 0.0;
+
+	/** Share of requests that probably found an open connection, see EstimatedReusedRequests */
+	double GetEstimatedReuseRatio() const
+	{
+		return Requests > 0 ? static_cast<double>(EstimatedReusedRequests) / static_cast<double>(Requests) : 0.0;
+	}
+};
+
+/**
+ * Keeps provider connections warm so gameplay requests skip the DNS, TCP and TLS setup.
+ *
+ * The HTTP backend caches open connections per host. Pre-warming sends cheap requests to each
+ * configured endpoint so that cache is populated before the first real request, and idle hosts
+ * are pinged before the backend would drop their connections.
+ */
+class GENERATIVEAISUPPORT_API FGenConnectionManager
+{
+public:
+	/** Gets the singleton instance */
+	static FGenConnectionManager& Get();
+
+	/** Starts the keep-alive ticker and pre-warms endpoints if enabled in the runtime settings */
+	void Initialize();
+
+	/** Stops the keep-alive ticker */
+	void Shutdown();
+
+	/** Opens connections to every configured endpoint of the providers that have an API key */
+	void PrewarmAll();
+
+	/** Opens connections to every configured endpoint of one provider, if it has an API key */
+	void Prewarm(EGenAIOrgs Org);
+
+	/** Opens PoolSize connections to an arbitrary URL and keeps its host alive from then on.
+	 *  PingIntervalSeconds overrides KeepAlivePingIntervalSeconds for this host when positive */
+	void PrewarmUrl(const FString& Url, int32 PoolSize = 1, float PingIntervalSeconds = 0.0f);
+
+	/** Called by the providers right before a request is processed, updates the estimated reuse counters */
+	void NotifyRequestIssued(const FString& Url);
+
+	/** Snapshot of the counters for every known host */
+	TArray<FGenConnectionStats> GetStats() const;
+
+	/** Writes the counters for every known host to the log */
+	void LogStats() const;
+
+private:
+	struct FHostState
+	{
+		FString WarmUrl;
+		int32 PoolSize = 1;
+		float PingInterval = 0.0f;
+		double LastActivityTime = 0.0;
+		bool bHasConnection = false;
+		bool bKeepAlive = false;
+		int32 PingsInFlight = 0;
+		FGenConnectionStats Stats;
+	};
+
+	bool Tick(float DeltaTime);
+	void PrewarmLocal();
+	static bool HasApiKey(EGenAIOrgs Org);
+	void SendPings(const FString& Origin, const FString& Url, int32 Count);
+	static FString GetOrigin(const FString& Url);
+
+	/** Known hosts keyed by origin */
+	TMap<FString, FHostState> Hosts;
+
+	mutable FCriticalSection HostsLock;
+
+	FTSTicker::FDelegateHandle TickHandle;
+	FDelegateHandle EngineInitHandle;
+
+	/** Singleton instance */
+	static FGenConnectionManager* Singleton;
+};
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Anthropic/GenClaudeChatStructs.h"
+#include "Data/GenAIOrgs.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Network/GenRequestSubsystem.h"
+#include "GenProviderRouter.generated.h"
+
+/**
+ * Provider-neutral chat request, translated to each backend's settings when it is dispatched
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenRoutedChatRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	TArray<FGenChatMessage> Messages;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	int32 MaxTokens = 1024;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	float Temperature = 0.7f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing|Models")
+	EGenOAIChatModel OpenAIModel = EGenOAIChatModel::GPT_4O_Mini;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing|Models")
+	EClaudeModels ClaudeModel = EClaudeModels::Claude_4_Sonnet;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing|Models")
+	EDeepSeekModels DeepSeekModel = EDeepSeekModels::Chat;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing|Models")
+	FString XAIModel = TEXT("grok-3-latest");
+
+	// Empty uses the first model of the Local Provider settings
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing|Models")
+	FString LocalModel;
+};
+
+/**
+ * Which providers a routed request may use and what it may cost
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenRoutingPolicy
+{
+	GENERATED_BODY()
+
+	// Providers in order of preference, the first healthy one is tried first. Empty allows every provider
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing")
+	TArray<EGenAIOrgs> Providers;
+
+	// Seconds one attempt may take before the router fails over, also ranks providers by recent latency. 0 disables
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing", meta = (ClampMin = "0"))
+	float LatencySLOSeconds = 0.0f;
+
+	// Estimated USD a single request may cost, from the prompt size, MaxTokens and ProviderPricing. 0 disables
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing", meta = (ClampMin = "0"))
+	float MaxCostPerRequest = 0.0f;
+
+	// Providers tried before giving up, 0 tries every eligible provider
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Routing", meta = (ClampMin = "0"))
+	int32 MaxAttempts = 0;
+};
+
+/**
+ * Live health of one provider as seen by the router
+ */
+struct GENERATIVEAISUPPORT_API FGenProviderHealth
+{
+	double LatencyEwmaSeconds = 0.0;
+	double ErrorEwma = 0.0;
+	int64 Requests = 0;
+	int32 ConsecutiveFailures = 0;
+	double CooldownUntil = 0.0;
+};
+
+// Completion of a routed request, ServedBy is the provider that produced the final result
+typedef TFunction<void(const FString& Response, const FString& Error, bool bSuccess, EGenAIOrgs ServedBy)> FGenRoutedChatCallback;
+
+/**
+ * Dispatches provider-neutral chat requests to the best healthy backend.
+ *
+ * Every attempt goes through UGenRequestSubsystem, and its latency and outcome feed exponentially
+ * weighted averages per provider. Candidates are the policy's providers that have an API key and fit
+ * the cost ceiling; providers failing repeatedly are cooled down, and ones slower than the SLO move
+ * behind those within it. A failed or timed-out attempt fails over to the next candidate, the SLO
+ * counts from submission so time spent queued is included. With an SLO, a provider that already has
+ * requests queued is skipped while other candidates remain.
+ * Game thread only.
+ */
+class GENERATIVEAISUPPORT_API FGenProviderRouter
+{
+public:
+	/** Gets the singleton instance */
+	static FGenProviderRouter& Get();
+
+	/** Routes a chat request, the options' token cancels every attempt and its timeout bounds the whole request */
+	void SendChat(const FGenRoutedChatRequest& Request, const FGenRoutingPolicy& Policy, FGenRoutedChatCallback&& OnComplete,
+	              const FGenRequestOptions& Options = FGenRequestOptions());
+
+	/** Providers in the order SendChat would try them right now */
+	TArray<EGenAIOrgs> RankProviders(const FGenRoutedChatRequest& Request, const FGenRoutingPolicy& Policy) const;
+
+	FGenProviderHealth GetHealth(EGenAIOrgs Org) const;
+
+	/** Feeds an outcome into the provider's averages, also usable for requests made outside the router */
+	void RecordResult(EGenAIOrgs Org, double LatencySeconds, bool bSuccess);
+
+	/** Writes the health of every provider to the log */
+	void LogStats() const;
+
+private:
+	struct FRoutedRequest;
+
+	void Dispatch(const TSharedRef<FRoutedRequest>& Routed);
+	static FGenRequestHandle Submit(UGenRequestSubsystem& Subsystem, EGenAIOrgs Org, const FGenRoutedChatRequest& Request,
+	                                FGenRequestCallback&& OnDone, const FGenRequestOptions& Options);
+	static double EstimateCost(EGenAIOrgs Org, const FGenRoutedChatRequest& Request);
+
+	TMap<EGenAIOrgs, FGenProviderHealth> Health;
+
+	static FGenProviderRouter* Singleton;
+};
@@ -0,0 +1,42 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Network/GenCancellationToken.h"
+
+// Completion callback shared by every provider
+typedef TFunction<void(const FString& Response, const FString& Error, bool bSuccess)> FGenRequestCallback;
+
+// Starts the provider request, it must bind the HTTP request to the token and eventually call OnDone
+typedef TFunction<void(const FGenCancellationTokenRef& CancellationToken, FGenRequestCallback&& OnDone)> FGenRequestLauncher;
+
+/**
+ * Scheduling class of a request, higher classes leave the provider queue first
+ */
+enum class EGenRequestPriority : uint8
+{
+	// Ambient chatter, asset descriptions, anything the player does not wait for
+	Background,
+	Normal,
+	// Player-facing replies
+	Interactive,
+	// Must not wait behind anything else
+	Critical
+};
+
+/**
+ * Lightweight reference to a request owned by UGenRequestSubsystem.
+ * Slots are recycled, the serial makes stale handles harmless.
+ */
+struct GENERATIVEAISUPPORT_API FGenRequestHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Reset() { Index = INDEX_NONE; Serial = 0; }
+};
@@ -0,0 +1,171 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Audio/GenStreamingSoundWave.h"
+#include "Containers/Ticker.h"
+#include "Data/GenAIOrgs.h"
+#include "Data/Anthropic/GenClaudeChatStructs.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Data/OpenAI/GenOAISpeechStructs.h"
+#include "Data/XAI/GenXAIChatStructs.h"
+#include "Models/DeepSeek/GenDSeekChat.h"
+#include "Models/Local/GenLocalChat.h"
+#include "Models/OpenAI/GenOAIEmbeddings.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "GenRequestSubsystem.generated.h"
+
+/**
+ * Per-request options
+ */
+struct GENERATIVEAISUPPORT_API FGenRequestOptions
+{
+	// Deadline relative to submission, 0 means no deadline
+	double TimeoutSeconds = 0.0;
+
+	// When false the request waits in its slot until Start() is called
+	bool bStartImmediately = true;
+
+	// Queued requests are started by priority, promoted one class per PriorityAgingSeconds of waiting
+	EGenRequestPriority Priority = EGenRequestPriority::Normal;
+
+	// Caller-owned token, cancelling it from any thread frees the slot and reports "Request cancelled".
+	// The request runs on a child of it, so the timeout and Cancel() never touch the caller's token.
+	// A fresh token is created when this is not set
+	FGenCancellationTokenPtr CancellationToken;
+
+	// Objects the launcher reads, like the textures of chat images, kept from garbage collection while the request is active
+	TArray<TObjectPtr<UObject>> ReferencedObjects;
+};
+
+/**
+ * Owns every queued and in-flight provider request.
+ *
+ * Requests live in recycled slots and are limited per provider by MaxConcurrentRequestsPerProvider,
+ * the rest wait in the provider's queue and leave it by priority class, with aging so background work
+ * is never starved. Depending on BackgroundPreemption, interactive and critical requests may abort
+ * in-flight background requests when their provider is saturated. Requests still waiting when their
+ * deadline passes are failed without being started. Native callers get a handle and a callback and never allocate
+ * UObjects; the Blueprint async actions only hold a handle into the same slots.
+ * All functions must be called on the game thread.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenRequestSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Gets the subsystem, null before the engine is initialized */
+	static UGenRequestSubsystem* Get();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	/** Submits a provider-agnostic request */
+	FGenRequestHandle Submit(EGenAIOrgs Org, FGenRequestLauncher&& Launcher, FGenRequestCallback&& OnComplete,
+	                         const FGenRequestOptions& Options = FGenRequestOptions());
+
+	FGenRequestHandle SubmitOpenAIChat(FGenChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+	                                   const FGenRequestOptions& Options = FGenRequestOptions());
+
+	FGenRequestHandle SubmitOpenAIStructuredOutput(FGenOAIStructuredChatSettings StructuredChatSettings, FGenRequestCallback&& OnComplete,
+	                                               const FGenRequestOptions& Options = FGenRequestOptions());
+
+	FGenRequestHandle SubmitClaudeChat(FGenClaudeChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+	                                   const FGenRequestOptions& Options = FGenRequestOptions());
+
+	FGenRequestHandle SubmitDeepSeekChat(FGenDSeekChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+	                                     const FGenRequestOptions& Options = FGenRequestOptions());
+
+	FGenRequestHandle SubmitXAIChat(FGenXAIChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+	                                const FGenRequestOptions& Options = FGenRequestOptions());
+
+	/** OnDelta receives the fragments of a streamed response on the game thread, before OnComplete gets the full text */
+	FGenRequestHandle SubmitLocalChat(FGenLocalChatSettings ChatSettings, FGenRequestCallback&& OnComplete,
+	                                  const FGenRequestOptions& Options = FGenRequestOptions(), TFunction<void(const FString&)>&& OnDelta = nullptr);
+
+	/** Submits a whole embedding job as one request, its batches share the slot's token and deadline */
+	FGenRequestHandle SubmitOpenAIEmbeddings(FGenEmbeddingSettings EmbeddingSettings, FGenEmbeddingCallback&& OnComplete,
+	                                         const FGenRequestOptions& Options = FGenRequestOptions());
+
+	/** Streams the speech into Buffer as it arrives, OnAudioStarted is called on the game thread with the first chunk */
+	FGenRequestHandle SubmitOpenAISpeech(FGenOAISpeechSettings SpeechSettings, const TSharedRef<FGenPcmBuffer, ESPMode::ThreadSafe>& Buffer, FGenRequestCallback&& OnComplete,
+	                                     const FGenRequestOptions& Options = FGenRequestOptions(), TFunction<void()>&& OnAudioStarted = nullptr);
+
+	/** Queues a request that was submitted with bStartImmediately = false */
+	void Start(const FGenRequestHandle& Handle);
+
+	/** Aborts the request and frees its slot and concurrency slot immediately, the callback is not called.
+	 *  Cancelling the request's token instead does the same but reports the cancellation to the callback */
+	bool Cancel(const FGenRequestHandle& Handle);
+
+	/** True while the request is pending, queued or in flight */
+	bool IsActive(const FGenRequestHandle& Handle) const;
+
+	/** Cancellation token of an active request, for attaching extra cancel callbacks */
+	FGenCancellationTokenPtr GetCancellationToken(const FGenRequestHandle& Handle) const;
+
+	int32 GetNumQueued(EGenAIOrgs Org) const;
+	int32 GetNumInFlight(EGenAIOrgs Org) const;
+
+private:
+	enum class ESlotState : uint8
+	{
+		Free,
+		Pending,
+		Queued,
+		InFlight
+	};
+
+	struct FRequestSlot
+	{
+		uint32 Serial = 0;
+		ESlotState State = ESlotState::Free;
+		EGenAIOrgs Org = EGenAIOrgs::Unknown;
+		EGenRequestPriority Priority = EGenRequestPriority::Normal;
+		double SubmitTime = 0.0;
+		// Incremented on every launch so completions of preempted attempts are ignored
+		uint32 Attempt = 0;
+		FGenRequestLauncher Launcher;
+		FGenRequestCallback OnComplete;
+		FGenCancellationTokenPtr CancellationToken;
+		// Aborts only the current attempt, cancelled together with CancellationToken
+		FGenCancellationTokenPtr AttemptToken;
+		// Only reachable through the launcher, reported in AddReferencedObjects
+		TArray<TObjectPtr<UObject>> ReferencedObjects;
+	};
+
+	struct FProviderQueue
+	{
+		TArray<int32> Queued;
+		int32 InFlight = 0;
+	};
+
+	FRequestSlot* FindSlot(const FGenRequestHandle& Handle);
+	const FRequestSlot* FindSlot(const FGenRequestHandle& Handle) const;
+	void ReleaseSlot(int32 Index);
+	void PumpQueue(EGenAIOrgs Org);
+	int32 PopNextQueued(FProviderQueue& Queue) const;
+	void TryPreempt(EGenAIOrgs Org, EGenRequestPriority Priority);
+	void Launch(int32 Index);
+	void HandleCompleted(FGenRequestHandle Handle, uint32 Attempt, const FString& Response, const FString& Error, bool bSuccess);
+	void HandleTokenCancelled(FGenRequestHandle Handle);
+	FGenRequestCallback DetachSlot(const FGenRequestHandle& Handle);
+
+	/** Fails pending and queued requests whose deadline passed, in flight ones time out through their HTTP request */
+	bool SweepExpired(float DeltaTime);
+
+	TArray<FRequestSlot> Slots;
+	TArray<int32> FreeSlots;
+	TMap<EGenAIOrgs, FProviderQueue> Queues;
+	bool bShuttingDown = false;
+	FTSTicker::FDelegateHandle SweepHandle;
+};
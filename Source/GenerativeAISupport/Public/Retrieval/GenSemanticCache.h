@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Network/GenCancellationToken.h"
+#include "Network/GenRequestHandle.h"
+
+enum class EGenAIOrgs : uint8;
+
+/**
+ * Semantic response cache for chat requests.
+ *
+ * The final user message is embedded and compared with earlier messages sent with the same
+ * provider, model, sampling settings and prior conversation (the scope, so personas and
+ * conversations never share answers). A message within the configured similarity of a cached
+ * one is answered locally instead of upstream. Identical messages skip the embedding call
+ * entirely. Game thread only.
+ */
+class GENERATIVEAISUPPORT_API FGenSemanticCache
+{
+public:
+	/** Gets the singleton instance */
+	static FGenSemanticCache& Get();
+
+	/**
+	 * Answers from the cache or calls Send and caches its successful response.
+	 * Sampling is any text that changes the answer besides the messages, like temperature or token limits.
+	 * An embedding failure falls through to Send, cancelling the token reports a cancellation.
+	 */
+	void Fetch(EGenAIOrgs Org, const FString& Model, const FString& Sampling, const TArray<FGenChatMessage>& Messages, const FGenCancellationTokenRef& CancellationToken,
+	           TFunction<void(FGenRequestCallback&&)>&& Send, FGenRequestCallback&& OnDone);
+
+	/** Drops every cached response */
+	void Clear();
+
+	/** Writes hit and miss counters to the log */
+	void LogStats() const;
+
+private:
+	struct FEntry
+	{
+		FString Key;
+		FString Response;
+		double StoreTime = 0.0;
+		double LastUseTime = 0.0;
+	};
+
+	struct FScope
+	{
+		int32 Dimensions = 0;
+		// Unit vectors, row i belongs to Entries[i]
+		TArray<float> Vectors;
+		TArray<FEntry> Entries;
+		TMap<FString, int32> EntryByKey;
+	};
+
+	static uint64 MakeScopeId(EGenAIOrgs Org, const FString& Model, const FString& Sampling, const TArray<FGenChatMessage>& Messages);
+	static FString MakeKey(const FString& Message);
+
+	const FEntry* FindExact(uint64 ScopeId, const FString& Key);
+	const FEntry* FindSimilar(uint64 ScopeId, const TArray<float>& Vector);
+	void Store(uint64 ScopeId, const FString& Key, const TArray<float>& Vector, const FString& Response);
+	void RemoveEntry(FScope& Scope, int32 Index);
+	bool IsExpired(const FEntry& Entry) const;
+
+	TMap<uint64, FScope> Scopes;
+	int64 ExactHits = 0;
+	int64 SemanticHits = 0;
+	int64 Misses = 0;
+
+	static FGenSemanticCache* Singleton;
+};
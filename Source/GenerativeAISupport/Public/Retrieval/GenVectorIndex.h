@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIEmbeddingStructs.h"
+#include "Tasks/Task.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FGenPreparedQuery;
+struct FGenVectorIndexHeader;
+
+enum class EGenVectorMetric : uint8
+{
+	// Vectors and queries are normalized when added, scores are in [-1, 1]
+	Cosine,
+	DotProduct
+};
+
+enum class EGenVectorQuantization : uint8
+{
+	Float32,
+	// Half the memory, scores within about 1e-3 of Float32
+	Float16,
+	// A quarter of the memory, one scale per vector, good enough to rank retrieval candidates
+	Int8
+};
+
+struct GENERATIVEAISUPPORT_API FGenVectorMatch
+{
+	int64 Id = INDEX_NONE;
+	float Score = 0.0f;
+};
+
+struct GENERATIVEAISUPPORT_API FGenVectorIndexBuildOptions
+{
+	EGenVectorMetric Metric = EGenVectorMetric::Cosine;
+	EGenVectorQuantization Quantization = EGenVectorQuantization::Float32;
+
+	// Below this many vectors a flat scan beats probing inverted lists
+	int32 IvfThreshold = 20000;
+
+	// Inverted lists for large sets, 0 picks sqrt(Num)
+	int32 NumLists = 0;
+
+	// k-means passes over the training sample
+	int32 TrainingIterations = 10;
+
+	int32 Seed = 0x5EED;
+};
+
+struct GENERATIVEAISUPPORT_API FGenVectorSearchOptions
+{
+	int32 K = 8;
+
+	// Inverted lists scanned per query, 0 picks a sixteenth of the lists (at least 4). Ignored by flat indices
+	int32 NumProbes = 0;
+
+	// Matches scoring below this are dropped
+	float MinScore = -MAX_flt;
+};
+
+/**
+ * Immutable, thread safe vector index for retrieval.
+ *
+ * Small sets are scanned exhaustively, large ones are partitioned into k-means inverted lists
+ * (IVF) and only the lists closest to the query are scanned. Rows are stored contiguously per
+ * list, optionally quantized, in the same layout on disk and in memory: Load maps the file
+ * instead of reading it, so an index of any size is ready immediately and shares pages with
+ * the OS file cache. Build indices with FGenVectorIndexBuilder.
+ */
+class GENERATIVEAISUPPORT_API FGenVectorIndex : public TSharedFromThis<FGenVectorIndex, ESPMode::ThreadSafe>
+{
+public:
+	~FGenVectorIndex();
+
+	/** Memory maps an index saved with Save, falls back to reading it when mapping is unsupported */
+	static TSharedPtr<FGenVectorIndex, ESPMode::ThreadSafe> Load(const FString& Path);
+
+	bool Save(const FString& Path) const;
+
+	int32 Num() const;
+	int32 GetDimensions() const;
+	EGenVectorMetric GetMetric() const;
+	EGenVectorQuantization GetQuantization() const;
+	bool IsPartitioned() const { return NumLists > 0; }
+	int64 GetDataSize() const { return DataSize; }
+
+	/** Top matches for Query, best first. Runs on the calling thread, large scans fan out over the task graph */
+	TArray<FGenVectorMatch> Search(TArrayView<const float> Query, const FGenVectorSearchOptions& Options = FGenVectorSearchOptions()) const;
+
+	/** Same as Search on a worker thread, the index stays alive until the task completes */
+	UE::Tasks::TTask<TArray<FGenVectorMatch>> SearchAsync(TArray<float> Query, const FGenVectorSearchOptions& Options = FGenVectorSearchOptions()) const;
+
+	/** The vectorized dot product behind every scan, for callers scoring small mutable sets themselves */
+	static float DotProduct(const float* A, const float* B, int32 Dimensions);
+
+private:
+	friend class FGenVectorIndexBuilder;
+
+	FGenVectorIndex() = default;
+
+	/** Points the section views into Data, false when the header does not describe a valid index */
+	bool BindSections();
+
+	void ScanRows(int32 FirstRow, int32 LastRow, const FGenPreparedQuery& Query, float MinScore, TArray<FGenVectorMatch>& Heap, int32 K) const;
+
+	// Either owned (freshly built or read) or mapped
+	TArray64<uint8> OwnedData;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	// Views into Data
+	const FGenVectorIndexHeader* Header = nullptr;
+	const float* Centroids = nullptr;
+	const uint32* ListOffsets = nullptr;
+	const int64* Ids = nullptr;
+	const float* Scales = nullptr;
+	const uint8* Rows = nullptr;
+	int32 NumLists = 0;
+	int32 RowStride = 0;
+};
+
+/**
+ * Collects float vectors and builds an FGenVectorIndex from them
+ */
+class GENERATIVEAISUPPORT_API FGenVectorIndexBuilder
+{
+public:
+	explicit FGenVectorIndexBuilder(int32 InDimensions);
+
+	void Reserve(int32 NumVectors);
+
+	/** Adds one vector, false when its size does not match the index dimensions or the builder is full */
+	bool Add(int64 Id, TArrayView<const float> Vector);
+
+	/** Adds every vector of an embedding result with consecutive ids starting at FirstId, returns how many were added, 0 when they do not fit */
+	int32 AddEmbeddings(const FGenEmbeddingResult& Result, int64 FirstId);
+
+	int32 Num() const { return Ids.Num(); }
+
+	/** Builds the index, flat or partitioned depending on Options.IvfThreshold. Can be called from any thread */
+	TSharedPtr<FGenVectorIndex, ESPMode::ThreadSafe> Build(const FGenVectorIndexBuildOptions& Options = FGenVectorIndexBuildOptions()) const;
+
+private:
+	int32 Dimensions;
+	TArray<float> Vectors;
+	TArray<int64> Ids;
+};
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Network/GenRequestSubsystem.h"
+#include "Tasks/Task.h"
+#include <atomic>
+#include <type_traits>
+
+/**
+ * Result of any provider request
+ */
+struct GENERATIVEAISUPPORT_API FGenChatResult
+{
+	FString Response;
+	FString Error;
+	bool bSuccess = false;
+};
+
+/**
+ * Result of FGenAITasks::WhenAny, Index is the position of the first finished task
+ */
+struct GENERATIVEAISUPPORT_API FGenChatAnyResult
+{
+	int32 Index = INDEX_NONE;
+	FGenChatResult Result;
+};
+
+/**
+ * UE::Tasks based native API for chaining provider requests.
+ *
+ * Every function returns immediately with a task that completes when the provider answers, so
+ * independent prompts can be fanned out, joined with WhenAll/WhenAny and continued on any named
+ * thread without blocking the game thread. Requests go through UGenRequestSubsystem and may be
+ * started from any thread; pass a token in the options to cancel a whole pipeline at once.
+ */
+class GENERATIVEAISUPPORT_API FGenAITasks
+{
+public:
+	typedef UE::Tasks::TTask<FGenChatResult> FChatTask;
+
+	static FChatTask OpenAIChat(const FGenChatSettings& ChatSettings, const FGenRequestOptions& Options = FGenRequestOptions());
+	static FChatTask OpenAIStructuredOutput(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FGenRequestOptions& Options = FGenRequestOptions());
+	static FChatTask ClaudeChat(const FGenClaudeChatSettings& ChatSettings, const FGenRequestOptions& Options = FGenRequestOptions());
+	static FChatTask DeepSeekChat(const FGenDSeekChatSettings& ChatSettings, const FGenRequestOptions& Options = FGenRequestOptions());
+	static FChatTask XAIChat(const FGenXAIChatSettings& ChatSettings, const FGenRequestOptions& Options = FGenRequestOptions());
+
+	/** Wraps any UGenRequestSubsystem submission in a task, Submit receives the completion callback */
+	static FChatTask FromSubmission(TFunction<void(UGenRequestSubsystem& Subsystem, FGenRequestCallback&& OnComplete)>&& Submit);
+
+	/** Completes when every task has completed, results keep the input order */
+	static UE::Tasks::TTask<TArray<FGenChatResult>> WhenAll(const TArray<FChatTask>& Tasks);
+
+	/** Completes as soon as the first task completes, the others keep running */
+	static UE::Tasks::TTask<FGenChatAnyResult> WhenAny(const TArray<FChatTask>& Tasks);
+
+	/**
+	 * Runs Continuation on the given named thread once Task has completed.
+	 * Returns a task holding the continuation's return value, or a plain task for void continuations.
+	 */
+	template <typename InResultType, typename ContinuationType>
+	static auto Then(const UE::Tasks::TTask<InResultType>& Task, ENamedThreads::Type Thread, ContinuationType&& Continuation)
+	{
+		using FOutResultType = std::invoke_result_t<ContinuationType, const InResultType&>;
+
+		UE::Tasks::FTaskEvent Done(UE_SOURCE_LOCATION);
+		if constexpr (std::is_void_v<FOutResultType>)
+		{
+			UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[Task, Thread, Continuation = Forward<ContinuationType>(Continuation), Done]() mutable
+				{
+					AsyncTask(Thread, [Task, Continuation = MoveTemp(Continuation), Done]() mutable
+					{
+						Continuation(Task.GetResult());
+						Done.Trigger();
+					});
+				},
+				UE::Tasks::Prerequisites(Task));
+			return UE::Tasks::Launch(UE_SOURCE_LOCATION, []() {}, UE::Tasks::Prerequisites(Done));
+		}
+		else
+		{
+			TSharedRef<TOptional<FOutResultType>, ESPMode::ThreadSafe> Output = MakeShared<TOptional<FOutResultType>, ESPMode::ThreadSafe>();
+			UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[Task, Thread, Continuation = Forward<ContinuationType>(Continuation), Done, Output]() mutable
+				{
+					AsyncTask(Thread, [Task, Continuation = MoveTemp(Continuation), Done, Output]() mutable
+					{
+						Output->Emplace(Continuation(Task.GetResult()));
+						Done.Trigger();
+					});
+				},
+				UE::Tasks::Prerequisites(Task));
+			return UE::Tasks::Launch(UE_SOURCE_LOCATION, [Output]() { return MoveTemp(Output->GetValue()); }, UE::Tasks::Prerequisites(Done));
+		}
+	}
+};
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Tasks/Task.h"
+#include <atomic>
+#include "GenTokenizer.generated.h"
+
+/**
+ * Token encodings the local tokenizer can load
+ */
+UENUM(BlueprintType)
+enum class EGenTokenizerEncoding : uint8
+{
+	// GPT-3.5, GPT-4, GPT-4 Turbo, DeepSeek and Grok estimates
+	CL100K      UMETA(DisplayName = "cl100k_base"),
+	// GPT-4o, GPT-4.1, GPT-5 and o-series
+	O200K       UMETA(DisplayName = "o200k_base"),
+	// Claude family, the vocabulary is not public so counts are estimates unless claude.tiktoken is provided
+	Claude      UMETA(DisplayName = "claude")
+};
+
+/**
+ * In-process byte pair encoding tokenizer.
+ *
+ * Vocabularies are read from Resources/Tokenizers/<encoding>.tiktoken in the plugin folder, the same
+ * "base64 rank" format tiktoken uses, on a worker the first time an encoding is used. Until the load
+ * finished, or when a vocabulary is missing, counts fall back to a pre-token based estimate so
+ * budgeting still works, just less precisely.
+ * Encoders are immutable after loading and safe to use from any thread.
+ */
+class GENERATIVEAISUPPORT_API FGenBPETokenizer
+{
+public:
+	/** Gets the shared tokenizer for an encoding, its vocabulary starts loading in the background on first use */
+	static TSharedRef<FGenBPETokenizer, ESPMode::ThreadSafe> Get(EGenTokenizerEncoding Encoding);
+
+	/** Encoding best matching an OpenAI model name */
+	static EGenTokenizerEncoding GetEncodingForModel(const FString& Model);
+
+	/** True once a vocabulary file was loaded, false while it loads or when counts are estimates */
+	bool HasVocabulary() const { return bVocabularyLoaded.load(std::memory_order_acquire); }
+
+	/** Blocks until the vocabulary load finished, whether or not a file was found */
+	void WaitForVocabulary() const;
+
+	/** Encodes text into token ranks, waits for the vocabulary and is empty when there is none */
+	TArray<int32> Encode(const FString& Text) const;
+
+	/** Number of tokens in Text, cached per pre-token */
+	int32 CountTokens(const FString& Text) const;
+
+	/** Prompt tokens for a chat, including the per-message framing added by chat endpoints */
+	int32 CountChatTokens(const TArray<FGenChatMessage>& Messages) const;
+
+	/** Splits UTF-8 text into pre-tokens, the units BPE merges never cross. Exposed for tooling */
+	static void PreTokenize(const uint8* Data, int32 Length, TArray<TPair<int32, int32>>& OutPieces);
+
+private:
+	FGenBPETokenizer() = default;
+
+	/** Runs on a worker, publishes Ranks through bVocabularyLoaded */
+	void LoadVocabulary(const FString& VocabularyPath);
+
+	void EncodePiece(const uint8* Piece, int32 Length, TArray<int32>& OutTokens) const;
+	int32 CountPiece(const uint8* Piece, int32 Length) const;
+	int32 GetRank(const uint8* Bytes, int32 Length) const;
+
+	/** Merge table keyed by the hash of the token bytes, only read once bVocabularyLoaded is set */
+	TMap<uint64, int32> Ranks;
+	std::atomic<bool> bVocabularyLoaded = false;
+	UE::Tasks::FTask LoadTask;
+
+	/** Per pre-token count cache, game dialogue repeats the same words constantly */
+	mutable TMap<uint64, int32> PieceCountCache;
+	mutable FRWLock PieceCountCacheLock;
+};
+
+/**
+ * Keeps chat histories inside a prompt budget before they are sent
+ */
+class GENERATIVEAISUPPORT_API FGenContextTrimmer
+{
+public:
+	/**
+	 * Drops the oldest non-system messages until the prompt fits MaxPromptTokens.
+	 * System messages and the last KeepRecentMessages messages are always kept.
+	 * @return Number of messages removed
+	 */
+	static int32 TrimToBudget(TArray<FGenChatMessage>& Messages, int32 MaxPromptTokens, EGenTokenizerEncoding Encoding,
+	                          int32 KeepRecentMessages = 1);
+};
+
+/**
+ * Blueprint access to the local tokenizer
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenTokenizerLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintPure, Category = "GenAI|Tokenizer")
+	static int32 CountTokens(const FString& Text, EGenTokenizerEncoding Encoding = EGenTokenizerEncoding::O200K);
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Tokenizer")
+	static int32 CountChatTokens(const TArray<FGenChatMessage>& Messages, EGenTokenizerEncoding Encoding = EGenTokenizerEncoding::O200K);
+
+	// Returns the number of messages removed
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Tokenizer")
+	static int32 TrimMessagesToBudget(UPARAM(ref) TArray<FGenChatMessage>& Messages, int32 MaxPromptTokens,
+	                                  EGenTokenizerEncoding Encoding = EGenTokenizerEncoding::O200K, int32 KeepRecentMessages = 1);
+};
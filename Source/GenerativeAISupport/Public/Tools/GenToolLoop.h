@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/GenAIOrgs.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Network/GenRequestSubsystem.h"
+#include "Tools/GenToolbox.h"
+#include "GenToolLoop.generated.h"
+
+/**
+ * Chat request whose model may call tools before it answers
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenToolChatSettings
+{
+	GENERATED_BODY()
+
+	// OpenAI, Anthropic, DeepSeek, XAI or Local
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	EGenAIOrgs Org = EGenAIOrgs::OpenAI;
+
+	// Model name as the provider expects it, empty uses the provider's default chat model
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	FString Model;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	TArray<FGenChatMessage> Messages;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	int32 MaxTokens = 1024;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	float Temperature = 0.7f;
+
+	// Model turns that may request tools, the request fails if the model still wants tools after these
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools", meta = (ClampMin = "1"))
+	int32 MaxToolRounds = 8;
+
+	// Let the model request several independent tools in one turn, they are executed concurrently
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	bool bParallelToolCalls = true;
+};
+
+// Called on the game thread after each tool ran, before its result is sent back
+typedef TFunction<void(const FGenToolCall& Call, const FString& Result)> FGenToolCalledCallback;
+
+/**
+ * Runs a chat in which the model may call tools.
+ *
+ * Each round sends the conversation through UGenRequestSubsystem. When the model answers with
+ * tool calls, all of them are executed concurrently by the toolbox, the results are appended to
+ * the conversation and the next round is sent without involving the caller. The callback gets the
+ * model's final text. OpenAI, DeepSeek, XAI and Local share the OpenAI protocol, Anthropic uses
+ * its tool_use blocks. Game thread only.
+ */
+class GENERATIVEAISUPPORT_API FGenToolLoop
+{
+public:
+	/** The options' token cancels the current round and every later one, its timeout bounds the whole chat */
+	static void Run(const FGenToolChatSettings& ChatSettings, const TSharedRef<FGenToolbox, ESPMode::ThreadSafe>& Toolbox,
+	                FGenRequestCallback&& OnComplete, const FGenRequestOptions& Options = FGenRequestOptions(),
+	                FGenToolCalledCallback&& OnToolCalled = nullptr);
+
+private:
+	struct FConversation;
+
+	static void SendRound(const TSharedRef<FConversation>& Conversation);
+	static void HandleRound(const TSharedRef<FConversation>& Conversation, const FString& Response, const FString& Error, bool bSuccess);
+};
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "GenToolbox.generated.h"
+
+/**
+ * A UFUNCTION exposed to the model as a tool
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenFunctionTool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	TObjectPtr<UObject> Target = nullptr;
+
+	// Its parameters become the tool's arguments, its return value and out parameters the result
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	FName FunctionName;
+
+	// Tells the model when to call the tool, defaults to the function's tooltip in editor builds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Tools")
+	FString Description;
+};
+
+/**
+ * One tool call requested by the model
+ */
+struct GENERATIVEAISUPPORT_API FGenToolCall
+{
+	/** Provider id of the call, sent back with its result */
+	FString Id;
+
+	FString Name;
+
+	/** JSON object with the arguments */
+	FString Arguments;
+};
+
+// Runs a tool, returns the text handed back to the model, usually JSON
+typedef TFunction<FString(const TSharedRef<FJsonObject>& Arguments)> FGenToolFunction;
+
+/**
+ * A tool the model may call
+ */
+struct GENERATIVEAISUPPORT_API FGenTool
+{
+	FString Name;
+	FString Description;
+
+	/** JSON schema of the arguments object */
+	TSharedRef<FJsonObject> Parameters = MakeShared<FJsonObject>();
+
+	FGenToolFunction Function;
+
+	/** Tools touching UObjects must run on the game thread, the others run concurrently on worker threads */
+	bool bRunOnGameThread = false;
+};
+
+/**
+ * Tools offered to the model in a tool chat, see FGenToolLoop.
+ *
+ * Calls from one model turn are independent of each other, so ExecuteCalls runs them all at once:
+ * thread safe tools as tasks on worker threads, game thread tools inline while those run.
+ */
+class GENERATIVEAISUPPORT_API FGenToolbox : public TSharedFromThis<FGenToolbox, ESPMode::ThreadSafe>
+{
+public:
+	/** Adds a native tool, the function runs on a worker thread unless bRunOnGameThread is set */
+	void AddTool(const FString& Name, const FString& Description, const TSharedRef<FJsonObject>& ParametersSchema,
+	             FGenToolFunction&& Function, bool bRunOnGameThread = false);
+
+	/** Adds a UFUNCTION, its argument schema is generated from the parameters. Returns false if there is no such function */
+	bool AddFunction(UObject* Target, FName FunctionName, const FString& Description = FString());
+
+	bool AddFunction(const FGenFunctionTool& FunctionTool) { return AddFunction(FunctionTool.Target, FunctionTool.FunctionName, FunctionTool.Description); }
+
+	const TArray<FGenTool>& GetTools() const { return Tools; }
+
+	const FGenTool* FindTool(const FString& Name) const;
+
+	/**
+	 * Runs every call concurrently. OnDone receives the results in call order on the game thread,
+	 * failures are reported to the model as {"error": ...} results. Game thread only
+	 */
+	void ExecuteCalls(const TArray<FGenToolCall>& Calls, TFunction<void(TArray<FString>&&)>&& OnDone) const;
+
+	/** JSON schema for a property, used to describe UFUNCTION parameters */
+	static TSharedRef<FJsonObject> MakePropertySchema(const FProperty* Property);
+
+private:
+	FString RunCall(const FGenToolCall& Call) const;
+
+	TArray<FGenTool> Tools;
+};
@@ -0,0 +1,41 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/GenAIOrgs.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Network/GenCancellationToken.h"
+
+/**
+ * Puts chat images into request bodies without stalling the game thread.
+ *
+ * Payloads are built with a placeholder in place of each image's base64 data. When the request is
+ * sent, GPU resources are read back on the render thread and editor source art is decompressed on
+ * a worker, then a worker downscales each image to
+ * the provider's limit, encodes it and writes its base64 straight into the UTF-8 body in place of
+ * the placeholder. The full resolution pixels never pass through an FString.
+ */
+class GENERATIVEAISUPPORT_API FGenImageEncoder
+{
+public:
+	/** Unguessable text written into the payload for the image at Index, in the order images are handed to ProcessRequest */
+	static FString GetPlaceholder(int32 Index);
+
+	static FString GetMimeType(EGenImageEncoding Encoding);
+
+	/** Size the provider uses the image at without downscaling it again, images are never upscaled */
+	static FIntPoint GetTargetSize(FIntPoint Size, EGenAIOrgs Org, EGenImageDetail Detail);
+
+	/**
+	 * Replaces the placeholders in the request's content with the encoded images, then binds the
+	 * token and processes the request. OnFailed is called instead if an image cannot be read or the
+	 * token stopped while encoding. Game thread only
+	 */
+	static void ProcessRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest, TArray<FGenChatImage>&& Images, EGenAIOrgs Org,
+	                           const FGenCancellationTokenPtr& CancellationToken, TFunction<void(const FString& Error)>&& OnFailed);
+};
@@ -37,6 +37,7 @@ public class GenerativeAISupportEditor : ModuleRules
 				"MaterialEditor",
 				"MaterialUtilities",
 				"BlueprintGraph",
+				"Kismet",                // For FBlueprintCompilationManager
 				"UMGEditor",
 				"UMG",
 				"Settings",
@@ -693,6 +693,7 @@ void SGenEditorWindow::RefreshStatus()
     OrgDisplayNames.Add(EGenAIOrgs::Meta, "Meta");
     OrgDisplayNames.Add(EGenAIOrgs::DeepSeek, "DeepSeek");
     OrgDisplayNames.Add(EGenAIOrgs::XAI, "XAI");
+    OrgDisplayNames.Add(EGenAIOrgs::Local, "Local/Custom");
 
     // Add API key status rows using the GenSecureKey system
     for (const auto& OrgPair : OrgDisplayNames)
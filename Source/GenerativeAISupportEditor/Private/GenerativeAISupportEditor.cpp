@@ -14,6 +14,12 @@
 #include "WorkspaceMenuStructureModule.h"
 #include "Editor/GenEditorCommands.h"
 #include "Editor/GenEditorWindow.h"
+#include "MCP/GenActorIndex.h"
+#include "MCP/GenBlueprintCache.h"
+#include "MCP/GenCompileScheduler.h"
+#include "MCP/GenFunctionIndex.h"
+#include "MCP/GenSceneJournal.h"
+#include "MCP/GenSpatialIndex.h"
 
 #define LOCTEXT_NAMESPACE "FGenerativeAISupportEditorModule"
 
@@ -37,6 +43,14 @@ void FGenerativeAISupportEditorModule::StartupModule()
     // Register menu extension
     RegisterMenuExtension();
 
+    // Index the callable functions for node resolution once the engine is up
+    FGenFunctionIndex::Get().Initialize();
+    FGenCompileScheduler::Get().Initialize();
+    FGenBlueprintCache::Get().Initialize();
+    FGenActorIndex::Get().Initialize();
+    FGenSceneJournal::Get().Initialize();
+    FGenSpatialIndex::Get().Initialize();
+
     // Register tab spawner
     FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
                             GenEditorTabId,
@@ -56,6 +70,13 @@ void FGenerativeAISupportEditorModule::ShutdownModule()
     // Unregister menu extension
     UnregisterMenuExtension();
 
+    FGenFunctionIndex::Get().Shutdown();
+    FGenCompileScheduler::Get().Shutdown();
+    FGenBlueprintCache::Get().Shutdown();
+    FGenActorIndex::Get().Shutdown();
+    FGenSceneJournal::Get().Shutdown();
+    FGenSpatialIndex::Get().Shutdown();
+
     // Unregister tab spawner
     if (FSlateApplication::IsInitialized())
     {
@@ -7,6 +7,7 @@
 
 UGenerativeAISupportSettings::UGenerativeAISupportSettings()
     : bAutoStartSocketServer(false) // Default to false for safety
+    , CompileIdleDelaySeconds(1.0f)
 {
     // Default constructor
 }
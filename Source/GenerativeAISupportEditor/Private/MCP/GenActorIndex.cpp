@@ -0,0 +1,310 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "MCP/GenActorIndex.h"
+
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+
+FGenActorIndex* FGenActorIndex::Singleton = nullptr;
+
+FGenActorIndex& FGenActorIndex::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenActorIndex();
+	}
+	return *Singleton;
+}
+
+void FGenActorIndex::Initialize()
+{
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FGenActorIndex::OnLevelActorAdded);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FGenActorIndex::OnLevelActorDeleted);
+		ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddRaw(this, &FGenActorIndex::MarkDirty);
+	}
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FGenActorIndex::OnActorLabelChanged);
+
+	// Map loads and undo bring back or drop actors without reporting each of them
+	MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32)
+	{
+		MarkDirty();
+	});
+	PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FGenActorIndex::MarkDirty);
+}
+
+void FGenActorIndex::Shutdown()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+	FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+	ActorAddedHandle.Reset();
+	ActorDeletedHandle.Reset();
+	ActorListChangedHandle.Reset();
+	ActorLabelChangedHandle.Reset();
+	MapChangeHandle.Reset();
+	PostUndoRedoHandle.Reset();
+	Reset();
+}
+
+AActor* FGenActorIndex::FindActorByLabel(const FString& Label)
+{
+	if (!Update())
+	{
+		return nullptr;
+	}
+
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<4>> Candidates;
+	ActorsByLabel.MultiFind(Label, Candidates);
+	for (const TWeakObjectPtr<AActor>& Candidate : Candidates)
+	{
+		AActor* Actor = Candidate.Get();
+		if (IsValid(Actor) && Actor->GetActorLabel() == Label)
+		{
+			return Actor;
+		}
+	}
+	return nullptr;
+}
+
+AActor* FGenActorIndex::FindActorByName(FName Name)
+{
+	if (!Update())
+	{
+		return nullptr;
+	}
+
+	const TWeakObjectPtr<AActor>* Found = ActorsByName.Find(Name);
+	AActor* Actor = Found ? Found->Get() : nullptr;
+	return IsValid(Actor) && Actor->GetFName() == Name ? Actor : nullptr;
+}
+
+AActor* FGenActorIndex::FindActorByGuid(const FGuid& Guid)
+{
+	if (!Update())
+	{
+		return nullptr;
+	}
+
+	const TWeakObjectPtr<AActor>* Found = ActorsByGuid.Find(Guid);
+	AActor* Actor = Found ? Found->Get() : nullptr;
+	return IsValid(Actor) ? Actor : nullptr;
+}
+
+UActorComponent* FGenActorIndex::FindComponent(AActor* Actor, FName ComponentName)
+{
+	if (!IsValid(Actor) || !Update())
+	{
+		return nullptr;
+	}
+
+	FActorEntry* Entry = Entries.Find(Actor);
+	if (!Entry)
+	{
+		AddActor(Actor);
+		Entry = Entries.Find(Actor);
+	}
+
+	if (Entry->bComponentsIndexed)
+	{
+		if (const TWeakObjectPtr<UActorComponent>* Cached = Entry->Components.Find(ComponentName))
+		{
+			UActorComponent* Component = Cached->Get();
+			if (IsValid(Component) && Component->GetOwner() == Actor && Component->GetFName() == ComponentName)
+			{
+				return Component;
+			}
+		}
+	}
+
+	// First lookup on this actor or a stale map, the components may have been recreated since
+	IndexComponents(Actor, *Entry);
+	const TWeakObjectPtr<UActorComponent>* Found = Entry->Components.Find(ComponentName);
+	return Found ? Found->Get() : nullptr;
+}
+
+void FGenActorIndex::ForEachActor(TFunctionRef<void(AActor*)> Visitor)
+{
+	if (!Update())
+	{
+		return;
+	}
+
+	for (const TPair<TWeakObjectPtr<AActor>, FActorEntry>& Pair : Entries)
+	{
+		if (AActor* Actor = Pair.Key.Get(); IsValid(Actor))
+		{
+			Visitor(Actor);
+		}
+	}
+}
+
+TArray<FString> FGenActorIndex::GetActorLabels()
+{
+	TArray<FString> Labels;
+	if (Update())
+	{
+		Labels.Reserve(Entries.Num());
+		for (const TPair<TWeakObjectPtr<AActor>, FActorEntry>& Pair : Entries)
+		{
+			if (Pair.Key.IsValid())
+			{
+				Labels.Add(Pair.Value.Label);
+			}
+		}
+	}
+	return Labels;
+}
+
+TArray<FString> FGenActorIndex::GetComponentNames(AActor* Actor)
+{
+	TArray<FString> Names;
+	if (IsValid(Actor))
+	{
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			if (Component)
+			{
+				Names.Add(Component->GetName());
+			}
+		}
+	}
+	return Names;
+}
+
+void FGenActorIndex::Reset()
+{
+	Entries.Reset();
+	ActorsByLabel.Reset();
+	ActorsByName.Reset();
+	ActorsByGuid.Reset();
+	IndexedWorld.Reset();
+	bDirty = true;
+}
+
+UWorld* FGenActorIndex::Update()
+{
+	check(IsInGameThread());
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return nullptr;
+	}
+	if (!bDirty && IndexedWorld.Get() == World)
+	{
+		return World;
+	}
+
+	Reset();
+	IndexedWorld = World;
+	bDirty = false;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AddActor(*It);
+	}
+	UE_LOG(LogTemp, Log, TEXT("Indexed %d actors of %s"), Entries.Num(), *World->GetName());
+	return World;
+}
+
+void FGenActorIndex::AddActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+	if (Entries.Contains(Actor))
+	{
+		RemoveActor(Actor);
+	}
+
+	FActorEntry& Entry = Entries.Add(Actor);
+	Entry.Label = Actor->GetActorLabel();
+	Entry.Name = Actor->GetFName();
+	Entry.Guid = Actor->GetActorGuid();
+
+	ActorsByLabel.Add(Entry.Label, Actor);
+	ActorsByName.Add(Entry.Name, Actor);
+	if (Entry.Guid.IsValid())
+	{
+		ActorsByGuid.Add(Entry.Guid, Actor);
+	}
+}
+
+void FGenActorIndex::RemoveActor(AActor* Actor)
+{
+	FActorEntry Entry;
+	if (!Entries.RemoveAndCopyValue(Actor, Entry))
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<AActor> WeakActor(Actor);
+	ActorsByLabel.RemoveSingle(Entry.Label, WeakActor);
+
+	// Actors of different levels can share a name, only drop the mapping if it is still this actor's
+	if (const TWeakObjectPtr<AActor>* Named = ActorsByName.Find(Entry.Name); Named && *Named == WeakActor)
+	{
+		ActorsByName.Remove(Entry.Name);
+	}
+	if (const TWeakObjectPtr<AActor>* Guided = ActorsByGuid.Find(Entry.Guid); Guided && *Guided == WeakActor)
+	{
+		ActorsByGuid.Remove(Entry.Guid);
+	}
+}
+
+void FGenActorIndex::IndexComponents(AActor* Actor, FActorEntry& Entry)
+{
+	Entry.Components.Reset();
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component)
+		{
+			Entry.Components.Add(Component->GetFName(), Component);
+		}
+	}
+	Entry.bComponentsIndexed = true;
+}
+
+void FGenActorIndex::OnLevelActorAdded(AActor* Actor)
+{
+	// Play in editor and preview worlds report their actors here too
+	if (!bDirty && Actor && Actor->GetWorld() == IndexedWorld.Get())
+	{
+		AddActor(Actor);
+	}
+}
+
+void FGenActorIndex::OnLevelActorDeleted(AActor* Actor)
+{
+	if (!bDirty && Actor)
+	{
+		RemoveActor(Actor);
+	}
+}
+
+void FGenActorIndex::OnActorLabelChanged(AActor* Actor)
+{
+	if (!bDirty && Actor && Entries.Contains(Actor))
+	{
+		AddActor(Actor);
+	}
+}
+
+void FGenActorIndex::MarkDirty()
+{
+	bDirty = true;
+}
@@ -4,6 +4,10 @@
 
 
 #include "MCP/GenActorUtils.h"
+#include "MCP/GenActorIndex.h"
+#include "MCP/GenBlueprintCache.h"
+#include "MCP/GenCompileScheduler.h"
+#include "MCP/GenSpatialIndex.h"
 
 #include "Engine/StaticMeshActor.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -23,6 +27,42 @@
 #include "GameFramework/GameModeBase.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "UObject/SavePackage.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace GenActorUtils
+{
+    // Compact result of the spatial queries, the id is the actor GUID FindActorByName also accepts
+    FString SerializeHits(const TArray<FGenSpatialHit>& Hits)
+    {
+        TArray<TSharedPtr<FJsonValue>> ActorsArray;
+        ActorsArray.Reserve(Hits.Num());
+        for (const FGenSpatialHit& Hit : Hits)
+        {
+            const FVector Location = Hit.Actor->GetActorLocation();
+            TSharedRef<FJsonObject> ActorObject = MakeShared<FJsonObject>();
+            ActorObject->SetStringField(TEXT("id"), Hit.Actor->GetActorGuid().ToString());
+            ActorObject->SetStringField(TEXT("label"), Hit.Actor->GetActorLabel());
+            ActorObject->SetStringField(TEXT("class"), Hit.Actor->GetClass()->GetName());
+            TArray<TSharedPtr<FJsonValue>> LocationArray;
+            LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
+            LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
+            LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
+            ActorObject->SetArrayField(TEXT("location"), LocationArray);
+            ActorObject->SetNumberField(TEXT("distance"), Hit.Distance);
+            ActorsArray.Add(MakeShared<FJsonValueObject>(ActorObject));
+        }
+
+        TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+        Result->SetBoolField(TEXT("success"), true);
+        Result->SetArrayField(TEXT("actors"), ActorsArray);
+
+        FString Json;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+        FJsonSerializer::Serialize(Result, Writer);
+        return Json;
+    }
+}
 
 AActor* UGenActorUtils::SpawnBasicShape(const FString& ShapeName, const FVector& Location, 
                                         const FRotator& Rotation, const FVector& Scale, 
@@ -57,8 +97,12 @@ AActor* UGenActorUtils::SpawnBasicShape(const FString& ShapeName, const FVector&
 
     Actor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
     
-    // Set scale
+    // Set scale, then report the new bounds the way an editor move does
     Actor->SetActorScale3D(Scale);
+    if (GEditor)
+    {
+        GEditor->BroadcastOnActorMoved(Actor);
+    }
     
     // Set custom label if provided
     if (!ActorLabel.IsEmpty())
@@ -103,6 +147,10 @@ AActor* UGenActorUtils::SpawnStaticMeshActor(const FString& MeshPath, const FVec
     {
         MeshComponent->SetStaticMesh(Mesh);
         Actor->SetActorScale3D(Scale);
+        if (GEditor)
+        {
+            GEditor->BroadcastOnActorMoved(Actor);
+        }
     }
     else
     {
@@ -130,6 +178,14 @@ AActor* UGenActorUtils::SpawnActorFromClass(const FString& ActorClassName, const
     // Check if it's a path to a Blueprint class
     if (ActorClassName.StartsWith("/"))
     {
+        // A Blueprint edited through MCP may still wait for its deferred compile, spawn the current version
+        FString BlueprintPath = ActorClassName;
+        BlueprintPath.RemoveFromEnd(TEXT("_C"));
+        if (UBlueprint* Blueprint = FindObject<UBlueprint>(nullptr, *BlueprintPath); Blueprint && FGenCompileScheduler::Get().IsPending(Blueprint))
+        {
+            FGenCompileScheduler::Get().Flush(Blueprint);
+        }
+
         FSoftClassPath ClassPath(ActorClassName);
         ActorClass = ClassPath.TryLoadClass<AActor>();
     }
@@ -171,6 +227,10 @@ AActor* UGenActorUtils::SpawnActorFromClass(const FString& ActorClassName, const
     
     // Set scale
     Actor->SetActorScale3D(Scale);
+    if (GEditor)
+    {
+        GEditor->BroadcastOnActorMoved(Actor);
+    }
     
     // Set custom label if provided
     if (!ActorLabel.IsEmpty())
@@ -192,17 +252,27 @@ AActor* UGenActorUtils::FindActorByName(const FString& ActorName)
         return nullptr;
     }
 
-    // Try to find the actor in the current level
-    for (TActorIterator<AActor> It(World); It; ++It)
+    // Labels are what the user sees in the outliner, look those up first
+    if (AActor* Actor = FGenActorIndex::Get().FindActorByLabel(ActorName))
+    {
+        return Actor;
+    }
+
+    // Then the object name GetAllSceneObjects reports and the actor GUID
+    if (AActor* Actor = FGenActorIndex::Get().FindActorByName(FName(*ActorName)))
     {
-        AActor* Actor = *It;
-        if (Actor && Actor->GetActorLabel() == ActorName)
+        return Actor;
+    }
+    FGuid ActorGuid;
+    if (FGuid::Parse(ActorName, ActorGuid))
+    {
+        if (AActor* Actor = FGenActorIndex::Get().FindActorByGuid(ActorGuid))
         {
             return Actor;
         }
     }
 
-    // If not found by label, try using the full path format
+    // If not found in the index, try using the full path format
     AActor* FoundActor = FindObject<AActor>(World, *ActorName);
     if (FoundActor)
     {
@@ -213,6 +283,28 @@ AActor* UGenActorUtils::FindActorByName(const FString& ActorName)
     return nullptr;
 }
 
+FString UGenActorUtils::FindActorsInRadius(const FVector& Center, float Radius, int32 MaxResults)
+{
+    return GenActorUtils::SerializeHits(FGenSpatialIndex::Get().FindInRadius(Center, Radius, MaxResults));
+}
+
+FString UGenActorUtils::FindActorsInBox(const FVector& Min, const FVector& Max, int32 MaxResults)
+{
+    const FBox Box(Min.ComponentMin(Max), Min.ComponentMax(Max));
+    return GenActorUtils::SerializeHits(FGenSpatialIndex::Get().FindInBox(Box, MaxResults));
+}
+
+FString UGenActorUtils::FindActorsAlongRay(const FVector& Start, const FVector& Direction, float MaxDistance,
+                                           int32 MaxResults)
+{
+    return GenActorUtils::SerializeHits(FGenSpatialIndex::Get().FindAlongRay(Start, Direction, MaxDistance, MaxResults));
+}
+
+FString UGenActorUtils::FindNearestActors(const FVector& Location, int32 Count)
+{
+    return GenActorUtils::SerializeHits(FGenSpatialIndex::Get().FindNearest(Location, Count));
+}
+
 UMaterial* UGenActorUtils::CreateMaterial(const FString& MaterialName, const FLinearColor& Color)
 {
     // Create unique asset name to avoid conflicts
@@ -370,6 +462,10 @@ bool UGenActorUtils::SetActorPosition(const FString& ActorName, const FVector& P
     }
     
     Actor->SetActorLocation(Position);
+    if (GEditor)
+    {
+        GEditor->BroadcastOnActorMoved(Actor);
+    }
     UE_LOG(LogTemp, Log, TEXT("Set position of actor '%s' to (%f, %f, %f)"), 
            *ActorName, Position.X, Position.Y, Position.Z);
     return true;
@@ -385,6 +481,10 @@ bool UGenActorUtils::SetActorRotation(const FString& ActorName, const FRotator&
     }
     
     Actor->SetActorRotation(Rotation);
+    if (GEditor)
+    {
+        GEditor->BroadcastOnActorMoved(Actor);
+    }
     UE_LOG(LogTemp, Log, TEXT("Set rotation of actor '%s' to (%f, %f, %f)"), 
            *ActorName, Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
     return true;
@@ -400,6 +500,10 @@ bool UGenActorUtils::SetActorScale(const FString& ActorName, const FVector& Scal
     }
     
     Actor->SetActorScale3D(Scale);
+    if (GEditor)
+    {
+        GEditor->BroadcastOnActorMoved(Actor);
+    }
     UE_LOG(LogTemp, Log, TEXT("Set scale of actor '%s' to (%f, %f, %f)"), 
            *ActorName, Scale.X, Scale.Y, Scale.Z);
     return true;
@@ -431,7 +535,8 @@ FString UGenActorUtils::CreateGameModeWithPawn(const FString& GameModePath, cons
     }
 
     // Load the pawn Blueprint
-    UBlueprint* PawnBP = LoadObject<UBlueprint>(nullptr, *PawnBlueprintPath);
+    UBlueprint* PawnBP = FGenBlueprintCache::Get().FindBlueprint(PawnBlueprintPath);
+    FGenCompileScheduler::Get().Flush(PawnBP);
     if (!PawnBP || !PawnBP->GeneratedClass || !PawnBP->GeneratedClass->IsChildOf(APawn::StaticClass()))
     {
         UE_LOG(LogTemp, Error, TEXT("Invalid pawn blueprint: %s"), *PawnBlueprintPath);
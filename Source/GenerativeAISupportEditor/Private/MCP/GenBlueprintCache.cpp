@@ -0,0 +1,150 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "MCP/GenBlueprintCache.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "UObject/UObjectGlobals.h"
+
+FGenBlueprintCache* FGenBlueprintCache::Singleton = nullptr;
+
+FGenBlueprintCache& FGenBlueprintCache::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenBlueprintCache();
+	}
+	return *Singleton;
+}
+
+void FGenBlueprintCache::Initialize()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FGenBlueprintCache::OnAssetRenamed);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FGenBlueprintCache::OnAssetRemoved);
+
+	// Reloaded packages replace their objects, the old ones may still be alive until the next GC
+	PackageReloadedHandle = FCoreUObjectDelegates::OnPackageReloaded.AddLambda(
+		[this](EPackageReloadPhase Phase, FPackageReloadedEvent*)
+		{
+			if (Phase == EPackageReloadPhase::PostPackageFixup)
+			{
+				Reset();
+			}
+		});
+}
+
+void FGenBlueprintCache::Shutdown()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistryModule->Get().OnAssetRemoved().Remove(AssetRemovedHandle);
+	}
+	FCoreUObjectDelegates::OnPackageReloaded.Remove(PackageReloadedHandle);
+	AssetRenamedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	PackageReloadedHandle.Reset();
+	Reset();
+}
+
+UBlueprint* FGenBlueprintCache::FindBlueprint(const FString& BlueprintPath)
+{
+	check(IsInGameThread());
+
+	const FString ObjectPath = MakeObjectPath(BlueprintPath);
+	if (const TWeakObjectPtr<UBlueprint>* Cached = BlueprintsByPath.Find(ObjectPath))
+	{
+		UBlueprint* Blueprint = Cached->Get();
+		if (Blueprint && !Blueprint->HasAnyFlags(RF_NewerVersionExists))
+		{
+			return Blueprint;
+		}
+		GraphsByBlueprint.Remove(*Cached);
+		BlueprintsByPath.Remove(ObjectPath);
+	}
+
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	if (Blueprint)
+	{
+		BlueprintsByPath.Add(ObjectPath, Blueprint);
+	}
+	return Blueprint;
+}
+
+UEdGraph* FGenBlueprintCache::FindGraph(UBlueprint* Blueprint, const FGuid& GraphGuid)
+{
+	check(IsInGameThread());
+	if (!Blueprint)
+	{
+		return nullptr;
+	}
+
+	TMap<FGuid, TWeakObjectPtr<UEdGraph>>& Graphs = GraphsByBlueprint.FindOrAdd(Blueprint);
+
+	// Removed graphs are moved out of the Blueprint, the outer tells whether the entry is still current
+	if (const TWeakObjectPtr<UEdGraph>* Cached = Graphs.Find(GraphGuid))
+	{
+		UEdGraph* Graph = Cached->Get();
+		if (Graph && Graph->GetOuter() == Blueprint && Graph->GraphGuid == GraphGuid)
+		{
+			return Graph;
+		}
+	}
+
+	// A miss means the graph is new or the map is stale, rebuild it in one pass
+	Graphs.Reset();
+	UEdGraph* Found = nullptr;
+	for (const TArray<TObjectPtr<UEdGraph>>* GraphArray : { &Blueprint->UbergraphPages, &Blueprint->FunctionGraphs, &Blueprint->MacroGraphs })
+	{
+		for (UEdGraph* Graph : *GraphArray)
+		{
+			if (!Graph) continue;
+			Graphs.Add(Graph->GraphGuid, Graph);
+			if (!Found && Graph->GraphGuid == GraphGuid) Found = Graph;
+		}
+	}
+	return Found;
+}
+
+void FGenBlueprintCache::Reset()
+{
+	BlueprintsByPath.Reset();
+	GraphsByBlueprint.Reset();
+}
+
+void FGenBlueprintCache::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	RemovePath(OldObjectPath);
+}
+
+void FGenBlueprintCache::OnAssetRemoved(const FAssetData& AssetData)
+{
+	RemovePath(AssetData.GetObjectPathString());
+}
+
+void FGenBlueprintCache::RemovePath(const FString& ObjectPath)
+{
+	TWeakObjectPtr<UBlueprint> Removed;
+	if (BlueprintsByPath.RemoveAndCopyValue(ObjectPath, Removed))
+	{
+		GraphsByBlueprint.Remove(Removed);
+	}
+}
+
+FString FGenBlueprintCache::MakeObjectPath(const FString& BlueprintPath)
+{
+	int32 DotIndex = INDEX_NONE;
+	if (BlueprintPath.FindLastChar(TEXT('.'), DotIndex))
+	{
+		return BlueprintPath;
+	}
+
+	int32 SlashIndex = INDEX_NONE;
+	BlueprintPath.FindLastChar(TEXT('/'), SlashIndex);
+	return FString::Printf(TEXT("%s.%s"), *BlueprintPath, *BlueprintPath.Mid(SlashIndex + 1));
+}
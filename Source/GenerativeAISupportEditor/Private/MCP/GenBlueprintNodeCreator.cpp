@@ -3,6 +3,9 @@
 // source tree or http://opensource.org/licenses/MIT.
 
 #include "MCP/GenBlueprintNodeCreator.h"
+#include "MCP/GenBlueprintCache.h"
+#include "MCP/GenCompileScheduler.h"
+#include "MCP/GenFunctionIndex.h"
 #include "K2Node_CallFunction.h"
 #include "K2Node_ExecutionSequence.h"
 #include "K2Node_IfThenElse.h"
@@ -11,6 +14,7 @@
 #include "K2Node_SwitchString.h"
 #include "K2Node_VariableGet.h"
 #include "K2Node_VariableSet.h"
+#include "K2Node_Variable.h"
 #include "EdGraphSchema_K2.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
@@ -27,6 +31,7 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
+#include "ScopedTransaction.h"
 #include "UObject/UnrealTypePrivate.h"
 
 
@@ -38,7 +43,7 @@ FString UGenBlueprintNodeCreator::AddNode(const FString& BlueprintPath, const FS
                                           const FString& NodeType, float NodeX, float NodeY,
                                           const FString& PropertiesJson, bool bFinalizeChanges)
 {
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	UBlueprint* Blueprint = FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
 	if (!Blueprint)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
@@ -56,103 +61,33 @@ FString UGenBlueprintNodeCreator::AddNode(const FString& BlueprintPath, const FS
 	if (bFinalizeChanges)
 		IsBlueprintDirty = false;
 
-	UK2Node* NewNode = nullptr;
-	TArray<FString> Suggestions;
-
-	if (TryCreateKnownNodeType(FunctionGraph, NodeType, NewNode, PropertiesJson))
+	TSharedPtr<FJsonObject> Properties;
+	if (!PropertiesJson.IsEmpty())
 	{
-		// Node created successfully, make sure:
-		if (!NewNode)
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
+		if (!FJsonSerializer::Deserialize(Reader, Properties) || !Properties.IsValid())
 		{
-			UE_LOG(LogTemp, Error, TEXT("Node creation failed for type: %s"), *NodeType);
+			UE_LOG(LogTemp, Error, TEXT("Could not parse node properties: %s"), *PropertiesJson);
 			return TEXT("");
 		}
 	}
-	else
+
+	FString Suggestions;
+	UK2Node* NewNode = CreateNode(FunctionGraph, NodeType, NodeX, NodeY, Properties, Suggestions);
+	if (!Suggestions.IsEmpty())
 	{
-		FString Result = TryCreateNodeFromLibraries(FunctionGraph, NodeType, NewNode, Suggestions);
-		if (!Result.IsEmpty() && Result.StartsWith(TEXT("SUGGESTIONS:")))
-		{
-			return Result; // Return suggestions directly to caller
-		}
-		else if (!NewNode)
-		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to create node type: %s"), *NodeType);
-			return TEXT("");
-		}
+		return Suggestions; // Return suggestions directly to caller
 	}
-
-	FunctionGraph->AddNode(NewNode, false, false);
-	NewNode->NodePosX = NodeX;
-	NewNode->NodePosY = NodeY;
-	NewNode->AllocateDefaultPins();
-
-	if (!PropertiesJson.IsEmpty())
+	if (!NewNode)
 	{
-		TSharedPtr<FJsonObject> JsonObject;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
-		if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-		{
-			for (auto& Prop : JsonObject->Values)
-			{
-				const FString& PropName = Prop.Key;
-				TSharedPtr<FJsonValue> PropValue = Prop.Value;
-				UEdGraphPin* Pin = NewNode->FindPin(FName(*PropName));
-				if (Pin)
-				{
-					if (PropValue->Type == EJson::String) Pin->DefaultValue = PropValue->AsString();
-					else if (PropValue->Type == EJson::Number)
-						Pin->DefaultValue = FString::SanitizeFloat(
-							PropValue->AsNumber());
-					else if (PropValue->Type == EJson::Boolean)
-						Pin->DefaultValue = PropValue->AsBool()
-							                    ? TEXT("true")
-							                    : TEXT("false");
-				}
-
-				if ((NodeType.Equals(TEXT("VariableGet"), ESearchCase::IgnoreCase) ||
-						NodeType.Equals(TEXT("VariableSet"), ESearchCase::IgnoreCase)) &&
-					PropName.Equals(TEXT("variable_name"), ESearchCase::IgnoreCase) && PropValue->Type == EJson::String)
-				{
-					FString VariableName = PropValue->AsString();
-					if (!VariableName.IsEmpty())
-					{
-						FMemberReference VarRef;
-						VarRef.SetSelfMember(FName(*VariableName));
-						if (UK2Node_VariableGet* VarGet = Cast<UK2Node_VariableGet>(NewNode))
-							VarGet->VariableReference = VarRef;
-						else if (UK2Node_VariableSet* VarSet = Cast<UK2Node_VariableSet>(NewNode))
-							VarSet->VariableReference = VarRef;
-					}
-				}
-			}
-		}
+		return TEXT("");
 	}
 
-	NewNode->ReconstructNode();
-
 	if (bFinalizeChanges)
 	{
-		if (GEditor)
-		{
-			UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-			if (AssetEditorSubsystem)
-			{
-				AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-				if (FBlueprintEditor* BlueprintEditor = static_cast<FBlueprintEditor*>(AssetEditorSubsystem->
-					FindEditorForAsset(Blueprint, false)))
-					BlueprintEditor->OpenGraphAndBringToFront(FunctionGraph);
-			}
-		}
-		if (IsBlueprintDirty)
-		{
-			Blueprint->Modify();
-			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-		}
+		FinalizeGraphChanges(Blueprint, FunctionGraph);
 	}
 
-	if (!NewNode->NodeGuid.IsValid()) NewNode->NodeGuid = FGuid::NewGuid();
-
 	UE_LOG(LogTemp, Log, TEXT("Added node of type %s to blueprint %s with GUID %s"), *NodeType, *BlueprintPath,
 	       *NewNode->NodeGuid.ToString());
 	return NewNode->NodeGuid.ToString();
@@ -162,42 +97,20 @@ FString UGenBlueprintNodeCreator::AddNode(const FString& BlueprintPath, const FS
 FString UGenBlueprintNodeCreator::AddNodesBulk(const FString& BlueprintPath, const FString& FunctionGuid,
                                                const FString& NodesJson)
 {
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	UBlueprint* Blueprint = FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
 	if (!Blueprint)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
 		return TEXT("");
 	}
 
-	FGuid GraphGuid;
-	if (!FGuid::Parse(FunctionGuid, GraphGuid))
-	{
-		UE_LOG(LogTemp, Error, TEXT("Invalid GUID format: %s"), *FunctionGuid);
-		return TEXT("");
-	}
-
-	UEdGraph* FunctionGraph = nullptr;
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
-		if (Graph->GraphGuid == GraphGuid)
-		{
-			FunctionGraph = Graph;
-			break;
-		}
-	if (!FunctionGraph)
-		for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-			if (Graph->GraphGuid == GraphGuid)
-			{
-				FunctionGraph = Graph;
-				break;
-			}
+	UEdGraph* FunctionGraph = GetGraphFromFunctionId(Blueprint, FunctionGuid);
 	if (!FunctionGraph)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Could not find function graph with GUID: %s"), *FunctionGuid);
 		return TEXT("");
 	}
 
-	IsBlueprintDirty = false;
-
 	TArray<TSharedPtr<FJsonValue>> NodesArray;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(NodesJson);
 	if (!FJsonSerializer::Deserialize(Reader, NodesArray))
@@ -206,8 +119,16 @@ FString UGenBlueprintNodeCreator::AddNodesBulk(const FString& BlueprintPath, con
 		return TEXT("");
 	}
 
-	TSharedPtr<FJsonObject> ResultsObject = MakeShareable(new FJsonObject);
+	IsBlueprintDirty = false;
+
+	// One undo step for the whole batch, the graph is only notified once all nodes exist
+	const FScopedTransaction Transaction(NSLOCTEXT("GenBlueprintNodeCreator", "AddNodesBulk", "Add Nodes"));
+	Blueprint->Modify();
+	FunctionGraph->Modify();
+
 	TArray<TSharedPtr<FJsonValue>> ResultsArray;
+	ResultsArray.Reserve(NodesArray.Num());
+	int32 NodesAdded = 0;
 
 	for (auto& NodeValue : NodesArray)
 	{
@@ -215,57 +136,482 @@ FString UGenBlueprintNodeCreator::AddNodesBulk(const FString& BlueprintPath, con
 		if (!NodeObject.IsValid()) continue;
 
 		FString NodeType = NodeObject->GetStringField(TEXT("node_type"));
-		TArray<TSharedPtr<FJsonValue>> PositionArray = NodeObject->GetArrayField(TEXT("node_position"));
-		double NodeX = PositionArray.Num() > 0 ? PositionArray[0]->AsNumber() : 0.0;
-		double NodeY = PositionArray.Num() > 1 ? PositionArray[1]->AsNumber() : 0.0;
-
-		FString PropertiesJson;
-		if (NodeObject->HasField(TEXT("node_properties")))
+		const TArray<TSharedPtr<FJsonValue>>* PositionArray = nullptr;
+		double NodeX = 0.0;
+		double NodeY = 0.0;
+		if (NodeObject->TryGetArrayField(TEXT("node_position"), PositionArray))
 		{
-			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PropertiesJson);
-			FJsonSerializer::Serialize(NodeObject->GetObjectField(TEXT("node_properties")).ToSharedRef(), Writer);
+			NodeX = PositionArray->Num() > 0 ? (*PositionArray)[0]->AsNumber() : 0.0;
+			NodeY = PositionArray->Num() > 1 ? (*PositionArray)[1]->AsNumber() : 0.0;
 		}
 
 		FString NodeRefId;
 		if (NodeObject->HasField(TEXT("id"))) NodeRefId = NodeObject->GetStringField(TEXT("id"));
 
-		FString NodeGuid = AddNode(BlueprintPath, FunctionGuid, NodeType, NodeX, NodeY, PropertiesJson, false);
-		if (!NodeGuid.IsEmpty())
+		// The properties are used as parsed, not written back to a string for every node
+		const TSharedPtr<FJsonObject>* Properties = nullptr;
+		if (NodeObject->HasField(TEXT("node_properties")) && !NodeObject->TryGetObjectField(TEXT("node_properties"), Properties))
 		{
+			UE_LOG(LogTemp, Error, TEXT("Could not parse node properties of %s node %s"), *NodeType, *NodeRefId);
+			continue;
+		}
+
+		FString Suggestions;
+		UK2Node* NewNode = CreateNode(FunctionGraph, NodeType, NodeX, NodeY, Properties ? *Properties : nullptr, Suggestions, false);
+		if (NewNode || !Suggestions.IsEmpty())
+		{
+			// Unknown types report their suggestions in place of the GUID, as single adds do
 			TSharedPtr<FJsonObject> ResultObject = MakeShareable(new FJsonObject);
-			ResultObject->SetStringField(TEXT("node_guid"), NodeGuid);
+			ResultObject->SetStringField(TEXT("node_guid"), NewNode ? NewNode->NodeGuid.ToString() : Suggestions);
 			if (!NodeRefId.IsEmpty()) ResultObject->SetStringField(TEXT("ref_id"), NodeRefId);
 			ResultsArray.Add(MakeShareable(new FJsonValueObject(ResultObject)));
+			NodesAdded += NewNode ? 1 : 0;
+		}
+	}
+
+	if (NodesAdded > 0)
+	{
+		FunctionGraph->NotifyGraphChanged();
+		FinalizeGraphChanges(Blueprint, FunctionGraph);
+	}
+
+	FString ResultsJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultsJson);
+	FJsonSerializer::Serialize(ResultsArray, Writer);
+
+	UE_LOG(LogTemp, Log, TEXT("Added %d nodes to blueprint %s"), NodesAdded, *BlueprintPath);
+	return ResultsJson;
+}
+
+
+FString UGenBlueprintNodeCreator::ApplyGraph(const FString& BlueprintPath, const FString& FunctionGuid, const FString& GraphJson)
+{
+	auto MakeResult = [](const TSharedRef<FJsonObject>& ResultObject)
+	{
+		FString ResultJson;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+		FJsonSerializer::Serialize(ResultObject, Writer);
+		return ResultJson;
+	};
+	auto MakeError = [&MakeResult](const FString& Error)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ApplyGraph: %s"), *Error);
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetBoolField(TEXT("success"), false);
+		ResultObject->SetStringField(TEXT("error"), Error);
+		return MakeResult(ResultObject);
+	};
+
+	UBlueprint* Blueprint = FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
+	if (!Blueprint) return MakeError(FString::Printf(TEXT("Could not load blueprint at path: %s"), *BlueprintPath));
+
+	UEdGraph* Graph = GetGraphFromFunctionId(Blueprint, FunctionGuid);
+	if (!Graph) return MakeError(FString::Printf(TEXT("Could not find graph: %s"), *FunctionGuid));
+
+	TSharedPtr<FJsonObject> Spec;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(GraphJson);
+	if (!FJsonSerializer::Deserialize(Reader, Spec) || !Spec.IsValid()) return MakeError(TEXT("Failed to parse graph JSON"));
+
+	bool bPrune = false;
+	bool bCompile = true;
+	Spec->TryGetBoolField(TEXT("prune"), bPrune);
+	Spec->TryGetBoolField(TEXT("compile"), bCompile);
+
+	struct FSpecNode
+	{
+		FString RefId;
+		FString NodeType;
+		FGuid Guid;
+		TSharedPtr<FJsonObject> Object;
+		UK2Node* Node = nullptr;
+	};
+
+	// Nodes created by a spec get a GUID derived from the graph, ref id and type, so the next revision of the
+	// spec finds them again and a changed type replaces the node. Existing nodes can be referenced by "guid"
+	TArray<FSpecNode> SpecNodes;
+	TMap<FString, int32> SpecNodesByRef;
+	TArray<FString> Errors;
+	const TArray<TSharedPtr<FJsonValue>>* NodesArray = nullptr;
+	if (Spec->TryGetArrayField(TEXT("nodes"), NodesArray))
+	{
+		SpecNodes.Reserve(NodesArray->Num());
+		for (const TSharedPtr<FJsonValue>& NodeValue : *NodesArray)
+		{
+			const TSharedPtr<FJsonObject> NodeObject = NodeValue->AsObject();
+			FString RefId;
+			if (!NodeObject.IsValid() || !NodeObject->TryGetStringField(TEXT("id"), RefId) || RefId.IsEmpty())
+				return MakeError(TEXT("Every node needs an 'id'"));
+			if (SpecNodesByRef.Contains(RefId))
+				return MakeError(FString::Printf(TEXT("Duplicate node id: %s"), *RefId));
+
+			FSpecNode& SpecNode = SpecNodes.AddDefaulted_GetRef();
+			SpecNode.RefId = RefId;
+			SpecNode.Object = NodeObject;
+			FString GuidString;
+			if (NodeObject->TryGetStringField(TEXT("guid"), GuidString))
+			{
+				if (!FGuid::Parse(GuidString, SpecNode.Guid))
+					return MakeError(FString::Printf(TEXT("Invalid guid for node %s"), *RefId));
+			}
+			else if (NodeObject->TryGetStringField(TEXT("node_type"), SpecNode.NodeType) && !SpecNode.NodeType.IsEmpty())
+			{
+				SpecNode.Guid = FGuid::NewDeterministicGuid(FString::Printf(TEXT("%s/%s/%s"),
+					*Graph->GraphGuid.ToString(), *RefId, *SpecNode.NodeType.ToLower()));
+			}
+			else
+			{
+				return MakeError(FString::Printf(TEXT("Node %s needs a 'node_type' or a 'guid'"), *RefId));
+			}
+			SpecNodesByRef.Add(RefId, SpecNodes.Num() - 1);
+		}
+	}
+
+	TMap<FGuid, UEdGraphNode*> NodesByGuid;
+	NodesByGuid.Reserve(Graph->Nodes.Num());
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node) NodesByGuid.Add(Node->NodeGuid, Node);
+	}
+
+	IsBlueprintDirty = false;
+	const FScopedTransaction Transaction(NSLOCTEXT("GenBlueprintNodeCreator", "ApplyGraph", "Apply Graph"));
+	Blueprint->Modify();
+	Graph->Modify();
+
+	int32 NodesCreated = 0;
+	int32 NodesUpdated = 0;
+	int32 NodesDeleted = 0;
+	TSet<UEdGraphNode*> KeptNodes;
+
+	for (FSpecNode& SpecNode : SpecNodes)
+	{
+		if (UEdGraphNode** Existing = NodesByGuid.Find(SpecNode.Guid))
+		{
+			SpecNode.Node = Cast<UK2Node>(*Existing);
+			if (SpecNode.Node) KeptNodes.Add(SpecNode.Node);
+			else Errors.Add(FString::Printf(TEXT("Node %s: %s is not a Blueprint node"), *SpecNode.RefId, *SpecNode.Guid.ToString()));
+		}
+		else if (SpecNode.NodeType.IsEmpty())
+		{
+			Errors.Add(FString::Printf(TEXT("Node %s: no node with GUID %s"), *SpecNode.RefId, *SpecNode.Guid.ToString()));
 		}
 	}
 
-	if (ResultsArray.Num() > 0)
+	for (FSpecNode& SpecNode : SpecNodes)
 	{
-		if (GEditor)
+		double NodeX = 0.0;
+		double NodeY = 0.0;
+		const TArray<TSharedPtr<FJsonValue>>* PositionArray = nullptr;
+		const bool bHasPosition = SpecNode.Object->TryGetArrayField(TEXT("node_position"), PositionArray);
+		if (bHasPosition)
 		{
-			UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-			if (AssetEditorSubsystem)
+			NodeX = PositionArray->Num() > 0 ? (*PositionArray)[0]->AsNumber() : 0.0;
+			NodeY = PositionArray->Num() > 1 ? (*PositionArray)[1]->AsNumber() : 0.0;
+		}
+		const TSharedPtr<FJsonObject>* Properties = nullptr;
+		SpecNode.Object->TryGetObjectField(TEXT("node_properties"), Properties);
+
+		if (!SpecNode.Node)
+		{
+			if (SpecNode.NodeType.IsEmpty() || NodesByGuid.Contains(SpecNode.Guid)) continue;
+
+			FString Suggestions;
+			SpecNode.Node = CreateNode(Graph, SpecNode.NodeType, NodeX, NodeY, Properties ? *Properties : nullptr, Suggestions, false);
+			if (!SpecNode.Node)
 			{
-				AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-				if (FBlueprintEditor* BlueprintEditor = static_cast<FBlueprintEditor*>(AssetEditorSubsystem->
-					FindEditorForAsset(Blueprint, false)))
-					BlueprintEditor->OpenGraphAndBringToFront(FunctionGraph);
+				Errors.Add(FString::Printf(TEXT("Node %s: could not create %s%s"), *SpecNode.RefId, *SpecNode.NodeType,
+				                           Suggestions.IsEmpty() ? TEXT("") : *(TEXT(" ") + Suggestions)));
+				continue;
 			}
+			SpecNode.Node->NodeGuid = SpecNode.Guid;
+			KeptNodes.Add(SpecNode.Node);
+			NodesCreated++;
+			continue;
 		}
 
-		if (IsBlueprintDirty)
+		bool bChanged = false;
+		if (bHasPosition && (SpecNode.Node->NodePosX != static_cast<int32>(NodeX) || SpecNode.Node->NodePosY != static_cast<int32>(NodeY)))
+		{
+			SpecNode.Node->Modify();
+			SpecNode.Node->NodePosX = NodeX;
+			SpecNode.Node->NodePosY = NodeY;
+			bChanged = true;
+		}
+		if (Properties && ApplyNodeProperties(SpecNode.Node, SpecNode.NodeType, **Properties))
 		{
-			Blueprint->Modify();
-			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+			SpecNode.Node->ReconstructNode();
+			bChanged = true;
+			IsBlueprintDirty = true;
 		}
+		NodesUpdated += bChanged ? 1 : 0;
 	}
 
-	FString ResultsJson;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultsJson);
-	FJsonSerializer::Serialize(ResultsArray, Writer);
+	// Nodes the spec no longer mentions go once the spec's own nodes exist. A spec that failed to resolve or
+	// create a node is not a complete picture of the graph, so nothing is deleted then
+	const bool bPruned = bPrune && Errors.Num() == 0;
+	if (bPruned)
+	{
+		TArray<UEdGraphNode*> NodesToDelete;
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node || KeptNodes.Contains(Node)) continue;
+			if (Node->CanUserDeleteNode()) NodesToDelete.Add(Node);
+			else KeptNodes.Add(Node);
+		}
+		for (UEdGraphNode* Node : NodesToDelete)
+		{
+			FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+		}
+		NodesDeleted = NodesToDelete.Num();
+	}
+	else if (bPrune)
+	{
+		Errors.Add(TEXT("Nothing was pruned because of the errors above"));
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("Added %d nodes to blueprint %s"), ResultsArray.Num(), *BlueprintPath);
-	return ResultsJson;
+	// Links are diffed between the nodes the spec manages, without pruning links to other nodes stay untouched
+	TSet<UEdGraphNode*> ManagedNodes;
+	for (const FSpecNode& SpecNode : SpecNodes)
+	{
+		if (SpecNode.Node) ManagedNodes.Add(SpecNode.Node);
+	}
+	if (bPruned) ManagedNodes.Append(KeptNodes);
+
+	TSet<TPair<UEdGraphPin*, UEdGraphPin*>> DesiredLinks;
+	const TArray<TSharedPtr<FJsonValue>>* LinksArray = nullptr;
+	if (Spec->TryGetArrayField(TEXT("links"), LinksArray))
+	{
+		for (int32 Index = 0; Index < LinksArray->Num(); ++Index)
+		{
+			const TSharedPtr<FJsonObject> LinkObject = (*LinksArray)[Index]->AsObject();
+			if (!LinkObject.IsValid()) continue;
+
+			const FString SourceRef = LinkObject->GetStringField(TEXT("source_node_id"));
+			const FString TargetRef = LinkObject->GetStringField(TEXT("target_node_id"));
+			const FString SourcePinName = LinkObject->GetStringField(TEXT("source_pin"));
+			const FString TargetPinName = LinkObject->GetStringField(TEXT("target_pin"));
+
+			auto ResolveNode = [&](const FString& Ref) -> UEdGraphNode*
+			{
+				if (const int32* SpecIndex = SpecNodesByRef.Find(Ref)) return SpecNodes[*SpecIndex].Node;
+				FGuid Guid;
+				UEdGraphNode* const* Node = FGuid::Parse(Ref, Guid) ? NodesByGuid.Find(Guid) : nullptr;
+				return Node && (!bPruned || KeptNodes.Contains(*Node)) ? *Node : nullptr;
+			};
+			UEdGraphNode* SourceNode = ResolveNode(SourceRef);
+			UEdGraphNode* TargetNode = ResolveNode(TargetRef);
+			UEdGraphPin* SourcePin = SourceNode ? SourceNode->FindPin(FName(*SourcePinName), EGPD_Output) : nullptr;
+			UEdGraphPin* TargetPin = TargetNode ? TargetNode->FindPin(FName(*TargetPinName), EGPD_Input) : nullptr;
+			if (!SourcePin || !TargetPin)
+			{
+				Errors.Add(FString::Printf(TEXT("Link %d: %s.%s -> %s.%s not found"), Index,
+				                           *SourceRef, *SourcePinName, *TargetRef, *TargetPinName));
+				continue;
+			}
+			DesiredLinks.Add(TPair<UEdGraphPin*, UEdGraphPin*>(SourcePin, TargetPin));
+			ManagedNodes.Add(SourceNode);
+			ManagedNodes.Add(TargetNode);
+		}
+	}
+
+	int32 LinksRemoved = 0;
+	int32 LinksAdded = 0;
+	for (UEdGraphNode* Node : ManagedNodes)
+	{
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction != EGPD_Output) continue;
+			for (int32 LinkIndex = Pin->LinkedTo.Num() - 1; LinkIndex >= 0; --LinkIndex)
+			{
+				UEdGraphPin* LinkedPin = Pin->LinkedTo[LinkIndex];
+				if (ManagedNodes.Contains(LinkedPin->GetOwningNode()) &&
+					!DesiredLinks.Contains(TPair<UEdGraphPin*, UEdGraphPin*>(Pin, LinkedPin)))
+				{
+					Pin->BreakLinkTo(LinkedPin);
+					LinksRemoved++;
+				}
+			}
+		}
+	}
+	for (const TPair<UEdGraphPin*, UEdGraphPin*>& Link : DesiredLinks)
+	{
+		if (Link.Key->LinkedTo.Contains(Link.Value)) continue;
+
+		Link.Key->MakeLinkTo(Link.Value);
+		if (Link.Key->LinkedTo.Contains(Link.Value))
+		{
+			LinksAdded++;
+		}
+		else
+		{
+			Errors.Add(FString::Printf(TEXT("Could not link %s to %s - type mismatch or invalid connection"),
+			                           *Link.Key->PinName.ToString(), *Link.Value->PinName.ToString()));
+		}
+	}
+
+	const bool bModified = NodesCreated + NodesDeleted + NodesUpdated + LinksAdded + LinksRemoved > 0;
+	if (bModified)
+	{
+		// Structural changes are signalled once, the compile below picks them all up
+		IsBlueprintDirty = true;
+		Graph->NotifyGraphChanged();
+		FinalizeGraphChanges(Blueprint, Graph);
+	}
+
+	bool bCompiled = false;
+	if (bCompile && (bModified || Blueprint->Status != BS_UpToDate))
+	{
+		FGenCompileScheduler::Get().RequestCompile(Blueprint);
+		FGenCompileScheduler::Get().Flush(Blueprint);
+		bCompiled = true;
+	}
+
+	const TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+	const bool bCompileFailed = bCompiled && Blueprint->Status == BS_Error;
+	ResultObject->SetBoolField(TEXT("success"), Errors.Num() == 0 && !bCompileFailed);
+	const TSharedRef<FJsonObject> NodeMapping = MakeShared<FJsonObject>();
+	for (const FSpecNode& SpecNode : SpecNodes)
+	{
+		if (SpecNode.Node) NodeMapping->SetStringField(SpecNode.RefId, SpecNode.Node->NodeGuid.ToString());
+	}
+	ResultObject->SetObjectField(TEXT("nodes"), NodeMapping);
+	ResultObject->SetNumberField(TEXT("nodes_created"), NodesCreated);
+	ResultObject->SetNumberField(TEXT("nodes_updated"), NodesUpdated);
+	ResultObject->SetNumberField(TEXT("nodes_deleted"), NodesDeleted);
+	ResultObject->SetNumberField(TEXT("links_added"), LinksAdded);
+	ResultObject->SetNumberField(TEXT("links_removed"), LinksRemoved);
+	ResultObject->SetBoolField(TEXT("compiled"), bCompiled);
+	if (bCompileFailed) Errors.Add(TEXT("Blueprint failed to compile"));
+	TArray<TSharedPtr<FJsonValue>> ErrorValues;
+	for (const FString& Error : Errors)
+	{
+		ErrorValues.Add(MakeShared<FJsonValueString>(Error));
+	}
+	ResultObject->SetArrayField(TEXT("errors"), ErrorValues);
+
+	UE_LOG(LogTemp, Log, TEXT("Applied graph to %s: %d created, %d updated, %d deleted, %d links added, %d removed"),
+	       *BlueprintPath, NodesCreated, NodesUpdated, NodesDeleted, LinksAdded, LinksRemoved);
+	return MakeResult(ResultObject);
+}
+
+
+UK2Node* UGenBlueprintNodeCreator::CreateNode(UEdGraph* Graph, const FString& NodeType, float NodeX, float NodeY,
+                                              const TSharedPtr<FJsonObject>& Properties, FString& OutSuggestions,
+                                              bool bNotifyGraph)
+{
+	UK2Node* NewNode = nullptr;
+	TArray<FString> Suggestions;
+
+	if (TryCreateKnownNodeType(Graph, NodeType, NewNode, Properties))
+	{
+		// Node created successfully, make sure:
+		if (!NewNode)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Node creation failed for type: %s"), *NodeType);
+			return nullptr;
+		}
+	}
+	else
+	{
+		FString Result = TryCreateNodeFromLibraries(Graph, NodeType, NewNode, Suggestions);
+		if (!Result.IsEmpty() && Result.StartsWith(TEXT("SUGGESTIONS:")))
+		{
+			OutSuggestions = Result;
+			return nullptr;
+		}
+		else if (!NewNode)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to create node type: %s"), *NodeType);
+			return nullptr;
+		}
+	}
+
+	NewNode->SetFlags(RF_Transactional);
+	if (bNotifyGraph)
+	{
+		Graph->AddNode(NewNode, false, false);
+	}
+	else if (!Graph->Nodes.Contains(NewNode))
+	{
+		// Batches notify the graph once at the end instead of once per node
+		Graph->Nodes.Add(NewNode);
+	}
+	NewNode->NodePosX = NodeX;
+	NewNode->NodePosY = NodeY;
+	NewNode->AllocateDefaultPins();
+
+	if (Properties.IsValid())
+	{
+		ApplyNodeProperties(NewNode, NodeType, *Properties);
+	}
+
+	NewNode->ReconstructNode();
+
+	if (!NewNode->NodeGuid.IsValid()) NewNode->NodeGuid = FGuid::NewGuid();
+	return NewNode;
+}
+
+
+bool UGenBlueprintNodeCreator::ApplyNodeProperties(UK2Node* Node, const FString& NodeType, const FJsonObject& Properties)
+{
+	bool bChanged = false;
+	for (auto& Prop : Properties.Values)
+	{
+		const FString& PropName = Prop.Key;
+		TSharedPtr<FJsonValue> PropValue = Prop.Value;
+		UEdGraphPin* Pin = Node->FindPin(FName(*PropName));
+		if (Pin)
+		{
+			FString DefaultValue;
+			if (PropValue->Type == EJson::String) DefaultValue = PropValue->AsString();
+			else if (PropValue->Type == EJson::Number) DefaultValue = FString::SanitizeFloat(PropValue->AsNumber());
+			else if (PropValue->Type == EJson::Boolean) DefaultValue = PropValue->AsBool() ? TEXT("true") : TEXT("false");
+			else continue;
+
+			if (Pin->DefaultValue != DefaultValue)
+			{
+				Node->Modify();
+				Pin->DefaultValue = DefaultValue;
+				bChanged = true;
+			}
+		}
+
+		if ((NodeType.Equals(TEXT("VariableGet"), ESearchCase::IgnoreCase) ||
+				NodeType.Equals(TEXT("VariableSet"), ESearchCase::IgnoreCase)) &&
+			PropName.Equals(TEXT("variable_name"), ESearchCase::IgnoreCase) && PropValue->Type == EJson::String)
+		{
+			FString VariableName = PropValue->AsString();
+			UK2Node_Variable* VariableNode = Cast<UK2Node_Variable>(Node);
+			if (!VariableName.IsEmpty() && VariableNode && VariableNode->VariableReference.GetMemberName() != FName(*VariableName))
+			{
+				Node->Modify();
+				VariableNode->VariableReference.SetSelfMember(FName(*VariableName));
+				bChanged = true;
+			}
+		}
+	}
+	return bChanged;
+}
+
+
+void UGenBlueprintNodeCreator::FinalizeGraphChanges(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+	if (GEditor)
+	{
+		UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+		if (AssetEditorSubsystem)
+		{
+			AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+			if (FBlueprintEditor* BlueprintEditor = static_cast<FBlueprintEditor*>(AssetEditorSubsystem->
+				FindEditorForAsset(Blueprint, false)))
+				BlueprintEditor->OpenGraphAndBringToFront(Graph);
+		}
+	}
+	if (IsBlueprintDirty)
+	{
+		Blueprint->Modify();
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	}
 }
 
 
@@ -273,7 +619,7 @@ FString UGenBlueprintNodeCreator::AddNodesBulk(const FString& BlueprintPath, con
 bool UGenBlueprintNodeCreator::DeleteNode(const FString& BlueprintPath, const FString& FunctionGuid,
                                           const FString& NodeGuid)
 {
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	UBlueprint* Blueprint = FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
 	if (!Blueprint)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
@@ -350,7 +696,7 @@ bool UGenBlueprintNodeCreator::DeleteNode(const FString& BlueprintPath, const FS
 // Get all nodes in a graph with their positions
 FString UGenBlueprintNodeCreator::GetAllNodesInGraph(const FString& BlueprintPath, const FString& FunctionGuid)
 {
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	UBlueprint* Blueprint = FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
 	if (!Blueprint) return TEXT("");
 
 	UEdGraph* FunctionGraph = nullptr;
@@ -394,36 +740,8 @@ FString UGenBlueprintNodeCreator::GetAllNodesInGraph(const FString& BlueprintPat
 
 UEdGraph* UGenBlueprintNodeCreator::FindGraphByGuid(UBlueprint* Blueprint, const FGuid& GraphGuid)
 {
-	if (!Blueprint) return nullptr;
-
-	// Look in UbergraphPages
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
-	{
-		if (Graph && Graph->GraphGuid == GraphGuid)
-		{
-			return Graph;
-		}
-	}
-
-	// Look in FunctionGraphs
-	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-	{
-		if (Graph && Graph->GraphGuid == GraphGuid)
-		{
-			return Graph;
-		}
-	}
-
-	// Look in MacroGraphs (if needed)
-	for (UEdGraph* Graph : Blueprint->MacroGraphs)
-	{
-		if (Graph && Graph->GraphGuid == GraphGuid)
-		{
-			return Graph;
-		}
-	}
-
-	return nullptr;
+	// Looks in the event, function and macro graphs, cached per Blueprint
+	return FGenBlueprintCache::Get().FindGraph(Blueprint, GraphGuid);
 }
 
 
@@ -481,7 +799,7 @@ void UGenBlueprintNodeCreator::InitNodeTypeMap()
 
 
 bool UGenBlueprintNodeCreator::TryCreateKnownNodeType(UEdGraph* Graph, const FString& NodeType, UK2Node*& OutNode,
-                                                      const FString& PropertiesJson)
+                                                      const TSharedPtr<FJsonObject>& Properties)
 {
 	InitNodeTypeMap();
 	FString ActualNodeType = NodeTypeMap.FindRef(NodeType.ToLower(), NodeType);
@@ -624,34 +942,24 @@ bool UGenBlueprintNodeCreator::TryCreateKnownNodeType(UEdGraph* Graph, const FSt
 	if (ActualNodeType.Equals(TEXT("K2Node_InputAction"), ESearchCase::IgnoreCase))
 	{
 		UK2Node_InputAction* InputNode = NewObject<UK2Node_InputAction>(Graph);
-		if (!PropertiesJson.IsEmpty())
+		if (Properties.IsValid())
 		{
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
-			if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+			FString ActionName;
+			if (Properties->TryGetStringField(TEXT("action_name"), ActionName) && !ActionName.IsEmpty())
 			{
-				FString ActionName;
-				if (JsonObject->TryGetStringField(TEXT("action_name"), ActionName) && !ActionName.IsEmpty())
-				{
-					InputNode->InputActionName = FName(*ActionName);
-					UE_LOG(LogTemp, Log, TEXT("Created InputAction node for action '%s'"), *ActionName);
-				}
-				else
-				{
-					UE_LOG(LogTemp, Error, TEXT("InputAction node requires 'action_name' in PropertiesJson"));
-					return false;
-				}
+				InputNode->InputActionName = FName(*ActionName);
+				UE_LOG(LogTemp, Log, TEXT("Created InputAction node for action '%s'"), *ActionName);
 			}
 			else
 			{
-				UE_LOG(LogTemp, Error, TEXT("Failed to parse PropertiesJson for InputAction node"));
-				return false;
+				UE_LOG(LogTemp, Error, TEXT("InputAction node requires 'action_name' in PropertiesJson"));
+				return true; // Recognized but invalid, the library search must not create something else instead
 			}
 		}
 		else
 		{
 			UE_LOG(LogTemp, Error, TEXT("InputAction node requires PropertiesJson with 'action_name'"));
-			return false;
+			return true;
 		}
 		OutNode = InputNode;
 		IsBlueprintDirty = true;
@@ -694,25 +1002,17 @@ bool UGenBlueprintNodeCreator::TryCreateKnownNodeType(UEdGraph* Graph, const FSt
 		TEXT("Getter"), ESearchCase::IgnoreCase))
 	{
 		UK2Node_VariableGet* VarGet = NewObject<UK2Node_VariableGet>(Graph);
-		if (!PropertiesJson.IsEmpty())
+		FString VarName;
+		if (Properties.IsValid() && Properties->TryGetStringField(TEXT("VariableName"), VarName) && !VarName.IsEmpty())
 		{
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
-			if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-			{
-				FString VarName;
-				if (JsonObject->TryGetStringField(TEXT("VariableName"), VarName) && !VarName.IsEmpty())
-				{
-					FMemberReference VarRef;
-					VarRef.SetSelfMember(FName(*VarName));
-					VarGet->VariableReference = VarRef;
-					VarGet->AllocateDefaultPins(); // Ensure pins are created after setting the reference
-					OutNode = VarGet;
-					IsBlueprintDirty = true;
-					UE_LOG(LogTemp, Log, TEXT("Created VariableGet node for variable '%s'"), *VarName);
-					return true;
-				}
-			}
+			FMemberReference VarRef;
+			VarRef.SetSelfMember(FName(*VarName));
+			VarGet->VariableReference = VarRef;
+			VarGet->AllocateDefaultPins(); // Ensure pins are created after setting the reference
+			OutNode = VarGet;
+			IsBlueprintDirty = true;
+			UE_LOG(LogTemp, Log, TEXT("Created VariableGet node for variable '%s'"), *VarName);
+			return true;
 		}
 		UE_LOG(LogTemp, Error, TEXT("VariableGet requires 'VariableName' in PropertiesJson"));
 		return false;
@@ -721,37 +1021,29 @@ bool UGenBlueprintNodeCreator::TryCreateKnownNodeType(UEdGraph* Graph, const FSt
 		TEXT("Setter"), ESearchCase::IgnoreCase))
 	{
 		UK2Node_VariableSet* VarSet = NewObject<UK2Node_VariableSet>(Graph);
-		if (!PropertiesJson.IsEmpty())
+		FString VarName;
+		if (Properties.IsValid() && Properties->TryGetStringField(TEXT("VariableName"), VarName) && !VarName.IsEmpty())
 		{
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
-			if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+			FMemberReference VarRef;
+			VarRef.SetSelfMember(FName(*VarName));
+			VarSet->VariableReference = VarRef;
+			VarSet->AllocateDefaultPins(); // Ensure pins are created after setting the reference
+
+			// Optionally set a default value if provided
+			FString Value;
+			if (Properties->TryGetStringField(TEXT("Value"), Value))
 			{
-				FString VarName;
-				if (JsonObject->TryGetStringField(TEXT("VariableName"), VarName) && !VarName.IsEmpty())
+				UEdGraphPin* ValuePin = VarSet->FindPin(FName(TEXT("Value")));
+				if (ValuePin)
 				{
-					FMemberReference VarRef;
-					VarRef.SetSelfMember(FName(*VarName));
-					VarSet->VariableReference = VarRef;
-					VarSet->AllocateDefaultPins(); // Ensure pins are created after setting the reference
-
-					// Optionally set a default value if provided
-					FString Value;
-					if (JsonObject->TryGetStringField(TEXT("Value"), Value))
-					{
-						UEdGraphPin* ValuePin = VarSet->FindPin(FName(TEXT("Value")));
-						if (ValuePin)
-						{
-							ValuePin->DefaultValue = Value;
-						}
-					}
-
-					OutNode = VarSet;
-					IsBlueprintDirty = true;
-					UE_LOG(LogTemp, Log, TEXT("Created VariableSet node for variable '%s'"), *VarName);
-					return true;
+					ValuePin->DefaultValue = Value;
 				}
 			}
+
+			OutNode = VarSet;
+			IsBlueprintDirty = true;
+			UE_LOG(LogTemp, Log, TEXT("Created VariableSet node for variable '%s'"), *VarName);
+			return true;
 		}
 		UE_LOG(LogTemp, Error, TEXT("VariableSet requires 'VariableName' in PropertiesJson"));
 		return false;
@@ -846,10 +1138,7 @@ UEdGraph* UGenBlueprintNodeCreator::GetGraphFromFunctionId(UBlueprint* Blueprint
 	FGuid GraphGuid;
 	if (FGuid::Parse(FunctionGuid, GraphGuid))
 	{
-		for (UEdGraph* Graph : Blueprint->UbergraphPages)
-			if (Graph->GraphGuid == GraphGuid) return Graph;
-		for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-			if (Graph->GraphGuid == GraphGuid) return Graph;
+		if (UEdGraph* Graph = FindGraphByGuid(Blueprint, GraphGuid)) return Graph;
 	}
 	UE_LOG(LogTemp, Error, TEXT("Could not resolve function ID %s to a graph"), *FunctionGuid);
 	return nullptr;
@@ -859,110 +1148,32 @@ FString UGenBlueprintNodeCreator::TryCreateNodeFromLibraries(UEdGraph* Graph, co
                                                              UK2Node*& OutNode,
                                                              TArray<FString>& OutSuggestions)
 {
-	static const TArray<FString> CommonLibraries = {
-		TEXT("KismetMathLibrary"), TEXT("KismetSystemLibrary"), TEXT("KismetStringLibrary"),
-		TEXT("KismetArrayLibrary"), TEXT("KismetTextLibrary"), TEXT("GameplayStatics"),
-		TEXT("BlueprintFunctionLibrary"), TEXT("Actor"), TEXT("Pawn"), TEXT("Character")
-	};
-
-	struct FFunctionMatch
-	{
-		FString LibraryName;
-		FString FunctionName;
-		FString DisplayName;
-		int32 Score;
-		UFunction* Function;
-		UClass* Class;
-	};
-
-	TArray<FFunctionMatch> Matches;
-	const FString NodeTypeLower = NodeType.ToLower();
-
-	auto SplitName = [](const FString& Name) -> TArray<FString>
-	{
-		TArray<FString> Parts;
-		Name.ParseIntoArray(Parts, TEXT("_"));
-		if (Parts.Num() == 1)
-		{
-			FString Temp = Name;
-			Parts.Empty();
-			for (int32 i = 0; i < Temp.Len(); ++i)
-			{
-				if (i > 0 && FChar::IsUpper(Temp[i]))
-				{
-					Parts.Add(Temp.Mid(0, i));
-					Temp = Temp.Mid(i);
-					i = 0;
-				}
-			}
-			if (!Temp.IsEmpty()) Parts.Add(Temp);
-		}
-		return Parts;
-	};
-
-	TArray<FString> NodeTypeParts = SplitName(NodeTypeLower);
-
-	for (const FString& LibraryName : CommonLibraries)
-	{
-		UClass* LibClass = FindObject<UClass>(ANY_PACKAGE, *LibraryName);
-		if (!LibClass) continue;
-
-		for (TFieldIterator<UFunction> FuncIt(LibClass); FuncIt; ++FuncIt)
-		{
-			UFunction* Function = *FuncIt;
-			FString FuncName = Function->GetName();
-			FString FuncNameLower = FuncName.ToLower();
-
-			if (Function->HasMetaData(TEXT("DeprecatedFunction")) || Function->HasMetaData(
-				TEXT("BlueprintInternalUseOnly")))
-				continue;
-
-			int32 Score = 0;
-			if (FuncNameLower == NodeTypeLower) Score = 120; // Exact match
-			else if (FuncNameLower.Contains(NodeTypeLower)) Score = 80; // Substring match
-
-			TArray<FString> FuncParts = SplitName(FuncNameLower);
-			for (const FString& Part : NodeTypeParts)
-				if (FuncParts.Contains(Part)) Score += 20;
-			if (FuncNameLower.StartsWith(NodeTypeLower)) Score += 10;
-			if (FuncNameLower.Len() > NodeTypeLower.Len() * 2) Score -= 15;
-
-			if (Score > 0)
-			{
-				FFunctionMatch Match;
-				Match.LibraryName = LibraryName;
-				Match.FunctionName = FuncName;
-				Match.DisplayName = FString::Printf(TEXT("%s.%s"), *LibraryName, *FuncName);
-				Match.Score = Score;
-				Match.Function = Function;
-				Match.Class = LibClass;
-				Matches.Add(Match);
-			}
-		}
-	}
-
+	const TArray<FGenFunctionMatch> Matches = FGenFunctionIndex::Get().Find(NodeType, 10);
 	if (Matches.Num() == 0) return TEXT("");
 
-	Matches.Sort([](const FFunctionMatch& A, const FFunctionMatch& B) { return A.Score > B.Score; });
-	for (const FFunctionMatch& Match : Matches) OutSuggestions.Add(Match.DisplayName);
+	for (const FGenFunctionMatch& Match : Matches) OutSuggestions.Add(Match.GetDisplayName());
 
-	const int32 ScoreThreshold = 80; // Raised threshold for better precision
-	if (Matches[0].Score >= ScoreThreshold)
+	// The threshold is on the old library search's scale. Functions outside the libraries it covered need
+	// their exact name, so a partial match on an unrelated class is suggested rather than created
+	const int32 ScoreThreshold = Matches[0].bPreferredClass ? 80 : 120;
+	if (Matches[0].NameScore >= ScoreThreshold)
 	{
-		const FFunctionMatch& BestMatch = Matches[0];
+		const FGenFunctionMatch& BestMatch = Matches[0];
+		UFunction* Function = BestMatch.Resolve();
+		if (!Function) return TEXT("");
+
 		UK2Node_CallFunction* FunctionNode = NewObject<UK2Node_CallFunction>(Graph);
 		IsBlueprintDirty = true;
 		if (FunctionNode)
 		{
-			FunctionNode->FunctionReference.SetExternalMember(BestMatch.Function->GetFName(), BestMatch.Class);
+			FunctionNode->FunctionReference.SetExternalMember(Function->GetFName(), Function->GetOwnerClass());
 			OutNode = FunctionNode;
 			OutSuggestions.Empty(); // Clear suggestions on success
-			return BestMatch.DisplayName;
+			return BestMatch.GetDisplayName();
 		}
 		return TEXT("");
 	}
 
-	while (OutSuggestions.Num() > 10) OutSuggestions.RemoveAt(OutSuggestions.Num() - 1); // More suggestions
 	FString SuggestionStr = FString::Join(OutSuggestions, TEXT(", "));
 	return TEXT("SUGGESTIONS:") + SuggestionStr;
 }
@@ -992,98 +1203,17 @@ bool UGenBlueprintNodeCreator::CreateMathFunctionNode(UEdGraph* Graph, const FSt
 
 FString UGenBlueprintNodeCreator::GetNodeSuggestions(const FString& NodeType)
 {
-	static const TArray<FString> CommonLibraries = {
-		TEXT("KismetMathLibrary"), TEXT("KismetSystemLibrary"), TEXT("KismetStringLibrary"),
-		TEXT("KismetArrayLibrary"), TEXT("KismetTextLibrary"), TEXT("GameplayStatics"),
-		TEXT("BlueprintFunctionLibrary"), TEXT("Actor"), TEXT("Pawn"), TEXT("Character")
-	};
-
-	struct FFunctionMatch
-	{
-		FString LibraryName;
-		FString FunctionName;
-		FString DisplayName;
-		int32 Score;
-	};
-
-	TArray<FFunctionMatch> Matches;
-	const FString NodeTypeLower = NodeType.ToLower();
-
-	auto SplitName = [](const FString& Name) -> TArray<FString>
-	{
-		TArray<FString> Parts;
-		Name.ParseIntoArray(Parts, TEXT("_"));
-		if (Parts.Num() == 1)
-		{
-			FString Temp = Name;
-			Parts.Empty();
-			for (int32 i = 0; i < Temp.Len(); ++i)
-			{
-				if (i > 0 && FChar::IsUpper(Temp[i]))
-				{
-					Parts.Add(Temp.Mid(0, i));
-					Temp = Temp.Mid(i);
-					i = 0;
-				}
-			}
-			if (!Temp.IsEmpty()) Parts.Add(Temp);
-		}
-		return Parts;
-	};
-
-	TArray<FString> NodeTypeParts = SplitName(NodeTypeLower);
-
-	for (const FString& LibraryName : CommonLibraries)
-	{
-		UClass* LibClass = FindObject<UClass>(ANY_PACKAGE, *LibraryName);
-		if (!LibClass) continue;
-
-		for (TFieldIterator<UFunction> FuncIt(LibClass); FuncIt; ++FuncIt)
-		{
-			UFunction* Function = *FuncIt;
-			FString FuncName = Function->GetName();
-			FString FuncNameLower = FuncName.ToLower();
-
-			if (Function->HasMetaData(TEXT("DeprecatedFunction")) || Function->HasMetaData(
-				TEXT("BlueprintInternalUseOnly")))
-				continue;
-
-			int32 Score = 0;
-			if (FuncNameLower == NodeTypeLower) Score = 100;
-			else if (FuncNameLower.Contains(NodeTypeLower)) Score = 50;
-
-			TArray<FString> FuncParts = SplitName(FuncNameLower);
-			for (const FString& Part : NodeTypeParts)
-				if (FuncParts.Contains(Part)) Score += 10;
-
-			if (FuncNameLower.StartsWith(NodeTypeLower)) Score += 5;
-			if (FuncNameLower.Len() > NodeTypeLower.Len() * 2) Score -= 10;
-
-			if (Score > 0)
-			{
-				FFunctionMatch Match;
-				Match.LibraryName = LibraryName;
-				Match.FunctionName = FuncName;
-				Match.DisplayName = FString::Printf(TEXT("%s.%s"), *LibraryName, *FuncName);
-				Match.Score = Score;
-				Matches.Add(Match);
-			}
-		}
-	}
-
+	const TArray<FGenFunctionMatch> Matches = FGenFunctionIndex::Get().Find(NodeType, 5);
 	if (Matches.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("No suggestions found for node type: %s"), *NodeType);
 		return TEXT("");
 	}
 
-	Matches.Sort([](const FFunctionMatch& A, const FFunctionMatch& B) { return A.Score > B.Score; });
 	TArray<FString> Suggestions;
-	for (const FFunctionMatch& Match : Matches) Suggestions.Add(Match.DisplayName);
-	while (Suggestions.Num() > 5) Suggestions.RemoveAt(Suggestions.Num() - 1);
+	for (const FGenFunctionMatch& Match : Matches) Suggestions.Add(Match.GetDisplayName());
 
 	FString SuggestionStr = FString::Join(Suggestions, TEXT(", "));
 	UE_LOG(LogTemp, Log, TEXT("Suggestions for %s: %s"), *NodeType, *SuggestionStr);
 	return TEXT("SUGGESTIONS:") + SuggestionStr;
 }
-
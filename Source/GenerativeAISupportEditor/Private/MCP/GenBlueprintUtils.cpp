@@ -2,6 +2,8 @@
 // Licensed under the MIT License. See LICENSE file in the root directory of this
 // source tree or http://opensource.org/licenses/MIT.
 #include "MCP/GenBlueprintUtils.h"
+#include "MCP/GenBlueprintCache.h"
+#include "MCP/GenCompileScheduler.h"
 
 #include "BlueprintEditor.h"
 #include "K2Node_ComponentBoundEvent.h"
@@ -23,6 +25,103 @@
 #include "Engine/SimpleConstructionScript.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ScopedTransaction.h"
+
+namespace GenBlueprintUtils
+{
+	// Output and input pins of a node by name, built once instead of scanning the pins for every lookup
+	struct FNodePins
+	{
+		TMap<FName, UEdGraphPin*> Outputs;
+		TMap<FName, UEdGraphPin*> Inputs;
+
+		explicit FNodePins(const UK2Node* Node)
+		{
+			for (UEdGraphPin* Pin : Node->Pins)
+			{
+				// The first pin of a name wins, like FindPin
+				(Pin->Direction == EGPD_Output ? Outputs : Inputs).FindOrAdd(Pin->PinName, Pin);
+			}
+		}
+	};
+
+	static FString Serialize(const TSharedRef<FJsonObject>& JsonObject)
+	{
+		FString ResultJson;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+		return ResultJson;
+	}
+
+	static TSharedRef<FJsonObject> MakeError(const FString& Error)
+	{
+		TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+		ResponseObject->SetBoolField(TEXT("success"), false);
+		ResponseObject->SetStringField(TEXT("error"), Error);
+		return ResponseObject;
+	}
+
+	static TSharedRef<FJsonObject> MakePinInfo(const UEdGraphPin* Pin)
+	{
+		TSharedRef<FJsonObject> PinInfo = MakeShared<FJsonObject>();
+		PinInfo->SetStringField(TEXT("name"), Pin->PinName.ToString());
+		PinInfo->SetStringField(TEXT("type"), Pin->PinType.PinCategory.ToString());
+		if (Pin->PinType.PinSubCategory != NAME_None)
+			PinInfo->SetStringField(TEXT("subtype"), Pin->PinType.PinSubCategory.ToString());
+		return PinInfo;
+	}
+
+	static void AddPins(const UK2Node* Node, const FString& FieldName, FJsonObject& JsonObj, EEdGraphPinDirection Direction)
+	{
+		TArray<TSharedPtr<FJsonValue>> PinsArray;
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction == Direction)
+			{
+				TSharedRef<FJsonObject> PinObj = MakePinInfo(Pin);
+				PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
+				PinsArray.Add(MakeShareable(new FJsonValueObject(PinObj)));
+			}
+		}
+		JsonObj.SetArrayField(FieldName, PinsArray);
+	}
+
+	/** Links two resolved pins, the result object describes the available pins or the mismatch when it fails */
+	static TSharedRef<FJsonObject> LinkPins(UK2Node* SourceNode, UEdGraphPin* SourcePin, const FString& SourcePinName,
+	                                        UK2Node* TargetNode, UEdGraphPin* TargetPin, const FString& TargetPinName,
+	                                        bool& bOutSuccess)
+	{
+		bOutSuccess = false;
+		if (!SourcePin || !TargetPin)
+		{
+			const TSharedRef<FJsonObject> ResponseObject = MakeError(FString::Printf(
+				TEXT("Pin not found. Source: %s (%s), Target: %s (%s)"),
+				*SourcePinName, SourcePin ? TEXT("found") : TEXT("not found"),
+				*TargetPinName, TargetPin ? TEXT("found") : TEXT("not found")));
+			AddPins(SourceNode, TEXT("source_available_pins"), *ResponseObject, EGPD_Output);
+			AddPins(TargetNode, TEXT("target_available_pins"), *ResponseObject, EGPD_Input);
+			return ResponseObject;
+		}
+
+		// Attempt the connection directly, letting Unreal handle type conversion
+		SourcePin->MakeLinkTo(TargetPin);
+
+		// Verify if the connection was successful
+		if (SourcePin->LinkedTo.Contains(TargetPin) && TargetPin->LinkedTo.Contains(SourcePin))
+		{
+			bOutSuccess = true;
+			TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+			ResponseObject->SetBoolField(TEXT("success"), true);
+			return ResponseObject;
+		}
+
+		// Connection failed, provide detailed feedback
+		const TSharedRef<FJsonObject> ResponseObject = MakeError(TEXT("Failed to connect pins - type mismatch or invalid connection"));
+		ResponseObject->SetObjectField(TEXT("source_pin"), MakePinInfo(SourcePin));
+		ResponseObject->SetObjectField(TEXT("target_pin"), MakePinInfo(TargetPin));
+		return ResponseObject;
+	}
+}
 
 UBlueprint* UGenBlueprintUtils::CreateBlueprint(const FString& BlueprintName, const FString& ParentClassName,
                                                 const FString& SavePath)
@@ -141,8 +240,8 @@ bool UGenBlueprintUtils::AddComponent(const FString& BlueprintPath, const FStrin
 	// Mark the blueprint as modified
 	Blueprint->Modify();
 
-	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	// Compiled with the next batch, together with the other edits to this blueprint
+	FGenCompileScheduler::Get().RequestCompile(Blueprint);
 
 	// Open the Blueprint editor
 	if (GEditor)
@@ -284,8 +383,8 @@ bool UGenBlueprintUtils::AddVariable(const FString& BlueprintPath, const FString
 	// Mark the blueprint as modified
 	Blueprint->Modify();
 
-	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	// Compiled with the next batch, together with the other edits to this blueprint
+	FGenCompileScheduler::Get().RequestCompile(Blueprint);
 
 	// Open the Blueprint editor
 	if (GEditor)
@@ -334,16 +433,10 @@ FString UGenBlueprintUtils::AddFunction(const FString& BlueprintPath, const FStr
 	FBlueprintEditorUtils::AddFunctionGraph(Blueprint, FunctionGraph, /*bIsUserCreated=*/ true, /*UObjectClass=*/
 	                                        static_cast<UClass*>(nullptr));
 
-	// Get the function entry node
-	UK2Node_FunctionEntry* EntryNode = nullptr;
-	for (TObjectIterator<UK2Node_FunctionEntry> It; It; ++It)
-	{
-		if (It->GetGraph() == FunctionGraph)
-		{
-			EntryNode = *It;
-			break;
-		}
-	}
+	// The schema created the entry node in the new graph, only that graph has to be searched
+	TArray<UK2Node_FunctionEntry*> EntryNodes;
+	FunctionGraph->GetNodesOfClass(EntryNodes);
+	UK2Node_FunctionEntry* EntryNode = EntryNodes.Num() > 0 ? EntryNodes[0] : nullptr;
 
 	if (!EntryNode)
 	{
@@ -415,15 +508,10 @@ FString UGenBlueprintUtils::AddFunction(const FString& BlueprintPath, const FStr
 
 	// Add outputs
 	// For this simplified version, we're just adding a single return node
-	UK2Node_FunctionResult* ResultNode = nullptr;
-	for (TObjectIterator<UK2Node_FunctionResult> It; It; ++It)
-	{
-		if (It->GetGraph() == FunctionGraph)
-		{
-			ResultNode = *It;
-			break;
-		}
-	}
+	// New function graphs only get an entry node, the result node is created when there are outputs
+	UK2Node_FunctionResult* ResultNode = Outputs.Num() > 0
+		? FBlueprintEditorUtils::FindOrCreateFunctionResultNode(EntryNode)
+		: nullptr;
 
 	if (ResultNode)
 	{
@@ -480,8 +568,8 @@ FString UGenBlueprintUtils::AddFunction(const FString& BlueprintPath, const FStr
 	// Mark the blueprint as modified
 	Blueprint->Modify();
 
-	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	// Compiled with the next batch, together with the other edits to this blueprint
+	FGenCompileScheduler::Get().RequestCompile(Blueprint);
 
 	OpenBlueprintGraph(Blueprint, FunctionGraph);
 
@@ -497,32 +585,10 @@ FString UGenBlueprintUtils::ConnectNodes(const FString& BlueprintPath, const FSt
     UBlueprint* Blueprint = LoadBlueprintAsset(BlueprintPath);
     if (!Blueprint) return TEXT("{\"success\": false, \"error\": \"Could not load blueprint\"}");
 
-	// Special handling for EventGraph
-	UEdGraph* FunctionGraph = nullptr;
-	if (FunctionGuid.Equals(TEXT("EventGraph"), ESearchCase::IgnoreCase))
-	{
-		// Get the first UbergraphPage (EventGraph)
-		if (Blueprint->UbergraphPages.Num() > 0)
-		{
-			FunctionGraph = Blueprint->UbergraphPages[0];
-		}
-	}
-	else
-	{
-		// Original GUID-based lookup for function graphs
-		FGuid GraphGuid;
-		if (!FGuid::Parse(FunctionGuid, GraphGuid))
-			return TEXT("{\"success\": false, \"error\": \"Invalid function GUID\"}");
-
-		for (UEdGraph* Graph : Blueprint->UbergraphPages)
-			if (Graph->GraphGuid == GraphGuid) { FunctionGraph = Graph; break; }
-		if (!FunctionGraph)
-			for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-				if (Graph->GraphGuid == GraphGuid) { FunctionGraph = Graph; break; }
-	}
-
+	FString GraphError;
+	UEdGraph* FunctionGraph = FindGraph(Blueprint, FunctionGuid, GraphError);
 	if (!FunctionGraph)
-		return TEXT("{\"success\": false, \"error\": \"Could not find function graph\"}");
+		return GenBlueprintUtils::Serialize(GenBlueprintUtils::MakeError(GraphError));
 
 	FGuid SourceGuid, TargetGuid;
 	if (!FGuid::Parse(SourceNodeGuid, SourceGuid) || !FGuid::Parse(TargetNodeGuid, TargetGuid))
@@ -545,95 +611,47 @@ FString UGenBlueprintUtils::ConnectNodes(const FString& BlueprintPath, const FSt
     UEdGraphPin* SourcePin = SourceNode->FindPin(FName(*SourcePinName), EGPD_Output);
     UEdGraphPin* TargetPin = TargetNode->FindPin(FName(*TargetPinName), EGPD_Input);
 
-    if (!SourcePin || !TargetPin)
+    bool bSuccess = false;
+    const TSharedRef<FJsonObject> ResponseObject = GenBlueprintUtils::LinkPins(SourceNode, SourcePin, SourcePinName,
+                                                                               TargetNode, TargetPin, TargetPinName, bSuccess);
+    if (bSuccess)
     {
-    	TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
-    	ResponseObject->SetBoolField(TEXT("success"), false);
-        
-    	FString ErrorMessage = FString::Printf(
-			TEXT("Pin not found. Source: %s (%s), Target: %s (%s)"),
-			*SourcePinName, SourcePin ? TEXT("found") : TEXT("not found"),
-			*TargetPinName, TargetPin ? TEXT("found") : TEXT("not found"));
-    	
-        ResponseObject->SetBoolField(TEXT("success"), false);
-        ResponseObject->SetStringField(TEXT("error"), ErrorMessage);
-
-        auto AddPins = [](UK2Node* Node, const FString& FieldName, TSharedPtr<FJsonObject> JsonObj, EEdGraphPinDirection Direction)
-        {
-            TArray<TSharedPtr<FJsonValue>> PinsArray;
-            for (UEdGraphPin* Pin : Node->Pins)
-            {
-                if (Pin->Direction == Direction)
-                {
-                    TSharedPtr<FJsonObject> PinObj = MakeShareable(new FJsonObject);
-                    PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
-                    PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
-                    PinObj->SetStringField(TEXT("type"), Pin->PinType.PinCategory.ToString());
-                    if (Pin->PinType.PinSubCategory != NAME_None)
-                        PinObj->SetStringField(TEXT("subtype"), Pin->PinType.PinSubCategory.ToString());
-                    PinsArray.Add(MakeShareable(new FJsonValueObject(PinObj)));
-                }
-            }
-            JsonObj->SetArrayField(FieldName, PinsArray);
-        };
-
-        AddPins(SourceNode, TEXT("source_available_pins"), ResponseObject, EGPD_Output);
-        AddPins(TargetNode, TEXT("target_available_pins"), ResponseObject, EGPD_Input);
-
-        FString ResultJson;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
-        FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
-        return ResultJson;
+        Blueprint->Modify();
+        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
     }
+    return GenBlueprintUtils::Serialize(ResponseObject);
+}
 
-    // Attempt the connection directly, letting Unreal handle type conversion
-    SourcePin->MakeLinkTo(TargetPin);
+UEdGraph* UGenBlueprintUtils::FindGraph(UBlueprint* Blueprint, const FString& FunctionGuid, FString& OutError)
+{
+	// Special handling for EventGraph
+	if (FunctionGuid.Equals(TEXT("EventGraph"), ESearchCase::IgnoreCase))
+	{
+		// Get the first UbergraphPage (EventGraph)
+		if (Blueprint->UbergraphPages.Num() > 0)
+		{
+			return Blueprint->UbergraphPages[0];
+		}
+		OutError = TEXT("Could not find function graph");
+		return nullptr;
+	}
 
-    // Verify if the connection was successful
-    if (SourcePin->LinkedTo.Contains(TargetPin) && TargetPin->LinkedTo.Contains(SourcePin))
-    {
-        Blueprint->Modify();
-        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	FGuid GraphGuid;
+	if (!FGuid::Parse(FunctionGuid, GraphGuid))
+	{
+		OutError = TEXT("Invalid function GUID");
+		return nullptr;
+	}
 
-        TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
-        ResponseObject->SetBoolField(TEXT("success"), true);
-        FString ResultJson;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
-        FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
-        return ResultJson;
-    }
-    else
-    {
-        // Connection failed, provide detailed feedback
-        TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
-        ResponseObject->SetBoolField(TEXT("success"), false);
-        ResponseObject->SetStringField(TEXT("error"), TEXT("Failed to connect pins - type mismatch or invalid connection"));
-
-        TSharedPtr<FJsonObject> SourcePinInfo = MakeShareable(new FJsonObject);
-        SourcePinInfo->SetStringField(TEXT("name"), SourcePin->PinName.ToString());
-        SourcePinInfo->SetStringField(TEXT("type"), SourcePin->PinType.PinCategory.ToString());
-        if (SourcePin->PinType.PinSubCategory != NAME_None)
-            SourcePinInfo->SetStringField(TEXT("subtype"), SourcePin->PinType.PinSubCategory.ToString());
-
-        TSharedPtr<FJsonObject> TargetPinInfo = MakeShareable(new FJsonObject);
-        TargetPinInfo->SetStringField(TEXT("name"), TargetPin->PinName.ToString());
-        TargetPinInfo->SetStringField(TEXT("type"), TargetPin->PinType.PinCategory.ToString());
-        if (TargetPin->PinType.PinSubCategory != NAME_None)
-            TargetPinInfo->SetStringField(TEXT("subtype"), TargetPin->PinType.PinSubCategory.ToString());
-
-        ResponseObject->SetObjectField(TEXT("source_pin"), SourcePinInfo);
-        ResponseObject->SetObjectField(TEXT("target_pin"), TargetPinInfo);
-
-        FString ResultJson;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
-        FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
-        return ResultJson;
-    }
+	if (UEdGraph* Graph = FGenBlueprintCache::Get().FindGraph(Blueprint, GraphGuid)) return Graph;
+
+	OutError = TEXT("Could not find function graph");
+	return nullptr;
 }
 
 bool UGenBlueprintUtils::CompileBlueprint(const FString& BlueprintPath)
 {
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	UBlueprint* Blueprint = FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
 	if (!Blueprint) return false;
     
 	// Validate pin connections before compiling
@@ -674,13 +692,61 @@ bool UGenBlueprintUtils::CompileBlueprint(const FString& BlueprintPath)
 		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 	}
     
-	// Now compile
+	// Now compile, along with the pending edits it depends on
+	FGenCompileScheduler::Get().RequestCompile(Blueprint);
+	FGenCompileScheduler::Get().Flush(Blueprint);
 	UE_LOG(LogTemp, Log, TEXT("Compiled blueprint: %s"), *BlueprintPath);
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
     
 	return true;
 }
 
+FString UGenBlueprintUtils::FlushPendingCompiles()
+{
+	const TArray<UBlueprint*> Compiled = FGenCompileScheduler::Get().FlushAll();
+
+	TArray<TSharedPtr<FJsonValue>> BlueprintsArray;
+	for (UBlueprint* Blueprint : Compiled)
+	{
+		TArray<TSharedPtr<FJsonValue>> ErrorsArray;
+		TArray<TSharedPtr<FJsonValue>> WarningsArray;
+
+		// The compiler leaves its messages on the nodes it reported them for
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+		for (const UEdGraph* Graph : Graphs)
+		{
+			for (const UEdGraphNode* Node : Graph->Nodes)
+			{
+				if (!Node || !Node->bHasCompilerMessage)
+				{
+					continue;
+				}
+
+				TSharedPtr<FJsonObject> MessageObject = MakeShared<FJsonObject>();
+				MessageObject->SetStringField(TEXT("graph"), Graph->GetName());
+				MessageObject->SetStringField(TEXT("node_guid"), Node->NodeGuid.ToString());
+				MessageObject->SetStringField(TEXT("node_title"), Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+				MessageObject->SetStringField(TEXT("message"), Node->ErrorMsg);
+				(Node->ErrorType <= EMessageSeverity::Error ? ErrorsArray : WarningsArray).Add(MakeShared<FJsonValueObject>(MessageObject));
+			}
+		}
+
+		TSharedPtr<FJsonObject> BlueprintObject = MakeShared<FJsonObject>();
+		BlueprintObject->SetStringField(TEXT("path"), Blueprint->GetPathName());
+		BlueprintObject->SetStringField(TEXT("status"), Blueprint->Status == BS_Error ? TEXT("error")
+			: Blueprint->Status == BS_UpToDateWithWarnings ? TEXT("warnings") : TEXT("ok"));
+		BlueprintObject->SetArrayField(TEXT("errors"), ErrorsArray);
+		BlueprintObject->SetArrayField(TEXT("warnings"), WarningsArray);
+		BlueprintsArray.Add(MakeShared<FJsonValueObject>(BlueprintObject));
+	}
+
+	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+	ResponseObject->SetBoolField(TEXT("success"), true);
+	ResponseObject->SetNumberField(TEXT("compiled"), Compiled.Num());
+	ResponseObject->SetArrayField(TEXT("blueprints"), BlueprintsArray);
+	return GenBlueprintUtils::Serialize(ResponseObject);
+}
+
 AActor* UGenBlueprintUtils::SpawnBlueprint(const FString& BlueprintPath, const FVector& Location,
                                            const FRotator& Rotation, const FVector& Scale,
                                            const FString& ActorLabel)
@@ -694,6 +760,7 @@ AActor* UGenBlueprintUtils::SpawnBlueprint(const FString& BlueprintPath, const F
 	}
 
 	// Make sure the blueprint has been compiled
+	FGenCompileScheduler::Get().Flush(Blueprint);
 	if (!Blueprint->GeneratedClass)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Blueprint has not been compiled"));
@@ -732,7 +799,7 @@ AActor* UGenBlueprintUtils::SpawnBlueprint(const FString& BlueprintPath, const F
 // Helper functions
 UBlueprint* UGenBlueprintUtils::LoadBlueprintAsset(const FString& BlueprintPath)
 {
-	return LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	return FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
 }
 
 UClass* UGenBlueprintUtils::FindClassByName(const FString& ClassName)
@@ -778,6 +845,14 @@ FString UGenBlueprintUtils::ConnectNodesBulk(const FString& BlueprintPath, const
        return TEXT("{\"success\": false, \"error\": \"Could not load blueprint\"}");
     }
 
+    FString GraphError;
+    UEdGraph* FunctionGraph = FindGraph(Blueprint, FunctionGuid, GraphError);
+    if (!FunctionGraph)
+    {
+       UE_LOG(LogTemp, Error, TEXT("%s: %s"), *GraphError, *FunctionGuid);
+       return GenBlueprintUtils::Serialize(GenBlueprintUtils::MakeError(GraphError));
+    }
+
     // Parse the connections array from JSON
     TArray<TSharedPtr<FJsonValue>> ConnectionsArray;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ConnectionsJson);
@@ -788,8 +863,31 @@ FString UGenBlueprintUtils::ConnectNodesBulk(const FString& BlueprintPath, const
        return TEXT("{\"success\": false, \"error\": \"Failed to parse connections JSON\"}");
     }
 
+    // Every node is indexed once, the pins of a node only when a connection first touches it
+    TMap<FGuid, UK2Node*> NodesByGuid;
+    NodesByGuid.Reserve(FunctionGraph->Nodes.Num());
+    for (UEdGraphNode* Node : FunctionGraph->Nodes)
+    {
+       if (UK2Node* K2Node = Cast<UK2Node>(Node))
+       {
+           NodesByGuid.Add(K2Node->NodeGuid, K2Node);
+       }
+    }
+    TMap<UK2Node*, GenBlueprintUtils::FNodePins> PinsByNode;
+    auto FindNodePins = [&PinsByNode](UK2Node* Node) -> const GenBlueprintUtils::FNodePins&
+    {
+       if (const GenBlueprintUtils::FNodePins* Pins = PinsByNode.Find(Node))
+       {
+           return *Pins;
+       }
+       return PinsByNode.Add(Node, GenBlueprintUtils::FNodePins(Node));
+    };
+
+    const FScopedTransaction Transaction(NSLOCTEXT("GenBlueprintUtils", "ConnectNodesBulk", "Connect Nodes"));
+
     // Create a response array to track all connection results
     TArray<TSharedPtr<FJsonValue>> ResultsArray;
+    ResultsArray.Reserve(ConnectionsArray.Num());
     int SuccessfulConnections = 0;
     bool HasErrors = false;
 
@@ -804,47 +902,51 @@ FString UGenBlueprintUtils::ConnectNodesBulk(const FString& BlueprintPath, const
        FString TargetNodeGuid = ConnectionObject->GetStringField(TEXT("target_node_id"));
        FString TargetPinName = ConnectionObject->GetStringField(TEXT("target_pin"));
 
-       // Connect the nodes - UNCOMMENTED THIS!
-       FString ConnectionResult = ConnectNodes(BlueprintPath, FunctionGuid, SourceNodeGuid, SourcePinName, 
-                                          TargetNodeGuid, TargetPinName);
-
-       // Parse the result
        TSharedPtr<FJsonObject> ResultObject;
-       TSharedRef<TJsonReader<>> ResultReader = TJsonReaderFactory<>::Create(ConnectionResult);
-       
-       if (FJsonSerializer::Deserialize(ResultReader, ResultObject) && ResultObject.IsValid())
+       bool bSuccess = false;
+       FGuid SourceGuid, TargetGuid;
+       if (!FGuid::Parse(SourceNodeGuid, SourceGuid) || !FGuid::Parse(TargetNodeGuid, TargetGuid))
+       {
+           ResultObject = GenBlueprintUtils::MakeError(TEXT("Invalid node GUID"));
+       }
+       else
        {
-           // Add connection index and source/target identifiers
-           ResultObject->SetNumberField(TEXT("connection_index"), i);
-           ResultObject->SetStringField(TEXT("source_node"), SourceNodeGuid);
-           ResultObject->SetStringField(TEXT("target_node"), TargetNodeGuid);
-           
-           // Check if successful
-           bool bSuccess = false;
-           if (ResultObject->TryGetBoolField(TEXT("success"), bSuccess) && bSuccess)
+           UK2Node* const* SourceNode = NodesByGuid.Find(SourceGuid);
+           UK2Node* const* TargetNode = NodesByGuid.Find(TargetGuid);
+           if (!SourceNode || !TargetNode)
            {
-               SuccessfulConnections++;
+               ResultObject = GenBlueprintUtils::MakeError(TEXT("Could not find source or target node"));
            }
            else
            {
-               HasErrors = true;
+               UEdGraphPin* SourcePin = FindNodePins(*SourceNode).Outputs.FindRef(FName(*SourcePinName));
+               UEdGraphPin* TargetPin = FindNodePins(*TargetNode).Inputs.FindRef(FName(*TargetPinName));
+               ResultObject = GenBlueprintUtils::LinkPins(*SourceNode, SourcePin, SourcePinName,
+                                                          *TargetNode, TargetPin, TargetPinName, bSuccess);
            }
-           
-           ResultsArray.Add(MakeShareable(new FJsonValueObject(ResultObject)));
+       }
+
+       // Add connection index and source/target identifiers
+       ResultObject->SetNumberField(TEXT("connection_index"), i);
+       ResultObject->SetStringField(TEXT("source_node"), SourceNodeGuid);
+       ResultObject->SetStringField(TEXT("target_node"), TargetNodeGuid);
+
+       if (bSuccess)
+       {
+           SuccessfulConnections++;
        }
        else
        {
-           // Couldn't parse result, create error object
-           TSharedPtr<FJsonObject> ErrorObject = MakeShareable(new FJsonObject);
-           ErrorObject->SetBoolField(TEXT("success"), false);
-           ErrorObject->SetStringField(TEXT("error"), TEXT("Failed to parse connection result"));
-           ErrorObject->SetNumberField(TEXT("connection_index"), i);
-           ErrorObject->SetStringField(TEXT("source_node"), SourceNodeGuid);
-           ErrorObject->SetStringField(TEXT("target_node"), TargetNodeGuid);
-           
-           ResultsArray.Add(MakeShareable(new FJsonValueObject(ErrorObject)));
            HasErrors = true;
        }
+       ResultsArray.Add(MakeShareable(new FJsonValueObject(ResultObject)));
+    }
+
+    // The blueprint is marked modified once for the whole batch
+    if (SuccessfulConnections > 0)
+    {
+       Blueprint->Modify();
+       FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
     }
 
     // Create the final response
@@ -854,14 +956,10 @@ FString UGenBlueprintUtils::ConnectNodesBulk(const FString& BlueprintPath, const
     ResponseObject->SetNumberField(TEXT("successful_connections"), SuccessfulConnections);
     ResponseObject->SetArrayField(TEXT("results"), ResultsArray);
 
-    FString ResultJson;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
-    FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
-
     UE_LOG(LogTemp, Log, TEXT("Connected %d/%d node pairs in blueprint %s"), 
           SuccessfulConnections, ConnectionsArray.Num(), *BlueprintPath);
     
-    return ResultJson;
+    return GenBlueprintUtils::Serialize(ResponseObject.ToSharedRef());
 }
 
 bool UGenBlueprintUtils::OpenBlueprintGraph(UBlueprint* Blueprint, UEdGraph* Graph)
@@ -1073,7 +1171,7 @@ FString UGenBlueprintUtils::GetNodeGUID(const FString& BlueprintPath, const FStr
 FString UGenBlueprintUtils::AddComponentWithEvents(const FString& BlueprintPath, const FString& ComponentName, const FString& ComponentClassName)
 {
     // Load the Blueprint
-    UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+    UBlueprint* Blueprint = FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
     if (!Blueprint)
     {
         UE_LOG(LogTemp, Error, TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
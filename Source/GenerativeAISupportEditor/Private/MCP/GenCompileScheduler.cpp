@@ -0,0 +1,221 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "MCP/GenCompileScheduler.h"
+
+#include "BlueprintCompilationManager.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "GenerativeAISupportSettings.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+FGenCompileScheduler* FGenCompileScheduler::Singleton = nullptr;
+
+FGenCompileScheduler& FGenCompileScheduler::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenCompileScheduler();
+	}
+	return *Singleton;
+}
+
+void FGenCompileScheduler::Initialize()
+{
+	// The editor would otherwise compile the stale Blueprints one by one when play starts
+	PreBeginPIEHandle = FEditorDelegates::PreBeginPIE.AddLambda([this](bool)
+	{
+		FlushAll();
+	});
+
+	// Compiling is still safe before the editor starts tearing down, later the queue can only be dropped
+	EditorPreExitHandle = FEditorDelegates::OnEditorPreExit.AddLambda([this]()
+	{
+		FlushAll();
+	});
+}
+
+void FGenCompileScheduler::Shutdown()
+{
+	FEditorDelegates::PreBeginPIE.Remove(PreBeginPIEHandle);
+	PreBeginPIEHandle.Reset();
+	FEditorDelegates::OnEditorPreExit.Remove(EditorPreExitHandle);
+	EditorPreExitHandle.Reset();
+
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	// Compiling while the editor exits is unsafe. Saving an uncompiled Blueprint would persist a state the
+	// compiler never checked, so what is left is dropped and stays dirty for the editor's own save prompt
+	if (!IsEngineExitRequested())
+	{
+		FlushAll();
+	}
+	else
+	{
+		for (const FPendingCompile& Compile : Pending)
+		{
+			if (const UBlueprint* Blueprint = Compile.Blueprint.Get())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Dropped the queued compile of %s on exit"), *Blueprint->GetName());
+			}
+		}
+	}
+	Pending.Reset();
+}
+
+void FGenCompileScheduler::RequestCompile(UBlueprint* Blueprint, bool bSaveAfterCompile)
+{
+	check(IsInGameThread());
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	FPendingCompile* Existing = Pending.FindByPredicate([Blueprint](const FPendingCompile& Compile)
+	{
+		return Compile.Blueprint.Get() == Blueprint;
+	});
+	if (Existing)
+	{
+		Existing->bSave |= bSaveAfterCompile;
+	}
+	else
+	{
+		Pending.Add({ Blueprint, bSaveAfterCompile });
+	}
+
+	LastRequestTime = FPlatformTime::Seconds();
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FGenCompileScheduler::Tick), 0.1f);
+	}
+}
+
+bool FGenCompileScheduler::Flush(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	// The Blueprint's parents and the Blueprints it references have to be compiled along with it
+	TSet<TWeakObjectPtr<UBlueprint>> Dependencies;
+	TSet<TWeakObjectPtr<UStruct>> StructDependencies;
+	FBlueprintEditorUtils::GatherDependencies(Blueprint, Dependencies, StructDependencies);
+	for (UClass* ParentClass = Blueprint->ParentClass; ParentClass; ParentClass = ParentClass->GetSuperClass())
+	{
+		if (UBlueprint* ParentBlueprint = UBlueprint::GetBlueprintFromClass(ParentClass))
+		{
+			Dependencies.Add(ParentBlueprint);
+		}
+	}
+
+	TArray<FPendingCompile> Batch;
+	for (int32 Index = Pending.Num() - 1; Index >= 0; --Index)
+	{
+		const UBlueprint* PendingBlueprint = Pending[Index].Blueprint.Get();
+		if (PendingBlueprint == Blueprint || Dependencies.Contains(Pending[Index].Blueprint))
+		{
+			Batch.Add(Pending[Index]);
+			Pending.RemoveAtSwap(Index);
+		}
+	}
+
+	if (Batch.Num() > 0)
+	{
+		CompileBatch(MoveTemp(Batch));
+	}
+	return Blueprint->Status != BS_Error;
+}
+
+TArray<UBlueprint*> FGenCompileScheduler::FlushAll()
+{
+	check(IsInGameThread());
+	TArray<UBlueprint*> Compiled;
+	if (Pending.Num() > 0)
+	{
+		Compiled = CompileBatch(MoveTemp(Pending));
+		Pending.Reset();
+	}
+	return Compiled;
+}
+
+bool FGenCompileScheduler::IsPending(const UBlueprint* Blueprint) const
+{
+	return Pending.ContainsByPredicate([Blueprint](const FPendingCompile& Compile)
+	{
+		return Compile.Blueprint.Get() == Blueprint;
+	});
+}
+
+bool FGenCompileScheduler::Tick(float DeltaTime)
+{
+	// Wait until the commands stop coming, an agent usually sends several edits to the same Blueprint
+	const double IdleDelay = GetDefault<UGenerativeAISupportSettings>()->CompileIdleDelaySeconds;
+	if (Pending.Num() > 0 && FPlatformTime::Seconds() - LastRequestTime < IdleDelay)
+	{
+		return true;
+	}
+
+	TickHandle.Reset();
+	FlushAll();
+	return false;
+}
+
+TArray<UBlueprint*> FGenCompileScheduler::CompileBatch(TArray<FPendingCompile>&& Batch)
+{
+	TArray<UBlueprint*> Queued;
+	for (const FPendingCompile& Compile : Batch)
+	{
+		if (UBlueprint* Blueprint = Compile.Blueprint.Get())
+		{
+			FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+			Queued.Add(Blueprint);
+		}
+	}
+	if (Queued.Num() == 0)
+	{
+		return Queued;
+	}
+
+	// One flush compiles the whole batch, the manager orders it by dependencies and reinstances once
+	FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+	UE_LOG(LogTemp, Log, TEXT("Compiled %d Blueprints"), Queued.Num());
+
+	for (const FPendingCompile& Compile : Batch)
+	{
+		UBlueprint* Blueprint = Compile.Blueprint.Get();
+		if (Blueprint && Compile.bSave)
+		{
+			SaveBlueprint(Blueprint);
+		}
+	}
+	return Queued;
+}
+
+bool FGenCompileScheduler::SaveBlueprint(UBlueprint* Blueprint)
+{
+	UPackage* Package = Blueprint->GetOutermost();
+	const FString PackageFileName = FPackageName::LongPackageNameToFilename(
+		Package->GetName(), FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError; // Suppress success dialogs
+	if (!UPackage::SavePackage(Package, Blueprint, *PackageFileName, SaveArgs))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to save Blueprint: %s"), *Blueprint->GetName());
+		return false;
+	}
+	return true;
+}
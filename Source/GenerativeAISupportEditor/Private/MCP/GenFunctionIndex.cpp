@@ -0,0 +1,637 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "MCP/GenFunctionIndex.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Engine/Engine.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Misc/PackageName.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+FGenFunctionIndex* FGenFunctionIndex::Singleton = nullptr;
+
+namespace GenFunctionIndex
+{
+	// The libraries node resolution searched before the index existed, they win ties
+	static const TCHAR* PreferredClasses[] = {
+		TEXT("KismetMathLibrary"), TEXT("KismetSystemLibrary"), TEXT("KismetStringLibrary"),
+		TEXT("KismetArrayLibrary"), TEXT("KismetTextLibrary"), TEXT("GameplayStatics"),
+		TEXT("Actor"), TEXT("Pawn"), TEXT("Character")
+	};
+
+	/** Lower case letters and digits only, so "Print String", "print_string" and "PrintString" compare equal */
+	static FString MakeKey(const FString& Name)
+	{
+		FString Key;
+		Key.Reserve(Name.Len());
+		for (const TCHAR Char : Name)
+		{
+			if (FChar::IsAlnum(Char)) Key.AppendChar(FChar::ToLower(Char));
+		}
+		return Key;
+	}
+
+	/** Splits at separators, case changes and digits, "GetHTTPResponse_V2" gives get, http, response, v, 2 */
+	static void SplitWords(const FString& Name, TArray<FString>& OutWords)
+	{
+		FString Word;
+		auto Flush = [&Word, &OutWords]()
+		{
+			if (!Word.IsEmpty()) OutWords.AddUnique(Word.ToLower());
+			Word.Reset();
+		};
+
+		for (int32 Index = 0; Index < Name.Len(); ++Index)
+		{
+			const TCHAR Char = Name[Index];
+			if (!FChar::IsAlnum(Char))
+			{
+				Flush();
+				continue;
+			}
+			if (!Word.IsEmpty())
+			{
+				const TCHAR Previous = Name[Index - 1];
+				const bool bNextIsLower = Index + 1 < Name.Len() && FChar::IsLower(Name[Index + 1]);
+				const bool bStartsWord = FChar::IsUpper(Char) && (FChar::IsLower(Previous) || FChar::IsDigit(Previous)
+					|| (FChar::IsUpper(Previous) && bNextIsLower));
+				if (bStartsWord || FChar::IsDigit(Char) != FChar::IsDigit(Previous)) Flush();
+			}
+			Word.AppendChar(Char);
+		}
+		Flush();
+	}
+
+	static void GetTrigrams(const FString& Key, TArray<uint64>& OutTrigrams)
+	{
+		for (int32 Index = 0; Index + 2 < Key.Len(); ++Index)
+		{
+			OutTrigrams.AddUnique(static_cast<uint64>(Key[Index]) << 42 | static_cast<uint64>(Key[Index + 1]) << 21
+				| static_cast<uint64>(Key[Index + 2]));
+		}
+	}
+}
+
+FString FGenFunctionMatch::GetDisplayName() const
+{
+	return FString::Printf(TEXT("%s.%s"), *ClassName, *FunctionName.ToString());
+}
+
+UFunction* FGenFunctionMatch::Resolve() const
+{
+	const UClass* Class = FindObject<UClass>(nullptr, *ClassPath);
+	return Class ? Class->FindFunctionByName(FunctionName) : nullptr;
+}
+
+FGenFunctionIndex& FGenFunctionIndex::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenFunctionIndex();
+	}
+	return *Singleton;
+}
+
+void FGenFunctionIndex::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FGenFunctionIndex::OnModulesChanged);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FGenFunctionIndex::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FGenFunctionIndex::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FGenFunctionIndex::OnAssetRenamed);
+
+	// Most modules are loaded by then, the ones loaded later are indexed as they come
+	if (GEngine && GEngine->IsInitialized())
+	{
+		BuildAll();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FGenFunctionIndex::BuildAll);
+	}
+}
+
+void FGenFunctionIndex::Shutdown()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	if (FModuleManager::Get().OnModulesChanged().IsBound())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	}
+	PostEngineInitHandle.Reset();
+	ModulesChangedHandle.Reset();
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+		AssetRegistryModule->Get().OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistryModule->Get().OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistryModule->Get().OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+	FilesLoadedHandle.Reset();
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+
+	if (PendingLibrariesHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingLibrariesHandle);
+		PendingLibrariesHandle.Reset();
+	}
+	PendingLibraries.Reset();
+	for (const TPair<FString, TWeakObjectPtr<UBlueprint>>& Library : Libraries)
+	{
+		if (UBlueprint* Blueprint = Library.Value.Get())
+		{
+			Blueprint->OnCompiled().RemoveAll(this);
+		}
+	}
+	Libraries.Reset();
+
+	LastBuild.Wait();
+	bInitialized = false;
+}
+
+TArray<FGenFunctionMatch> FGenFunctionIndex::Find(const FString& Query, int32 MaxResults)
+{
+	TArray<FGenFunctionMatch> Matches;
+	const TSharedPtr<const FSnapshot, ESPMode::ThreadSafe> Current = GetSnapshot();
+	if (!Current.IsValid())
+	{
+		return Matches;
+	}
+
+	// Suggestions are reported as Class.Function, accept them back as a query
+	FString ClassKey;
+	FString NameQuery = Query;
+	FString Left, Right;
+	if (Query.Split(TEXT("."), &Left, &Right, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+	{
+		ClassKey = GenFunctionIndex::MakeKey(Left);
+		NameQuery = Right;
+	}
+
+	const FString Key = GenFunctionIndex::MakeKey(NameQuery);
+	if (Key.IsEmpty())
+	{
+		return Matches;
+	}
+	TArray<FString> Words;
+	GenFunctionIndex::SplitWords(NameQuery, Words);
+	TArray<uint64> Trigrams;
+	GenFunctionIndex::GetTrigrams(Key, Trigrams);
+
+	TArray<TSharedRef<const FSegment, ESPMode::ThreadSafe>> Segments = Current->Segments;
+	for (const TPair<FString, TSharedRef<const FSegment, ESPMode::ThreadSafe>>& Library : Current->LibrarySegments)
+	{
+		Segments.Add(Library.Value);
+	}
+
+	for (const TSharedRef<const FSegment, ESPMode::ThreadSafe>& Segment : Segments)
+	{
+		TMap<int32, int32> TrigramHits;
+		for (const uint64 Trigram : Trigrams)
+		{
+			if (const TArray<int32>* Entries = Segment->EntriesByTrigram.Find(Trigram))
+			{
+				for (const int32 EntryIndex : *Entries)
+				{
+					++TrigramHits.FindOrAdd(EntryIndex);
+				}
+			}
+		}
+
+		// Only functions sharing the name, a word or half the trigrams with the query are scored
+		TSet<int32> Candidates;
+		if (const TArray<int32>* Entries = Segment->EntriesByName.Find(Key))
+		{
+			Candidates.Append(*Entries);
+		}
+		for (const FString& Word : Words)
+		{
+			if (const TArray<int32>* Entries = Segment->EntriesByWord.Find(Word))
+			{
+				Candidates.Append(*Entries);
+			}
+		}
+		for (const TPair<int32, int32>& Hits : TrigramHits)
+		{
+			if (Hits.Value * 2 >= Trigrams.Num())
+			{
+				Candidates.Add(Hits.Key);
+			}
+		}
+
+		for (const int32 EntryIndex : Candidates)
+		{
+			const FEntry& Entry = Segment->Entries[EntryIndex];
+			if (!ClassKey.IsEmpty() && ClassKey != Entry.ClassLower && ClassKey != TEXT("u") + Entry.ClassLower
+				&& ClassKey != TEXT("a") + Entry.ClassLower)
+			{
+				continue;
+			}
+
+			// Same scale as the old library search, the auto-create threshold applies to this part only
+			int32 NameScore = 0;
+			if (Entry.NameLower == Key) NameScore = 120;
+			else if (Entry.NameLower.Contains(Key)) NameScore = 80;
+
+			for (const FString& Word : Words)
+			{
+				if (Entry.Words.Contains(Word)) NameScore += 20;
+			}
+			if (Entry.NameLower.StartsWith(Key)) NameScore += 10;
+			if (Entry.NameLower.Len() > Key.Len() * 2) NameScore -= 15;
+
+			// Trigram overlap ranks misspelled and reordered names
+			int32 Score = NameScore;
+			if (Trigrams.Num() > 0)
+			{
+				const int32 EntryTrigrams = FMath::Max(Entry.NameLower.Len() - 2, 1);
+				Score += 60 * TrigramHits.FindRef(EntryIndex) / (Trigrams.Num() + EntryTrigrams);
+			}
+			if (Score <= 0)
+			{
+				continue;
+			}
+
+			// Static functions can be placed in any graph
+			if (Entry.bStatic) Score += 3;
+			bool bPreferredClass = false;
+			for (const TCHAR* PreferredClass : GenFunctionIndex::PreferredClasses)
+			{
+				if (Entry.ClassName == PreferredClass)
+				{
+					bPreferredClass = true;
+					Score += 5;
+					break;
+				}
+			}
+
+			FGenFunctionMatch& Match = Matches.AddDefaulted_GetRef();
+			Match.ClassPath = Entry.ClassPath;
+			Match.ClassName = Entry.ClassName;
+			Match.FunctionName = Entry.FunctionName;
+			Match.Score = Score;
+			Match.NameScore = NameScore;
+			Match.bPreferredClass = bPreferredClass;
+		}
+	}
+
+	Matches.Sort([](const FGenFunctionMatch& A, const FGenFunctionMatch& B)
+	{
+		if (A.Score != B.Score) return A.Score > B.Score;
+		const int32 LengthA = A.FunctionName.GetStringLength();
+		const int32 LengthB = B.FunctionName.GetStringLength();
+		if (LengthA != LengthB) return LengthA < LengthB;
+		return A.GetDisplayName() < B.GetDisplayName();
+	});
+	if (Matches.Num() > MaxResults)
+	{
+		Matches.SetNum(MaxResults);
+	}
+	return Matches;
+}
+
+int32 FGenFunctionIndex::Num()
+{
+	const TSharedPtr<const FSnapshot, ESPMode::ThreadSafe> Current = GetSnapshot();
+	return Current.IsValid() ? Current->NumEntries : 0;
+}
+
+void FGenFunctionIndex::BuildAll()
+{
+	if (bBuildStarted)
+	{
+		return;
+	}
+	bBuildStarted = true;
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	PostEngineInitHandle.Reset();
+
+	// Reading reflection data is only safe on the game thread, the words and lists are built on a worker
+	TArray<FEntry> Entries;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		CollectClass(*It, Entries);
+	}
+	UE_LOG(LogTemp, Log, TEXT("Indexing %d Blueprint callable functions"), Entries.Num());
+	QueueBuild(MoveTemp(Entries));
+
+	IndexLibraries();
+}
+
+void FGenFunctionIndex::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	// Before the first build the new module is covered by it
+	if (Reason != EModuleChangeReason::ModuleLoaded || !bBuildStarted)
+	{
+		return;
+	}
+
+	const UPackage* Package = FindPackage(nullptr, *(TEXT("/Script/") + ModuleName.ToString()));
+	if (!Package)
+	{
+		return;
+	}
+
+	TArray<FEntry> Entries;
+	ForEachObjectWithPackage(Package, [this, &Entries](UObject* Object)
+	{
+		if (const UClass* Class = Cast<UClass>(Object))
+		{
+			CollectClass(Class, Entries);
+		}
+		return true;
+	}, false);
+
+	if (Entries.Num() > 0)
+	{
+		QueueBuild(MoveTemp(Entries));
+	}
+}
+
+void FGenFunctionIndex::QueueBuild(TArray<FEntry>&& NewEntries, const FString& LibraryPath)
+{
+	// Builds run one after another, each adds a segment to the snapshot the previous one published
+	auto Build = [this, NewEntries = MoveTemp(NewEntries), LibraryPath]() mutable
+	{
+		const TSharedRef<FSegment, ESPMode::ThreadSafe> Segment = MakeShared<FSegment, ESPMode::ThreadSafe>();
+		Segment->Entries.Reserve(NewEntries.Num());
+
+		TArray<uint64> Trigrams;
+		for (FEntry& Entry : NewEntries)
+		{
+			const FString FunctionName = Entry.FunctionName.ToString();
+			Entry.NameLower = GenFunctionIndex::MakeKey(FunctionName);
+			Entry.ClassLower = GenFunctionIndex::MakeKey(Entry.ClassName);
+			GenFunctionIndex::SplitWords(FunctionName, Entry.Words);
+
+			const int32 EntryIndex = Segment->Entries.Add(MoveTemp(Entry));
+			const FEntry& Added = Segment->Entries[EntryIndex];
+			Segment->EntriesByName.FindOrAdd(Added.NameLower).Add(EntryIndex);
+			for (const FString& Word : Added.Words)
+			{
+				Segment->EntriesByWord.FindOrAdd(Word).Add(EntryIndex);
+			}
+
+			Trigrams.Reset();
+			GenFunctionIndex::GetTrigrams(Added.NameLower, Trigrams);
+			for (const uint64 Trigram : Trigrams)
+			{
+				Segment->EntriesByTrigram.FindOrAdd(Trigram).Add(EntryIndex);
+			}
+		}
+
+		// Only the segment list is copied, the earlier segments are shared with the previous snapshot
+		const TSharedRef<FSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FSnapshot, ESPMode::ThreadSafe>();
+		FScopeLock Lock(&SnapshotLock);
+		if (Snapshot.IsValid())
+		{
+			*NewSnapshot = *Snapshot;
+		}
+		if (LibraryPath.IsEmpty())
+		{
+			NewSnapshot->Segments.Add(Segment);
+		}
+		else
+		{
+			TSharedPtr<const FSegment, ESPMode::ThreadSafe> Replaced;
+			NewSnapshot->LibrarySegments.RemoveAndCopyValue(LibraryPath, Replaced);
+			if (Replaced.IsValid())
+			{
+				NewSnapshot->NumEntries -= Replaced->Entries.Num();
+			}
+			if (Segment->Entries.Num() > 0)
+			{
+				NewSnapshot->LibrarySegments.Add(LibraryPath, Segment);
+			}
+		}
+		NewSnapshot->NumEntries += Segment->Entries.Num();
+		Snapshot = NewSnapshot;
+	};
+	LastBuild = LastBuild.IsValid()
+		? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Build), UE::Tasks::Prerequisites(LastBuild))
+		: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(Build));
+}
+
+TSharedPtr<const FGenFunctionIndex::FSnapshot, ESPMode::ThreadSafe> FGenFunctionIndex::GetSnapshot()
+{
+	check(IsInGameThread());
+
+	// Lookups before engine init, e.g. from a commandlet, build synchronously
+	if (!bBuildStarted)
+	{
+		Initialize();
+		BuildAll();
+	}
+
+	{
+		FScopeLock Lock(&SnapshotLock);
+		if (Snapshot.IsValid())
+		{
+			return Snapshot;
+		}
+	}
+
+	// Only the first lookup can arrive before anything was published
+	LastBuild.Wait();
+	FScopeLock Lock(&SnapshotLock);
+	return Snapshot;
+}
+
+void FGenFunctionIndex::CollectClass(const UClass* Class, TArray<FEntry>& OutEntries)
+{
+	if (!Class->HasAnyClassFlags(CLASS_Native) || Class->HasAnyClassFlags(CLASS_Deprecated | CLASS_NewerVersionExists))
+	{
+		return;
+	}
+
+	const FString ClassName = Class->GetName();
+	if (ClassName.StartsWith(TEXT("REINST_")) || ClassName.StartsWith(TEXT("HOTRELOADED_")))
+	{
+		return;
+	}
+
+	bool bAlreadyCollected = false;
+	CollectedClasses.Add(Class->GetPathName(), &bAlreadyCollected);
+	if (bAlreadyCollected)
+	{
+		return;
+	}
+
+	CollectFunctions(Class, ClassName, OutEntries);
+}
+
+void FGenFunctionIndex::CollectFunctions(const UClass* Class, const FString& ClassName, TArray<FEntry>& OutEntries)
+{
+	for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		const UFunction* Function = *It;
+		if (!Function->HasAnyFunctionFlags(FUNC_BlueprintCallable | FUNC_BlueprintPure)
+			|| Function->HasAnyFunctionFlags(FUNC_Delegate)
+			|| Function->HasMetaData(TEXT("DeprecatedFunction"))
+			|| Function->HasMetaData(TEXT("BlueprintInternalUseOnly")))
+		{
+			continue;
+		}
+
+		FEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.ClassPath = Class->GetPathName();
+		Entry.ClassName = ClassName;
+		Entry.FunctionName = Function->GetFName();
+		Entry.bStatic = Function->HasAnyFunctionFlags(FUNC_Static);
+	}
+}
+
+void FGenFunctionIndex::IndexLibraries()
+{
+	if (bLibrariesIndexed)
+	{
+		return;
+	}
+
+	// Libraries found by the initial scan are indexed together once it is done
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		if (!FilesLoadedHandle.IsValid())
+		{
+			FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FGenFunctionIndex::IndexLibraries);
+		}
+		return;
+	}
+	AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+	FilesLoadedHandle.Reset();
+	bLibrariesIndexed = true;
+
+	// Their functions are only known from the generated class, so each library is loaded
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), Assets);
+	int32 NumLibraries = 0;
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (IsFunctionLibrary(AssetData))
+		{
+			if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset()))
+			{
+				IndexLibrary(Blueprint);
+				NumLibraries++;
+			}
+		}
+	}
+	UE_LOG(LogTemp, Log, TEXT("Indexing %d Blueprint function libraries"), NumLibraries);
+}
+
+void FGenFunctionIndex::IndexLibrary(UBlueprint* Blueprint)
+{
+	const FString ObjectPath = Blueprint->GetPathName();
+	if (!Libraries.Contains(ObjectPath))
+	{
+		Libraries.Add(ObjectPath, Blueprint);
+		Blueprint->OnCompiled().AddRaw(this, &FGenFunctionIndex::OnLibraryCompiled);
+	}
+
+	// Reported by the asset name, the form the library is known by in the editor
+	TArray<FEntry> Entries;
+	if (const UClass* Class = Blueprint->GeneratedClass)
+	{
+		CollectFunctions(Class, Blueprint->GetName(), Entries);
+	}
+	QueueBuild(MoveTemp(Entries), ObjectPath);
+}
+
+void FGenFunctionIndex::RemoveLibrary(const FString& ObjectPath)
+{
+	PendingLibraries.Remove(ObjectPath);
+
+	TWeakObjectPtr<UBlueprint> Library;
+	if (!Libraries.RemoveAndCopyValue(ObjectPath, Library))
+	{
+		return;
+	}
+	if (UBlueprint* Blueprint = Library.Get())
+	{
+		Blueprint->OnCompiled().RemoveAll(this);
+	}
+	QueueBuild(TArray<FEntry>(), ObjectPath);
+}
+
+void FGenFunctionIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	// Before the initial scan is done every asset is reported, those are covered by IndexLibraries
+	if (!bLibrariesIndexed || !IsFunctionLibrary(AssetData))
+	{
+		return;
+	}
+
+	PendingLibraries.Add(AssetData.GetObjectPathString());
+	if (!PendingLibrariesHandle.IsValid())
+	{
+		PendingLibrariesHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FGenFunctionIndex::IndexPendingLibraries));
+	}
+}
+
+void FGenFunctionIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	RemoveLibrary(AssetData.GetObjectPathString());
+}
+
+void FGenFunctionIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	RemoveLibrary(OldObjectPath);
+	OnAssetAdded(AssetData);
+}
+
+void FGenFunctionIndex::OnLibraryCompiled(UBlueprint* Blueprint)
+{
+	// Functions added, renamed or removed in the library only show in its generated class after a compile
+	if (Blueprint && Libraries.Contains(Blueprint->GetPathName()))
+	{
+		IndexLibrary(Blueprint);
+	}
+}
+
+bool FGenFunctionIndex::IndexPendingLibraries(float DeltaTime)
+{
+	PendingLibrariesHandle.Reset();
+	const TSet<FString> Paths = MoveTemp(PendingLibraries);
+	PendingLibraries.Reset();
+
+	for (const FString& ObjectPath : Paths)
+	{
+		if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *ObjectPath))
+		{
+			IndexLibrary(Blueprint);
+		}
+	}
+	return false;
+}
+
+bool FGenFunctionIndex::IsFunctionLibrary(const FAssetData& AssetData)
+{
+	// The parent is read from the tags, so assets that are not libraries are never loaded
+	FString ParentClassPath;
+	if (!AssetData.GetTagValue(FBlueprintTags::ParentClassPath, ParentClassPath))
+	{
+		return false;
+	}
+	const UClass* ParentClass = FindObject<UClass>(nullptr, *FPackageName::ExportTextPathToObjectPath(ParentClassPath));
+	return ParentClass && ParentClass->IsChildOf(UBlueprintFunctionLibrary::StaticClass());
+}
@@ -2,6 +2,9 @@
 
 
 #include "MCP/GenObjectProperties.h"
+#include "MCP/GenActorIndex.h"
+#include "MCP/GenBlueprintCache.h"
+#include "MCP/GenSceneJournal.h"
 
 #include "EngineUtils.h"
 #include "K2Node_Event.h"
@@ -24,61 +27,32 @@ FString UGenObjectProperties::EditComponentProperty(const FString& BlueprintPath
 		UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 		if (!World) return TEXT("{\"success\": false, \"error\": \"No editor world found\"}");
 		
-		// Store available actors for better error messages
-		TArray<FString> AvailableActors;
-		
-		for (TActorIterator<AActor> It(World); It; ++It)
-		{
-			// Add to available actors list for error reporting
-			AvailableActors.Add(It->GetActorLabel());
-			
-			// CHANGE: Use GetActorLabel() instead of GetName()
-			if (It->GetActorLabel() == ActorName)
-			{
-				SceneActor = *It;
-				UE_LOG(LogTemp, Log, TEXT("Found scene actor: %s"), *ActorName);
-				
-				// Get available component names for better error messages
-				TArray<FString> AvailableComponents;
-				
-				for (UActorComponent* Comp : SceneActor->GetComponents())
-				{
-					AvailableComponents.Add(Comp->GetName());
-					if (Comp->GetName() == ComponentName)
-					{
-						TargetObject = Comp;
-						UE_LOG(LogTemp, Log, TEXT("Found component: %s"), *ComponentName);
-						break;
-					}
-				}
-				
-				// If we found the actor but not the component, return detailed error
-				if (SceneActor && !TargetObject) {
-					FString ComponentsList = FString::Join(AvailableComponents, TEXT(", "));
-					return FString::Printf(
-						TEXT("{\"success\": false, \"error\": \"Component '%s' not found on actor '%s'. Available components: ['%s']\"}"),
-						*ComponentName, *ActorName, *ComponentsList);
-				}
-				
-				break;
-			}
-		}
-		
-		// If we didn't find the actor, return detailed error
+		SceneActor = FGenActorIndex::Get().FindActorByLabel(ActorName);
+
+		// The available actors are only listed when the lookup failed
 		if (!SceneActor) {
-			FString ActorsList = FString::Join(AvailableActors, TEXT(", "));
+			FString ActorsList = FString::Join(FGenActorIndex::Get().GetActorLabels(), TEXT(", "));
 			return FString::Printf(
 				TEXT("{\"success\": false, \"error\": \"Scene actor not found: %s. Available actors: %s\"}"),
 				*ActorName, *ActorsList);
 		}
-		
-		// If we didn't find the component, the detailed error is already returned above
-		if (!TargetObject) return TEXT("{\"success\": false, \"error\": \"Scene actor or component not found\"}");
+		UE_LOG(LogTemp, Log, TEXT("Found scene actor: %s"), *ActorName);
+
+		TargetObject = FGenActorIndex::Get().FindComponent(SceneActor, FName(*ComponentName));
+
+		// If we found the actor but not the component, return detailed error
+		if (!TargetObject) {
+			FString ComponentsList = FString::Join(FGenActorIndex::Get().GetComponentNames(SceneActor), TEXT(", "));
+			return FString::Printf(
+				TEXT("{\"success\": false, \"error\": \"Component '%s' not found on actor '%s'. Available components: ['%s']\"}"),
+				*ComponentName, *ActorName, *ComponentsList);
+		}
+		UE_LOG(LogTemp, Log, TEXT("Found component: %s"), *ComponentName);
 	}
 	else
 	{
 		// Blueprint code remains unchanged
-		Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+		Blueprint = FGenBlueprintCache::Get().FindBlueprint(BlueprintPath);
 		if (!Blueprint) return TEXT("{\"success\": false, \"error\": \"Could not load blueprint at path: ") +
 			BlueprintPath + TEXT("\"}");
 		for (USCS_Node* Node : Blueprint->SimpleConstructionScript->GetAllNodes())
@@ -563,3 +537,13 @@ FString UGenObjectProperties::GetAllSceneObjects()
 	FJsonSerializer::Serialize(ActorsArray, Writer);
 	return ResultJson;
 }
+
+FString UGenObjectProperties::GetSceneSnapshot(const FString& QueryJson)
+{
+	return FGenSceneJournal::Get().GetSnapshot(QueryJson);
+}
+
+FString UGenObjectProperties::GetSceneChanges(const FString& SinceVersion, const FString& QueryJson)
+{
+	return FGenSceneJournal::Get().GetChanges(SinceVersion, QueryJson);
+}
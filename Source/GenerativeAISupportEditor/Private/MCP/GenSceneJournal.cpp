@@ -0,0 +1,554 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "MCP/GenSceneJournal.h"
+#include "MCP/GenActorIndex.h"
+
+#include "Algo/BinarySearch.h"
+#include "Components/ActorComponent.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace GenSceneJournal
+{
+	// Older changes are dropped beyond this, clients that fell that far behind take a new snapshot
+	constexpr int32 MaxJournalEntries = 65536;
+	constexpr int32 MaxPageSize = 10000;
+
+	FString Serialize(const TSharedRef<FJsonObject>& Object)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Object, Writer);
+		return Json;
+	}
+
+	FString MakeError(const FString& Error)
+	{
+		TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetBoolField(TEXT("success"), false);
+		Result->SetStringField(TEXT("error"), Error);
+		return Serialize(Result);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> MakeVector(const FVector& Vector)
+	{
+		return {
+			MakeShared<FJsonValueNumber>(Vector.X),
+			MakeShared<FJsonValueNumber>(Vector.Y),
+			MakeShared<FJsonValueNumber>(Vector.Z)
+		};
+	}
+
+	bool ParseVector(const TArray<TSharedPtr<FJsonValue>>* Values, FVector& OutVector)
+	{
+		if (!Values || Values->Num() != 3)
+		{
+			return false;
+		}
+		OutVector = FVector((*Values)[0]->AsNumber(), (*Values)[1]->AsNumber(), (*Values)[2]->AsNumber());
+		return true;
+	}
+}
+
+FGenSceneJournal* FGenSceneJournal::Singleton = nullptr;
+
+FGenSceneJournal& FGenSceneJournal::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenSceneJournal();
+	}
+	return *Singleton;
+}
+
+void FGenSceneJournal::Initialize()
+{
+	SessionId = FGuid::NewGuid();
+
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FGenSceneJournal::OnLevelActorAdded);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FGenSceneJournal::OnLevelActorDeleted);
+		ActorFolderChangedHandle = GEngine->OnLevelActorFolderChanged().AddRaw(this, &FGenSceneJournal::OnLevelActorFolderChanged);
+		ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddLambda([this]()
+		{
+			bResyncPending = true;
+		});
+	}
+	if (GEditor)
+	{
+		ActorMovedHandle = GEditor->OnActorMoved().AddRaw(this, &FGenSceneJournal::RecordActor);
+	}
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FGenSceneJournal::RecordActor);
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FGenSceneJournal::OnObjectPropertyChanged);
+
+	// Neither a new map nor an undo says which actors it touched
+	MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32)
+	{
+		RecordReset();
+	});
+	PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FGenSceneJournal::RecordReset);
+}
+
+void FGenSceneJournal::Shutdown()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnLevelActorFolderChanged().Remove(ActorFolderChangedHandle);
+		GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+	}
+	if (GEditor)
+	{
+		GEditor->OnActorMoved().Remove(ActorMovedHandle);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+	FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+	ActorAddedHandle.Reset();
+	ActorDeletedHandle.Reset();
+	ActorFolderChangedHandle.Reset();
+	ActorListChangedHandle.Reset();
+	ActorMovedHandle.Reset();
+	ActorLabelChangedHandle.Reset();
+	PropertyChangedHandle.Reset();
+	MapChangeHandle.Reset();
+	PostUndoRedoHandle.Reset();
+
+	Changes.Reset();
+	KnownActors.Reset();
+	bKnownActorsValid = false;
+}
+
+FString FGenSceneJournal::GetSnapshot(const FString& QueryJson)
+{
+	check(IsInGameThread());
+
+	FQuery Query;
+	FString Error;
+	if (!Query.Parse(QueryJson, Error))
+	{
+		return GenSceneJournal::MakeError(Error);
+	}
+	if (!GEditor || !GEditor->GetEditorWorldContext().World())
+	{
+		return GenSceneJournal::MakeError(TEXT("No editor world found"));
+	}
+
+	Resync();
+
+	// Pages are ordered by GUID so the cursor stays valid while actors come and go between pages
+	TArray<AActor*> Matches;
+	FGenActorIndex::Get().ForEachActor([&Query, &Matches](AActor* Actor)
+	{
+		const FGuid Guid = Actor->GetActorGuid();
+		if (Guid.IsValid() && (!Query.Cursor.IsValid() || Query.Cursor < Guid) && Query.Matches(Actor))
+		{
+			Matches.Add(Actor);
+		}
+	});
+	Matches.Sort([](const AActor& A, const AActor& B)
+	{
+		return A.GetActorGuid() < B.GetActorGuid();
+	});
+
+	const int32 PageSize = FMath::Min(Matches.Num(), Query.Limit);
+	TArray<TSharedPtr<FJsonValue>> ActorsArray;
+	ActorsArray.Reserve(PageSize);
+	for (int32 Index = 0; Index < PageSize; ++Index)
+	{
+		ActorsArray.Add(MakeShared<FJsonValueObject>(SerializeActor(Matches[Index], Query)));
+	}
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetBoolField(TEXT("success"), true);
+	Result->SetStringField(TEXT("version"), MakeVersionToken(Version));
+	Result->SetArrayField(TEXT("actors"), ActorsArray);
+	if (PageSize < Matches.Num())
+	{
+		Result->SetStringField(TEXT("next_cursor"), Matches[PageSize - 1]->GetActorGuid().ToString());
+	}
+	Result->SetNumberField(TEXT("remaining"), Matches.Num() - PageSize);
+	return GenSceneJournal::Serialize(Result);
+}
+
+FString FGenSceneJournal::GetChanges(const FString& SinceVersion, const FString& QueryJson)
+{
+	check(IsInGameThread());
+
+	FQuery Query;
+	FString Error;
+	if (!Query.Parse(QueryJson, Error))
+	{
+		return GenSceneJournal::MakeError(Error);
+	}
+
+	Resync();
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetBoolField(TEXT("success"), true);
+
+	int64 Since = 0;
+	if (!ParseVersionToken(SinceVersion, Since) || Since < BaseVersion || Since > Version)
+	{
+		Result->SetBoolField(TEXT("reset"), true);
+		Result->SetStringField(TEXT("version"), MakeVersionToken(Version));
+		return GenSceneJournal::Serialize(Result);
+	}
+
+	// Only the current state of an actor is reported, repeated changes to it collapse into one
+	TSet<FGuid> Reported;
+	TArray<TSharedPtr<FJsonValue>> ChangedArray;
+	TArray<TSharedPtr<FJsonValue>> RemovedArray;
+	int64 ReachedVersion = Version;
+	bool bHasMore = false;
+
+	const int32 First = Algo::UpperBoundBy(Changes, Since, &FChange::Version);
+	for (int32 Index = First; Index < Changes.Num(); ++Index)
+	{
+		const FChange& Change = Changes[Index];
+		if (Reported.Contains(Change.ActorGuid))
+		{
+			continue;
+		}
+		if (Reported.Num() >= Query.Limit)
+		{
+			ReachedVersion = Change.Version - 1;
+			bHasMore = true;
+			break;
+		}
+		Reported.Add(Change.ActorGuid);
+
+		// Actors that no longer match the query have left the client's view just like deleted ones
+		AActor* Actor = FGenActorIndex::Get().FindActorByGuid(Change.ActorGuid);
+		if (Actor && Query.Matches(Actor))
+		{
+			ChangedArray.Add(MakeShared<FJsonValueObject>(SerializeActor(Actor, Query)));
+		}
+		else
+		{
+			RemovedArray.Add(MakeShared<FJsonValueString>(Change.ActorGuid.ToString()));
+		}
+	}
+
+	Result->SetBoolField(TEXT("reset"), false);
+	Result->SetStringField(TEXT("version"), MakeVersionToken(ReachedVersion));
+	Result->SetArrayField(TEXT("changed"), ChangedArray);
+	Result->SetArrayField(TEXT("removed"), RemovedArray);
+	Result->SetBoolField(TEXT("has_more"), bHasMore);
+	return GenSceneJournal::Serialize(Result);
+}
+
+void FGenSceneJournal::RecordChange(const FGuid& ActorGuid)
+{
+	if (!ActorGuid.IsValid())
+	{
+		return;
+	}
+
+	// Dragging an actor reports it every frame, consecutive changes of one actor share an entry
+	++Version;
+	if (Changes.Num() > 0 && Changes.Last().ActorGuid == ActorGuid)
+	{
+		Changes.Last().Version = Version;
+		return;
+	}
+	Changes.Add({ Version, ActorGuid });
+
+	if (Changes.Num() > GenSceneJournal::MaxJournalEntries)
+	{
+		const int32 NumDropped = Changes.Num() / 2;
+		BaseVersion = Changes[NumDropped - 1].Version;
+		Changes.RemoveAt(0, NumDropped);
+	}
+}
+
+void FGenSceneJournal::RecordActor(AActor* Actor)
+{
+	if (Actor && IsInEditorWorld(Actor))
+	{
+		RecordChange(Actor->GetActorGuid());
+	}
+}
+
+void FGenSceneJournal::RecordReset()
+{
+	++Version;
+	BaseVersion = Version;
+	Changes.Reset();
+	KnownActors.Reset();
+	bKnownActorsValid = false;
+	bResyncPending = false;
+}
+
+void FGenSceneJournal::Resync()
+{
+	if (bKnownActorsValid && !bResyncPending)
+	{
+		return;
+	}
+
+	TSet<FGuid> CurrentActors;
+	CurrentActors.Reserve(KnownActors.Num());
+	FGenActorIndex::Get().ForEachActor([&CurrentActors](AActor* Actor)
+	{
+		const FGuid Guid = Actor->GetActorGuid();
+		if (Guid.IsValid())
+		{
+			CurrentActors.Add(Guid);
+		}
+	});
+
+	// Without a previous actor set there is nothing to compare with, clients snapshot after a reset anyway
+	if (bKnownActorsValid)
+	{
+		for (const FGuid& Guid : CurrentActors)
+		{
+			if (!KnownActors.Contains(Guid))
+			{
+				RecordChange(Guid);
+			}
+		}
+		for (const FGuid& Guid : KnownActors)
+		{
+			if (!CurrentActors.Contains(Guid))
+			{
+				RecordChange(Guid);
+			}
+		}
+	}
+
+	KnownActors = MoveTemp(CurrentActors);
+	bKnownActorsValid = true;
+	bResyncPending = false;
+}
+
+FString FGenSceneJournal::MakeVersionToken(int64 InVersion) const
+{
+	return FString::Printf(TEXT("%s:%lld"), *SessionId.ToString(), InVersion);
+}
+
+bool FGenSceneJournal::ParseVersionToken(const FString& Token, int64& OutVersion) const
+{
+	FString Session;
+	FString Number;
+	if (!Token.Split(TEXT(":"), &Session, &Number) || Session != SessionId.ToString() || !Number.IsNumeric())
+	{
+		return false;
+	}
+	OutVersion = FCString::Atoi64(*Number);
+	return true;
+}
+
+bool FGenSceneJournal::IsInEditorWorld(const AActor* Actor) const
+{
+	return GEditor && Actor->GetWorld() == GEditor->GetEditorWorldContext().World();
+}
+
+TSharedRef<FJsonObject> FGenSceneJournal::SerializeActor(AActor* Actor, const FQuery& Query)
+{
+	TSharedRef<FJsonObject> ActorObject = MakeShared<FJsonObject>();
+	ActorObject->SetStringField(TEXT("id"), Actor->GetActorGuid().ToString());
+	if (Query.HasField(TEXT("name")))
+	{
+		ActorObject->SetStringField(TEXT("name"), Actor->GetName());
+	}
+	if (Query.HasField(TEXT("label")))
+	{
+		ActorObject->SetStringField(TEXT("label"), Actor->GetActorLabel());
+	}
+	if (Query.HasField(TEXT("class")))
+	{
+		ActorObject->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+	}
+	if (Query.HasField(TEXT("folder")))
+	{
+		ActorObject->SetStringField(TEXT("folder"), Actor->GetFolderPath().ToString());
+	}
+	if (Query.HasField(TEXT("location")))
+	{
+		ActorObject->SetArrayField(TEXT("location"), GenSceneJournal::MakeVector(Actor->GetActorLocation()));
+	}
+	if (Query.HasField(TEXT("rotation")))
+	{
+		const FRotator Rotation = Actor->GetActorRotation();
+		ActorObject->SetArrayField(TEXT("rotation"), GenSceneJournal::MakeVector(FVector(Rotation.Pitch, Rotation.Yaw, Rotation.Roll)));
+	}
+	if (Query.HasField(TEXT("scale")))
+	{
+		ActorObject->SetArrayField(TEXT("scale"), GenSceneJournal::MakeVector(Actor->GetActorScale3D()));
+	}
+	if (Query.HasField(TEXT("bounds")))
+	{
+		FVector Origin;
+		FVector Extent;
+		Actor->GetActorBounds(false, Origin, Extent);
+		TSharedRef<FJsonObject> BoundsObject = MakeShared<FJsonObject>();
+		BoundsObject->SetArrayField(TEXT("origin"), GenSceneJournal::MakeVector(Origin));
+		BoundsObject->SetArrayField(TEXT("extent"), GenSceneJournal::MakeVector(Extent));
+		ActorObject->SetObjectField(TEXT("bounds"), BoundsObject);
+	}
+	if (Query.HasField(TEXT("components")))
+	{
+		TArray<TSharedPtr<FJsonValue>> ComponentsArray;
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			if (!Component) continue;
+			TSharedRef<FJsonObject> ComponentObject = MakeShared<FJsonObject>();
+			ComponentObject->SetStringField(TEXT("name"), Component->GetName());
+			ComponentObject->SetStringField(TEXT("class"), Component->GetClass()->GetName());
+			ComponentsArray.Add(MakeShared<FJsonValueObject>(ComponentObject));
+		}
+		ActorObject->SetArrayField(TEXT("components"), ComponentsArray);
+	}
+	return ActorObject;
+}
+
+void FGenSceneJournal::OnLevelActorAdded(AActor* Actor)
+{
+	if (Actor && IsInEditorWorld(Actor))
+	{
+		RecordChange(Actor->GetActorGuid());
+		if (bKnownActorsValid)
+		{
+			KnownActors.Add(Actor->GetActorGuid());
+		}
+	}
+}
+
+void FGenSceneJournal::OnLevelActorDeleted(AActor* Actor)
+{
+	if (Actor && IsInEditorWorld(Actor))
+	{
+		RecordChange(Actor->GetActorGuid());
+		KnownActors.Remove(Actor->GetActorGuid());
+	}
+}
+
+void FGenSceneJournal::OnLevelActorFolderChanged(const AActor* Actor, FName OldPath)
+{
+	if (Actor && IsInEditorWorld(Actor))
+	{
+		RecordChange(Actor->GetActorGuid());
+	}
+}
+
+void FGenSceneJournal::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		RecordActor(Actor);
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		RecordActor(Component->GetOwner());
+	}
+}
+
+bool FGenSceneJournal::FQuery::Parse(const FString& QueryJson, FString& OutError)
+{
+	Fields = { TEXT("name"), TEXT("label"), TEXT("class"), TEXT("location") };
+	if (QueryJson.TrimStartAndEnd().IsEmpty())
+	{
+		return true;
+	}
+
+	TSharedPtr<FJsonObject> Object;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(QueryJson);
+	if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+	{
+		OutError = TEXT("Failed to parse query JSON");
+		return false;
+	}
+
+	Object->TryGetStringArrayField(TEXT("classes"), Classes);
+	Object->TryGetStringField(TEXT("folder"), Folder);
+
+	const TSharedPtr<FJsonObject>* BoundsObject = nullptr;
+	if (Object->TryGetObjectField(TEXT("bounds"), BoundsObject))
+	{
+		const TArray<TSharedPtr<FJsonValue>>* MinValues = nullptr;
+		const TArray<TSharedPtr<FJsonValue>>* MaxValues = nullptr;
+		(*BoundsObject)->TryGetArrayField(TEXT("min"), MinValues);
+		(*BoundsObject)->TryGetArrayField(TEXT("max"), MaxValues);
+
+		FVector Min;
+		FVector Max;
+		if (!GenSceneJournal::ParseVector(MinValues, Min) || !GenSceneJournal::ParseVector(MaxValues, Max))
+		{
+			OutError = TEXT("bounds needs \"min\" and \"max\" as [X, Y, Z]");
+			return false;
+		}
+		Bounds = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+	}
+
+	TArray<FString> FieldNames;
+	if (Object->TryGetStringArrayField(TEXT("fields"), FieldNames))
+	{
+		Fields.Reset();
+		Fields.Append(FieldNames);
+	}
+
+	FString CursorString;
+	if (Object->TryGetStringField(TEXT("cursor"), CursorString) && !CursorString.IsEmpty()
+		&& !FGuid::Parse(CursorString, Cursor))
+	{
+		OutError = FString::Printf(TEXT("Invalid cursor: %s"), *CursorString);
+		return false;
+	}
+
+	int32 RequestedLimit = 0;
+	if (Object->TryGetNumberField(TEXT("limit"), RequestedLimit) && RequestedLimit > 0)
+	{
+		Limit = FMath::Min(RequestedLimit, GenSceneJournal::MaxPageSize);
+	}
+	return true;
+}
+
+bool FGenSceneJournal::FQuery::Matches(AActor* Actor) const
+{
+	if (Classes.Num() > 0)
+	{
+		bool bClassMatches = false;
+		for (const UClass* Class = Actor->GetClass(); Class && !bClassMatches; Class = Class->GetSuperClass())
+		{
+			bClassMatches = Classes.Contains(Class->GetName());
+		}
+		if (!bClassMatches)
+		{
+			return false;
+		}
+	}
+
+	if (!Folder.IsEmpty() && !Actor->GetFolderPath().ToString().StartsWith(Folder))
+	{
+		return false;
+	}
+
+	if (Bounds.IsValid)
+	{
+		FVector Origin;
+		FVector Extent;
+		Actor->GetActorBounds(false, Origin, Extent);
+		if (!Bounds.Intersect(FBox(Origin - Extent, Origin + Extent)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FGenSceneJournal::FQuery::HasField(const TCHAR* Field) const
+{
+	return Fields.Contains(Field) || Fields.Contains(TEXT("all"));
+}
@@ -0,0 +1,327 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#include "MCP/GenSpatialIndex.h"
+
+#include "Components/ActorComponent.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace GenSpatialIndex
+{
+	// Half size of the root node, actors outside of it are kept in the root
+	constexpr double OctreeExtent = 16777216.0;
+
+	// Nearest queries start with this radius and widen it until enough actors are found
+	constexpr double InitialNearestRadius = 1000.0;
+
+	FBoxCenterAndExtent GetActorBounds(const AActor* Actor)
+	{
+		FVector Origin;
+		FVector Extent;
+		Actor->GetActorBounds(false, Origin, Extent);
+
+		// Actors without primitives have no bounds, they are found at their location
+		if (Extent.IsNearlyZero())
+		{
+			return FBoxCenterAndExtent(Actor->GetActorLocation(), FVector::ZeroVector);
+		}
+		return FBoxCenterAndExtent(Origin, Extent);
+	}
+
+	// Slab test, OutDistance is where the ray enters the box or 0 when it starts inside
+	bool IntersectRay(const FBox& Box, const FVector& Start, const FVector& Direction, double MaxDistance, double& OutDistance)
+	{
+		double Near = 0.0;
+		double Far = MaxDistance;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (FMath::IsNearlyZero(Direction[Axis]))
+			{
+				if (Start[Axis] < Box.Min[Axis] || Start[Axis] > Box.Max[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const double InvDirection = 1.0 / Direction[Axis];
+			const double T0 = (Box.Min[Axis] - Start[Axis]) * InvDirection;
+			const double T1 = (Box.Max[Axis] - Start[Axis]) * InvDirection;
+			Near = FMath::Max(Near, FMath::Min(T0, T1));
+			Far = FMath::Min(Far, FMath::Max(T0, T1));
+			if (Near > Far)
+			{
+				return false;
+			}
+		}
+		OutDistance = Near;
+		return true;
+	}
+
+	void SortAndTrim(TArray<FGenSpatialHit>& Hits, int32 MaxResults)
+	{
+		Hits.Sort([](const FGenSpatialHit& A, const FGenSpatialHit& B)
+		{
+			return A.Distance < B.Distance;
+		});
+		if (MaxResults > 0 && Hits.Num() > MaxResults)
+		{
+			Hits.SetNum(MaxResults);
+		}
+	}
+}
+
+FGenSpatialIndex* FGenSpatialIndex::Singleton = nullptr;
+
+FGenSpatialIndex& FGenSpatialIndex::Get()
+{
+	if (!Singleton)
+	{
+		Singleton = new FGenSpatialIndex();
+	}
+	return *Singleton;
+}
+
+void FGenSpatialIndex::FOctreeSemantics::SetElementId(const FElement& Element, FOctreeElementId2 Id)
+{
+	Singleton->ElementIds.Add(Element.Actor, Id);
+}
+
+void FGenSpatialIndex::Initialize()
+{
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FGenSpatialIndex::AddActor);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FGenSpatialIndex::RemoveActor);
+		ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddRaw(this, &FGenSpatialIndex::MarkDirty);
+	}
+	if (GEditor)
+	{
+		ActorMovedHandle = GEditor->OnActorMoved().AddRaw(this, &FGenSpatialIndex::UpdateActor);
+	}
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FGenSpatialIndex::OnObjectPropertyChanged);
+
+	// Map loads and undo move or bring back actors without reporting each of them
+	MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32)
+	{
+		MarkDirty();
+	});
+	PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FGenSpatialIndex::MarkDirty);
+}
+
+void FGenSpatialIndex::Shutdown()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+	}
+	if (GEditor)
+	{
+		GEditor->OnActorMoved().Remove(ActorMovedHandle);
+	}
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+	FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+	ActorAddedHandle.Reset();
+	ActorDeletedHandle.Reset();
+	ActorListChangedHandle.Reset();
+	ActorMovedHandle.Reset();
+	PropertyChangedHandle.Reset();
+	MapChangeHandle.Reset();
+	PostUndoRedoHandle.Reset();
+	Reset();
+}
+
+TArray<FGenSpatialHit> FGenSpatialIndex::FindInRadius(const FVector& Center, double Radius, int32 MaxResults)
+{
+	TArray<FGenSpatialHit> Hits;
+	if (!Update() || Radius < 0.0)
+	{
+		return Hits;
+	}
+
+	const double RadiusSquared = FMath::Square(Radius);
+	Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(Center, FVector(Radius)),
+		[&Hits, &Center, RadiusSquared](const FElement& Element)
+		{
+			AActor* Actor = Element.Actor.Get();
+			const double DistanceSquared = Element.Bounds.GetBox().ComputeSquaredDistanceToPoint(Center);
+			if (IsValid(Actor) && DistanceSquared <= RadiusSquared)
+			{
+				Hits.Add({ Actor, FMath::Sqrt(DistanceSquared) });
+			}
+		});
+
+	GenSpatialIndex::SortAndTrim(Hits, MaxResults);
+	return Hits;
+}
+
+TArray<FGenSpatialHit> FGenSpatialIndex::FindInBox(const FBox& Box, int32 MaxResults)
+{
+	TArray<FGenSpatialHit> Hits;
+	if (!Update() || !Box.IsValid)
+	{
+		return Hits;
+	}
+
+	// Sorted by distance to the box center so a trimmed result keeps the central actors
+	const FVector BoxCenter = Box.GetCenter();
+	Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(Box),
+		[&Hits, &BoxCenter](const FElement& Element)
+		{
+			if (AActor* Actor = Element.Actor.Get(); IsValid(Actor))
+			{
+				Hits.Add({ Actor, FMath::Sqrt(Element.Bounds.GetBox().ComputeSquaredDistanceToPoint(BoxCenter)) });
+			}
+		});
+
+	GenSpatialIndex::SortAndTrim(Hits, MaxResults);
+	return Hits;
+}
+
+TArray<FGenSpatialHit> FGenSpatialIndex::FindAlongRay(const FVector& Start, const FVector& Direction, double MaxDistance, int32 MaxResults)
+{
+	TArray<FGenSpatialHit> Hits;
+	const FVector UnitDirection = Direction.GetSafeNormal();
+	if (!Update() || UnitDirection.IsZero() || MaxDistance <= 0.0)
+	{
+		return Hits;
+	}
+
+	// Only descend into the nodes the ray passes through, the loose node bounds contain all their elements
+	Octree->FindElementsWithPredicate(
+		[&Start, &UnitDirection, MaxDistance](auto ParentNodeIndex, auto NodeIndex, const FBoxCenterAndExtent& NodeBounds)
+		{
+			double Distance = 0.0;
+			return GenSpatialIndex::IntersectRay(NodeBounds.GetBox(), Start, UnitDirection, MaxDistance, Distance);
+		},
+		[&Hits, &Start, &UnitDirection, MaxDistance](auto ParentNodeIndex, const FElement& Element)
+		{
+			AActor* Actor = Element.Actor.Get();
+			double Distance = 0.0;
+			if (IsValid(Actor) && GenSpatialIndex::IntersectRay(Element.Bounds.GetBox(), Start, UnitDirection, MaxDistance, Distance))
+			{
+				Hits.Add({ Actor, Distance });
+			}
+		});
+
+	GenSpatialIndex::SortAndTrim(Hits, MaxResults);
+	return Hits;
+}
+
+TArray<FGenSpatialHit> FGenSpatialIndex::FindNearest(const FVector& Location, int32 Count)
+{
+	TArray<FGenSpatialHit> Hits;
+	if (!Update() || Count <= 0)
+	{
+		return Hits;
+	}
+
+	// Every actor within the radius is found, so the closest Count of them are the nearest overall
+	for (double Radius = GenSpatialIndex::InitialNearestRadius; ; Radius *= 4.0)
+	{
+		Hits = FindInRadius(Location, Radius, 0);
+		if (Hits.Num() >= Count || Radius >= GenSpatialIndex::OctreeExtent * 2.0)
+		{
+			break;
+		}
+	}
+
+	GenSpatialIndex::SortAndTrim(Hits, Count);
+	return Hits;
+}
+
+void FGenSpatialIndex::Reset()
+{
+	Octree.Reset();
+	ElementIds.Reset();
+	IndexedWorld.Reset();
+	bDirty = true;
+}
+
+bool FGenSpatialIndex::Update()
+{
+	check(IsInGameThread());
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return false;
+	}
+	if (!bDirty && Octree.IsValid() && IndexedWorld.Get() == World)
+	{
+		return true;
+	}
+
+	Reset();
+	Octree = MakeUnique<FActorOctree>(FVector::ZeroVector, GenSpatialIndex::OctreeExtent);
+	IndexedWorld = World;
+	bDirty = false;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AddActor(*It);
+	}
+	UE_LOG(LogTemp, Log, TEXT("Built spatial index over %d actors of %s"), ElementIds.Num(), *World->GetName());
+	return true;
+}
+
+void FGenSpatialIndex::AddActor(AActor* Actor)
+{
+	// Play in editor and preview worlds report their actors too
+	if (bDirty || !IsValid(Actor) || Actor->GetWorld() != IndexedWorld.Get())
+	{
+		return;
+	}
+	if (ElementIds.Contains(Actor))
+	{
+		RemoveActor(Actor);
+	}
+	Octree->AddElement({ Actor, GenSpatialIndex::GetActorBounds(Actor) });
+}
+
+void FGenSpatialIndex::RemoveActor(AActor* Actor)
+{
+	FOctreeElementId2 ElementId;
+	if (!bDirty && ElementIds.RemoveAndCopyValue(Actor, ElementId) && ElementId.IsValidId())
+	{
+		Octree->RemoveElement(ElementId);
+	}
+}
+
+void FGenSpatialIndex::UpdateActor(AActor* Actor)
+{
+	if (IsIndexed(Actor))
+	{
+		AddActor(Actor);
+	}
+}
+
+bool FGenSpatialIndex::IsIndexed(AActor* Actor) const
+{
+	return !bDirty && Actor && ElementIds.Contains(Actor);
+}
+
+void FGenSpatialIndex::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	// Transform and mesh edits in the details panel arrive here rather than as moves
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		UpdateActor(Actor);
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		UpdateActor(Component->GetOwner());
+	}
+}
+
+void FGenSpatialIndex::MarkDirty()
+{
+	bDirty = true;
+}
@@ -3,6 +3,8 @@
 // source tree or http://opensource.org/licenses/MIT.
 
 #include "MCP/GenWidgetUtils.h"
+#include "MCP/GenBlueprintCache.h"
+#include "MCP/GenCompileScheduler.h"
 #include "Blueprint/WidgetTree.h"
 #include "Components/CanvasPanel.h"
 #include "Components/PanelWidget.h"
@@ -60,36 +62,20 @@ UWidget* UGenWidgetUtils::FindWidgetByName(UWidgetTree* WidgetTree, const FName&
 	return nullptr;
 }
 
-bool UGenWidgetUtils::SaveAndRecompileWidgetBlueprint(UBlueprint* WidgetBP)
+bool UGenWidgetUtils::QueueSaveAndRecompileWidgetBlueprint(UBlueprint* WidgetBP)
 {
 	if (!WidgetBP) return false;
 
-	// Mark dirty, compile, and save
-	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBP); // Important for tree changes
-	FKismetEditorUtilities::CompileBlueprint(WidgetBP); // Compile to ensure changes are reflected
-
 	UPackage* Package = WidgetBP->GetOutermost();
-	if (Package)
-	{
-		FString PackageFileName = FPackageName::LongPackageNameToFilename(
-			Package->GetName(), FPackageName::GetAssetPackageExtension());
-		FSavePackageArgs SaveArgs;
-		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-		SaveArgs.SaveFlags = SAVE_NoError; // Suppress success dialogs
-		bool bSaved = UPackage::SavePackage(Package, WidgetBP, *PackageFileName, SaveArgs);
-
-		if (!bSaved)
-		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to save User Widget Blueprint: %s"), *WidgetBP->GetName());
-			return false;
-		}
-		// FAssetRegistryModule::AssetCreated(WidgetBP); // Use AssetSaved? Or handled by SavePackage? Test this.
-	}
-	else
+	if (!Package)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed get package for: %s"), *WidgetBP->GetName());
 		return false;
 	}
+
+	// Mark dirty, the compile and save run once for a series of widget edits
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(WidgetBP); // Important for tree changes
+	FGenCompileScheduler::Get().RequestCompile(WidgetBP, true);
 	return true;
 }
 
@@ -119,7 +105,7 @@ FString UGenWidgetUtils::AddWidgetToUserWidget(const FString& UserWidgetPath, co
     };
 
     // 1. Load and Validate Blueprint Asset
-    UBlueprint* LoadedBP = LoadObject<UBlueprint>(nullptr, *UserWidgetPath);
+    UBlueprint* LoadedBP = FGenBlueprintCache::Get().FindBlueprint(UserWidgetPath);
     if (!LoadedBP)
     {
         return CreateJsonReturn(false, FString::Printf(TEXT("User Widget Blueprint asset not found at: %s"), *UserWidgetPath));
@@ -237,13 +223,13 @@ FString UGenWidgetUtils::AddWidgetToUserWidget(const FString& UserWidgetPath, co
             WidgetBP->Modify();
 
             // Save and return result for setting root
-            if (SaveAndRecompileWidgetBlueprint(WidgetBP))
+            if (QueueSaveAndRecompileWidgetBlueprint(WidgetBP))
             {
-                return CreateJsonReturn(true, FString::Printf(TEXT("Successfully added '%s' (%s) as the Root Widget to '%s'."), *NewRootWidget->GetName(), *WidgetClassName, *UserWidgetPath), NewRootWidget->GetName());
+                return CreateJsonReturn(true, FString::Printf(TEXT("Successfully added '%s' (%s) as the Root Widget to '%s', compile and save queued."), *NewRootWidget->GetName(), *WidgetClassName, *UserWidgetPath), NewRootWidget->GetName());
             }
             else
             {
-                return CreateJsonReturn(false, FString::Printf(TEXT("Set '%s' as root but failed to save/recompile Blueprint '%s'."), *NewRootWidget->GetName(), *UserWidgetPath));
+                return CreateJsonReturn(false, FString::Printf(TEXT("Set '%s' as root but failed to queue the compile and save of Blueprint '%s'."), *NewRootWidget->GetName(), *UserWidgetPath));
             }
         }
         else
@@ -300,13 +286,13 @@ FString UGenWidgetUtils::AddWidgetToUserWidget(const FString& UserWidgetPath, co
         }
 
         // Save and return result for adding child
-        if (SaveAndRecompileWidgetBlueprint(WidgetBP))
+        if (QueueSaveAndRecompileWidgetBlueprint(WidgetBP))
         {
-            return CreateJsonReturn(true, FString::Printf(TEXT("Successfully added widget '%s' of type '%s' as child of '%s' in '%s'."), *ActualWidgetName.ToString(), *WidgetClassName, *ParentPanel->GetName(), *UserWidgetPath), ActualWidgetName.ToString());
+            return CreateJsonReturn(true, FString::Printf(TEXT("Successfully added widget '%s' of type '%s' as child of '%s' in '%s', compile and save queued."), *ActualWidgetName.ToString(), *WidgetClassName, *ParentPanel->GetName(), *UserWidgetPath), ActualWidgetName.ToString());
         }
         else
         {
-            return CreateJsonReturn(false, FString::Printf(TEXT("Added widget '%s' but failed to save/recompile Blueprint '%s'."), *ActualWidgetName.ToString(), *UserWidgetPath));
+            return CreateJsonReturn(false, FString::Printf(TEXT("Added widget '%s' but failed to queue the compile and save of Blueprint '%s'."), *ActualWidgetName.ToString(), *UserWidgetPath));
         }
         // --- END OF CHILD ADDING LOGIC ---
     }
@@ -371,7 +357,7 @@ FString UGenWidgetUtils::EditWidgetProperty(const FString& UserWidgetPath, const
 {
 	TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
 
-	UBlueprint* LoadedBP = LoadObject<UBlueprint>(nullptr, *UserWidgetPath);
+	UBlueprint* LoadedBP = FGenBlueprintCache::Get().FindBlueprint(UserWidgetPath);
 	UWidgetBlueprint* WidgetBP = Cast<UWidgetBlueprint>(LoadedBP);
 	if (!WidgetBP || !WidgetBP->GeneratedClass || !WidgetBP->GeneratedClass->IsChildOf(UUserWidget::StaticClass()))
 	{
@@ -502,18 +488,18 @@ FString UGenWidgetUtils::EditWidgetProperty(const FString& UserWidgetPath, const
 
 	if (bSuccess)
 	{
-		if (SaveAndRecompileWidgetBlueprint(WidgetBP))
+		if (QueueSaveAndRecompileWidgetBlueprint(WidgetBP))
 		{
 			ResultJson->SetBoolField("success", true);
 			ResultJson->SetStringField("message", FString::Printf(
-				                           TEXT("Successfully set property '%s' on widget '%s' in '%s'."),
+				                           TEXT("Successfully set property '%s' on widget '%s' in '%s', compile and save queued."),
 				                           *PropertyName, *WidgetName, *UserWidgetPath));
 		}
 		else
 		{
 			ResultJson->SetBoolField("success", false);
 			ResultJson->SetStringField("error", FString::Printf(
-				                           TEXT("Set property '%s' but failed to save/recompile Blueprint '%s'."),
+				                           TEXT("Set property '%s' but failed to queue the compile and save of Blueprint '%s'."),
 				                           *PropertyName, *UserWidgetPath));
 		}
 	}
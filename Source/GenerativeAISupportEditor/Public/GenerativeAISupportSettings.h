@@ -23,4 +23,8 @@ public:
     /** Whether to automatically start the socket server when Unreal Engine launches */
     UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Socket Server", meta = (DisplayName = "Auto Start Socket Server"))
     bool bAutoStartSocketServer;
+
+    /** Blueprints edited by MCP commands are compiled together once no edit arrived for this long */
+    UPROPERTY(config, EditAnywhere, BlueprintReadWrite, Category = "Blueprint Tools", meta = (ClampMin = "0.0", Units = "s"))
+    float CompileIdleDelaySeconds;
 };
@@ -0,0 +1,94 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UActorComponent;
+class UWorld;
+
+/**
+ * Finds the actors of the editor world by label, name or GUID without walking the level.
+ *
+ * The index is built once for the current editor world and then follows actor adds, deletes and
+ * label changes. Bulk changes like level streaming or undo only mark it dirty, it is rebuilt on
+ * the next lookup. Components are indexed by name per actor when first asked for and rebuilt when
+ * a hit turns out stale, construction scripts recreate them on every edit. Game thread only.
+ */
+class GENERATIVEAISUPPORTEDITOR_API FGenActorIndex
+{
+public:
+	/** Gets the singleton instance */
+	static FGenActorIndex& Get();
+
+	/** Follows the editor's actor and map events */
+	void Initialize();
+
+	void Shutdown();
+
+	/** Actor with the given label, same as comparing GetActorLabel() but without iterating the level */
+	AActor* FindActorByLabel(const FString& Label);
+
+	/** Actor with the given object name */
+	AActor* FindActorByName(FName Name);
+
+	AActor* FindActorByGuid(const FGuid& Guid);
+
+	/** Component of the actor with the given object name */
+	UActorComponent* FindComponent(AActor* Actor, FName ComponentName);
+
+	/** Visits every indexed actor of the editor world */
+	void ForEachActor(TFunctionRef<void(AActor*)> Visitor);
+
+	/** Labels of every indexed actor, only meant for error messages */
+	TArray<FString> GetActorLabels();
+
+	/** Names of the actor's components, only meant for error messages */
+	TArray<FString> GetComponentNames(AActor* Actor);
+
+	/** Forgets everything, the next lookup rebuilds the index */
+	void Reset();
+
+private:
+	struct FActorEntry
+	{
+		FString Label;
+		FName Name;
+		FGuid Guid;
+		TMap<FName, TWeakObjectPtr<UActorComponent>> Components;
+		bool bComponentsIndexed = false;
+	};
+
+	/** Rebuilds the index when the editor world changed or a bulk change was reported */
+	UWorld* Update();
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+	void IndexComponents(AActor* Actor, FActorEntry& Entry);
+
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnActorLabelChanged(AActor* Actor);
+	void MarkDirty();
+
+	static FGenActorIndex* Singleton;
+
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	bool bDirty = true;
+
+	TMap<TWeakObjectPtr<AActor>, FActorEntry> Entries;
+	TMultiMap<FString, TWeakObjectPtr<AActor>> ActorsByLabel;
+	TMap<FName, TWeakObjectPtr<AActor>> ActorsByName;
+	TMap<FGuid, TWeakObjectPtr<AActor>> ActorsByGuid;
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorListChangedHandle;
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle PostUndoRedoHandle;
+};
@@ -58,4 +58,18 @@ public:
 
 	// Utility function to find actors by name
 	static AActor* FindActorByName(const FString& ActorName);
+
+	// Spatial queries over the editor world, JSON with the actors sorted by distance
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Actor Utils")
+	static FString FindActorsInRadius(const FVector& Center, float Radius, int32 MaxResults);
+
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Actor Utils")
+	static FString FindActorsInBox(const FVector& Min, const FVector& Max, int32 MaxResults);
+
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Actor Utils")
+	static FString FindActorsAlongRay(const FVector& Start, const FVector& Direction, float MaxDistance,
+	                                  int32 MaxResults);
+
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Actor Utils")
+	static FString FindNearestActors(const FVector& Location, int32 Count);
 };
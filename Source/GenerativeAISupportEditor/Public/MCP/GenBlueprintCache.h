@@ -0,0 +1,57 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraph;
+struct FAssetData;
+
+/**
+ * Resolves the Blueprint paths and graph GUIDs the MCP commands refer to.
+ *
+ * A command sequence usually targets the same asset over and over, so resolved Blueprints are
+ * kept by path and their graphs by GUID. Entries only hold weak pointers, are checked on every
+ * hit and are dropped when the asset registry reports a rename or removal or a package is
+ * reloaded. Game thread only.
+ */
+class GENERATIVEAISUPPORTEDITOR_API FGenBlueprintCache
+{
+public:
+	/** Gets the singleton instance */
+	static FGenBlueprintCache& Get();
+
+	/** Follows asset renames, removals and package reloads */
+	void Initialize();
+
+	void Shutdown();
+
+	/** Cached replacement for LoadObject<UBlueprint>, loads the asset on a miss */
+	UBlueprint* FindBlueprint(const FString& BlueprintPath);
+
+	/** Function, event or macro graph of the Blueprint, the graphs are scanned only on a miss */
+	UEdGraph* FindGraph(UBlueprint* Blueprint, const FGuid& GraphGuid);
+
+	/** Forgets every Blueprint and graph */
+	void Reset();
+
+private:
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void RemovePath(const FString& ObjectPath);
+
+	/** "/Game/BP" and "/Game/BP.BP" name the same asset */
+	static FString MakeObjectPath(const FString& BlueprintPath);
+
+	static FGenBlueprintCache* Singleton;
+
+	TMap<FString, TWeakObjectPtr<UBlueprint>> BlueprintsByPath;
+	TMap<TWeakObjectPtr<UBlueprint>, TMap<FGuid, TWeakObjectPtr<UEdGraph>>> GraphsByBlueprint;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle PackageReloadedHandle;
+};
@@ -7,6 +7,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "K2Node.h"
+#include "Dom/JsonObject.h"
 #include "GenBlueprintNodeCreator.generated.h"
 
 /**
@@ -27,6 +28,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Nodes")
 	static FString AddNodesBulk(const FString& BlueprintPath, const FString& FunctionGuid, const FString& NodesJson);
 
+	// Makes a graph match a complete spec of nodes and links, only the differences are applied, in one transaction with one compile
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Nodes")
+	static FString ApplyGraph(const FString& BlueprintPath, const FString& FunctionGuid, const FString& GraphJson);
+
 	UFUNCTION(BlueprintCallable, Category = "Blueprint")
 	static bool DeleteNode(const FString& BlueprintPath, const FString& FunctionGuid, const FString& NodeGuid);
 
@@ -49,7 +54,18 @@ private:
 	static void InitNodeTypeMap();
 	// Attempts to create a node of a known type
 	static bool TryCreateKnownNodeType(UEdGraph* Graph, const FString& NodeType, UK2Node*& OutNode,
-									   const FString& PropertiesJson = TEXT(""));
+									   const TSharedPtr<FJsonObject>& Properties = nullptr);
+
+	// Creates a node in an already resolved graph and applies its parsed properties, OutSuggestions is set when the type is ambiguous.
+	// Without bNotifyGraph the node is added silently, the caller notifies the graph once for the whole batch
+	static UK2Node* CreateNode(UEdGraph* Graph, const FString& NodeType, float NodeX, float NodeY,
+							   const TSharedPtr<FJsonObject>& Properties, FString& OutSuggestions, bool bNotifyGraph = true);
+
+	// Sets pin defaults and variable references, returns whether the node changed
+	static bool ApplyNodeProperties(UK2Node* Node, const FString& NodeType, const FJsonObject& Properties);
+
+	// Brings the graph to front and marks the blueprint structurally modified if any node changed it
+	static void FinalizeGraphChanges(UBlueprint* Blueprint, UEdGraph* Graph);
 	static UEdGraph* GetGraphFromFunctionId(UBlueprint* Blueprint, const FString& FunctionGuid);
 
 	// Attempts to create a node by searching Blueprint libraries and actor classes
@@ -94,6 +94,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
 	static bool CompileBlueprint(const FString& BlueprintPath);
 
+	/**
+	 * Compile every Blueprint whose edits are still waiting for the next coalesced compile
+	 * 
+	 * @return JSON with the status and the compiler errors and warnings of each compiled Blueprint
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
+	static FString FlushPendingCompiles();
+
 	/**
 	 * Spawn a Blueprint actor in the level
 	 * 
@@ -134,6 +142,8 @@ public:
 private:
 	// Helper functions for internal use
 	static UBlueprint* LoadBlueprintAsset(const FString& BlueprintPath);
+	// Resolves "EventGraph" or a function graph GUID, OutError is set when no graph matches
+	static UEdGraph* FindGraph(UBlueprint* Blueprint, const FString& FunctionGuid, FString& OutError);
 	static UClass* FindClassByName(const FString& ClassName);
 	static UFunction* FindFunctionByName(UClass* Class, const FString& FunctionName);
 };
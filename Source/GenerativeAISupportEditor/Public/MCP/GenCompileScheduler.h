@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class UBlueprint;
+
+/**
+ * Coalesces Blueprint compiles requested by the MCP commands.
+ *
+ * Edits mark their Blueprint dirty here instead of compiling it. Once no compile was requested
+ * for the idle delay of the editor settings, every dirty Blueprint is queued with the Blueprint
+ * compilation manager and compiled in one batch, which orders parents and dependencies before
+ * the Blueprints that use them. Commands that need compiled results flush explicitly.
+ * Game thread only.
+ */
+class GENERATIVEAISUPPORTEDITOR_API FGenCompileScheduler
+{
+public:
+	/** Gets the singleton instance */
+	static FGenCompileScheduler& Get();
+
+	/** Flushes pending compiles before play in editor starts and before the editor exits */
+	void Initialize();
+
+	/** Compiles what is still pending and stops the idle ticker, on engine exit the rest is dropped unsaved */
+	void Shutdown();
+
+	/** Marks the Blueprint for the next batch, bSaveAfterCompile also saves its package after compiling */
+	void RequestCompile(UBlueprint* Blueprint, bool bSaveAfterCompile = false);
+
+	/** Compiles the Blueprint now together with the pending Blueprints it depends on, false if it has errors */
+	bool Flush(UBlueprint* Blueprint);
+
+	/** Compiles every pending Blueprint in one batch, returns the Blueprints that were compiled */
+	TArray<UBlueprint*> FlushAll();
+
+	bool IsPending(const UBlueprint* Blueprint) const;
+
+	int32 GetNumPending() const { return Pending.Num(); }
+
+private:
+	struct FPendingCompile
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		bool bSave = false;
+	};
+
+	bool Tick(float DeltaTime);
+	TArray<UBlueprint*> CompileBatch(TArray<FPendingCompile>&& Batch);
+	static bool SaveBlueprint(UBlueprint* Blueprint);
+
+	static FGenCompileScheduler* Singleton;
+
+	TArray<FPendingCompile> Pending;
+	double LastRequestTime = 0.0;
+	FTSTicker::FDelegateHandle TickHandle;
+	FDelegateHandle PreBeginPIEHandle;
+	FDelegateHandle EditorPreExitHandle;
+};
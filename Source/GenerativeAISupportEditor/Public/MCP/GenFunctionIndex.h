@@ -0,0 +1,148 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Modules/ModuleManager.h"
+#include "Tasks/Task.h"
+
+struct FAssetData;
+class UBlueprint;
+
+/**
+ * A callable function found by FGenFunctionIndex
+ */
+struct GENERATIVEAISUPPORTEDITOR_API FGenFunctionMatch
+{
+	/** Path of the class that declares the function */
+	FString ClassPath;
+
+	FString ClassName;
+
+	FName FunctionName;
+
+	/** Rank among the matches, includes the spelling, static and preferred class bonuses */
+	int32 Score = 0;
+
+	/** Name match alone on the scale of the old library search, 120 exact, 80 or more contained */
+	int32 NameScore = 0;
+
+	/** Declared by one of the libraries the old library search covered */
+	bool bPreferredClass = false;
+
+	/** ClassName.FunctionName, the form suggestions are reported in */
+	FString GetDisplayName() const;
+
+	/** Finds the function again, null if its class was unloaded since the index was built */
+	UFunction* Resolve() const;
+};
+
+/**
+ * Search index over every Blueprint callable and pure function of the loaded native classes and of the
+ * project's Blueprint function libraries.
+ *
+ * The native functions are collected once after engine init and again for each module loaded later.
+ * Function libraries are loaded once the asset registry finished its scan, each gets its own segment
+ * that is replaced when the library compiles and dropped when the asset is removed or renamed.
+ * Names are split into lower case words and trigrams and the inverted lists for both are built
+ * on a worker, queries then only score the functions that share a word or trigram with the query.
+ * Each build adds one immutable segment and publishes a snapshot listing the segments, so lookups
+ * never wait for a module being indexed and a module load never copies the earlier segments.
+ */
+class GENERATIVEAISUPPORTEDITOR_API FGenFunctionIndex
+{
+public:
+	/** Gets the singleton instance */
+	static FGenFunctionIndex& Get();
+
+	/** Builds the index once the engine is initialized and follows module loads and library assets from then on */
+	void Initialize();
+
+	/** Stops following module loads and library assets and waits for a running build */
+	void Shutdown();
+
+	/**
+	 * Ranked lookup of a node type such as "PrintString", "print string" or "KismetMathLibrary.Add_IntInt".
+	 * NameScore is 120 for the exact name and 80 or more when the name contains the query, game thread only
+	 */
+	TArray<FGenFunctionMatch> Find(const FString& Query, int32 MaxResults = 10);
+
+	/** Number of indexed functions, waits for the first build */
+	int32 Num();
+
+private:
+	struct FEntry
+	{
+		FString ClassPath;
+		FString ClassName;
+		FName FunctionName;
+		FString NameLower;
+		FString ClassLower;
+		TArray<FString> Words;
+		bool bStatic = false;
+	};
+
+	struct FSegment
+	{
+		TArray<FEntry> Entries;
+		TMap<FString, TArray<int32>> EntriesByName;
+		TMap<FString, TArray<int32>> EntriesByWord;
+		TMap<uint64, TArray<int32>> EntriesByTrigram;
+	};
+
+	struct FSnapshot
+	{
+		TArray<TSharedRef<const FSegment, ESPMode::ThreadSafe>> Segments;
+		/** One segment per function library, by the object path of its Blueprint */
+		TMap<FString, TSharedRef<const FSegment, ESPMode::ThreadSafe>> LibrarySegments;
+		int32 NumEntries = 0;
+	};
+
+	void BuildAll();
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	/**
+	 * Indexes the collected functions on a worker, after the builds already queued.
+	 * With a library path the segment replaces the one of that library, no entries remove it
+	 */
+	void QueueBuild(TArray<FEntry>&& NewEntries, const FString& LibraryPath = FString());
+	TSharedPtr<const FSnapshot, ESPMode::ThreadSafe> GetSnapshot();
+
+	/** Adds the callable functions a native class declares, each class is collected once */
+	void CollectClass(const UClass* Class, TArray<FEntry>& OutEntries);
+	static void CollectFunctions(const UClass* Class, const FString& ClassName, TArray<FEntry>& OutEntries);
+
+	/** Loads and indexes every function library known to the asset registry, deferred until its scan is done */
+	void IndexLibraries();
+	void IndexLibrary(UBlueprint* Blueprint);
+	void RemoveLibrary(const FString& ObjectPath);
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnLibraryCompiled(UBlueprint* Blueprint);
+	/** Loads the libraries added since the last tick, the asset registry events are no place to load packages */
+	bool IndexPendingLibraries(float DeltaTime);
+	static bool IsFunctionLibrary(const FAssetData& AssetData);
+
+	static FGenFunctionIndex* Singleton;
+
+	FCriticalSection SnapshotLock;
+	TSharedPtr<const FSnapshot, ESPMode::ThreadSafe> Snapshot;
+	TSet<FString> CollectedClasses;
+	TMap<FString, TWeakObjectPtr<UBlueprint>> Libraries;
+	TSet<FString> PendingLibraries;
+	UE::Tasks::FTask LastBuild;
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle FilesLoadedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FTSTicker::FDelegateHandle PendingLibrariesHandle;
+	bool bInitialized = false;
+	bool bBuildStarted = false;
+	bool bLibrariesIndexed = false;
+};
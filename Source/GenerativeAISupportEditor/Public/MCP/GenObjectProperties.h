@@ -16,6 +16,14 @@ class GENERATIVEAISUPPORTEDITOR_API  UGenObjectProperties : public UAutomationBl
 	
 	UFUNCTION(BlueprintCallable, Category = "Blueprint")
 	FString GetAllSceneObjects();
+
+	/** One page of the scene actors matching QueryJson, with the version token to ask for changes */
+	UFUNCTION(BlueprintCallable, Category = "Blueprint")
+	static FString GetSceneSnapshot(const FString& QueryJson);
+
+	/** Scene actors changed or removed since the version token of a snapshot or previous change query */
+	UFUNCTION(BlueprintCallable, Category = "Blueprint")
+	static FString GetSceneChanges(const FString& SinceVersion, const FString& QueryJson);
 	
 	UFUNCTION(BlueprintCallable, Category = "Blueprint")
 	static FString EditComponentProperty(const FString& BlueprintPath, const FString& ComponentName,
@@ -0,0 +1,114 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class FJsonObject;
+class UObject;
+struct FPropertyChangedEvent;
+
+/**
+ * Versioned view of the editor world for the MCP scene queries.
+ *
+ * Every actor add, delete, move, label, folder or property change bumps the version and is
+ * appended to a bounded journal. A client takes a snapshot once, keeps the version token it
+ * came with and afterwards only asks for the actors changed since then. When the journal no
+ * longer reaches back that far, or the map changed or an undo touched unknown actors, the
+ * answer says so and the client takes a new snapshot. Game thread only.
+ *
+ * Queries are JSON objects with these optional fields:
+ *  - classes: class names, an actor matches if it is of one of them or a subclass
+ *  - folder: outliner folder path prefix
+ *  - bounds: {"min": [X, Y, Z], "max": [X, Y, Z]} box the actor bounds must intersect
+ *  - fields: fields to return per actor besides "id", "all" for every field
+ *  - cursor: "next_cursor" of the previous snapshot page
+ *  - limit: actors per page
+ */
+class GENERATIVEAISUPPORTEDITOR_API FGenSceneJournal
+{
+public:
+	/** Gets the singleton instance */
+	static FGenSceneJournal& Get();
+
+	/** Follows the editor's actor, property and map events */
+	void Initialize();
+
+	void Shutdown();
+
+	/** One page of the actors matching the query, ordered by actor GUID, with the version token */
+	FString GetSnapshot(const FString& QueryJson);
+
+	/** Actors changed or removed since the version token, or a request to take a new snapshot */
+	FString GetChanges(const FString& SinceVersion, const FString& QueryJson);
+
+private:
+	struct FQuery
+	{
+		TArray<FString> Classes;
+		FString Folder;
+		FBox Bounds = FBox(ForceInit);
+		TSet<FString> Fields;
+		FGuid Cursor;
+		int32 Limit = 1000;
+
+		bool Parse(const FString& QueryJson, FString& OutError);
+		bool Matches(AActor* Actor) const;
+		bool HasField(const TCHAR* Field) const;
+	};
+
+	struct FChange
+	{
+		int64 Version = 0;
+		FGuid ActorGuid;
+	};
+
+	void RecordChange(const FGuid& ActorGuid);
+	void RecordActor(AActor* Actor);
+
+	/** Drops the journal, every client has to take a new snapshot */
+	void RecordReset();
+
+	/** Turns a bulk actor list change into per actor changes by comparing with the known actors */
+	void Resync();
+
+	FString MakeVersionToken(int64 InVersion) const;
+	bool ParseVersionToken(const FString& Token, int64& OutVersion) const;
+	bool IsInEditorWorld(const AActor* Actor) const;
+
+	static TSharedRef<FJsonObject> SerializeActor(AActor* Actor, const FQuery& Query);
+
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnLevelActorFolderChanged(const AActor* Actor, FName OldPath);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+
+	static FGenSceneJournal* Singleton;
+
+	/** Tokens of a previous editor session are never accepted */
+	FGuid SessionId;
+	int64 Version = 0;
+
+	/** Oldest version the journal can still answer changes for */
+	int64 BaseVersion = 0;
+
+	TArray<FChange> Changes;
+
+	TSet<FGuid> KnownActors;
+	bool bKnownActorsValid = false;
+	bool bResyncPending = false;
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorListChangedHandle;
+	FDelegateHandle ActorFolderChangedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle PostUndoRedoHandle;
+};
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/GenericOctree.h"
+
+class AActor;
+class UObject;
+class UWorld;
+struct FPropertyChangedEvent;
+
+/**
+ * An actor found by a FGenSpatialIndex query
+ */
+struct GENERATIVEAISUPPORTEDITOR_API FGenSpatialHit
+{
+	AActor* Actor = nullptr;
+
+	/** Distance from the query point or ray start to the actor bounds, 0 when inside */
+	double Distance = 0.0;
+};
+
+/**
+ * Loose octree over the bounds of the editor world actors for the MCP spatial queries.
+ *
+ * The tree is built on the first query and then follows actor adds, deletes, moves and property
+ * changes one actor at a time. Bulk changes like level streaming, map changes or undo mark it
+ * dirty, it is rebuilt on the next query. Every query returns its hits sorted by distance.
+ * Game thread only.
+ */
+class GENERATIVEAISUPPORTEDITOR_API FGenSpatialIndex
+{
+public:
+	/** Gets the singleton instance */
+	static FGenSpatialIndex& Get();
+
+	/** Follows the editor's actor and map events */
+	void Initialize();
+
+	void Shutdown();
+
+	/** Actors whose bounds are within Radius of Center */
+	TArray<FGenSpatialHit> FindInRadius(const FVector& Center, double Radius, int32 MaxResults);
+
+	/** Actors whose bounds intersect the box */
+	TArray<FGenSpatialHit> FindInBox(const FBox& Box, int32 MaxResults);
+
+	/** Actors whose bounds the ray hits within MaxDistance, the distance is where it enters them */
+	TArray<FGenSpatialHit> FindAlongRay(const FVector& Start, const FVector& Direction, double MaxDistance, int32 MaxResults);
+
+	/** The Count actors whose bounds are closest to Location */
+	TArray<FGenSpatialHit> FindNearest(const FVector& Location, int32 Count);
+
+	/** Forgets every actor, the next query rebuilds the tree */
+	void Reset();
+
+private:
+	struct FElement
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FBoxCenterAndExtent Bounds;
+	};
+
+	struct FOctreeSemantics
+	{
+		enum { MaxElementsPerLeaf = 16 };
+		enum { MinInclusiveElementsPerNode = 7 };
+		enum { MaxNodeDepth = 12 };
+
+		typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+		static FBoxCenterAndExtent GetBoundingBox(const FElement& Element) { return Element.Bounds; }
+		static bool AreElementsEqual(const FElement& A, const FElement& B) { return A.Actor == B.Actor; }
+		static void SetElementId(const FElement& Element, FOctreeElementId2 Id);
+	};
+
+	typedef TOctree2<FElement, FOctreeSemantics> FActorOctree;
+
+	/** Rebuilds the tree when the editor world changed or a bulk change was reported */
+	bool Update();
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+	void UpdateActor(AActor* Actor);
+	bool IsIndexed(AActor* Actor) const;
+
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void MarkDirty();
+
+	static FGenSpatialIndex* Singleton;
+
+	TUniquePtr<FActorOctree> Octree;
+	TMap<TWeakObjectPtr<AActor>, FOctreeElementId2> ElementIds;
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	bool bDirty = true;
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorListChangedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle PostUndoRedoHandle;
+};
@@ -46,6 +46,6 @@ private:
     static UWidget* FindWidgetByName(UWidgetTree* WidgetTree, const FName& Name);
     // Helper to get the actual object (widget or slot) and property
     static bool FindPropertyAndObject(UWidget* TargetWidget, const FString& PropertyName, UObject*& OutObject, FProperty*& OutProperty);
-    // Helper to save and recompile widget blueprint
-    static bool SaveAndRecompileWidgetBlueprint(UBlueprint* WidgetBP);
+    // Helper to queue the widget blueprint for the next coalesced compile and save, true once it is queued, not saved
+    static bool QueueSaveAndRecompileWidgetBlueprint(UBlueprint* WidgetBP);
 };
\ No newline at end of file